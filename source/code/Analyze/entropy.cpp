@@ -1,25 +1,262 @@
 #include "entropy.h"
 
-double ENT::Entropy(const TS::intTimeSeries& X) {
-	std::set<std::vector<int>> symbols{ X.begin(),X.end() }; // used to get unique symbols
-	std::vector<std::vector<int>> symbolIndices(symbols.begin(), symbols.end()); // "map" (index in vector is key) to keep track of which symbol is which
-	std::vector<int> frequencyTable(symbols.size(), 0); // count of how many times each symbol shows up
+namespace {
+	// finalizer from splitmix64, spreads the bits of key so that the low bits can be used as a table index
+	inline uint64_t mixBits(uint64_t key) {
+		key ^= key >> 30;
+		key *= 0xbf58476d1ce4e5b9ULL;
+		key ^= key >> 27;
+		key *= 0x94d049bb133111ebULL;
+		key ^= key >> 31;
+		return key;
+	}
+
+	// smallest power of 2 which is at least twice expected (keeps the table at most half full)
+	inline uint64_t tableSizeFor(size_t expected) {
+		uint64_t size = 16;
+		while (size < 2 * (uint64_t)expected) {
+			size <<= 1;
+		}
+		return size;
+	}
 
-	for (auto symbol : X) {
-		frequencyTable[std::find(symbolIndices.begin(), symbolIndices.end(), symbol) - symbolIndices.begin()]++;
+	// number of bits needed to hold values in [0,range]
+	inline int bitsFor(uint64_t range) {
+		int bits = 0;
+		while (range) {
+			bits++;
+			range >>= 1;
+		}
+		return bits;
+	}
+}
+
+ENT::SymbolTable::SymbolTable(size_t expectedKeys) {
+	auto size = tableSizeFor(expectedKeys);
+	keys.resize(size);
+	ids.resize(size, emptySlot);
+	mask = size - 1;
+}
+
+uint32_t ENT::SymbolTable::getID(uint64_t key) {
+	uint64_t slot = mixBits(key) & mask;
+	while (ids[slot] != emptySlot) {
+		if (keys[slot] == key) {
+			return ids[slot];
+		}
+		slot = (slot + 1) & mask; // linear probe
+	}
+	keys[slot] = key;
+	ids[slot] = nextID;
+	return nextID++;
+}
+
+ENT::SymbolSeries ENT::Encode(const TS::intTimeSeries& X) {
+	SymbolSeries encoded;
+	encoded.symbols.resize(X.size());
+	if (X.empty()) {
+		return encoded;
+	}
+
+	// find the range of each column so samples can be bit packed
+	size_t width = X[0].size();
+	bool sameWidth = true;
+	for (const auto& sample : X) {
+		if (sample.size() != width) {
+			sameWidth = false;
+			break;
+		}
+	}
+	std::vector<int> mins;
+	std::vector<int> shifts;
+	int totalBits = 0;
+	if (sameWidth) {
+		mins = X[0];
+		std::vector<int> maxs = X[0];
+		for (const auto& sample : X) {
+			for (size_t i = 0; i < width; i++) {
+				mins[i] = std::min(mins[i], sample[i]);
+				maxs[i] = std::max(maxs[i], sample[i]);
+			}
+		}
+		shifts.resize(width);
+		for (size_t i = 0; i < width && totalBits <= 64; i++) {
+			shifts[i] = totalBits;
+			totalBits += bitsFor((uint64_t)((int64_t)maxs[i] - (int64_t)mins[i]));
+		}
+	}
+
+	SymbolTable table(X.size());
+	if (sameWidth && totalBits <= 64) {
+		// each sample packs into a single 64 bit key
+		for (size_t t = 0; t < X.size(); t++) {
+			uint64_t key = 0;
+			for (size_t i = 0; i < width; i++) {
+				uint64_t value = (uint64_t)((int64_t)X[t][i] - (int64_t)mins[i]);
+				if (value) { // columns with no variation have 0 bits
+					key |= value << shifts[i];
+				}
+			}
+			encoded.symbols[t] = table.getID(key);
+		}
+	}
+	else {
+		// samples are too wide (or ragged) to pack. hash each sample, and resolve collisions
+		// by comparing against the first sample that was assigned each slot
+		uint64_t size = tableSizeFor(X.size());
+		uint64_t mask = size - 1;
+		std::vector<int64_t> firstSample(size, -1); // index in X of the sample that owns this slot
+		std::vector<uint32_t> slotIDs(size);
+		uint32_t nextID = 0;
+		for (size_t t = 0; t < X.size(); t++) {
+			uint64_t hash = X[t].size();
+			for (auto value : X[t]) {
+				hash = mixBits(hash ^ (uint32_t)value) + 0x9e3779b97f4a7c15ULL;
+			}
+			uint64_t slot = mixBits(hash) & mask;
+			while (firstSample[slot] != -1 && X[firstSample[slot]] != X[t]) {
+				slot = (slot + 1) & mask;
+			}
+			if (firstSample[slot] == -1) {
+				firstSample[slot] = t;
+				slotIDs[slot] = nextID++;
+			}
+			encoded.symbols[t] = slotIDs[slot];
+		}
+		encoded.symbolCount = nextID;
+		return encoded;
+	}
+	encoded.symbolCount = table.size();
+	return encoded;
+}
+
+ENT::SymbolSeries ENT::Encode(const TS::intSeriesView& X) {
+	// same as Encode(intTimeSeries) (and gives the same symbols) but works one column at a time
+	SymbolSeries encoded;
+	size_t rows = X.size();
+	encoded.symbols.resize(rows);
+	if (rows == 0) {
+		return encoded;
+	}
+
+	std::vector<uint64_t> keys(rows, 0);
+	std::vector<int> column(rows);
+	int totalBits = 0;
+	for (size_t i = 0; i < X.getWidth() && totalBits <= 64; i++) {
+		X.copyColumn(i, column.data());
+		auto range = std::minmax_element(column.begin(), column.end());
+		int columnMin = *range.first;
+		int shift = totalBits;
+		totalBits += bitsFor((uint64_t)((int64_t)*range.second - (int64_t)columnMin));
+		if (totalBits <= 64 && totalBits > shift) { // columns with no variation have 0 bits
+			for (size_t t = 0; t < rows; t++) {
+				keys[t] |= (uint64_t)((int64_t)column[t] - (int64_t)columnMin) << shift;
+			}
+		}
+	}
+
+	if (totalBits <= 64) {
+		// each sample packs into a single 64 bit key
+		SymbolTable table(rows);
+		for (size_t t = 0; t < rows; t++) {
+			encoded.symbols[t] = table.getID(keys[t]);
+		}
+		encoded.symbolCount = table.size();
+		return encoded;
+	}
+
+	// samples are too wide to pack. hash each sample, and resolve collisions
+	// by comparing against the first sample that was assigned each slot
+	std::vector<uint64_t>& hashes = keys;
+	std::fill(hashes.begin(), hashes.end(), X.getWidth());
+	for (size_t i = 0; i < X.getWidth(); i++) {
+		X.copyColumn(i, column.data());
+		for (size_t t = 0; t < rows; t++) {
+			hashes[t] = mixBits(hashes[t] ^ (uint32_t)column[t]) + 0x9e3779b97f4a7c15ULL;
+		}
+	}
+	auto sameSample = [&X](size_t a, size_t b) {
+		for (size_t i = 0; i < X.getWidth(); i++) {
+			if (X(a, i) != X(b, i)) {
+				return false;
+			}
+		}
+		return true;
+	};
+	uint64_t size = tableSizeFor(rows);
+	uint64_t mask = size - 1;
+	std::vector<int64_t> firstSample(size, -1); // index in X of the sample that owns this slot
+	std::vector<uint32_t> slotIDs(size);
+	uint32_t nextID = 0;
+	for (size_t t = 0; t < rows; t++) {
+		uint64_t slot = mixBits(hashes[t]) & mask;
+		while (firstSample[slot] != -1 && !sameSample(firstSample[slot], t)) {
+			slot = (slot + 1) & mask;
+		}
+		if (firstSample[slot] == -1) {
+			firstSample[slot] = t;
+			slotIDs[slot] = nextID++;
+		}
+		encoded.symbols[t] = slotIDs[slot];
+	}
+	encoded.symbolCount = nextID;
+	return encoded;
+}
+
+ENT::SymbolSeries ENT::Join(const SymbolSeries& X, const SymbolSeries& Y) {
+	if (X.symbols.size() != Y.symbols.size()) {
+		std::cout << "in ENT::Join(X,Y) :: X and Y are not of the same size. exiting...";
+		exit(1);
+	}
+	SymbolSeries joined;
+	joined.symbols.resize(X.symbols.size());
+	SymbolTable table(X.symbols.size());
+	for (size_t t = 0; t < X.symbols.size(); t++) {
+		// both IDs are < 2^32, so the pair packs into one key
+		joined.symbols[t] = table.getID(((uint64_t)X.symbols[t] << 32) | Y.symbols[t]);
+	}
+	joined.symbolCount = table.size();
+	return joined;
+}
+
+double ENT::Entropy(const SymbolSeries& X) {
+	std::vector<int> frequencyTable(X.symbolCount, 0); // count of how many times each symbol shows up
+	for (auto symbol : X.symbols) {
+		frequencyTable[symbol]++;
 	}
 
 	double ent = 0;
 	double temp;
-	for (int index = 0; index < symbols.size(); index++) {
-		temp = (1.0 / X.size()) * frequencyTable[index];
+	for (auto count : frequencyTable) {
+		temp = (1.0 / X.symbols.size()) * count;
 		ent += (temp * std::log2(temp)); // p log(p)
 	}
 	return std::abs(ent);
 }
 
+double ENT::MutualEntropy(const SymbolSeries& X, const SymbolSeries& Y) {
+	return (Entropy(X) + Entropy(Y)) - Entropy(Join(X, Y));
+}
+
+double ENT::ConditionalEntropy(const SymbolSeries& X, const SymbolSeries& Y) {
+	return Entropy(X) - MutualEntropy(X, Y);
+}
+
+double ENT::ConditionalMutualEntropy(const SymbolSeries& X, const SymbolSeries& Y, const SymbolSeries& Z) {
+	auto XZ = Join(X, Z);
+	return Entropy(XZ) + Entropy(Join(Y, Z)) - (Entropy(Z) + Entropy(Join(XZ, Y)));
+}
+
+double ENT::Entropy(const TS::intTimeSeries& X) {
+	return Entropy(Encode(X));
+}
+
 double ENT::MutualEntropy(const TS::intTimeSeries& X, const TS::intTimeSeries& Y) {
-	return (Entropy(X) + Entropy(Y)) - Entropy(TS::Join(X, Y));
+	if (X.size() != Y.size()) {
+		std::cout << "in Join(X,Y) :: X and Y are not of the same size. exiting...";
+		exit(1);
+	}
+	return MutualEntropy(Encode(X), Encode(Y));
 }
 
 double ENT::ConditionalEntropy(const TS::intTimeSeries& X, const TS::intTimeSeries& Y) {
@@ -27,6 +264,33 @@ double ENT::ConditionalEntropy(const TS::intTimeSeries& X, const TS::intTimeSeri
 }
 
 double ENT::ConditionalMutualEntropy(const TS::intTimeSeries& X, const TS::intTimeSeries& Y, const TS::intTimeSeries& Z) {
-	return Entropy(TS::Join(X, Z)) + Entropy(TS::Join(Y, Z)) - (Entropy(Z) + Entropy(TS::Join({ X, Y, Z })));
+	if (X.size() != Z.size() || Y.size() != Z.size()) {
+		std::cout << "in Join({X,Y,...}) :: the data sets are not of the same size. exiting...";
+		exit(1);
+	}
+	return ConditionalMutualEntropy(Encode(X), Encode(Y), Encode(Z));
+}
+
+double ENT::Entropy(const TS::intSeriesView& X) {
+	return Entropy(Encode(X));
+}
+
+double ENT::MutualEntropy(const TS::intSeriesView& X, const TS::intSeriesView& Y) {
+	if (X.size() != Y.size()) {
+		std::cout << "in Join(X,Y) :: X and Y are not of the same size. exiting...";
+		exit(1);
+	}
+	return MutualEntropy(Encode(X), Encode(Y));
 }
 
+double ENT::ConditionalEntropy(const TS::intSeriesView& X, const TS::intSeriesView& Y) {
+	return Entropy(X) - MutualEntropy(X, Y);
+}
+
+double ENT::ConditionalMutualEntropy(const TS::intSeriesView& X, const TS::intSeriesView& Y, const TS::intSeriesView& Z) {
+	if (X.size() != Z.size() || Y.size() != Z.size()) {
+		std::cout << "in Join({X,Y,...}) :: the data sets are not of the same size. exiting...";
+		exit(1);
+	}
+	return ConditionalMutualEntropy(Encode(X), Encode(Y), Encode(Z));
+}
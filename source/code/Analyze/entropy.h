@@ -11,6 +11,8 @@
 #include <iostream>
 #include <string>
 #include <algorithm>    // std::find
+#include <climits>
+#include <cstdint>
 
 
 
@@ -18,10 +20,60 @@
 #include "timeSeries.h"
 
 namespace ENT {
+	// an intTimeSeries where each sample has been replaced by a symbol ID
+	// symbol IDs are dense, i.e. in [0,symbolCount), and are assigned in order of first appearance
+	// two samples have the same ID if and only if they are the same state
+	// SymbolSeries can be joined (see Join) without ever building the joined intTimeSeries
+	struct SymbolSeries {
+		std::vector<uint32_t> symbols;
+		uint32_t symbolCount = 0;
+	};
+
+	// open addressing hash table which maps 64 bit keys to dense IDs (in order of first insertion)
+	class SymbolTable {
+		std::vector<uint64_t> keys;
+		std::vector<uint32_t> ids; // emptySlot if slot is not in use
+		uint64_t mask;
+		uint32_t nextID = 0;
+	public:
+		static constexpr uint32_t emptySlot = UINT32_MAX;
+
+		// expectedKeys is an upper bound on the number of unique keys that will be inserted
+		explicit SymbolTable(size_t expectedKeys);
+
+		// return the ID for key, if key has not been seen yet assign it the next ID
+		uint32_t getID(uint64_t key);
+
+		uint32_t size() const { return nextID; }
+	};
+
+	// convert X into a SymbolSeries
+	// if a sample fits in 64 bits (after each column is offset by it's min value and packed to it's bit width)
+	// the packed sample is used as the key, otherwise samples are hashed and compared directly
+	SymbolSeries Encode(const TS::intTimeSeries& X);
+	SymbolSeries Encode(const TS::intSeriesView& X);
+
+	// given two SymbolSeries of the same length, return the SymbolSeries of the joint states {X,Y}
+	// (i.e. Encode(TS::Join(X,Y)) but without building the joined intTimeSeries)
+	SymbolSeries Join(const SymbolSeries& X, const SymbolSeries& Y);
+
 	// calculate entropy for a intTimeSeries X
 	double Entropy(const TS::intTimeSeries& X);
 	double MutualEntropy(const TS::intTimeSeries& X, const TS::intTimeSeries& Y);
 	double ConditionalEntropy(const TS::intTimeSeries& X, const TS::intTimeSeries& Y);
 	double ConditionalMutualEntropy(const TS::intTimeSeries& X, const TS::intTimeSeries& Y, const TS::intTimeSeries& Z);
+
+	// versions of the above for intSeries (Join, subSetTimeSeries and trimTimeSeries views can be passed without copying)
+	double Entropy(const TS::intSeriesView& X);
+	double MutualEntropy(const TS::intSeriesView& X, const TS::intSeriesView& Y);
+	double ConditionalEntropy(const TS::intSeriesView& X, const TS::intSeriesView& Y);
+	double ConditionalMutualEntropy(const TS::intSeriesView& X, const TS::intSeriesView& Y, const TS::intSeriesView& Z);
+
+	// versions of the above which work on already encoded data
+	// use these when the same series takes part in many calculations (encode once, reuse many times)
+	double Entropy(const SymbolSeries& X);
+	double MutualEntropy(const SymbolSeries& X, const SymbolSeries& Y);
+	double ConditionalEntropy(const SymbolSeries& X, const SymbolSeries& Y);
+	double ConditionalMutualEntropy(const SymbolSeries& X, const SymbolSeries& Y, const SymbolSeries& Z);
 }
 
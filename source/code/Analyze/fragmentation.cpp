@@ -1,72 +1,183 @@
 #include "fragmentation.h"
 
-int FRAG::getFragmentation(const TS::intTimeSeries& feature, const TS::intTimeSeries& predictor, double threshold, const std::string& compareTo, int maxPartitionSize) {
+namespace {
+	// small amount of slack used when pruning so that rounding error can never prune a partition
+	// which would have passed the (exact) test used in getFragmentation
+	const double pruneSlack = 1e-9;
+
+	// predictor data that does not depend on feature. this is built once and then shared by
+	// every feature tested against the same predictor (see getFragmentationSet)
+	struct PredictorCache {
+		std::vector<ENT::SymbolSeries> columns; // each column of predictor, encoded
+		std::vector<double> columnEntropies;
+		ENT::SymbolSeries wholePredictor;
+		std::unordered_map<uint64_t, double> partitionEntropies; // keyed by partition bit mask
+
+		explicit PredictorCache(const TS::intSeriesView& predictor) {
+			wholePredictor = ENT::Encode(predictor);
+			if (predictor.size() == 0) {
+				return; // no columns (feature is also empty, so has no entropy and getFragmentation returns -1)
+			}
+			for (int i = 0; i < (int)predictor.getWidth(); i++) {
+				columns.push_back(ENT::Encode(TS::subSetTimeSeries(predictor, { i })));
+				columnEntropies.push_back(ENT::Entropy(columns.back()));
+			}
+		}
+	};
+
+	// depth first search over partitions of a fixed size (partitionSize) built from columns [0,columnCount)
+	// each step adds one column to the partition on the stack (and removing it is just a pop), so the
+	// encoded partition and the encoded {feature,partition} are both built from their parents with one Join
+	// branches that can not reach target (even if every remaining column was perfectly informative) are pruned
+	class PartitionSearch {
+		PredictorCache& cache;
+		const ENT::SymbolSeries& feature;
+		double featureEntropy;
+		double target; // shared entropy a partition must reach
+		int columnCount;
+		int partitionSize;
+
+		// returns true if a partition of partitionSize which contains the partition described by
+		// (partition, joint, mask) and extends it with columns > lastColumn reaches target
+		bool search(const ENT::SymbolSeries* partition, const ENT::SymbolSeries& joint, uint64_t mask, int depth, int lastColumn) {
+			int remaining = partitionSize - depth - 1; // columns still needed after this one
+			for (int i = lastColumn + 1; i < columnCount - remaining; i++) {
+				uint64_t newMask = mask | (uint64_t(1) << i);
+				ENT::SymbolSeries newJoint = ENT::Join(joint, cache.columns[i]);
+				double jointEntropy = ENT::Entropy(newJoint);
+
+				ENT::SymbolSeries newPartition;
+				auto found = cache.partitionEntropies.find(newMask);
+				double partitionEntropy;
+				if (found != cache.partitionEntropies.end() && remaining == 0) {
+					partitionEntropy = found->second; // a leaf with a known entropy does not need to be encoded
+				}
+				else {
+					newPartition = (partition == nullptr) ? cache.columns[i] : ENT::Join(*partition, cache.columns[i]);
+					partitionEntropy = (found != cache.partitionEntropies.end()) ? found->second : ENT::Entropy(newPartition);
+					cache.partitionEntropies[newMask] = partitionEntropy;
+				}
 
-	if (predictor.size() != feature.size()) {
-		std::cout << "in entropy.h Fragmentation(...) :: the predictor and feature are not of the same size. exiting...";
-		exit(1);
-	}
+				double sharedEntropy = (partitionEntropy + featureEntropy) - jointEntropy;
+				if (remaining == 0) {
+					if (sharedEntropy >= target) {
+						return true;
+					}
+					continue;
+				}
 
-	double featureEntropy = ENT::Entropy(feature);
-	double predictorEntropy = ENT::Entropy(predictor);
-	double maxJointEntropy = ENT::Entropy(TS::Join(feature,predictor)); // this is the entropy of the feature and predictor together
-	double maxSharedEntropy = ENT::MutualEntropy(feature,predictor); // this is the max known by the predictor about the feature
+				// what is left can add at most the entropy of the best remaining columns (and never more than the unknown part of feature)
+				std::vector<double> laterEntropies(cache.columnEntropies.begin() + i + 1, cache.columnEntropies.begin() + columnCount);
+				std::partial_sort(laterEntropies.begin(), laterEntropies.begin() + remaining, laterEntropies.end(), std::greater<double>());
+				double bestGain = 0;
+				for (int r = 0; r < remaining; r++) {
+					bestGain += laterEntropies[r];
+				}
+				bestGain = std::min(bestGain, featureEntropy - sharedEntropy);
+				if (sharedEntropy + bestGain + pruneSlack < target) {
+					continue;
+				}
 
-	double maxEntropyRatio = 0;
-	if (featureEntropy > 0) {
-		maxEntropyRatio = maxSharedEntropy / featureEntropy;
-	}
-	else {
-		return -1; // there is no entropy in feature, so we can just stop now
-	}
+				if (search(&newPartition, newJoint, newMask, depth + 1, i)) {
+					return true;
+				}
+			}
+			return false;
+		}
 
-	// get power set for all combinations of predictor (partitions)
-	if (maxPartitionSize == -1 || maxPartitionSize > predictor[0].size()) {
-		maxPartitionSize = predictor[0].size();
-	}
-	PowerSet ps;
-	auto indexSets = ps.getPowerSet(maxPartitionSize);
+	public:
+		PartitionSearch(PredictorCache& _cache, const ENT::SymbolSeries& _feature, double _featureEntropy, double _target, int _columnCount) :
+			cache(_cache), feature(_feature), featureEntropy(_featureEntropy), target(_target), columnCount(_columnCount), partitionSize(0) {
+		}
+
+		// return true if any partition with exactly size columns reaches target
+		bool findPartition(int size) {
+			partitionSize = size;
+			return search(nullptr, feature, 0, 0, -1);
+		}
+	};
+
+	// getFragmentation using an already built PredictorCache
+	int getFragmentation(const TS::intSeriesView& feature, PredictorCache& cache, double threshold, const std::string& compareTo, int maxPartitionSize) {
+		ENT::SymbolSeries featureSeries = ENT::Encode(feature);
+		double featureEntropy = ENT::Entropy(featureSeries);
+		if (featureEntropy <= 0) {
+			return -1; // there is no entropy in feature, so we can just stop now
+		}
 
-	// test each power set until we find a powerset with suffect shared entropy
-	for (const auto& indexSet : indexSets) {
-		TS::intTimeSeries partition = TS::subSetTimeSeries(predictor, indexSet);
-		double partitionEntropy = ENT::Entropy(partition);
-		double jointEntropy = ENT::Entropy(TS::Join(feature,partition));
+		double maxSharedEntropy = ENT::MutualEntropy(featureSeries, cache.wholePredictor); // this is the max known by the predictor about the feature
 
+		double target;
 		if (compareTo == "feature") {
-			if ((partitionEntropy + featureEntropy) - jointEntropy >= threshold * featureEntropy) { // if what we have left after we remove joint entorpy is = feature entropy then...
-				return indexSet.size();
-			}
+			target = threshold * featureEntropy; // if what we have left after we remove joint entorpy is = feature entropy then...
 		}
 		else if (compareTo == "shared") { // i.e.  to maxSharedEntropy
-			if ((partitionEntropy + featureEntropy) - jointEntropy >= threshold * maxSharedEntropy) { // if what this brain partition knows about everything the brain knows about the feature then...
-				return indexSet.size();
-			}
+			target = threshold * maxSharedEntropy; // if what this brain partition knows about everything the brain knows about the feature then...
 		}
 		else {
 			std::cout << "in entropy.h Fragmentation(...) :: compairTo is not \"feature\" or \"shared\". exiting...";
 			exit(1);
 		}
+
+		// no partition can know more about feature than the whole predictor
+		if (maxSharedEntropy + pruneSlack < target) {
+			return -1;
+		}
+
+		// partitions are drawn from the first maxPartitionSize columns of predictor
+		if (maxPartitionSize == -1 || maxPartitionSize > (int)cache.columns.size()) {
+			maxPartitionSize = cache.columns.size();
+		}
+		if (maxPartitionSize > 64) {
+			std::cout << "in entropy.h Fragmentation(...) :: predictor has more then 64 elements. exiting...";
+			exit(1);
+		}
+
+		// smaller partitions are tested first, as soon as one size works all larger partitions can be skipped
+		PartitionSearch partitionSearch(cache, featureSeries, featureEntropy, target, maxPartitionSize);
+		for (int size = 1; size <= maxPartitionSize; size++) {
+			if (partitionSearch.findPartition(size)) {
+				return size;
+			}
+		}
+
+		// if we don't find a good partition...
+		return -1;
 	}
+}
+
+int FRAG::getFragmentation(const TS::intSeriesView& feature, const TS::intSeriesView& predictor, double threshold, const std::string& compareTo, int maxPartitionSize) {
 
-	// if we don't find a good partition...
-	return -1;
+	if (predictor.size() != feature.size()) {
+		std::cout << "in entropy.h Fragmentation(...) :: the predictor and feature are not of the same size. exiting...";
+		exit(1);
+	}
+
+	PredictorCache cache(predictor);
+	return ::getFragmentation(feature, cache, threshold, compareTo, maxPartitionSize);
 }
 
-std::vector<int> FRAG::getFragmentationSet(const std::vector<TS::intTimeSeries>& features, const TS::intTimeSeries& predictor, double threshold, const std::string& compareTo, int maxPartitionSize) {
+std::vector<int> FRAG::getFragmentationSet(const std::vector<TS::intSeriesView>& features, const TS::intSeriesView& predictor, double threshold, const std::string& compareTo, int maxPartitionSize) {
 	std::vector<int> returnVect;
-	for (auto feature : features) {
-		returnVect.push_back(getFragmentation(feature, predictor, threshold, compareTo, maxPartitionSize));
+	for (const auto& feature : features) {
+		if (predictor.size() != feature.size()) {
+			std::cout << "in entropy.h Fragmentation(...) :: the predictor and feature are not of the same size. exiting...";
+			exit(1);
+		}
+	}
+	PredictorCache cache(predictor); // partition entropies are shared by all features
+	for (const auto& feature : features) {
+		returnVect.push_back(::getFragmentation(feature, cache, threshold, compareTo, maxPartitionSize));
 	}
 	return returnVect;
 }
 
-std::vector<int> FRAG::getFragmentationSet(const TS::intTimeSeries& features, const TS::intTimeSeries& predictor, double threshold, const std::string& compareTo, int maxPartitionSize) {
+std::vector<int> FRAG::getFragmentationSet(const TS::intSeriesView& features, const TS::intSeriesView& predictor, double threshold, const std::string& compareTo, int maxPartitionSize) {
 	return getFragmentationSet(TS::deconstructTimeSeries(features), predictor, threshold, compareTo, maxPartitionSize);
 }
 
 
-std::pair<std::vector<std::vector<int>>, std::vector<std::vector<double>>> FRAG::getFragmentationMatrix(const std::vector<TS::intTimeSeries>& features, const TS::intTimeSeries& predictor, const std::string& compareTo, int maxPartitionSize) {
+std::pair<std::vector<std::vector<int>>, std::vector<std::vector<double>>> FRAG::getFragmentationMatrix(const std::vector<TS::intSeriesView>& features, const TS::intSeriesView& predictor, const std::string& compareTo, int maxPartitionSize) {
 	for (int f = 0; f < features.size(); f++) {
 		if (features[f].size() != predictor.size()) {
 			std::cout << "in entropy.h fragmentationMatrix() :: the features sets are not of the same size as the predictor. exiting...";
@@ -75,27 +186,41 @@ std::pair<std::vector<std::vector<int>>, std::vector<std::vector<double>>> FRAG:
 	}
 
 	// get power set for all combinations of predictor (partitions)
-	if (maxPartitionSize == -1 || maxPartitionSize > predictor[0].size()) {
-		maxPartitionSize = predictor[0].size();
+	if (maxPartitionSize == -1 || maxPartitionSize > predictor.getWidth()) {
+		maxPartitionSize = predictor.getWidth();
 	}
 	PowerSet ps;
 	auto indexSets = ps.getPowerSet(maxPartitionSize);
 
 	std::vector<std::vector<double>> fragMatrix; // a matrix used to how the shared info for each partition and feature
 
-	double predictorEntropy = ENT::Entropy(predictor);
+	// encode each partition once. indexSets is ordered by size, so the partition with the last index removed
+	// has always been encoded already and each partition only costs one Join
+	PredictorCache cache(predictor);
 	std::vector<double> partitionEntropies;
-	std::vector<TS::intTimeSeries> partitions;
+	std::vector<ENT::SymbolSeries> partitions;
+	std::unordered_map<uint64_t, size_t> partitionLookup; // partition bit mask -> index in partitions
 	for (size_t i = 0; i < indexSets.size(); i++) {
-		partitions.push_back(TS::subSetTimeSeries(predictor, indexSets[i]));
+		uint64_t parentMask = 0;
+		for (size_t e = 0; e + 1 < indexSets[i].size(); e++) {
+			parentMask |= uint64_t(1) << indexSets[i][e];
+		}
+		int lastIndex = indexSets[i].back();
+		if (indexSets[i].size() == 1) {
+			partitions.push_back(cache.columns[lastIndex]);
+		}
+		else {
+			partitions.push_back(ENT::Join(partitions[partitionLookup[parentMask]], cache.columns[lastIndex]));
+		}
+		partitionLookup[parentMask | (uint64_t(1) << lastIndex)] = i;
 		partitionEntropies.push_back(ENT::Entropy(partitions.back()));
 	}
 
-	for (auto feature : features) {
+	for (const auto& feature : features) {
 
-		double featureEntropy = ENT::Entropy(feature);
-		double maxJointEntropy = ENT::Entropy(TS::Join(feature, predictor)); // this is the entropy of this feature and predictor together
-		double maxSharedEntropy = ENT::MutualEntropy(feature, predictor); // this is the max known by the predictor about this feature
+		ENT::SymbolSeries featureSeries = ENT::Encode(feature);
+		double featureEntropy = ENT::Entropy(featureSeries);
+		double maxSharedEntropy = ENT::MutualEntropy(featureSeries, cache.wholePredictor); // this is the max known by the predictor about this feature
 
 		std::cout << "  working on feature " <<
 			"\n    featureEntropy = " << featureEntropy << "  maxSharedEntropy between feature and predictor = " << maxSharedEntropy << std::endl;
@@ -107,7 +232,7 @@ std::pair<std::vector<std::vector<int>>, std::vector<std::vector<double>>> FRAG:
 			fragMatrix.push_back({});
 
 			for (size_t i = 0; i < indexSets.size(); i++) {
-				double jointEntropy = ENT::Entropy(TS::Join(feature, partitions[i]));
+				double jointEntropy = ENT::Entropy(ENT::Join(featureSeries, partitions[i]));
 
 				if (compareTo == "none") { // add mutual entropy without normalizing
 					fragMatrix.back().push_back((partitionEntropies[i] + featureEntropy) - jointEntropy);
@@ -136,18 +261,18 @@ std::pair<std::vector<std::vector<int>>, std::vector<std::vector<double>>> FRAG:
 
 }
 
-std::pair<std::vector<std::vector<int>>, std::vector<std::vector<double>>> FRAG::getFragmentationMatrix(const TS::intTimeSeries& features, const TS::intTimeSeries& predictor, const std::string& compareTo, int maxPartitionSize) {
+std::pair<std::vector<std::vector<int>>, std::vector<std::vector<double>>> FRAG::getFragmentationMatrix(const TS::intSeriesView& features, const TS::intSeriesView& predictor, const std::string& compareTo, int maxPartitionSize) {
 	return getFragmentationMatrix(TS::deconstructTimeSeries(features), predictor, compareTo, maxPartitionSize);
 }
 
 
 // save a collection of flowMatrixs derived from a set of time ranges
-void FRAG::saveFragMatrixSet(const TS::intTimeSeries& features, const TS::intTimeSeries& predictor, const std::vector<int>& lifeTimes, const std::vector<std::pair<double, double>>& flowRanges, const std::string& fileName, const std::string& compareTo, int maxPartitionSize) {
+void FRAG::saveFragMatrixSet(const TS::intSeriesView& features, const TS::intSeriesView& predictor, const std::vector<int>& lifeTimes, const std::vector<std::pair<double, double>>& flowRanges, const std::string& fileName, const std::string& compareTo, int maxPartitionSize) {
 	std::string outStr;
 	// save data flow information
 	// i.e. fragmentation matrix of (input + hidden) predictions of (output + hidden)
-	auto flowStatesBefore = predictor;
-	auto flowStatesAfter = features;
+	const auto& flowStatesBefore = predictor;
+	const auto& flowStatesAfter = features;
 	for (int r = 0; r < flowRanges.size(); r++) {
 		double i = flowRanges[r].first;
 		double j = flowRanges[r].second;
@@ -181,7 +306,7 @@ void FRAG::saveFragMatrixSet(const TS::intTimeSeries& features, const TS::intTim
 	}
 }
 
-void FRAG::saveFragMatrix(const TS::intTimeSeries& features, const TS::intTimeSeries& predictor, const std::string& fileName, const std::string& compareTo, int maxPartitionSize) {
+void FRAG::saveFragMatrix(const TS::intSeriesView& features, const TS::intSeriesView& predictor, const std::string& fileName, const std::string& compareTo, int maxPartitionSize) {
 	auto fm = FRAG::getFragmentationMatrix(features, predictor, compareTo, maxPartitionSize);
 	std::string outStr = "fragPartitions = [\n";
 	for (auto p : fm.first) {
@@ -207,6 +332,47 @@ void FRAG::saveFragMatrix(const TS::intTimeSeries& features, const TS::intTimeSe
 }
 
 
+// intTimeSeries versions copy each argument into an intSeries once and then work on views
+
+static std::vector<TS::intSeries> toIntSeries(const std::vector<TS::intTimeSeries>& X) {
+	std::vector<TS::intSeries> series;
+	for (const auto& x : X) {
+		series.emplace_back(x);
+	}
+	return series;
+}
+
+int FRAG::getFragmentation(const TS::intTimeSeries& feature, const TS::intTimeSeries& predictor, double threshold, const std::string& compareTo, int maxPartitionSize) {
+	return getFragmentation(TS::intSeries(feature), TS::intSeries(predictor), threshold, compareTo, maxPartitionSize);
+}
+
+std::vector<int> FRAG::getFragmentationSet(const std::vector<TS::intTimeSeries>& features, const TS::intTimeSeries& predictor, double threshold, const std::string& compareTo, int maxPartitionSize) {
+	auto featureSeries = toIntSeries(features);
+	return getFragmentationSet(std::vector<TS::intSeriesView>(featureSeries.begin(), featureSeries.end()), TS::intSeries(predictor), threshold, compareTo, maxPartitionSize);
+}
+
+std::vector<int> FRAG::getFragmentationSet(const TS::intTimeSeries& features, const TS::intTimeSeries& predictor, double threshold, const std::string& compareTo, int maxPartitionSize) {
+	return getFragmentationSet(TS::intSeries(features), TS::intSeries(predictor), threshold, compareTo, maxPartitionSize);
+}
+
+std::pair<std::vector<std::vector<int>>, std::vector<std::vector<double>>> FRAG::getFragmentationMatrix(const std::vector<TS::intTimeSeries>& features, const TS::intTimeSeries& predictor, const std::string& compareTo, int maxPartitionSize) {
+	auto featureSeries = toIntSeries(features);
+	return getFragmentationMatrix(std::vector<TS::intSeriesView>(featureSeries.begin(), featureSeries.end()), TS::intSeries(predictor), compareTo, maxPartitionSize);
+}
+
+std::pair<std::vector<std::vector<int>>, std::vector<std::vector<double>>> FRAG::getFragmentationMatrix(const TS::intTimeSeries& features, const TS::intTimeSeries& predictor, const std::string& compareTo, int maxPartitionSize) {
+	return getFragmentationMatrix(TS::intSeries(features), TS::intSeries(predictor), compareTo, maxPartitionSize);
+}
+
+void FRAG::saveFragMatrixSet(const TS::intTimeSeries& features, const TS::intTimeSeries& predictor, const std::vector<int>& lifeTimes, const std::vector<std::pair<double, double>>& flowRanges, const std::string& fileName, const std::string& compareTo, int maxPartitionSize) {
+	saveFragMatrixSet(TS::intSeries(features), TS::intSeries(predictor), lifeTimes, flowRanges, fileName, compareTo, maxPartitionSize);
+}
+
+void FRAG::saveFragMatrix(const TS::intTimeSeries& features, const TS::intTimeSeries& predictor, const std::string& fileName, const std::string& compareTo, int maxPartitionSize) {
+	saveFragMatrix(TS::intSeries(features), TS::intSeries(predictor), fileName, compareTo, maxPartitionSize);
+}
+
+
 /*
 void testEntropy() {
 	{
@@ -24,10 +24,12 @@ namespace FRAG {
 	// threshold: the first partition of source that has atleast this amount of shared entropy with feature as compaired with features total entropy will trigger a return
 	// compairTo: If "feature", function works as decribed. If "shared", threshold comparison is made agaist max shared entropy as aposed to feature entropy (i.e. it will always succed unless feature entropy is 0)
 	// maxPartitionSize: max size of partitions of source to consider, if -1 (defaut) consider all partitions
+	// partitions are searched smallest first, each partition is built from it's parent by adding one element,
+	// and branches which can not reach threshold are skipped, so predictors with up to 64 elements can be searched
 	int getFragmentation(const TS::intTimeSeries& feature, const TS::intTimeSeries& Predictor, double threshold = 1.0, const std::string& compareTo = "feature", int maxPartitionSize = -1);
 
 	// given a vector of features (TimeSeriess) and predictor (intTimeSeries) return a list of fragmentation for each feature
-	// uses getFragmentation
+	// uses getFragmentation, the predictor is encoded once and partition entropies are shared by all features
 	std::vector<int> getFragmentationSet(const std::vector<TS::intTimeSeries>& features, const TS::intTimeSeries& predictor, double threshold = 1.0, const std::string& compareTo = "feature", int maxPartitionSize = -1);
 
 	// given a feature(intTimeSeries) and predictor (intTimeSeries) return a list of fragmentation for each element of feature
@@ -60,4 +62,13 @@ namespace FRAG {
 	// save a single flowMatrix
 	void saveFragMatrix(const TS::intTimeSeries& features, const TS::intTimeSeries& predictor, const std::string& fileName, const std::string& compareTo = "feature", int maxPartitionSize = -1);
 
+	// versions of the above for intSeries, features are split into column views and trimmed ranges are views, so nothing is copied
+	int getFragmentation(const TS::intSeriesView& feature, const TS::intSeriesView& Predictor, double threshold = 1.0, const std::string& compareTo = "feature", int maxPartitionSize = -1);
+	std::vector<int> getFragmentationSet(const std::vector<TS::intSeriesView>& features, const TS::intSeriesView& predictor, double threshold = 1.0, const std::string& compareTo = "feature", int maxPartitionSize = -1);
+	std::vector<int> getFragmentationSet(const TS::intSeriesView& features, const TS::intSeriesView& predictor, double threshold = 1.0, const std::string& compareTo = "feature", int maxPartitionSize = -1);
+	std::pair<std::vector<std::vector<int>>, std::vector<std::vector<double>>> getFragmentationMatrix(const std::vector<TS::intSeriesView>& features, const TS::intSeriesView& predictor, const std::string& compareTo = "feature", int maxPartitionSize = -1);
+	std::pair<std::vector<std::vector<int>>, std::vector<std::vector<double>>> getFragmentationMatrix(const TS::intSeriesView& features, const TS::intSeriesView& predictor, const std::string& compareTo = "feature", int maxPartitionSize = -1);
+	void saveFragMatrixSet(const TS::intSeriesView& features, const TS::intSeriesView& predictor, const std::vector<int>& lifeTimes, const std::vector<std::pair<double, double>>& flowRanges, const std::string& fileName, const std::string& compareTo = "feature", int maxPartitionSize = -1);
+	void saveFragMatrix(const TS::intSeriesView& features, const TS::intSeriesView& predictor, const std::string& fileName, const std::string& compareTo = "feature", int maxPartitionSize = -1);
+
 }
\ No newline at end of file
@@ -1,9 +1,9 @@
 #include "smearedness.h"
 
-double SMR::getAtomicR(size_t whichConcept, size_t whichBrainNode, const TS::intTimeSeries& inputStates, const TS::intTimeSeries& worldStates, const TS::intTimeSeries& brainStates) {
-	TS::intTimeSeries input_and_world_concept = TS::Join(inputStates, TS::subSetTimeSeries(worldStates, { (int)whichConcept }));
-	TS::intTimeSeries input_and_brain_node = TS::Join(inputStates, TS::subSetTimeSeries(brainStates, { (int)whichBrainNode }));
-	TS::intTimeSeries input_and_world_concept_and_brain_node = TS::Join({ 
+double SMR::getAtomicR(size_t whichConcept, size_t whichBrainNode, const TS::intSeriesView& inputStates, const TS::intSeriesView& worldStates, const TS::intSeriesView& brainStates) {
+	TS::intSeriesView input_and_world_concept = TS::Join(inputStates, TS::subSetTimeSeries(worldStates, { (int)whichConcept }));
+	TS::intSeriesView input_and_brain_node = TS::Join(inputStates, TS::subSetTimeSeries(brainStates, { (int)whichBrainNode }));
+	TS::intSeriesView input_and_world_concept_and_brain_node = TS::Join({ 
 		inputStates,
 		TS::subSetTimeSeries(worldStates, { (int)whichConcept }), 
 		TS::subSetTimeSeries(brainStates, { (int)whichBrainNode }) 
@@ -15,26 +15,26 @@ double SMR::getAtomicR(size_t whichConcept, size_t whichBrainNode, const TS::int
 }
 
 
-std::vector<std::vector<double>> SMR::getAtomicRArray(const TS::intTimeSeries& inputStates, const TS::intTimeSeries& worldStates, const TS::intTimeSeries& brainStates){
+std::vector<std::vector<double>> SMR::getAtomicRArray(const TS::intSeriesView& inputStates, const TS::intSeriesView& worldStates, const TS::intSeriesView& brainStates){
 	double sensorEntropy = ENT::Entropy(inputStates);
-	std::vector<double> environmentSensorEntropies(worldStates[0].size(), 0.0);
-	std::vector<double> memorySensorEntropies(brainStates[0].size(), 0.0);
-	std::vector <std::vector<double>> totalEntropies(worldStates[0].size(), std::vector<double>(brainStates[0].size(), 0.0));
-	for (int ii = 0; ii < worldStates[0].size(); ii++) {
+	std::vector<double> environmentSensorEntropies(worldStates.getWidth(), 0.0);
+	std::vector<double> memorySensorEntropies(brainStates.getWidth(), 0.0);
+	std::vector <std::vector<double>> totalEntropies(worldStates.getWidth(), std::vector<double>(brainStates.getWidth(), 0.0));
+	for (int ii = 0; ii < worldStates.getWidth(); ii++) {
 		environmentSensorEntropies[ii] = ENT::Entropy(TS::Join(inputStates, TS::subSetTimeSeries(worldStates, { ii })));
-		for (int jj = 0; jj < brainStates[0].size(); jj++) {
+		for (int jj = 0; jj < brainStates.getWidth(); jj++) {
 			totalEntropies[ii][jj] = ENT::Entropy(TS::Join({ inputStates, TS::subSetTimeSeries(worldStates, { ii }) , TS::subSetTimeSeries(brainStates, { jj }) }));
 		}
 	}
-	for (int jj = 0; jj < brainStates[0].size(); jj++) {
+	for (int jj = 0; jj < brainStates.getWidth(); jj++) {
 		memorySensorEntropies[jj] = ENT::Entropy(TS::Join( inputStates,TS::subSetTimeSeries(brainStates, { jj }) ));
 	}
 
 	std::vector<std::vector<double>> m_array;
 	std::vector<double> m_row;
-	for (int ii = 0; ii < worldStates[0].size(); ii++) {
+	for (int ii = 0; ii < worldStates.getWidth(); ii++) {
 		m_row = {};
-		for (int jj = 0; jj < brainStates[0].size(); jj++) {
+		for (int jj = 0; jj < brainStates.getWidth(); jj++) {
 			m_row.push_back(environmentSensorEntropies[ii] + memorySensorEntropies[jj] - sensorEntropy - totalEntropies[ii][jj]);
 		}
 		m_array.push_back(m_row);
@@ -43,12 +43,12 @@ std::vector<std::vector<double>> SMR::getAtomicRArray(const TS::intTimeSeries& i
 }
 
 
-double SMR::getSmearednessOfConcepts(const TS::intTimeSeries& inputStates, const TS::intTimeSeries& worldStates, const TS::intTimeSeries& brainStates) {
+double SMR::getSmearednessOfConcepts(const TS::intSeriesView& inputStates, const TS::intSeriesView& worldStates, const TS::intSeriesView& brainStates) {
 	std::vector < std::vector < double > > atomicRValues = getAtomicRArray(inputStates, worldStates, brainStates);
 	double smearedness = 0.0;
-	for (int ii = 0; ii < brainStates[0].size(); ii++) {
-		for (int jj = 0; jj < worldStates[0].size() - 1; jj++) {
-			for (int kk = jj + 1; kk < worldStates[0].size(); kk++) {
+	for (int ii = 0; ii < brainStates.getWidth(); ii++) {
+		for (int jj = 0; jj < worldStates.getWidth() - 1; jj++) {
+			for (int kk = jj + 1; kk < worldStates.getWidth(); kk++) {
 				smearedness += std::min(atomicRValues[jj][ii], atomicRValues[kk][ii]);
 			}
 		}
@@ -56,12 +56,12 @@ double SMR::getSmearednessOfConcepts(const TS::intTimeSeries& inputStates, const
 	return smearedness;
 }
 
-double SMR::getSmearednessOfNodes(const TS::intTimeSeries& inputStates, const TS::intTimeSeries& worldStates, const TS::intTimeSeries& brainStates) {
+double SMR::getSmearednessOfNodes(const TS::intSeriesView& inputStates, const TS::intSeriesView& worldStates, const TS::intSeriesView& brainStates) {
 	std::vector < std::vector < double > > atomicRValues = getAtomicRArray(inputStates, worldStates, brainStates);
 	double smearedness = 0.0;
-	for (int ii = 0; ii < worldStates[0].size(); ii++) {
-		for (int jj = 0; jj < brainStates[0].size() - 1; jj++) {
-			for (int kk = jj + 1; kk < brainStates[0].size(); kk++) {
+	for (int ii = 0; ii < worldStates.getWidth(); ii++) {
+		for (int jj = 0; jj < brainStates.getWidth() - 1; jj++) {
+			for (int kk = jj + 1; kk < brainStates.getWidth(); kk++) {
 				smearedness += std::min(atomicRValues[ii][jj], atomicRValues[ii][kk]);
 			}
 		}
@@ -70,23 +70,45 @@ double SMR::getSmearednessOfNodes(const TS::intTimeSeries& inputStates, const TS
 
 }
 
-std::pair<double, double> SMR::getSmearednessConceptsNodesPair(const TS::intTimeSeries& inputStates, const TS::intTimeSeries& worldStates, const TS::intTimeSeries& brainStates) {
+std::pair<double, double> SMR::getSmearednessConceptsNodesPair(const TS::intSeriesView& inputStates, const TS::intSeriesView& worldStates, const TS::intSeriesView& brainStates) {
 	std::vector < std::vector < double > > atomicRValues = getAtomicRArray(inputStates, worldStates, brainStates);
 	double smearednessConcepts = 0.0;
-	for (int ii = 0; ii < brainStates[0].size(); ii++) {
-		for (int jj = 0; jj < worldStates[0].size() - 1; jj++) {
-			for (int kk = jj + 1; kk < worldStates[0].size(); kk++) {
+	for (int ii = 0; ii < brainStates.getWidth(); ii++) {
+		for (int jj = 0; jj < worldStates.getWidth() - 1; jj++) {
+			for (int kk = jj + 1; kk < worldStates.getWidth(); kk++) {
 				smearednessConcepts += std::min(atomicRValues[jj][ii], atomicRValues[kk][ii]);
 			}
 		}
 	}
 	double smearednessNodes = 0.0;
-	for (int ii = 0; ii < worldStates[0].size(); ii++) {
-		for (int jj = 0; jj < brainStates[0].size() - 1; jj++) {
-			for (int kk = jj + 1; kk < brainStates[0].size(); kk++) {
+	for (int ii = 0; ii < worldStates.getWidth(); ii++) {
+		for (int jj = 0; jj < brainStates.getWidth() - 1; jj++) {
+			for (int kk = jj + 1; kk < brainStates.getWidth(); kk++) {
 				smearednessNodes += std::min(atomicRValues[ii][jj], atomicRValues[ii][kk]);
 			}
 		}
 	}
 	return { smearednessConcepts, smearednessNodes };
 }
+
+// intTimeSeries versions copy each argument into an intSeries once and then work on views
+
+double SMR::getAtomicR(size_t whichConcept, size_t whichBrainNode, const TS::intTimeSeries& inputStates, const TS::intTimeSeries& worldStates, const TS::intTimeSeries& brainStates) {
+	return getAtomicR(whichConcept, whichBrainNode, TS::intSeries(inputStates), TS::intSeries(worldStates), TS::intSeries(brainStates));
+}
+
+std::vector<std::vector<double>> SMR::getAtomicRArray(const TS::intTimeSeries& inputStates, const TS::intTimeSeries& worldStates, const TS::intTimeSeries& brainStates) {
+	return getAtomicRArray(TS::intSeries(inputStates), TS::intSeries(worldStates), TS::intSeries(brainStates));
+}
+
+double SMR::getSmearednessOfConcepts(const TS::intTimeSeries& inputStates, const TS::intTimeSeries& worldStates, const TS::intTimeSeries& brainStates) {
+	return getSmearednessOfConcepts(TS::intSeries(inputStates), TS::intSeries(worldStates), TS::intSeries(brainStates));
+}
+
+double SMR::getSmearednessOfNodes(const TS::intTimeSeries& inputStates, const TS::intTimeSeries& worldStates, const TS::intTimeSeries& brainStates) {
+	return getSmearednessOfNodes(TS::intSeries(inputStates), TS::intSeries(worldStates), TS::intSeries(brainStates));
+}
+
+std::pair<double, double> SMR::getSmearednessConceptsNodesPair(const TS::intTimeSeries& inputStates, const TS::intTimeSeries& worldStates, const TS::intTimeSeries& brainStates) {
+	return getSmearednessConceptsNodesPair(TS::intSeries(inputStates), TS::intSeries(worldStates), TS::intSeries(brainStates));
+}
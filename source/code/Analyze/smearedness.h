@@ -40,5 +40,12 @@ namespace SMR {
 	double getSmearednessOfNodes(const TS::intTimeSeries& inputStates, const TS::intTimeSeries& worldStates, const TS::intTimeSeries& brainStates);
 
 	std::pair<double, double> getSmearednessConceptsNodesPair(const TS::intTimeSeries& inputStates, const TS::intTimeSeries& worldStates, const TS::intTimeSeries& brainStates);
+
+	// versions of the above for intSeries, the joined and subset series are views so nothing is copied
+	double getAtomicR(size_t whichConcept, size_t whichBrainNode, const TS::intSeriesView& inputStates, const TS::intSeriesView& worldStates, const TS::intSeriesView& brainState);
+	std::vector<std::vector<double>> getAtomicRArray(const TS::intSeriesView& inputStates, const TS::intSeriesView& worldStates, const TS::intSeriesView& brainState);
+	double getSmearednessOfConcepts(const TS::intSeriesView& inputStates, const TS::intSeriesView& worldStates, const TS::intSeriesView& brainStates);
+	double getSmearednessOfNodes(const TS::intSeriesView& inputStates, const TS::intSeriesView& worldStates, const TS::intSeriesView& brainStates);
+	std::pair<double, double> getSmearednessConceptsNodesPair(const TS::intSeriesView& inputStates, const TS::intSeriesView& worldStates, const TS::intSeriesView& brainStates);
 }
 
@@ -5,7 +5,7 @@
 // nodes and edges are labeled, and edges labels are followed by "(# of times this edge appears)"
 // in addtion, edge thickness is representative of relitive frequency (2.0 + .5 * std::sqrt(counts)) - need parameter here
 // finally, edges are colored to represent the average time that the edge occures relitive to lifetimes RED->GREEN->BLUE = EARLY->LATE
-void S2S::saveStateToState(const std::vector<TS::intTimeSeries>& nodesList, const std::vector<TS::intTimeSeries>& edgesList, std::vector<int> lifeTimes, std::string fileName) {
+void S2S::saveStateToState(const std::vector<TS::intSeriesView>& nodesList, const std::vector<TS::intSeriesView>& edgesList, std::vector<int> lifeTimes, std::string fileName) {
 
 	if (nodesList[0].size() != edgesList[0].size()+lifeTimes.size()) {
 		std::cout << "  in saveStateToState :: nodesList[0].size() != linksList[0].size() + lifeTimes.size(). exiting. " << std::endl;
@@ -24,7 +24,7 @@ void S2S::saveStateToState(const std::vector<TS::intTimeSeries>& nodesList, cons
 		}
 		// for each element in each time list in nodesList, append to the back of the new nodes strings list
 		for (int j = 0; j < nodesList[i].size(); j++) {
-			nodes[j] += TS::TimeSeriesSampleToString(nodesList[i][j],",");
+			nodes[j] += TS::TimeSeriesSampleToString(nodesList[i], j, ",");
 			if (i < nodesList.size() - 1) {
 				nodes[j] += "_";
 			}
@@ -38,7 +38,7 @@ void S2S::saveStateToState(const std::vector<TS::intTimeSeries>& nodesList, cons
 			exit(1);
 		}
 		for (int j = 0; j < edgesList[i].size(); j++) {
-			edges[j] += TS::TimeSeriesSampleToString(edgesList[i][j],",");
+			edges[j] += TS::TimeSeriesSampleToString(edgesList[i], j, ",");
 			if (i < edgesList.size() - 1) {
 				edges[j] += "_";
 			}
@@ -136,3 +136,13 @@ void S2S::saveStateToState(const std::vector<TS::intTimeSeries>& nodesList, cons
 
 }
 
+void S2S::saveStateToState(const std::vector<TS::intTimeSeries>& nodesList, const std::vector<TS::intTimeSeries>& edgesList, std::vector<int> lifeTimes, std::string fileName) {
+	std::vector<TS::intSeries> nodes, edges;
+	for (const auto& X : nodesList) {
+		nodes.emplace_back(X);
+	}
+	for (const auto& X : edgesList) {
+		edges.emplace_back(X);
+	}
+	saveStateToState(std::vector<TS::intSeriesView>(nodes.begin(), nodes.end()), std::vector<TS::intSeriesView>(edges.begin(), edges.end()), lifeTimes, fileName);
+}
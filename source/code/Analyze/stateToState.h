@@ -18,4 +18,5 @@
 
 namespace S2S {
 	void saveStateToState(const std::vector<TS::intTimeSeries>& nodes, const std::vector<TS::intTimeSeries>& links, std::vector<int> lifeTimes, std::string fileName);
+	void saveStateToState(const std::vector<TS::intSeriesView>& nodes, const std::vector<TS::intSeriesView>& links, std::vector<int> lifeTimes, std::string fileName);
 }
@@ -1,5 +1,7 @@
 #include "timeSeries.h"
 
+#include <cstring>
+
 std::string TS::TimeSeriesSampleToString(const std::vector<int>& sample, const std::string& sep) {
 	std::string returnStr = "";
 	for (auto e : sample) {
@@ -72,43 +74,32 @@ TS::intTimeSeries TS::Join(const std::vector<intTimeSeries>& data) {
 	return returnTS;
 }
 
-TS::intTimeSeries TS::trimTimeSeries(const intTimeSeries& experience, const std::pair<double, double>& range, const std::vector<int>& lifeTimes) {
-	intTimeSeries returnTS;
+// rows [first,second) of each life which are kept by trimTimeSeries(experience, range, lifeTimes)
+static std::vector<std::pair<size_t, size_t>> rangeSegments(const std::pair<double, double>& range, const std::vector<int>& lifeTimes) {
+	std::vector<std::pair<size_t, size_t>> segments;
 	int birthTime = 0; // updated to the birth time of each life time
 	for (auto lifeTime : lifeTimes) { // itterate over all life times
 		size_t ignoreBefore = ceil((lifeTime-1.0) * range.first);
 		size_t ignoreAfter = (lifeTime-1) * range.second;
-		returnTS.insert(returnTS.end(),
-			experience.begin() + birthTime + ignoreBefore,
-			experience.begin() + birthTime + ignoreAfter + 1
-		);
+		segments.push_back({ birthTime + ignoreBefore, birthTime + ignoreAfter + 1 });
 		birthTime += lifeTime;
 	}
-	return returnTS;
-}
-
-TS::intTimeSeries TS::trimTimeSeries(const intTimeSeries& experience, const std::pair<double, double>& range, size_t lives) {
-	if (experience.size() % lives != 0) {
-		std::cout << "  in trimTimeSeries :: while attempting to trimTimeSeries, experiance is not divisable by lives. exiting..." << std::endl;
-		exit(1);
-	}
-	int lifeTime = experience.size() / lives;
-	std::vector<int> lifeTimes(lives, lifeTime);
-	return trimTimeSeries(experience, range, lifeTimes);
+	return segments;
 }
 
-TS::intTimeSeries TS::trimTimeSeries(const intTimeSeries& experience, const Position& removeWhich, const std::vector<int>& lifeTimes, int n) {
+// rows [first,second) of each life which are kept by trimTimeSeries(experience, removeWhich, lifeTimes, n)
+static std::vector<std::pair<size_t, size_t>> positionSegments(size_t experienceSize, const TS::Position& removeWhich, const std::vector<int>& lifeTimes, int n) {
 	std::vector<int> localLifeTimes;
 	int totalLifeTime = std::accumulate(lifeTimes.begin(), lifeTimes.end(), 0);
-	if (totalLifeTime + lifeTimes.size() == experience.size()) {
-		localLifeTimes = updateLifeTimes(lifeTimes, 1);
+	if (totalLifeTime + lifeTimes.size() == experienceSize) {
+		localLifeTimes = TS::updateLifeTimes(lifeTimes, 1);
 		totalLifeTime += lifeTimes.size();
 	}
 	else {
 		localLifeTimes = lifeTimes;
 	}
 	
-	if (totalLifeTime != experience.size()) {
+	if (totalLifeTime != experienceSize) {
 		std::cout << "  in trimTimeSeries :: either sum(lifeTimes) must equal experiance.size(),\n"<<
 			"    or sum(lifeTimes) + lifeTimes.size() must equal experience.size() (in the case of a bloated TimeSeries), but it does not. \n" << 
 			"    I can not determine where lives start and end!\n" <<
@@ -116,28 +107,52 @@ TS::intTimeSeries TS::trimTimeSeries(const intTimeSeries& experience, const Posi
 		exit(1);
 	}
 
-	intTimeSeries returnTS;
+	std::vector<std::pair<size_t, size_t>> segments;
 	int birthTime = 0;
 	for (auto lifeTime : localLifeTimes) { // itterate over all life times
-		if (removeWhich == Position::FIRST) {
-			returnTS.insert(returnTS.end(), experience.begin() + birthTime + n, experience.begin() + birthTime + lifeTime);
+		if (removeWhich == TS::Position::FIRST) {
+			segments.push_back({ birthTime + n, birthTime + lifeTime });
 		}
-		else if (removeWhich == Position::LAST) {
-			returnTS.insert(returnTS.end(), experience.begin() + birthTime, experience.begin() + birthTime + (lifeTime - n));
+		else if (removeWhich == TS::Position::LAST) {
+			segments.push_back({ birthTime, birthTime + (lifeTime - n) });
 		}
 		birthTime += lifeTime;
 	}
-	return returnTS;
+	return segments;
 }
 
-TS::intTimeSeries TS::trimTimeSeries(const intTimeSeries& experience, const Position& removeWhich, size_t lives, int n) {
-	if (experience.size() % lives != 0) {
+// lifeTimes for experienceSize samples split evenly into lives
+static std::vector<int> evenLifeTimes(size_t experienceSize, size_t lives) {
+	if (experienceSize % lives != 0) {
 		std::cout << "  in trimTimeSeries :: while attempting to trimTimeSeries, experiance is not divisable by lives. exiting..." << std::endl;
 		exit(1);
 	}
-	int lifeTime = experience.size() / lives;
-	std::vector<int> lifeTimes(lives, lifeTime);
-	return trimTimeSeries(experience, removeWhich, lifeTimes, n);
+	int lifeTime = experienceSize / lives;
+	return std::vector<int>(lives, lifeTime);
+}
+
+static TS::intTimeSeries selectRows(const TS::intTimeSeries& experience, const std::vector<std::pair<size_t, size_t>>& segments) {
+	TS::intTimeSeries returnTS;
+	for (const auto& segment : segments) {
+		returnTS.insert(returnTS.end(), experience.begin() + segment.first, experience.begin() + segment.second);
+	}
+	return returnTS;
+}
+
+TS::intTimeSeries TS::trimTimeSeries(const intTimeSeries& experience, const std::pair<double, double>& range, const std::vector<int>& lifeTimes) {
+	return selectRows(experience, rangeSegments(range, lifeTimes));
+}
+
+TS::intTimeSeries TS::trimTimeSeries(const intTimeSeries& experience, const std::pair<double, double>& range, size_t lives) {
+	return trimTimeSeries(experience, range, evenLifeTimes(experience.size(), lives));
+}
+
+TS::intTimeSeries TS::trimTimeSeries(const intTimeSeries& experience, const Position& removeWhich, const std::vector<int>& lifeTimes, int n) {
+	return selectRows(experience, positionSegments(experience.size(), removeWhich, lifeTimes, n));
+}
+
+TS::intTimeSeries TS::trimTimeSeries(const intTimeSeries& experience, const Position& removeWhich, size_t lives, int n) {
+	return trimTimeSeries(experience, removeWhich, evenLifeTimes(experience.size(), lives), n);
 }
 
 TS::intTimeSeries TS::extendTimeSeries(const intTimeSeries& X, const std::vector<int>& lifeTimes, const std::vector<int> Y, Position addWhere, int n) {
@@ -178,116 +193,420 @@ std::vector<int> TS::updateLifeTimes(const std::vector<int>& lifeTimes, int n) {
 	return newLifeTimes;
 }
 
-TS::intTimeSeries TS::remapToIntTimeSeries(const TS::TimeSeries& X, TS::RemapRules rule, std::vector<double> ruleParameter) {
-	//RemapRules { INT, BIT, TRIT, NEAREST_BIT, NEAREST_TRIT, MEDIAN };
-	TS::intTimeSeries returnTS(X.size());
-	if (rule == TS::RemapRules::INT) {
-		for (int i = 0; i < X.size(); i++) {
-			for (int j = 0; j < X[i].size(); j++) {
-				returnTS[i].push_back((int)X[i][j]);
-			}
+// remap kernels for the rules which map each value on its own (INT, BIT, TRIT and NEAREST_*)
+// each loop is branch free so the compiler can vectorize it (the results match Bit(), Trit(), etc. exactly)
+static bool isElementRule(TS::RemapRules rule) {
+	return rule != TS::RemapRules::MEDIAN && rule != TS::RemapRules::UNIQUE;
+}
+
+static void remapValues(const double* in, int* out, size_t count, TS::RemapRules rule) {
+	switch (rule) {
+	case TS::RemapRules::INT:
+		for (size_t i = 0; i < count; i++) {
+			out[i] = (int)in[i];
 		}
-	}
-	else if (rule == TS::RemapRules::BIT) {
-		for (int i = 0; i < X.size(); i++) {
-			for (int j = 0; j < X[i].size(); j++) {
-				returnTS[i].push_back(Bit(X[i][j]));
-			}
+		break;
+	case TS::RemapRules::BIT:
+		for (size_t i = 0; i < count; i++) {
+			out[i] = in[i] > 0.0;
 		}
+		break;
+	case TS::RemapRules::TRIT:
+		for (size_t i = 0; i < count; i++) {
+			out[i] = (in[i] > 0.0) - (in[i] < 0.0);
+		}
+		break;
+	case TS::RemapRules::NEAREST_INT:
+		for (size_t i = 0; i < count; i++) {
+			out[i] = (int)(in[i] + .5);
+		}
+		break;
+	case TS::RemapRules::NEAREST_BIT:
+		for (size_t i = 0; i < count; i++) {
+			out[i] = (in[i] + .5) > 0.0;
+		}
+		break;
+	case TS::RemapRules::NEAREST_TRIT:
+		for (size_t i = 0; i < count; i++) {
+			out[i] = (in[i] > .5) - (in[i] < -.5);
+		}
+		break;
+	default:
+		break;
 	}
-	else if (rule == TS::RemapRules::TRIT) {
-		for (int i = 0; i < X.size(); i++) {
-			for (int j = 0; j < X[i].size(); j++) {
-				returnTS[i].push_back(Trit(X[i][j]));
+}
+
+// maps the values in one column to symbols, in order of first appearance (used by UNIQUE)
+// open addressing on the bits of each value, the table doubles when it is half full
+class ColumnSymbols {
+	std::vector<uint64_t> keys;
+	std::vector<int> ids; // -1 if slot is not in use
+	int tableBits = 0; // keys.size() == 2^tableBits
+	int count = 0;
+
+	void grow() {
+		std::vector<uint64_t> oldKeys = std::move(keys);
+		std::vector<int> oldIDs = std::move(ids);
+		tableBits = oldKeys.empty() ? 4 : tableBits + 1;
+		keys.assign((size_t)1 << tableBits, 0);
+		ids.assign(keys.size(), -1);
+		for (size_t i = 0; i < oldKeys.size(); i++) {
+			if (oldIDs[i] != -1) {
+				*findSlot(oldKeys[i]) = oldIDs[i];
 			}
 		}
 	}
-	else if (rule == TS::RemapRules::NEAREST_INT) {
-		for (int i = 0; i < X.size(); i++) {
-			for (int j = 0; j < X[i].size(); j++) {
-				returnTS[i].push_back((int)(X[i][j] + .5));
-			}
+
+	int* findSlot(uint64_t key) {
+		size_t mask = keys.size() - 1;
+		// low bits of a double are often all 0, so the slot is taken from the high bits of the product
+		size_t slot = (key * 0x9e3779b97f4a7c15ULL) >> (64 - tableBits);
+		while (ids[slot] != -1 && keys[slot] != key) {
+			slot = (slot + 1) & mask;
 		}
+		keys[slot] = key;
+		return &ids[slot];
 	}
-	else if (rule == TS::RemapRules::NEAREST_BIT) {
-		for (int i = 0; i < X.size(); i++) {
-			for (int j = 0; j < X[i].size(); j++) {
-				returnTS[i].push_back(Bit(X[i][j] + .5));
-			}
+
+public:
+	int getSymbol(double value) {
+		if (value != value) { // NaN is never equal to a seen value, so it is always a new symbol
+			return count++;
 		}
+		if (value == 0.0) {
+			value = 0.0; // -0.0 and 0.0 are the same symbol
+		}
+		if (2 * (count + 1) > (int)keys.size()) {
+			grow();
+		}
+		uint64_t key;
+		std::memcpy(&key, &value, sizeof(key));
+		int* id = findSlot(key);
+		if (*id == -1) {
+			*id = count++;
+		}
+		return *id;
 	}
-	else if (rule == TS::RemapRules::NEAREST_TRIT) {
-		for (int i = 0; i < X.size(); i++) {
-			for (int j = 0; j < X[i].size(); j++) {
-				if (X[i][j] > .5) { returnTS[i].push_back(1); }
-				else if (X[i][j] < -.5) { returnTS[i].push_back(-1); }
-				else { returnTS[i].push_back(0); }
-			}
+};
+
+static const double* rowValues(const TS::TimeSeries& X, size_t row) {
+	return X[row].data();
+}
+
+static const double* rowValues(const TS::StateBuffer& X, size_t row) {
+	return X[row].values;
+}
+
+// X can be a TS::TimeSeries or a TS::StateBuffer, rowOut(row) must return where row should be written
+template <typename Rows, typename RowOut>
+static void remapRows(const Rows& X, TS::RemapRules rule, const std::vector<double>& ruleParameter, RowOut rowOut) {
+	if (isElementRule(rule)) {
+		for (size_t row = 0; row < X.size(); row++) {
+			remapValues(rowValues(X, row), rowOut(row), X[row].size(), rule);
 		}
 	}
 	else if (rule == TS::RemapRules::MEDIAN) {
-		std::vector<std::vector<double>> values;
-		for (int row = 0; row < X.size(); row++) {
-			for (int column = 0; column < X[row].size(); column++) {
-				if (values.size() < column + 1) {
-					values.push_back({});
-				}
-				values[column].push_back(X[row][column]);
-			}
+		size_t columnCount = 0;
+		for (size_t row = 0; row < X.size(); row++) {
+			columnCount = std::max(columnCount, (size_t)X[row].size());
 		}
-		for (int column = 0; column < values.size(); column++) {
-			std::sort(values[column].begin(), values[column].end());
+		std::vector<std::vector<double>> values(columnCount);
+		for (auto& column : values) {
+			column.reserve(X.size());
+		}
+		for (size_t row = 0; row < X.size(); row++) {
+			const double* in = rowValues(X, row);
+			for (size_t column = 0; column < X[row].size(); column++) {
+				values[column].push_back(in[column]);
+			}
 		}
 		int subSetCount = (int)ruleParameter[0];
 		if (subSetCount == -1) {
 			subSetCount = 2;
 		}
 
-		std::vector<std::vector<double>> cutPoints(values.size(), std::vector<double>(subSetCount - 1));
-		for (int column = 0; column < values.size(); column++) {
+		// cut points are order statistics of each column, they are found with nth_element (rather then sorting the column).
+		// cut points are in increasing order, so each search only needs to look at what is right of the last cut point
+		std::vector<std::vector<double>> cutPoints(columnCount, std::vector<double>(subSetCount - 1));
+		for (size_t column = 0; column < columnCount; column++) {
+			auto& columnValues = values[column];
+			size_t searchFrom = 0;
 			for (int cutPointIndex = 0; cutPointIndex < (subSetCount - 1); cutPointIndex++) {
-				cutPoints[column][cutPointIndex] = (double)values[column][((double)(1 + cutPointIndex)* (double)values[column].size()) / (double)subSetCount];
+				size_t nth = ((double)(1 + cutPointIndex) * (double)columnValues.size()) / (double)subSetCount;
+				std::nth_element(columnValues.begin() + searchFrom, columnValues.begin() + nth, columnValues.end());
+				cutPoints[column][cutPointIndex] = columnValues[nth];
+				searchFrom = nth;
 			}
 		}
 
-		for (int row = 0; row < X.size(); row++) {
-			for (int column = 0; column < X[row].size(); column++) {
+		// a value maps to the number of cut points it is greater then
+		for (size_t row = 0; row < X.size(); row++) {
+			const double* in = rowValues(X, row);
+			int* out = rowOut(row);
+			for (size_t column = 0; column < X[row].size(); column++) {
 				int s = 0;
-				while (s < cutPoints[column].size() && X[row][column] > cutPoints[column][s]) {
- 					s++;
+				for (double cutPoint : cutPoints[column]) {
+					s += in[column] > cutPoint;
 				}
-				returnTS[row].push_back(s);
+				out[column] = s;
 			}
 		}
 	}
 	else if (rule == TS::RemapRules::UNIQUE) {
-		std::vector<std::vector<double>> uniqueSymbols; // this will hold the unique values in each column
-		for (int row = 0; row < X.size(); row++) {
-			for (int column = 0; column < X[row].size(); column++) {
+		// each value maps to the order in which it first appeared in its column
+		std::vector<ColumnSymbols> uniqueSymbols;
+		for (size_t row = 0; row < X.size(); row++) {
+			const double* in = rowValues(X, row);
+			int* out = rowOut(row);
+			if (uniqueSymbols.size() < X[row].size()) {
+				uniqueSymbols.resize(X[row].size());
+			}
+			for (size_t column = 0; column < X[row].size(); column++) {
+				out[column] = uniqueSymbols[column].getSymbol(in[column]);
+			}
+		}
+	}
+}
 
-				//std::cout << row << "  symbol: " << X[row][column] << " ";
+// an intTimeSeries with the same shape as X
+template <typename Rows>
+static TS::intTimeSeries shapedLike(const Rows& X) {
+	TS::intTimeSeries returnTS(X.size());
+	for (size_t i = 0; i < X.size(); i++) {
+		returnTS[i].resize(X[i].size());
+	}
+	return returnTS;
+}
 
-				if (uniqueSymbols.size() < column + 1) {
-					//std::cout << "NEW COLUMN (" << uniqueSymbols.size() << "):: ";
-					uniqueSymbols.push_back({});
-				}
-				// see if the current value (i.e. symbol is in uniqueSymbols for this column already.
-				auto symbolAddress = std::find(uniqueSymbols[column].begin(), uniqueSymbols[column].end(),X[row][column]);
-
-				// if not found, it's new
-				if (symbolAddress == uniqueSymbols[column].end()) { // this is a new symbol for this column
-					//std::cout << "NEW SYMBOL :: VALUE = " << uniqueSymbols[column].size() << std::endl;
-					returnTS[row].push_back(uniqueSymbols[column].size());
-					uniqueSymbols[column].push_back(X[row][column]);
-				}
-				else { // it's not new, add the index (i.e. pointer - pointer to start of vector
-					//std::cout << "VALUE = " << symbolAddress - uniqueSymbols[column].begin() << std::endl;
-					returnTS[row].push_back(symbolAddress - uniqueSymbols[column].begin());
-				}
+TS::intTimeSeries TS::remapToIntTimeSeries(const TS::TimeSeries& X, TS::RemapRules rule, std::vector<double> ruleParameter) {
+	auto returnTS = shapedLike(X);
+	remapRows(X, rule, ruleParameter, [&returnTS](size_t row) { return returnTS[row].data(); });
+	return returnTS;
+}
+
+TS::intTimeSeries TS::remapToIntTimeSeries(const TS::StateBuffer& X, TS::RemapRules rule, std::vector<double> ruleParameter) {
+	auto returnTS = shapedLike(X);
+	remapRows(X, rule, ruleParameter, [&returnTS](size_t row) { return returnTS[row].data(); });
+	return returnTS;
+}
+
+// remapToIntSeries writes ROW_MAJOR (the same order as the rows in X), so each row is contiguous
+
+TS::intSeries TS::remapToIntSeries(const TS::TimeSeries& X, TS::RemapRules rule, std::vector<double> ruleParameter) {
+	size_t width = X.empty() ? 0 : X[0].size();
+	for (const auto& row : X) {
+		if (row.size() != width) {
+			std::cout << "in remapToIntSeries(X) :: samples in X are not all the same size. exiting...";
+			exit(1);
+		}
+	}
+	intSeries returnTS(X.size(), width, intSeries::Layout::ROW_MAJOR);
+	remapRows(X, rule, ruleParameter, [&returnTS, width](size_t row) { return returnTS.data() + row * width; });
+	return returnTS;
+}
+
+TS::intSeries TS::remapToIntSeries(const TS::StateBuffer& X, TS::RemapRules rule, std::vector<double> ruleParameter) {
+	intSeries returnTS(X.size(), X.getWidth(), intSeries::Layout::ROW_MAJOR);
+	if (isElementRule(rule)) { // X is one flat buffer, so it can be remapped in one pass
+		remapValues(X.data(), returnTS.data(), X.size() * X.getWidth(), rule);
+	}
+	else {
+		size_t width = X.getWidth();
+		remapRows(X, rule, ruleParameter, [&returnTS, width](size_t row) { return returnTS.data() + row * width; });
+	}
+	return returnTS;
+}
+
+TS::intSeries::intSeries(const intTimeSeries& X, Layout _layout) {
+	resize(X.size(), X.empty() ? 0 : X[0].size(), _layout);
+	for (size_t row = 0; row < rows; row++) {
+		if (X[row].size() != width) {
+			std::cout << "in intSeries(X) :: samples in X are not all the same size. exiting...";
+			exit(1);
+		}
+		for (size_t column = 0; column < width; column++) {
+			(*this)(row, column) = X[row][column];
+		}
+	}
+}
+
+TS::intSeries::intSeries(const intSeriesView& X, Layout _layout) {
+	resize(X.size(), X.getWidth(), _layout);
+	if (layout == Layout::COLUMN_MAJOR) {
+		for (size_t column = 0; column < width; column++) {
+			X.copyColumn(column, values.data() + column * columnStride);
+		}
+	}
+	else {
+		for (size_t row = 0; row < rows; row++) {
+			for (size_t column = 0; column < width; column++) {
+				(*this)(row, column) = X(row, column);
 			}
 		}
+	}
+}
+
+TS::intTimeSeries TS::intSeries::toIntTimeSeries() const {
+	return intSeriesView(*this).toIntTimeSeries();
+}
+
+void TS::intSeriesView::copyColumn(size_t column, int* destination) const {
+	const Column& c = columns[column];
+	if (c.rowMap) {
+		const size_t* rowMap = c.rowMap->data();
+		for (size_t row = 0; row < rows; row++) {
+			destination[row] = c.values[rowMap[row] * c.stride];
+		}
+	}
+	else {
+		for (size_t row = 0; row < rows; row++) {
+			destination[row] = c.values[row * c.stride];
+		}
+	}
+}
+
+TS::intTimeSeries TS::intSeriesView::toIntTimeSeries() const {
+	intTimeSeries X(rows, std::vector<int>(columns.size()));
+	std::vector<int> values(rows);
+	for (size_t column = 0; column < columns.size(); column++) {
+		copyColumn(column, values.data());
+		for (size_t row = 0; row < rows; row++) {
+			X[row][column] = values[row];
+		}
+	}
+	return X;
+}
+
+std::string TS::TimeSeriesSampleToString(const intSeriesView& X, size_t row, const std::string& sep) {
+	std::string returnStr = "";
+	for (size_t column = 0; column < X.getWidth(); column++) {
+		returnStr += std::to_string(X(row, column)) + sep;
+	}
+	return returnStr.substr(0, returnStr.size() - 1); // trim last sep
+}
+
+std::string TS::TimeSeriesToString(const intSeriesView& X, const std::string& sepElement, const std::string& sepLine) {
+	std::string returnStr = "";
+	for (size_t row = 0; row < X.size(); row++) {
+		returnStr += TimeSeriesSampleToString(X, row, sepElement) + sepLine;
+	}
+	return returnStr;
+}
+
+TS::intSeriesView TS::subSetTimeSeries(const intSeriesView& X, const std::vector<int>& indices) {
+	std::vector<intSeriesView::Column> columns;
+	columns.reserve(indices.size());
+	for (auto index : indices) {
+		columns.push_back(X.getColumn(index));
+	}
+	return intSeriesView(std::move(columns), X.size());
+}
+
+std::vector<TS::intSeriesView> TS::deconstructTimeSeries(const intSeriesView& X) {
+	std::vector<intSeriesView> returnTS;
+	for (size_t column = 0; column < X.getWidth(); column++) {
+		returnTS.push_back(intSeriesView({ X.getColumn(column) }, X.size()));
+	}
+	return returnTS;
+}
+
+TS::intSeriesView TS::Join(const intSeriesView& X, const intSeriesView& Y) {
+	if (X.size() != Y.size()) {
+		std::cout << "in Join(X,Y) :: X and Y are not of the same size. exiting...";
+		exit(1);
+	}
+	return Join(std::vector<intSeriesView>({ X, Y }));
+}
+
+TS::intSeriesView TS::Join(const std::vector<intSeriesView>& data) {
+	std::vector<intSeriesView::Column> columns;
+	for (const auto& X : data) {
+		if (X.size() != data[0].size()) {
+			std::cout << "in Join({X,Y,...}) :: the data sets are not of the same size. exiting...";
+			exit(1);
+		}
+		for (size_t column = 0; column < X.getWidth(); column++) {
+			columns.push_back(X.getColumn(column));
+		}
+	}
+	return intSeriesView(std::move(columns), data.empty() ? 0 : data[0].size());
+}
 
+// a view of the rows of experience in segments. columns which shared a rowMap (or had none) share the new rowMap
+static TS::intSeriesView selectRows(const TS::intSeriesView& experience, const std::vector<std::pair<size_t, size_t>>& segments) {
+	size_t rows = 0;
+	for (const auto& segment : segments) {
+		rows += segment.second - segment.first;
 	}
+	std::vector<const std::vector<size_t>*> oldMaps;
+	std::vector<std::shared_ptr<const std::vector<size_t>>> newMaps;
+	std::vector<TS::intSeriesView::Column> columns;
+	for (size_t column = 0; column < experience.getWidth(); column++) {
+		auto c = experience.getColumn(column);
+		const std::vector<size_t>* oldMap = c.rowMap.get();
+		size_t mapIndex = std::find(oldMaps.begin(), oldMaps.end(), oldMap) - oldMaps.begin();
+		if (mapIndex == oldMaps.size()) {
+			auto newMap = std::make_shared<std::vector<size_t>>();
+			newMap->reserve(rows);
+			for (const auto& segment : segments) {
+				for (size_t row = segment.first; row < segment.second; row++) {
+					newMap->push_back(oldMap ? (*oldMap)[row] : row);
+				}
+			}
+			oldMaps.push_back(oldMap);
+			newMaps.push_back(newMap);
+		}
+		c.rowMap = newMaps[mapIndex];
+		columns.push_back(c);
+	}
+	return TS::intSeriesView(std::move(columns), rows);
+}
+
+TS::intSeriesView TS::trimTimeSeries(const intSeriesView& experience, const std::pair<double, double>& range, const std::vector<int>& lifeTimes) {
+	return selectRows(experience, rangeSegments(range, lifeTimes));
+}
+
+TS::intSeriesView TS::trimTimeSeries(const intSeriesView& experience, const std::pair<double, double>& range, size_t lives) {
+	return trimTimeSeries(experience, range, evenLifeTimes(experience.size(), lives));
+}
 
+TS::intSeriesView TS::trimTimeSeries(const intSeriesView& experience, const Position& removeWhich, const std::vector<int>& lifeTimes, int n) {
+	return selectRows(experience, positionSegments(experience.size(), removeWhich, lifeTimes, n));
+}
+
+TS::intSeriesView TS::trimTimeSeries(const intSeriesView& experience, const Position& removeWhich, size_t lives, int n) {
+	return trimTimeSeries(experience, removeWhich, evenLifeTimes(experience.size(), lives), n);
+}
+
+TS::intSeries TS::extendTimeSeries(const intSeriesView& X, const std::vector<int>& lifeTimes, const std::vector<int> Y, Position addWhere, int n) {
+	if (Y.size() != X.getWidth()) {
+		std::cout << "  in extendTimeSeries :: Y is not the same size as the samples in X. exiting..." << std::endl;
+		exit(1);
+	}
+	int totalLifeTime = std::accumulate(lifeTimes.begin(), lifeTimes.end(), 0);
+	intSeries returnTS(totalLifeTime + lifeTimes.size() * n, X.getWidth());
+	size_t row = 0;
+	int birthTime = 0;
+	auto addY = [&]() {
+		for (int i = 0; i < n; i++, row++) {
+			for (size_t column = 0; column < X.getWidth(); column++) {
+				returnTS(row, column) = Y[column];
+			}
+		}
+	};
+	for (auto l : lifeTimes) {
+		if (addWhere == Position::FIRST) {
+			addY();
+		}
+		for (int t = birthTime; t < birthTime + l; t++, row++) {
+			for (size_t column = 0; column < X.getWidth(); column++) {
+				returnTS(row, column) = X(t, column);
+			}
+		}
+		if (addWhere == Position::LAST) {
+			addY();
+		}
+		birthTime += l;
+	}
 	return returnTS;
 }
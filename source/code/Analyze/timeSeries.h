@@ -11,6 +11,8 @@
 #include <iostream>
 #include <string>
 #include <numeric>      // std::accumulate
+#include <algorithm>
+#include <memory>
 
 #include "Utilities/Utilities.h"
 
@@ -20,6 +22,176 @@ namespace TS {
 	enum class Position { FIRST, LAST }; // used with trimTimeSeries and extendTimeSeries
 	enum class RemapRules { INT, BIT, TRIT, NEAREST_INT, NEAREST_BIT, NEAREST_TRIT, MEDIAN, UNIQUE }; // used with remapTimeSeries
 
+	// a TimeSeries stored in one flat buffer (row after row), used to record brain activity.
+	// addRow returns a pointer to the new row, so recording a sample does not allocate unless
+	// the buffer has to grow (use reserve if the number of samples is known).
+	// StateBuffer can be read like a TimeSeries (size(), X[row].size(), X[row][column])
+	class StateBuffer {
+	public:
+		// view of one row in a StateBuffer (only valid until the next addRow)
+		class Row {
+		public:
+			const double* values;
+			size_t width;
+			size_t size() const { return width; }
+			const double& operator[](size_t i) const { return values[i]; }
+			const double* begin() const { return values; }
+			const double* end() const { return values + width; }
+		};
+
+		size_t size() const { return rows; }
+		bool empty() const { return rows == 0; }
+		size_t getWidth() const { return width; }
+		const double* data() const { return values.data(); }
+
+		Row operator[](size_t row) const {
+			return { values.data() + row * width, width };
+		}
+
+		// add a row of rowWidth values (all rows must have the same width) and return it.
+		// values in the new row are not set
+		double* addRow(size_t rowWidth) {
+			if (rows == 0) {
+				width = rowWidth;
+				if (reservedRows > 0) {
+					values.reserve(reservedRows * width);
+				}
+			}
+			values.resize((rows + 1) * width);
+			return values.data() + (rows++) * width;
+		}
+
+		// add all rows from other
+		void append(const StateBuffer& other) {
+			for (size_t row = 0; row < other.size(); row++) {
+				std::copy(other[row].begin(), other[row].end(), addRow(other.getWidth()));
+			}
+		}
+
+		// make room for rowCount rows (if width is not known yet, this happens on the first addRow)
+		void reserve(size_t rowCount) {
+			reservedRows = rowCount;
+			if (width > 0) {
+				values.reserve(rowCount * width);
+			}
+		}
+
+		// remove all rows (memory is kept)
+		void clear() {
+			values.clear();
+			rows = 0;
+		}
+
+		TimeSeries toTimeSeries() const {
+			TimeSeries X(rows);
+			for (size_t row = 0; row < rows; row++) {
+				X[row].assign((*this)[row].begin(), (*this)[row].end());
+			}
+			return X;
+		}
+
+	private:
+		std::vector<double> values;
+		size_t rows = 0;
+		size_t width = 0;
+		size_t reservedRows = 0;
+	};
+
+	class intSeriesView;
+
+	// an intTimeSeries stored in one flat buffer. samples can be stored one after another (ROW_MAJOR) or
+	// each column can be stored one after another (COLUMN_MAJOR, which is faster when columns are read one
+	// at a time, as the entropy functions do). intSeries is read through an intSeriesView (see below)
+	class intSeries {
+	public:
+		enum class Layout { ROW_MAJOR, COLUMN_MAJOR };
+
+		intSeries() = default;
+		intSeries(size_t rowCount, size_t rowWidth, Layout _layout = Layout::COLUMN_MAJOR) {
+			resize(rowCount, rowWidth, _layout);
+		}
+		// copy X (all samples in X must have the same size)
+		explicit intSeries(const intTimeSeries& X, Layout _layout = Layout::COLUMN_MAJOR);
+		explicit intSeries(const intSeriesView& X, Layout _layout = Layout::COLUMN_MAJOR);
+
+		size_t size() const { return rows; }
+		bool empty() const { return rows == 0; }
+		size_t getWidth() const { return width; }
+		Layout getLayout() const { return layout; }
+
+		// distance (in ints) between row r and row r+1 in the same column
+		size_t getRowStride() const { return rowStride; }
+		// first value in column
+		const int* columnData(size_t column) const { return values.data() + column * columnStride; }
+		// all values, in the order given by layout
+		int* data() { return values.data(); }
+		const int* data() const { return values.data(); }
+
+		int& operator()(size_t row, size_t column) { return values[row * rowStride + column * columnStride]; }
+		const int& operator()(size_t row, size_t column) const { return values[row * rowStride + column * columnStride]; }
+
+		// set size to rowCount x rowWidth, all values are set to 0
+		void resize(size_t rowCount, size_t rowWidth, Layout _layout = Layout::COLUMN_MAJOR) {
+			rows = rowCount;
+			width = rowWidth;
+			layout = _layout;
+			rowStride = (layout == Layout::ROW_MAJOR) ? width : 1;
+			columnStride = (layout == Layout::ROW_MAJOR) ? 1 : rows;
+			values.assign(rows * width, 0);
+		}
+
+		intTimeSeries toIntTimeSeries() const;
+
+	private:
+		std::vector<int> values;
+		size_t rows = 0;
+		size_t width = 0;
+		size_t rowStride = 0;
+		size_t columnStride = 0;
+		Layout layout = Layout::COLUMN_MAJOR;
+	};
+
+	// a read only view of columns from one or more intSeries (optionally with only some rows)
+	// views are made by subSetTimeSeries, deconstructTimeSeries, Join and trimTimeSeries without copying samples,
+	// they are only valid while the intSeries they look at are alive and unchanged
+	class intSeriesView {
+	public:
+		// row r of a column is values[r * stride], or values[(*rowMap)[r] * stride] if the column has a rowMap
+		struct Column {
+			const int* values;
+			size_t stride;
+			std::shared_ptr<const std::vector<size_t>> rowMap;
+		};
+
+		intSeriesView() = default;
+		intSeriesView(const intSeries& X) : rows(X.size()) {
+			columns.reserve(X.getWidth());
+			for (size_t column = 0; column < X.getWidth(); column++) {
+				columns.push_back({ X.columnData(column), X.getRowStride(), nullptr });
+			}
+		}
+		intSeriesView(std::vector<Column> _columns, size_t _rows) : columns(std::move(_columns)), rows(_rows) {}
+
+		size_t size() const { return rows; }
+		bool empty() const { return rows == 0; }
+		size_t getWidth() const { return columns.size(); }
+		const Column& getColumn(size_t column) const { return columns[column]; }
+
+		int operator()(size_t row, size_t column) const {
+			const Column& c = columns[column];
+			return c.values[(c.rowMap ? (*c.rowMap)[row] : row) * c.stride];
+		}
+
+		// copy the values in column into destination (which must have room for size() values)
+		void copyColumn(size_t column, int* destination) const;
+
+		intTimeSeries toIntTimeSeries() const;
+
+	private:
+		std::vector<Column> columns;
+		size_t rows = 0;
+	};
+
 	// convert one sample from an intTimeSeries to a string, sep will be placed between elements
 	std::string TimeSeriesSampleToString(const std::vector<int>& sample, const std::string& sep = " ");
 	
@@ -73,4 +245,29 @@ namespace TS {
 
 	// given a TimeSeries X and a mapping rule, return a new intTimeSeries based on rule
 	intTimeSeries remapToIntTimeSeries(const TimeSeries& X, RemapRules rule, std::vector<double> ruleParameter = { -1 });
+	intTimeSeries remapToIntTimeSeries(const StateBuffer& X, RemapRules rule, std::vector<double> ruleParameter = { -1 });
+
+	// versions of the above which work on intSeries (through intSeriesView)
+	// subSetTimeSeries, deconstructTimeSeries, Join and trimTimeSeries return views of X (nothing is copied),
+	// so X must outlive the result
+
+	std::string TimeSeriesSampleToString(const intSeriesView& X, size_t row, const std::string& sep = " ");
+	std::string TimeSeriesToString(const intSeriesView& X, const std::string& sepElement = " ", const std::string& sepSample = "\n");
+
+	intSeriesView subSetTimeSeries(const intSeriesView& X, const std::vector<int>& indices);
+	std::vector<intSeriesView> deconstructTimeSeries(const intSeriesView& X);
+	intSeriesView Join(const intSeriesView& X, const intSeriesView& Y);
+	intSeriesView Join(const std::vector<intSeriesView>& data);
+
+	intSeriesView trimTimeSeries(const intSeriesView& experience, const std::pair<double, double>& range, const std::vector<int>& lifeTimes);
+	intSeriesView trimTimeSeries(const intSeriesView& experience, const std::pair<double, double>& range, size_t lives);
+	intSeriesView trimTimeSeries(const intSeriesView& experience, const Position& removeWhich, const std::vector<int>& lifeTimes, int n = 1);
+	intSeriesView trimTimeSeries(const intSeriesView& experience, const Position& removeWhich, size_t lives, int n = 1);
+
+	// extendTimeSeries adds samples, so it returns a new intSeries (Y must be the same size as the samples in X)
+	intSeries extendTimeSeries(const intSeriesView& X, const std::vector<int>& lifeTimes, const std::vector<int> Y, Position addWhere, int n = 1);
+
+	// remap directly into a ROW_MAJOR intSeries (X must not be ragged)
+	intSeries remapToIntSeries(const TimeSeries& X, RemapRules rule, std::vector<double> ruleParameter = { -1 });
+	intSeries remapToIntSeries(const StateBuffer& X, RemapRules rule, std::vector<double> ruleParameter = { -1 });
 }
\ No newline at end of file
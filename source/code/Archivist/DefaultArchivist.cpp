@@ -151,6 +151,8 @@ DefaultArchivist::DefaultArchivist(std::vector<std::string> & popFileColumns,
 
   convertCSVListToVector(PopFileColumnNames, default_pop_file_columns_);
   max_formula_ = std::move(max_formula);
+  if (max_formula_ != nullptr)
+    max_formula_compiled_ = std::make_shared<CompiledMTree>(max_formula_);
 
   if (default_pop_file_columns_.empty()) // hack because somehow getting passed empty string
     default_pop_file_columns_ = popFileColumns;
@@ -186,12 +188,13 @@ void DefaultArchivist::writeRealTimeFiles(
   if (writePopFile) {
     DataMap PopMap;
     for (auto &kv : unique_column_name_to_output_behaviors_) {
+      auto slot = DataMap::slotOf(kv.first);
       if (kv.first != "update")
         for (auto const &org : population)
           if (org->timeOfBirth < Global::update || save_new_orgs_)
-            PopMap.append(kv.first, org->dataMap.getAverage(kv.first));
+            PopMap.append(slot, org->dataMap.getAverage(slot));
 
-      PopMap.setOutputBehavior(kv.first, kv.second);
+      PopMap.setOutputBehavior(slot, kv.second);
     }
     PopMap.set("update", Global::update);
     PopMap.writeToFile(
@@ -205,7 +208,7 @@ void DefaultArchivist::writeRealTimeFiles(
     auto score = std::numeric_limits<double>::lowest();
     for (auto const &org : population)
       if (org->timeOfBirth < Global::update || save_new_orgs_) {
-        auto sc = max_formula_->eval(org->dataMap, org->PT)[0];
+        auto sc = max_formula_compiled_->eval(org->dataMap, org->PT);
         if (sc > score) {
           score = sc;
           best_org = org;
@@ -265,21 +268,23 @@ void DefaultArchivist::saveSnapshotData(
 }
 
 void DefaultArchivist::saveOrgToFile(const std::shared_ptr<Organism> &org, const std::string &data_file_name) {
+  static const auto ancestors_slot = DataMap::slotOf("snapshotAncestors");
+  static const auto update_slot = DataMap::slotOf("update");
 
   for (auto ancestorID : org->snapshotAncestors) {
-    org->dataMap.append("snapshotAncestors", ancestorID);
+    org->dataMap.append(ancestors_slot, ancestorID);
   }
 
-  org->dataMap.setOutputBehavior("snapshotAncestors", DataMap::LIST);
+  org->dataMap.setOutputBehavior(ancestors_slot, DataMap::LIST);
 
   org->snapshotAncestors.clear(); // now that we have saved the ancestor data, set ancestors to self (so that others will inherit correctly)
   org->snapshotAncestors.insert(org->ID);
 
-  org->dataMap.set("update", Global::update);
-  org->dataMap.setOutputBehavior("update", DataMap::FIRST);
+  org->dataMap.set(update_slot, Global::update);
+  org->dataMap.setOutputBehavior(update_slot, DataMap::FIRST);
   org->dataMap.writeToFile(data_file_name, files_["snapshotData"]); // append new data to the file
-  org->dataMap.clear("snapshotAncestors");
-  org->dataMap.clear("update");
+  org->dataMap.clear(ancestors_slot);
+  org->dataMap.clear(update_slot);
 }
 
 
@@ -422,7 +427,7 @@ bool DefaultArchivist::archive(
     // we don't need to worry about tracking parents or
     // lineage, so we clear out this data every generation.
     for (auto const &org : population)
-      org->parents.clear();
+      org->clearParents();
   } else {
 	cleanUpParents(population);
   }
@@ -442,7 +447,7 @@ void DefaultArchivist::cleanUpParents(
     if (org->snapshotAncestors.find(org->ID) != org->snapshotAncestors.end())
       // if ancestors contains self, then this org has been saved
       // and it's ancestor list has been collapsed
-      org->parents.clear();
+      org->clearParents();
     //else                            // org has not ever been saved to file...
       //need_to_clean.push_back(org); // we will need to check to see if we can do
                                     // clean up related to this org
@@ -462,7 +467,7 @@ void DefaultArchivist::cleanUpParents(
     need_to_clean.pop_back();
     if (org->timeOfBirth < minBirthTime)
       // no living org can be this orgs ancestor
-      org->parents.clear(); // so we can safely release parents
+      org->clearParents(); // so we can safely release parents
     else
       for (auto const &parent : org->parents) // we need to check parents (if any)
         if (std::find(std::begin(logged), std::end(logged), parent) ==
@@ -476,5 +481,31 @@ void DefaultArchivist::cleanUpParents(
   */
 }
 
+void DefaultArchivist::saveCheckpoint(CheckpointWriter &checkpoint) {
+  checkpoint.section("ARCHIVIST_DEFAULT");
+  checkpoint.write(realtime_sequence_index_);
+  checkpoint.write(realtime_data_seq_index_);
+  checkpoint.write(realtime_organism_seq_index_);
+  checkpoint.write(finished_);
+  checkpoint.write(static_cast<uint64_t>(files_.size()));
+  for (auto const &file : files_) {
+    checkpoint.write(file.first);
+    checkpoint.write(file.second);
+  }
+}
 
-
+void DefaultArchivist::loadCheckpoint(
+    CheckpointReader &checkpoint,
+    std::unordered_map<int, std::shared_ptr<Organism>> & /*organisms*/) {
+  checkpoint.section("ARCHIVIST_DEFAULT");
+  checkpoint.read(realtime_sequence_index_);
+  checkpoint.read(realtime_data_seq_index_);
+  checkpoint.read(realtime_organism_seq_index_);
+  checkpoint.read(finished_);
+  files_.clear();
+  auto fileCount = checkpoint.read<uint64_t>();
+  for (uint64_t i = 0; i < fileCount; i++) {
+    auto name = checkpoint.read<std::string>();
+    checkpoint.read(files_[name]);
+  }
+}
@@ -20,6 +20,7 @@
 #include "../Global.h"
 #include "../Organism/Organism.h"
 #include "../Utilities/MTree.h"
+#include "../Utilities/CompiledMTree.h"
 
 class DefaultArchivist {
 //protected:
@@ -52,6 +53,8 @@ public:
   std::shared_ptr<Abstract_MTree>
       max_formula_; // what value will be used to determine
                     // which organism to write to max file
+  std::shared_ptr<CompiledMTree> max_formula_compiled_; // max_formula_, run
+                                                        // once per org
 
   bool save_new_orgs_ = false;
 
@@ -130,4 +133,12 @@ public:
   // return true if next save will be > updates + terminate after
   virtual bool archive(std::vector<std::shared_ptr<Organism>> & /*population*/,
                        int /*flush*/ = 0);
+
+  // save (or load) where this archivist is in it's sequences. organisms
+  // are saved with the group (see Group::saveCheckpoint) and can be looked up
+  // by ID in organisms
+  virtual void saveCheckpoint(CheckpointWriter & /*checkpoint*/);
+  virtual void loadCheckpoint(
+      CheckpointReader & /*checkpoint*/,
+      std::unordered_map<int, std::shared_ptr<Organism>> & /*organisms*/);
 };
@@ -39,6 +39,25 @@ std::shared_ptr<ParameterLink<bool>>
         Parameters::register_parameter(
             "ARCHIVIST_LODWAP-writeOrganismsFile", true,
             "if true, an organisms file will be written");
+std::shared_ptr<ParameterLink<std::string>>
+    LODwAPArchivist::LODwAP_Arch_organismsFileFormatPL =
+        Parameters::register_parameter(
+            "ARCHIVIST_LODWAP-organismsFileFormat", std::string("csv"),
+            "format of the organisms file, csv or binary (LOD_organisms.mabo, "
+            "raw genome sites and typed columns, can be loaded like a csv "
+            "file)");
+std::shared_ptr<ParameterLink<bool>>
+    LODwAPArchivist::LODwAP_Arch_compressOrganismsFilePL =
+        Parameters::register_parameter(
+            "ARCHIVIST_LODWAP-compressOrganismsFile", true,
+            "if true (and organismsFileFormat is binary), compress the "
+            "organisms file (needs MABE to be built with zlib)");
+std::shared_ptr<ParameterLink<int>>
+    LODwAPArchivist::LODwAP_Arch_organismsBlockSizePL =
+        Parameters::register_parameter(
+            "ARCHIVIST_LODWAP-organismsBlockSize", 16,
+            "if organismsFileFormat is binary, organisms are written to file "
+            "(and compressed) in blocks of this many organisms");
 std::shared_ptr<ParameterLink<std::string>>
     LODwAPArchivist::LODwAP_Arch_FilePrefixPL =
         Parameters::register_parameter("ARCHIVIST_LODWAP-filePrefix",
@@ -74,6 +93,23 @@ LODwAPArchivist::LODwAPArchivist(std::vector<std::string> popFileColumns,
   writeDataFile = LODwAP_Arch_writeDataFilePL->get(PT);
   writeOrganismFile = LODwAP_Arch_writeOrganismFilePL->get(PT);
 
+  auto organismsFileFormat = LODwAP_Arch_organismsFileFormatPL->get(PT);
+  if (organismsFileFormat == "binary") {
+    organism_file_name_ =
+        organism_file_name_.substr(0, organism_file_name_.size() - 4) +
+        OrganismArchiveReader::extension;
+    if (writeOrganismFile) {
+      organism_archive_ = std::make_shared<OrganismArchiveWriter>(
+          organism_file_name_, LODwAP_Arch_compressOrganismsFilePL->get(PT),
+          LODwAP_Arch_organismsBlockSizePL->get(PT));
+    }
+  } else if (organismsFileFormat != "csv") {
+    std::cout << "  In LODwAPArchivist :: organismsFileFormat must be csv or "
+                 "binary, but was \""
+              << organismsFileFormat << "\".\n  Exiting." << std::endl;
+    exit(1);
+  }
+
   dataSequence = seq(LODwAP_Arch_dataSequencePL->get(PT), Global::updatesPL->get(), true);
   organismSequence = seq(LODwAP_Arch_organismSequencePL->get(PT), Global::updatesPL->get(), true);
 
@@ -94,6 +130,23 @@ void LODwAPArchivist::constructLODFiles(const std::shared_ptr<Organism> &org) {
   }
 }
 
+// LOD is ordered by timeOfBirth (oldest first), return the organism born just
+// before the first organism born at or after time, or nullptr if the LOD starts
+// at or after time (this happens when the LOD starts with an organism that has
+// no parents, i.e. a migrant from another process, see IslandsOptimizer)
+static std::shared_ptr<Organism>
+lastBornBefore(const std::vector<std::shared_ptr<Organism>> &LOD, int time) {
+  auto firstAfter = std::lower_bound(
+      LOD.begin(), LOD.end(), time,
+      [](const std::shared_ptr<Organism> &org, int t) {
+        return org->timeOfBirth < t;
+      });
+  if (firstAfter == LOD.begin()) {
+    return nullptr;
+  }
+  return *(firstAfter - 1);
+}
+
 void LODwAPArchivist::writeLODDataFile(
     std::vector<std::shared_ptr<Organism>> &LOD,
     const std::shared_ptr<Organism> &real_MRCA,
@@ -109,14 +162,12 @@ void LODwAPArchivist::writeLODDataFile(
     //auto current = LOD[(next_data_write_ - last_prune_) - 1];
 
     // new version
-    std::shared_ptr<Organism> current;
-    int currentIndex = 0;
-    while (LOD[currentIndex]->timeOfBirth < next_data_write_) {
-        currentIndex++;
-    }
-    currentIndex--;
-    current = LOD[currentIndex];
+    auto current = lastBornBefore(LOD, next_data_write_);
     // end new version
+    if (!current) { // nothing on this LOD was alive at next_data_write_
+      next_data_write_ = dataSequence[++data_seq_index];
+      continue;
+    }
 
     current->dataMap.set("update", next_data_write_);
     current->dataMap.setOutputBehavior("update", DataMap::FIRST);
@@ -149,14 +200,12 @@ void LODwAPArchivist::writeLODOrganismFile(
     //auto current = LOD[(next_organism_write_ - last_prune_) - 1];
 
     // new version
-    std::shared_ptr<Organism> current;
-    int currentIndex = 0;
-    while (LOD[currentIndex]->timeOfBirth < next_organism_write_) {
-        currentIndex++;
-    }
-    currentIndex--;
-    current = LOD[currentIndex];
+    auto current = lastBornBefore(LOD, next_organism_write_);
     // end new version
+    if (!current) { // nothing on this LOD was alive at next_organism_write_
+      next_organism_write_ = organismSequence[++organism_seq_index];
+      continue;
+    }
 
     DataMap OrgMap;
     OrgMap.set("ID", current->ID);
@@ -165,13 +214,17 @@ void LODwAPArchivist::writeLODOrganismFile(
 
     for (auto & genome : current->genomes) {
       auto name = "GENOME_" + genome.first;
-      OrgMap.merge(genome.second->serialize(name));
+      OrgMap.merge(organism_archive_ ? genome.second->serializeBinary(name)
+                                     : genome.second->serialize(name));
     }
     for (auto & brain : current->brains) {
       auto name = "BRAIN_" + brain.first;
       OrgMap.merge(brain.second->serialize(name));
     }
-    OrgMap.writeToFile(organism_file_name_); // append new data to the file
+    if (organism_archive_)
+      organism_archive_->write(OrgMap);
+    else
+      OrgMap.writeToFile(organism_file_name_); // append new data to the file
 
     next_organism_write_ = organismSequence[++organism_seq_index];
   }
@@ -211,7 +264,14 @@ bool LODwAPArchivist::archive(std::vector<std::shared_ptr<Organism>> &population
 
   // get the MRCA
   auto some_org = population[0];
-  auto LOD = some_org->getLOD(some_org); // get line of descent
+  std::vector<std::shared_ptr<Organism>> LOD; // get line of descent
+  auto root = lod_root_.lock();
+  if (!flush && root && root->lineageID == some_org->lineageID)
+    // only the part of the LOD from the last prune to the MRCA is needed,
+    // so follow offspring forward from where the last prune left off
+    LOD = some_org->getLODToMostRecentCommonAncestor(root, some_org);
+  if (LOD.empty())
+    LOD = some_org->getLOD(some_org);
 
   if (flush) // if flush then we don't care about coalescence
     std::cout << "flushing LODwAP: organism with ID " << population[0]->ID <<
@@ -256,10 +316,13 @@ bool LODwAPArchivist::archive(std::vector<std::shared_ptr<Organism>> &population
   // Save Organisms
   if (writeOrganismFile)
     writeLODOrganismFile(LOD, effective_MRCA);
+  if (organism_archive_ && flush)
+    organism_archive_->close(); // write out the last block and the index
 
   // data and genomes have now been written out up till the MRCA
   // so all data and genomes from before the MRCA can be deleted
-  effective_MRCA->parents.clear();
+  effective_MRCA->clearParents();
+  lod_root_ = effective_MRCA; // the next LOD starts here
   last_prune_ = effective_MRCA->timeOfBirth; // this will hold the time of the
                                              // oldest genome in RAM
 
@@ -302,3 +365,43 @@ bool LODwAPArchivist::archive(std::vector<std::shared_ptr<Organism>> &population
 
 }
 
+void LODwAPArchivist::saveCheckpoint(CheckpointWriter &checkpoint) {
+  DefaultArchivist::saveCheckpoint(checkpoint);
+  checkpoint.section("ARCHIVIST_LODWAP");
+  checkpoint.write(last_prune_);
+  auto root = lod_root_.lock();
+  checkpoint.write(root ? root->ID : -1);
+  checkpoint.write(time_to_coalescence);
+  checkpoint.write(next_data_write_);
+  checkpoint.write(next_organism_write_);
+  checkpoint.write(data_seq_index);
+  checkpoint.write(organism_seq_index);
+  checkpoint.write(organism_archive_ != nullptr);
+  if (organism_archive_)
+    organism_archive_->saveCheckpoint(checkpoint);
+}
+
+void LODwAPArchivist::loadCheckpoint(
+    CheckpointReader &checkpoint,
+    std::unordered_map<int, std::shared_ptr<Organism>> &organisms) {
+  DefaultArchivist::loadCheckpoint(checkpoint, organisms);
+  checkpoint.section("ARCHIVIST_LODWAP");
+  checkpoint.read(last_prune_);
+  auto root = organisms.find(checkpoint.read<int>());
+  lod_root_.reset();
+  if (root != organisms.end())
+    lod_root_ = root->second;
+  checkpoint.read(time_to_coalescence);
+  checkpoint.read(next_data_write_);
+  checkpoint.read(next_organism_write_);
+  checkpoint.read(data_seq_index);
+  checkpoint.read(organism_seq_index);
+  if (checkpoint.read<bool>() != (organism_archive_ != nullptr)) {
+    std::cout << "  In LODwAPArchivist::loadCheckpoint :: checkpoint was "
+                 "saved with a different organismsFileFormat.\n  Exiting."
+              << std::endl;
+    exit(1);
+  }
+  if (organism_archive_)
+    organism_archive_->loadCheckpoint(checkpoint);
+}
@@ -11,6 +11,7 @@
 #pragma once
 
 #include <Archivist/DefaultArchivist.h>
+#include <Utilities/OrganismArchive.h>
 
 class LODwAPArchivist
     : public DefaultArchivist { // Line of Decent with Active Pruning
@@ -29,6 +30,13 @@ public:
   static std::shared_ptr<ParameterLink<bool>>
       LODwAP_Arch_writeOrganismFilePL; // if true, write genome file
 
+  static std::shared_ptr<ParameterLink<std::string>>
+      LODwAP_Arch_organismsFileFormatPL; // csv or binary
+  static std::shared_ptr<ParameterLink<bool>>
+      LODwAP_Arch_compressOrganismsFilePL; // if true, compress binary file
+  static std::shared_ptr<ParameterLink<int>>
+      LODwAP_Arch_organismsBlockSizePL; // organisms per block in binary file
+
   static std::shared_ptr<ParameterLink<std::string>> LODwAP_Arch_FilePrefixPL;
 
   std::vector<int> dataSequence;     // how often to write out data
@@ -59,11 +67,19 @@ public:
 
   virtual bool archive(std::vector<std::shared_ptr<Organism>> &population,
                        int flush = 0) override;
+
+  virtual void saveCheckpoint(CheckpointWriter &checkpoint) override;
+  virtual void loadCheckpoint(
+      CheckpointReader &checkpoint,
+      std::unordered_map<int, std::shared_ptr<Organism>> &organisms) override;
  
  
   std::string data_file_name_;          // name of the Data file
   std::string organism_file_name_;      // name of the Genome file (genomes on LOD)
+  std::shared_ptr<OrganismArchiveWriter>
+      organism_archive_; // if not null, the Genome file is a binary archive
   int last_prune_ = -1; // last time Genome was Pruned
+  std::weak_ptr<Organism> lod_root_; // oldest organism on LOD after last prune
   int time_to_coalescence = -1;
 
   //// info about files under management
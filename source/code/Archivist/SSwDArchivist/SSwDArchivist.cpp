@@ -551,7 +551,7 @@ bool SSwDArchivist::archive(std::vector<std::shared_ptr<Organism>> &population,
        population) { // we don't need to worry about tracking parents or
                      // lineage, so we clear out this data every generation.
     if (!writeSnapshotDataFiles && !writeDataFiles && !writeOrganismFiles) {
-      org->parents.clear();
+      org->clearParents();
       // cout << "HERE?" << endl;
     } else if (org->snapshotAncestors.find(org->ID) !=
                    org->snapshotAncestors.end() &&
@@ -563,7 +563,7 @@ bool SSwDArchivist::archive(std::vector<std::shared_ptr<Organism>> &population,
                                          // contains self, then this org has
                                          // been saved and it's ancestor list
                                          // has been collapsed
-      org->parents.clear();
+      org->clearParents();
       checked.insert(org); // make a note, so we don't check this org later
       minBirthTime = std::min(org->timeOfBirth, minBirthTime);
     } else { // org has not ever been saved to either snapshot_Data or SSwD_Data
@@ -588,7 +588,7 @@ bool SSwDArchivist::archive(std::vector<std::shared_ptr<Organism>> &population,
       // org->timeOfBirth << " org->timeOfDeath: " << org->timeOfDeath <<
       // "max(dataDelay, organismDelay): " << max(dataDelay, organismDelay) <<
       // endl;
-      org->parents.clear(); // we can safely release parents
+      org->clearParents(); // we can safely release parents
     } else {
       for (auto p : org->parents) { // we need to check parents (if any)
         if (checked.find(p) == checked.end()) { // if parent is not already in
@@ -607,3 +607,51 @@ bool SSwDArchivist::archive(std::vector<std::shared_ptr<Organism>> &population,
   return finished_;
 }
 
+void SSwDArchivist::saveCheckpoint(CheckpointWriter &checkpoint) {
+  DefaultArchivist::saveCheckpoint(checkpoint);
+  checkpoint.section("ARCHIVIST_SSWD");
+  checkpoint.write(writeDataSeqIndex);
+  checkpoint.write(checkPointDataSeqIndex);
+  checkpoint.write(writeOrganismSeqIndex);
+  checkpoint.write(checkPointOrganismSeqIndex);
+  checkpoint.write(nextDataWrite);
+  checkpoint.write(nextOrganismWrite);
+  checkpoint.write(nextDataCheckPoint);
+  checkpoint.write(nextOrganismCheckPoint);
+  checkpoint.write(static_cast<uint64_t>(checkpoints.size()));
+  for (auto const &checkpointOrgs : checkpoints) {
+    checkpoint.write(checkpointOrgs.first);
+    std::vector<int> IDs; // -1 for organisms that are no longer in memory
+    for (auto const &weakPtrToOrg : checkpointOrgs.second) {
+      auto org = weakPtrToOrg.lock();
+      IDs.push_back(org ? org->ID : -1);
+    }
+    checkpoint.write(IDs);
+  }
+}
+
+void SSwDArchivist::loadCheckpoint(
+    CheckpointReader &checkpoint,
+    std::unordered_map<int, std::shared_ptr<Organism>> &organisms) {
+  DefaultArchivist::loadCheckpoint(checkpoint, organisms);
+  checkpoint.section("ARCHIVIST_SSWD");
+  checkpoint.read(writeDataSeqIndex);
+  checkpoint.read(checkPointDataSeqIndex);
+  checkpoint.read(writeOrganismSeqIndex);
+  checkpoint.read(checkPointOrganismSeqIndex);
+  checkpoint.read(nextDataWrite);
+  checkpoint.read(nextOrganismWrite);
+  checkpoint.read(nextDataCheckPoint);
+  checkpoint.read(nextOrganismCheckPoint);
+  checkpoints.clear();
+  auto checkpointCount = checkpoint.read<uint64_t>();
+  for (uint64_t i = 0; i < checkpointCount; i++) {
+    auto &checkpointOrgs = checkpoints[checkpoint.read<int>()];
+    for (auto ID : checkpoint.read<std::vector<int>>()) {
+      auto org = organisms.find(ID);
+      checkpointOrgs.push_back(org != organisms.end()
+                                   ? std::weak_ptr<Organism>(org->second)
+                                   : std::weak_ptr<Organism>());
+    }
+  }
+}
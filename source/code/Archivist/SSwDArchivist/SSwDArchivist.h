@@ -83,4 +83,9 @@ public:
 
   virtual bool archive(std::vector<std::shared_ptr<Organism>> &population,
                        int flush = 0) override;
+
+  virtual void saveCheckpoint(CheckpointWriter &checkpoint) override;
+  virtual void loadCheckpoint(
+      CheckpointReader &checkpoint,
+      std::unordered_map<int, std::shared_ptr<Organism>> &organisms) override;
 };
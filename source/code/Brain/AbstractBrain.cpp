@@ -134,6 +134,31 @@ void AbstractBrain::resetBrain() {
     }
 }
 
+void AbstractBrain::resetLanes(int laneCount) {
+    std::cout << "in Brain::resetLanes() : " << getType() << " brain does not support lane evaluation (check canUpdateLanes() first)\nExiting" << std::endl;
+    exit(1);
+}
+
+void AbstractBrain::setInputLanes(int inputAddress, uint64_t value) {
+    std::cout << "in Brain::setInputLanes() : " << getType() << " brain does not support lane evaluation (check canUpdateLanes() first)\nExiting" << std::endl;
+    exit(1);
+}
+
+void AbstractBrain::updateLanes() {
+    std::cout << "in Brain::updateLanes() : " << getType() << " brain does not support lane evaluation (check canUpdateLanes() first)\nExiting" << std::endl;
+    exit(1);
+}
+
+uint64_t AbstractBrain::readOutputLanes(int outputAddress) {
+    std::cout << "in Brain::readOutputLanes() : " << getType() << " brain does not support lane evaluation (check canUpdateLanes() first)\nExiting" << std::endl;
+    exit(1);
+}
+
+void AbstractBrain::finishLanes() {
+    std::cout << "in Brain::finishLanes() : " << getType() << " brain does not support lane evaluation (check canUpdateLanes() first)\nExiting" << std::endl;
+    exit(1);
+}
+
 ///////////////////////////////////////////////////////////////////////////////////////////
 // these functions need to be filled in if genomes are being used in this brain
 ///////////////////////////////////////////////////////////////////////////////////////////
@@ -202,3 +227,14 @@ void AbstractBrain::deserialize(std::shared_ptr<ParametersTable> PT,
     // the corisponding serialize process
 }
 
+void AbstractBrain::saveCheckpoint(CheckpointWriter& checkpoint, std::string& name) {
+    serialize(name).saveCheckpoint(checkpoint);
+}
+
+void AbstractBrain::loadCheckpoint(CheckpointReader& checkpoint, std::string& name) {
+    DataMap serialDataMap;
+    serialDataMap.loadCheckpoint(checkpoint);
+    auto orgData = serialDataMap.getStringMap();
+    deserialize(PT, orgData, name);
+}
+
@@ -10,6 +10,7 @@
 
 #pragma once
 
+#include <cstdint>
 #include <set>
 #include <vector>
 
@@ -20,6 +21,8 @@
 #include "../Analyze/timeSeries.h"
 #include "../Analyze/stateToState.h"
 
+class AbstractBrainBatch;
+
 class AbstractBrain {
 public:
     static std::shared_ptr<ParameterLink<std::string>> brainTypeStrPL;
@@ -81,6 +84,41 @@ public:
 
     virtual void resetBrain();
 
+    ///////////////////////////////////////////////////////////////////////////////////////////
+    // bit parallel (lane) evaluation
+    // brains which are deterministic and only care if values are > 0 can run up to 64 independent
+    // trials at the same time. each input and output is then a uint64_t where bit l belongs to
+    // the trial in lane l. worlds should check canUpdateLanes() and otherwise use the normal functions.
+    ///////////////////////////////////////////////////////////////////////////////////////////
+
+    virtual bool canUpdateLanes() { return false; }
+
+    // like resetBrain, but starts laneCount (1 to 64) trials
+    virtual void resetLanes(int laneCount);
+
+    // bit l of value is the input for lane l
+    virtual void setInputLanes(int inputAddress, uint64_t value);
+
+    virtual void updateLanes();
+
+    // bit l is set if outputAddress is > 0 in lane l
+    virtual uint64_t readOutputLanes(int outputAddress);
+
+    // call after the last updateLanes. if recordActivity, the activity of each lane is added
+    // (in lane order, one lifetime per lane) just as if the trials had been run one at a time
+    virtual void finishLanes();
+
+    ///////////////////////////////////////////////////////////////////////////////////////////
+    // batched evaluation
+    // brains of the same type and shape (i.e. only the weights differ) can be updated together
+    // as one batch. makeBatch can be called on any brain and returns nullptr if brains can not
+    // be batched, worlds should then use the normal functions.
+    ///////////////////////////////////////////////////////////////////////////////////////////
+
+    virtual std::shared_ptr<AbstractBrainBatch> makeBatch(const std::vector<std::shared_ptr<AbstractBrain>>& brains) {
+        return nullptr;
+    }
+
 
     // I dont this this is being used anywhere....
                 //// setRecordActivity and setRecordFileName provide a standard way to set up brain
@@ -134,6 +172,13 @@ public:
         std::unordered_map<std::string, std::string>& orgData,
         std::string& name);
 
+    // save / load everything needed to continue a run with this brain (see
+    // Utilities/Checkpoint.h). the default uses serialize and deserialize.
+    // brains with state that serialize does not write (i.e. mutation counts)
+    // should override these and call them.
+    virtual void saveCheckpoint(CheckpointWriter& checkpoint, std::string& name);
+    virtual void loadCheckpoint(CheckpointReader& checkpoint, std::string& name);
+
     virtual std::vector<double> getInputVector() {
         return (inputValues);
     }
@@ -160,18 +205,19 @@ public:
         recordActivity = setting;
     };
 
-    TS::TimeSeries InputStates;
-    TS::TimeSeries OutputStates;
-    TS::TimeSeries HiddenStates;
+    // each state is one row in a flat buffer (see TS::StateBuffer), brains should use addRow to record
+    TS::StateBuffer InputStates;
+    TS::StateBuffer OutputStates;
+    TS::StateBuffer HiddenStates;
     std::vector<int> lifeTimes = { 0 }; // a vector of the durration of each lifetime
 
-    TS::TimeSeries getInputStates() {
+    const TS::StateBuffer& getInputStates() {
         return InputStates;
     }
-    TS::TimeSeries getOutputStates() {
+    const TS::StateBuffer& getOutputStates() {
         return OutputStates;
     }
-    TS::TimeSeries getHiddenStates() {
+    const TS::StateBuffer& getHiddenStates() {
         return HiddenStates;
     }
     std::vector<int> getLifeTimes() {
@@ -184,9 +230,39 @@ public:
         HiddenStates.clear();
         lifeTimes = { 0 };
     }
+
+    // worlds that know how many updates (over how many lifetimes) will be recorded can call this
+    // so that states are recorded without growing buffers. hidden has one extra state per lifetime
+    void reserveActivity(int updates, int lives = 1) {
+        InputStates.reserve(updates);
+        OutputStates.reserve(updates + (recurrentOutput ? lives : 0));
+        HiddenStates.reserve(updates + lives);
+        lifeTimes.reserve(lives + 1);
+    }
     /////////////////////////////////////////////////////////////////////////////////////////////
     /////////////////////////////////////////////////////////////////////////////////////////////
     // end information theory stuff
     /////////////////////////////////////////////////////////////////////////////////////////////
     /////////////////////////////////////////////////////////////////////////////////////////////
 };
+
+// a group of brains which are updated together (see AbstractBrain::makeBatch)
+// each brain in the batch acts just as it would if it were updated on it's own (this includes
+// recorded activity). finish() must be called after the last update to write state back to the brains
+class AbstractBrainBatch {
+public:
+    virtual ~AbstractBrainBatch() = default;
+
+    virtual int size() = 0;
+
+    // resetBrain() for every brain in the batch
+    virtual void resetBrains() = 0;
+
+    virtual void setInput(int brain, int inputAddress, double value) = 0;
+
+    virtual double readOutput(int brain, int outputAddress) = 0;
+
+    virtual void update() = 0;
+
+    virtual void finish() = 0;
+};
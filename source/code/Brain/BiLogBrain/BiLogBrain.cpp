@@ -16,6 +16,7 @@
 #include <Utilities/Random.h> //random
 #include <utility> //std::pair
 #include <iostream> //std::cout
+#include <mutex> //std::mutex
 
 
 int BiLogBrain::mutProgIndex = 0;
@@ -524,16 +525,17 @@ DataMap BiLogBrain::serialize(std::string &name) {
 // given an unordered_map<string, string> and PT, load data into this brain
 void BiLogBrain::deserialize(std::shared_ptr<ParametersTable> PT, std::unordered_map<std::string, std::string> &orgData, std::string &name) {
 	
-	auto brainData = orgData["BRAIN_" + name + "_BiLogBrainGates"];
+	// name already has the "BRAIN_" prefix (see serialize)
+	auto brainData = orgData[name + "_BiLogBrainGates"];
 
 	std::vector<std::string> brainLayersData;
 	std::vector<int> thisLayersValues;
 
 	gates.clear();
 
-	//std::cout << orgData["BRAIN_" + name + "_BiLogBrainGates"] << std::endl;
+	//std::cout << brainData << std::endl;
 
-	convertCSVListToVector(orgData["BRAIN_" + name + "_BiLogBrainGates"], brainLayersData, '_');
+	convertCSVListToVector(brainData, brainLayersData, '_');
 	int layerCount = 0;
 	for (auto layerData : brainLayersData) {
 		gates.push_back({}); // make room for this layer
@@ -558,6 +560,28 @@ void BiLogBrain::deserialize(std::shared_ptr<ParametersTable> PT, std::unordered
 	//exit(1);
 
 }
+void BiLogBrain::saveCheckpoint(CheckpointWriter &checkpoint, std::string &name) {
+	AbstractBrain::saveCheckpoint(checkpoint, name);
+	checkpoint.write(mutCountLogic1);
+	checkpoint.write(mutCountLogic2);
+	checkpoint.write(mutCountLogic3);
+	checkpoint.write(mutCountLogic4);
+	checkpoint.write(mutCountWire1);
+	checkpoint.write(mutCountWire2);
+	checkpoint.write(mutationHistory);
+}
+
+void BiLogBrain::loadCheckpoint(CheckpointReader &checkpoint, std::string &name) {
+	AbstractBrain::loadCheckpoint(checkpoint, name);
+	checkpoint.read(mutCountLogic1);
+	checkpoint.read(mutCountLogic2);
+	checkpoint.read(mutCountLogic3);
+	checkpoint.read(mutCountLogic4);
+	checkpoint.read(mutCountWire1);
+	checkpoint.read(mutCountWire2);
+	checkpoint.read(mutationHistory);
+}
+
 void
 BiLogBrain::resetBrain() {
 	for (auto &layer : nodes) {
@@ -896,9 +920,14 @@ void BiLogBrain::setMutationRates() {
 std::shared_ptr<AbstractBrain>
 BiLogBrain::makeBrainFrom(std::shared_ptr<AbstractBrain> parent, std::unordered_map<std::string, std::shared_ptr<AbstractGenome>> &_genomes) {
 
-	// if Global::updates catches up to mutProg_updates next entry then add 1 to
-	// mutProgIndex so that we used the next set of mutation rates.
-	if (mutProgIndex + 1 < mutProg_updates.size() && mutProg_updates[mutProgIndex + 1] == Global::update) {
+	// if Global::updates catches up to mutProg_updates next entry(s) then move
+	// mutProgIndex to the last entry reached so that we used the next set of mutation rates.
+	// (mutProgIndex is not saved in checkpoints, a resumed run catches up here)
+	// (mutProgIndex is shared by all brains, and offspring may be made on more
+	// then one thread, see TournamentOptimizer)
+	static std::mutex mutProgMutex;
+	std::unique_lock<std::mutex> mutProgLock(mutProgMutex);
+	while (mutProgIndex + 1 < mutProg_updates.size() && mutProg_updates[mutProgIndex + 1] <= Global::update) {
 		mutProgIndex++;
 	}
 	if (mutProg_updates.size() > 0 && Global::update >= mutProg_updates[mutProgIndex]) {
@@ -912,6 +941,7 @@ BiLogBrain::makeBrainFrom(std::shared_ptr<AbstractBrain> parent, std::unordered_
 		mutOneBrain = mutProg_onePerBrain[mutProgIndex];
 		mutOneGate = mutProg_onePerGate[mutProgIndex];
 	}
+	mutProgLock.unlock();
 
 
 
@@ -34,6 +34,9 @@ public:
 	DataMap serialize(std::string &name)  override;
 	// given an unordered_map<string, string> and PT, load data into this brain
 	void deserialize(std::shared_ptr<ParametersTable> PT, std::unordered_map<std::string, std::string> &orgData, std::string &name) override;
+	// checkpoints also keep the mutation counts (and history) which are passed on to offspring
+	void saveCheckpoint(CheckpointWriter &checkpoint, std::string &name) override;
+	void loadCheckpoint(CheckpointReader &checkpoint, std::string &name) override;
 
     virtual void resetBrain() override;
 
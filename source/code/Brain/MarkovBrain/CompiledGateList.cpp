@@ -0,0 +1,188 @@
+//  MABE is a product of The Hintze Lab @ MSU
+//     for general research information:
+//         hintzelab.msu.edu
+//     for MABE documentation:
+//         github.com/Hintzelab/MABE/wiki
+//
+//  Copyright (c) 2015 Michigan State University. All rights reserved.
+//     to view the full license, visit:
+//         github.com/Hintzelab/MABE/wiki/License
+
+#include "CompiledGateList.h"
+
+#include <algorithm>
+#include <unordered_map>
+
+#include "Gate/DeterministicGate.h"
+
+bool CompiledGateList::compile(const std::vector<std::shared_ptr<AbstractGate>> &gates) {
+	compiled = false;
+	inputStarts.assign(1, 0);
+	inputAddresses.clear();
+	outputStarts.assign(1, 0);
+	outputAddresses.clear();
+	tableStarts.clear();
+	tableRows.clear();
+	outputTruthTables.clear();
+	lanesCompiled = true;
+	maxWriters = 0;
+	gateIsAnn.clear();
+	annInputStarts.assign(1, 0);
+	annInputAddresses.clear();
+	annWeights.clear();
+	annBiases.clear();
+	annOutputAddresses.clear();
+	annSettings = nullptr;
+
+	for (auto &gate : gates) {
+		auto annGate = std::dynamic_pointer_cast<AnnGate>(gate);
+		if (annGate != nullptr) {
+			if (annSettings == nullptr) {
+				annSettings = annGate;
+			}
+			if (annGate->activation != annSettings->activation || annGate->discretizeOutput != annSettings->discretizeOutput ||
+				annGate->bitBehavior != annSettings->bitBehavior || annGate->outputs.size() != 1 ||
+				annGate->weights.size() != annGate->inputs.size()) {
+				return false;
+			}
+			gateIsAnn.push_back(true);
+			annInputAddresses.insert(annInputAddresses.end(), annGate->inputs.begin(), annGate->inputs.end());
+			annWeights.insert(annWeights.end(), annGate->weights.begin(), annGate->weights.end());
+			annInputStarts.push_back(static_cast<int>(annInputAddresses.size()));
+			annBiases.push_back(annGate->initalValue);
+			annOutputAddresses.push_back(annGate->outputs[0]);
+			lanesCompiled = false; // ANN gates are not bit gates
+			continue;
+		}
+
+		auto detGate = std::dynamic_pointer_cast<DeterministicGate>(gate);
+		if (detGate == nullptr || detGate->outputs.size() > 64 ||
+			detGate->inputs.size() > 30 || detGate->table.size() != (size_t(1) << detGate->inputs.size())) {
+			return false;
+		}
+
+		tableStarts.push_back(static_cast<int>(tableRows.size()));
+		for (auto &row : detGate->table) {
+			if (row.size() != detGate->outputs.size()) {
+				return false;
+			}
+			uint64_t bits = 0;
+			for (size_t o = 0; o < row.size(); o++) {
+				if (row[o] != 0 && row[o] != 1) { // only 0/1 tables can be packed
+					return false;
+				}
+				bits |= uint64_t(row[o]) << o;
+			}
+			tableRows.push_back(bits);
+		}
+
+		if (detGate->inputs.size() > 6) { // truth tables would not fit in 64 bits
+			lanesCompiled = false;
+		}
+		else {
+			for (size_t o = 0; o < detGate->outputs.size(); o++) {
+				uint64_t truthTable = 0;
+				for (size_t r = 0; r < detGate->table.size(); r++) {
+					truthTable |= uint64_t(detGate->table[r][o]) << r;
+				}
+				outputTruthTables.push_back(truthTable);
+			}
+		}
+
+		gateIsAnn.push_back(false);
+		inputAddresses.insert(inputAddresses.end(), detGate->inputs.begin(), detGate->inputs.end());
+		inputStarts.push_back(static_cast<int>(inputAddresses.size()));
+		outputAddresses.insert(outputAddresses.end(), detGate->outputs.begin(), detGate->outputs.end());
+		outputStarts.push_back(static_cast<int>(outputAddresses.size()));
+	}
+
+	std::unordered_map<int, int> writers;
+	for (auto address : outputAddresses) {
+		maxWriters = std::max(maxWriters, ++writers[address]);
+	}
+
+	annInputValues.resize(annInputAddresses.size());
+	annResults.resize(annOutputAddresses.size());
+
+	compiled = true;
+	return true;
+}
+
+void CompiledGateList::update(const std::vector<double> &nodes, std::vector<double> &nextNodes) {
+	// ANN layer
+	if (!annResults.empty()) {
+		const bool bitBehavior = annSettings->bitBehavior;
+		for (size_t i = 0; i < annInputAddresses.size(); i++) {
+			annInputValues[i] = bitBehavior ? Bit(nodes[annInputAddresses[i]]) : nodes[annInputAddresses[i]];
+		}
+		const int annCount = static_cast<int>(annResults.size());
+		for (int a = 0; a < annCount; a++) {
+			double result = annBiases[a];
+			for (int i = annInputStarts[a]; i < annInputStarts[a + 1]; i++) {
+				result += annWeights[i] * annInputValues[i];
+			}
+			result = annSettings->activate(result);
+			annResults[a] = bitBehavior ? Bit(result) : result;
+		}
+	}
+
+	// add results to nextNodes in gate order (the order matters for ANN results)
+	int d = 0; // deterministic gate index
+	int a = 0; // ANN gate index
+	for (bool isAnn : gateIsAnn) {
+		if (isAnn) {
+			nextNodes[annOutputAddresses[a]] += annResults[a];
+			a++;
+			continue;
+		}
+		// first input is the low bit (this matches vectorToBitToInt(nodes, inputs, true))
+		int row = 0;
+		for (int i = inputStarts[d], bit = 0; i < inputStarts[d + 1]; i++, bit++) {
+			row |= (nodes[inputAddresses[i]] > 0.0) << bit;
+		}
+		uint64_t bits = tableRows[tableStarts[d] + row];
+		for (int o = outputStarts[d]; bits != 0; o++, bits >>= 1) {
+			if (bits & 1) {
+				nextNodes[outputAddresses[o]] += 1.0;
+			}
+		}
+		d++;
+	}
+}
+
+void CompiledGateList::updateLanes(const std::vector<uint64_t> &nodes, std::vector<uint64_t> &nextNodes, int planeCount) const {
+	uint64_t rows[64];
+	const int gateCount = static_cast<int>(tableStarts.size());
+	for (int g = 0; g < gateCount; g++) {
+		const int inputCount = inputStarts[g + 1] - inputStarts[g];
+		for (int o = outputStarts[g]; o < outputStarts[g + 1]; o++) {
+			// fill in a word for each row of the truth table and then use the inputs (low bit first)
+			// to select between pairs of rows until only the row picked by each lane remains
+			uint64_t truthTable = outputTruthTables[o];
+			int rowCount = 1 << inputCount;
+			for (int r = 0; r < rowCount; r++) {
+				rows[r] = ((truthTable >> r) & 1) ? ~uint64_t(0) : 0;
+			}
+			for (int i = inputStarts[g]; i < inputStarts[g + 1]; i++) {
+				uint64_t select = nodes[inputAddresses[i]];
+				rowCount >>= 1;
+				for (int r = 0; r < rowCount; r++) {
+					rows[r] = (select & rows[2 * r + 1]) | (~select & rows[2 * r]);
+				}
+			}
+
+			uint64_t *planes = &nextNodes[outputAddresses[o] * planeCount];
+			if (planeCount == 1) {
+				planes[0] |= rows[0];
+			}
+			else { // add one to the count in each lane which wrote 1
+				uint64_t carry = rows[0];
+				for (int p = 0; carry != 0 && p < planeCount; p++) {
+					uint64_t nextCarry = planes[p] & carry;
+					planes[p] ^= carry;
+					carry = nextCarry;
+				}
+			}
+		}
+	}
+}
@@ -0,0 +1,81 @@
+//  MABE is a product of The Hintze Lab @ MSU
+//     for general research information:
+//         hintzelab.msu.edu
+//     for MABE documentation:
+//         github.com/Hintzelab/MABE/wiki
+//
+//  Copyright (c) 2015 Michigan State University. All rights reserved.
+//     to view the full license, visit:
+//         github.com/Hintzelab/MABE/wiki/License
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "Gate/AbstractGate.h"
+#include "Gate/AnnGate.h"
+
+// a gate list lowered into flat arrays so that it can be run in one loop
+// without a virtual call (and a vector<vector<int>> lookup) per gate.
+// only lists made entirely of DeterministicGates and AnnGates can be compiled,
+// compile() returns false for anything else and the gates must be updated as usual.
+class CompiledGateList {
+	// for each gate (in order) true if it is an ANN gate, otherwise it is deterministic
+	std::vector<bool> gateIsAnn;
+
+	// deterministic gates:
+	// gate g reads inputAddresses[inputStarts[g]] ... inputAddresses[inputStarts[g + 1] - 1]
+	// and writes outputAddresses[outputStarts[g]] ... outputAddresses[outputStarts[g + 1] - 1]
+	std::vector<int> inputStarts;
+	std::vector<int> inputAddresses;
+	std::vector<int> outputStarts;
+	std::vector<int> outputAddresses;
+
+	// row r of gate g's table is tableRows[tableStarts[g] + r]
+	// bit o of a row is set if the gate writes 1 to it's o'th output
+	std::vector<int> tableStarts;
+	std::vector<uint64_t> tableRows;
+
+	// truth table of each output (bit r is the output for input row r), used by updateLanes.
+	// only built if there are no ANN gates and no gate has more then 6 inputs
+	std::vector<uint64_t> outputTruthTables;
+	bool lanesCompiled = false;
+	int maxWriters = 0; // most gate outputs connected to any single node
+
+	// ANN gates (the ANN layer): all ANN gates only read nodes, so they are run together
+	// (gather inputs, then one weighted sum per gate) before results are added to nextNodes in gate order.
+	// ANN gate a has weights annWeights[annInputStarts[a]] ... annWeights[annInputStarts[a + 1] - 1]
+	std::vector<int> annInputStarts;
+	std::vector<int> annInputAddresses;
+	std::vector<double> annWeights;
+	std::vector<double> annBiases;
+	std::vector<int> annOutputAddresses;
+	std::shared_ptr<AnnGate> annSettings; // activation, discretizeOutput and bitBehavior (the same for all ANN gates)
+	std::vector<double> annInputValues;   // gathered inputs (scratch)
+	std::vector<double> annResults;       // output of each ANN gate (scratch)
+
+	bool compiled = false;
+
+public:
+	// build the flat program from gates, returns false (and leaves the list
+	// uncompiled) if any gate can not be compiled
+	bool compile(const std::vector<std::shared_ptr<AbstractGate>> &gates);
+
+	bool isCompiled() const { return compiled; }
+
+	// same as calling update(nodes, nextNodes) on each gate in order
+	void update(const std::vector<double> &nodes, std::vector<double> &nextNodes);
+
+	bool canUpdateLanes() const { return compiled && lanesCompiled; }
+	int getMaxWriters() const { return maxWriters; }
+
+	// bit parallel version of update where bit l of each word belongs to an independent trial.
+	// nodes has one word per node (bit set if node > 0). nextNodes holds planeCount words per node
+	// (node n uses nextNodes[n * planeCount] ... nextNodes[n * planeCount + planeCount - 1]) which
+	// are the bits (low bit first) of the number of gates that wrote 1 to that node.
+	// if planeCount is 1, writes are or'ed (i.e. only > 0 is kept), otherwise planeCount
+	// must be large enough to hold getMaxWriters()
+	void updateLanes(const std::vector<uint64_t> &nodes, std::vector<uint64_t> &nextNodes, int planeCount) const;
+};
@@ -56,6 +56,11 @@ public:
 	virtual std::string gateType() {
 		return "undefined";
 	}
+	// true if makeCopy (and then resetGate) gives a gate just like one freshly translated from the
+	// same genome sites. only such gates are reused by ClassicGateListBuilder::buildGateListFrom
+	virtual bool isReusable() {
+		return false;
+	}
 	virtual std::pair<std::vector<int>, std::vector<int>> getConnectionsLists(){
 		std::pair<std::vector<int>, std::vector<int>> connectionsLists;
 		connectionsLists.first = inputs;
@@ -50,7 +50,7 @@ AnnGate::AnnGate(std::vector<int> _inputs, int _output, std::vector<double> _wei
 	
 	initalValue = _initalValue;
 	discretizeOutput = discretizeOutputPL->get(PT);
-	activationFunction = activationFunctionPL->get(PT);
+	activation = getActivation(activationFunctionPL->get(PT));
 
 	convertCSVListToVector(weightRangeMappingPL->get(), weightRangeMapping);
 
@@ -64,6 +64,26 @@ AnnGate::AnnGate(std::vector<int> _inputs, int _output, std::vector<double> _wei
 	bitBehavior = bitBehaviorPL->get(PT);
 }
 
+AnnGate::Activation AnnGate::getActivation(const std::string& name) {
+	if (name == "none" || name == "linear") {
+		return Activation::LINEAR;
+	}
+	else if (name == "tanh") {
+		return Activation::TANH;
+	}
+	else if (name == "tanh(0-1)") {
+		return Activation::TANH_0_1;
+	}
+	else if (name == "bit") {
+		return Activation::BIT;
+	}
+	else if (name == "triangle") {
+		return Activation::TRIANGLE;
+	}
+	// any other name means no activation function (same as none/linear)
+	return Activation::LINEAR;
+}
+
 void AnnGate::update(std::vector<double>& nodes, std::vector<double>& nextNodes) {  //this translates the input bits of the current states to the output bits of the next states
 	
 	double result = initalValue; // initalize this nodes return value
@@ -79,38 +99,7 @@ void AnnGate::update(std::vector<double>& nodes, std::vector<double>& nextNodes)
 		}
 	}
 
-	// select activation function (if none/linear, do nothing)
-	if (activationFunction == "none" || activationFunction == "linear") {
-		// if none / linear, do nothing
-	}
-	else if (activationFunction == "tanh") {
-		result = tanh(result);
-	}
-	else if (activationFunction == "tanh(0-1)") {
-		result = tanh(result) * .5 + .5;
-	}
-	else if (activationFunction == "bit") {
-		result = Bit(result);
-	}
-	else if (activationFunction == "triangle") {
-		result = std::max(1.0-std::abs(result*2.0),-1.0);
-	}
-
-	// apply discertize rule is set
-	if (discretizeOutput == 1) {
-		result = Bit(result);
-	}
-	else if (discretizeOutput > 1) {
-		// move value is in to range 0 to discretizeOutput
-		result = ((result + 1.0) / 2.0) * discretizeOutput;
-		// use int to discretize
-		result = (double)(int)(result);
-		if (result == discretizeOutput) { // if node value was exactly 1
-			result--;
-		}
-		// move back to [0..1] (with / discretizeOutput-1) and then to [-1...1] (with * 2 - 1)
-		result = (result / (double)(discretizeOutput - 1) * 2.0) - 1.0;
-	}
+	result = activate(result);
 
 	if (bitBehavior) {
 		nextNodes[outputs[0]] += Bit(result);
@@ -134,5 +123,6 @@ std::shared_ptr<AbstractGate> AnnGate::makeCopy(std::shared_ptr<ParametersTable>
 	newGate->weightRangeMapping = weightRangeMapping;
 	newGate->weightRangeMappingSums = weightRangeMappingSums;
 	newGate->bitBehavior = bitBehavior;
+	newGate->activation = activation;
 	return newGate;
 }
@@ -31,7 +31,50 @@ public:
 	int discretizeOutput = 0;
 	std::vector<double> weightRangeMapping = {};
 	std::vector<double> weightRangeMappingSums = {};
-	std::string activationFunction = "tanh";
+
+	// activation function is looked up once (from activationFunctionPL) when the gate is made
+	enum class Activation { LINEAR, TANH, TANH_0_1, BIT, TRIANGLE };
+	Activation activation = Activation::TANH;
+
+	// convert an activation function name to an Activation, names which are not known are LINEAR (no activation)
+	static Activation getActivation(const std::string& name);
+
+	// apply activation function and discretizeOutput to the weighted sum of a gates inputs
+	double activate(double result) const {
+		switch (activation) {
+		case Activation::LINEAR: // do nothing
+			break;
+		case Activation::TANH:
+			result = tanh(result);
+			break;
+		case Activation::TANH_0_1:
+			result = tanh(result) * .5 + .5;
+			break;
+		case Activation::BIT:
+			result = Bit(result);
+			break;
+		case Activation::TRIANGLE:
+			result = std::max(1.0 - std::abs(result * 2.0), -1.0);
+			break;
+		}
+
+		// apply discertize rule is set
+		if (discretizeOutput == 1) {
+			result = Bit(result);
+		}
+		else if (discretizeOutput > 1) {
+			// move value is in to range 0 to discretizeOutput
+			result = ((result + 1.0) / 2.0) * discretizeOutput;
+			// use int to discretize
+			result = (double)(int)(result);
+			if (result == discretizeOutput) { // if node value was exactly 1
+				result--;
+			}
+			// move back to [0..1] (with / discretizeOutput-1) and then to [-1...1] (with * 2 - 1)
+			result = (result / (double)(discretizeOutput - 1) * 2.0) - 1.0;
+		}
+		return result;
+	}
 
 	AnnGate() = delete;
 	AnnGate(std::shared_ptr<ParametersTable> _PT = nullptr) :
@@ -29,6 +29,9 @@ public:
 	virtual std::string gateType() override{
 		return "DecomposableDirect";
 	}
+	virtual bool isReusable() override {
+		return true;
+	}
 	virtual std::shared_ptr<AbstractGate> makeCopy(std::shared_ptr<ParametersTable> _PT = nullptr) override;
   virtual std::string getTPMdescription() {
     std::string S="";
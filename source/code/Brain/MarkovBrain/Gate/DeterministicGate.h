@@ -31,6 +31,9 @@ public:
 	virtual std::string gateType() override{
 		return "Deterministic";
 	}
+	virtual bool isReusable() override {
+		return true;
+	}
         virtual std::string getTPMdescription() override{
           std::string S="";
           S+="\"ins\":[";
@@ -38,6 +38,9 @@ class GPGate : public AbstractGate {
 	virtual std::string gateType() override{
 		return "GeneticPrograming";
 	}
+	virtual bool isReusable() override {
+		return true;
+	}
 	virtual std::shared_ptr<AbstractGate> makeCopy(std::shared_ptr<ParametersTable> _PT = nullptr) override;
 
 };
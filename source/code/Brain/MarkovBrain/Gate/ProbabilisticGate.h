@@ -29,5 +29,8 @@ public:
 	virtual std::string gateType() override{
 		return "Probabilistic";
 	}
+	virtual bool isReusable() override {
+		return true;
+	}
 	virtual std::shared_ptr<AbstractGate> makeCopy(std::shared_ptr<ParametersTable> _PT = nullptr) override;
 };
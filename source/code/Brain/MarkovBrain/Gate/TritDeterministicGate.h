@@ -34,6 +34,9 @@ class TritDeterministicGate : public AbstractGate {
 	virtual std::string gateType() override{
 		return "TritDeterministic";
 	}
+	virtual bool isReusable() override {
+		return true;
+	}
 
 	virtual std::shared_ptr<AbstractGate> makeCopy(std::shared_ptr<ParametersTable> _PT = nullptr) override;
 
@@ -959,6 +959,7 @@ void Gate_Builder::setupGates() {
 
 	if (usingAnnGatePL->get(PT)) {
 		inUseGateNames.insert("ANN");
+		randomTranslation = true; // the number of inputs is random
 		int codonOne = AnnCode;
 		inUseGateTypes.insert(codonOne);
 		{
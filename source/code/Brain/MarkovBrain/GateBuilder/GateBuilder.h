@@ -78,6 +78,7 @@ public:
 
 	std::set<int> inUseGateTypes;
 	std::set<std::string> inUseGateNames;
+	bool randomTranslation = false; // true if making some in use gate type draws random numbers (so gates can not be reused between translations)
 	std::vector<std::vector<int>> gateStartCodes;
 
 	std::map<int, int> intialGateCounts;
@@ -36,6 +36,36 @@ std::vector<std::shared_ptr<AbstractGate>> ClassicGateListBuilder::buildGateList
 
 		int gateCount = 0;
 
+		// genomeHandler is just past a start codon (of type gateType), build a gate from there
+		auto buildGate = [&](int gateType) {
+			std::vector<int> thisGatesValues;
+			std::shared_ptr<AbstractGate> newGate = translateGate(gateType, gateCount, codonMax, genomeHandler, gateGenomeHandler, maxValue, thisGatesValues, genomePerGateValuesCount, gatePT);
+			if (newGate != nullptr) {
+				gates.push_back(newGate);
+				genomePerGateValues.push_back(thisGatesValues);
+			}
+			gateCount++;
+		};
+
+		// if start codons fit in a single site, the genome may be able to tell us where they are
+		const std::vector<int>* startCodonSites = mustReadAll ? nullptr : getStartCodonSites(genome, codonMax);
+
+		if (startCodonSites != nullptr) {
+			// visit only the start codons. the scan below tests start codons beginning at sites 0 to size-3
+			int lastSite = genome->countSites() - 3;
+			for (int site : *startCodonSites) {
+				if (site > lastSite) {
+					break;
+				}
+				genomeHandler->resetHandler();
+				genomeHandler->advanceIndex(site);
+				int gateType = genomeHandler->readInt(0, codonMax);
+				genomeHandler->readInt(0, codonMax);
+				buildGate(gateType);
+			}
+			translation_Complete = true;
+		}
+
 		int testSite1Value, testSite2Value;
 		testSite1Value = genomeHandler->readInt(0, codonMax);
 		testSite2Value = genomeHandler->readInt(0, codonMax);
@@ -48,29 +78,7 @@ std::vector<std::shared_ptr<AbstractGate>> ClassicGateListBuilder::buildGateList
 				genomeHandler->copyTo(placeHolderGenomeHandler);  // move placeholder to the next chromosome aswell so mustReadAll method works
 				testSite2Value = genomeHandler->readInt(0, codonMax);  // place first value in new chromosome in testSite2 so !mustReadAll method works
 			} else if (gateBuilder.gateStartCodes[testSite1Value].size() != 0 && gateBuilder.gateStartCodes[testSite1Value][1] == testSite2Value) {  // if we found a start codon
-					genomeHandler->copyTo(gateGenomeHandler);
-					gateGenomeHandler->toggleReadDirection();
-					gateGenomeHandler->readInt(0, codonMax);  // move back 2 start codon values
-					gateGenomeHandler->readInt(0, codonMax);
-					gateGenomeHandler->toggleReadDirection();  // reverse the read direction again
-					gateGenomeHandler->readInt(0, codonMax, AbstractGate::START_CODE, gateCount);  // mark start codon in genomes coding region
-					gateGenomeHandler->readInt(0, codonMax, AbstractGate::START_CODE, gateCount);
-					std::shared_ptr<AbstractGate> newGate = gateBuilder.makeGate[testSite1Value](gateGenomeHandler, gateCount, gatePT);
-
-					if (newGate != nullptr) {
-						// now read perGate values from genome
-						std::vector<int> thisGatesValues;
-						int i = 0;
-						while (i < genomePerGateValuesCount && !gateGenomeHandler->atEOC()) {
-							thisGatesValues.push_back(gateGenomeHandler->readInt(0, maxValue));
-							i++;
-						}
-						if (!gateGenomeHandler->atEOC()) {  // we may run out of space while reading the perGate sites...
-							gates.push_back(newGate);
-							genomePerGateValues.push_back(thisGatesValues);
-						}
-					}
-					gateCount++;
+					buildGate(testSite1Value);
 			}
 			if (mustReadAll) {  // if start codon values are bigger then the alphabetSize of the genome, we must step forward one genome site at a time (slow)
 				placeHolderGenomeHandler->advanceIndex();
@@ -89,3 +97,130 @@ std::vector<std::shared_ptr<AbstractGate>> ClassicGateListBuilder::buildGateList
 	return gates;
 }
 
+
+const std::vector<int>* ClassicGateListBuilder::getStartCodonSites(std::shared_ptr<AbstractGenome> genome, int codonMax) {
+	std::vector<int> startCodes(codonMax + 1, -1);
+	for (int codon = 0; codon <= codonMax; codon++) {
+		if (gateBuilder.gateStartCodes[codon].size() != 0) {
+			startCodes[codon] = gateBuilder.gateStartCodes[codon][1];
+		}
+	}
+	return genome->getStartCodonSites(startCodes);
+}
+
+std::shared_ptr<AbstractGate> ClassicGateListBuilder::translateGate(int gateType, int gateCount, int codonMax, std::shared_ptr<AbstractGenome::Handler> genomeHandler, std::shared_ptr<AbstractGenome::Handler> gateGenomeHandler, int maxValue, std::vector<int> &perGateValues, int genomePerGateValuesCount, std::shared_ptr<ParametersTable> gatePT) {
+	genomeHandler->copyTo(gateGenomeHandler);
+	gateGenomeHandler->toggleReadDirection();
+	gateGenomeHandler->readInt(0, codonMax);  // move back 2 start codon values
+	gateGenomeHandler->readInt(0, codonMax);
+	gateGenomeHandler->toggleReadDirection();  // reverse the read direction again
+	gateGenomeHandler->readInt(0, codonMax, AbstractGate::START_CODE, gateCount);  // mark start codon in genomes coding region
+	gateGenomeHandler->readInt(0, codonMax, AbstractGate::START_CODE, gateCount);
+	std::shared_ptr<AbstractGate> newGate = gateBuilder.makeGate[gateType](gateGenomeHandler, gateCount, gatePT);
+
+	if (newGate != nullptr) {
+		// now read perGate values from genome
+		int i = 0;
+		while (i < genomePerGateValuesCount && !gateGenomeHandler->atEOC()) {
+			perGateValues.push_back(gateGenomeHandler->readInt(0, maxValue));
+			i++;
+		}
+		if (gateGenomeHandler->atEOC()) {  // we may run out of space while reading the perGate sites...
+			newGate = nullptr;
+		}
+	}
+	return newGate;
+}
+
+std::vector<std::shared_ptr<AbstractGate>> ClassicGateListBuilder::buildGateListFrom(std::shared_ptr<AbstractGenome> genome, int nrOfBrainStates, const std::vector<std::shared_ptr<AbstractGate>> &parentGates, const GateListTranslation &parentTranslation, GateListTranslation &translation, std::shared_ptr<ParametersTable> gatePT) {
+	translation = GateListTranslation();
+	int codonMax = (1 << Gate_Builder::bitsPerCodonPL->get(PT)) - 1;
+	bool mustReadAll = codonMax > genome->getAlphabetSize();
+	const std::vector<int>* startCodonSites = (mustReadAll || genome->isEmpty()) ? nullptr : getStartCodonSites(genome, codonMax);
+	if (startCodonSites == nullptr) {  // translation can not be recorded, just build the gates
+		return buildGateList(genome, nrOfBrainStates, gatePT);
+	}
+
+	// parent gates can be reused if genome is parentTranslation.genome with only some point mutations,
+	// and if making a gate does not draw random numbers (reusing would change the random sequence)
+	std::vector<int> changedSites;
+	auto parentGenome = parentTranslation.genome.lock();
+	bool canReuse = parentGenome != nullptr && !gateBuilder.randomTranslation &&
+		genome->getPointMutations(changedSites) == parentGenome && genome->countSites() == parentTranslation.genomeSize;
+	std::sort(changedSites.begin(), changedSites.end());
+
+	std::vector<std::shared_ptr<AbstractGate>> gates;
+	translation.genome = genome;
+	translation.genomeSize = genome->countSites();
+
+	auto genomeHandler = genome->newHandler(genome, true);
+	auto gateGenomeHandler = genome->newHandler(genome, true);
+	std::vector<int> thisGatesValues; // not used (no perGate values are read)
+
+	// visit the start codons in the same order as buildGateListAndGetAllValues. note that gateGenomeHandler is
+	// shared by all gates and copyTo does not clear EOC, so once a gate reads past the end of the genome no
+	// later gate can be made. translation.endSites is -1 for start codons translated after this has happened
+	int lastSite = translation.genomeSize - 3;
+	bool pastEnd = false;
+	size_t parentIndex = 0;
+	for (int site : *startCodonSites) {
+		if (site > lastSite) {
+			break;
+		}
+		int gateCount = (int)translation.startSites.size();
+		translation.startSites.push_back(site);
+		if (pastEnd && !gateBuilder.randomTranslation) {  // no gate can be made (and making one would have no side effects)
+			translation.endSites.push_back(-1);
+			translation.gateIndex.push_back(-1);
+			continue;
+		}
+		if (canReuse && !pastEnd) {
+			while (parentIndex < parentTranslation.startSites.size() && parentTranslation.startSites[parentIndex] < site) {
+				parentIndex++;
+			}
+			if (parentIndex < parentTranslation.startSites.size() && parentTranslation.startSites[parentIndex] == site && parentTranslation.endSites[parentIndex] != -1) {
+				int endSite = parentTranslation.endSites[parentIndex];
+				int parentGate = parentTranslation.gateIndex[parentIndex];
+				auto changed = std::lower_bound(changedSites.begin(), changedSites.end(), site);
+				bool unchanged = changed == changedSites.end() || *changed >= endSite;  // none of the sites this gate was read from have changed
+				if (unchanged && (parentGate == -1 || parentGates[parentGate]->isReusable())) {
+					translation.endSites.push_back(endSite);
+					pastEnd = endSite == translation.genomeSize;
+					if (parentGate == -1) {
+						translation.gateIndex.push_back(-1);
+					}
+					else {
+						auto newGate = parentGates[parentGate]->makeCopy();
+						newGate->resetGate();
+						newGate->ID = gateCount;
+						translation.gateIndex.push_back((int)gates.size());
+						translation.reused.push_back(true);
+						gates.push_back(newGate);
+					}
+					continue;
+				}
+			}
+		}
+		genomeHandler->resetHandler();
+		genomeHandler->advanceIndex(site);
+		int gateType = genomeHandler->readInt(0, codonMax);
+		genomeHandler->readInt(0, codonMax);
+		auto newGate = translateGate(gateType, gateCount, codonMax, genomeHandler, gateGenomeHandler, 0, thisGatesValues, 0, gatePT);
+		if (pastEnd) {
+			translation.endSites.push_back(-1);
+		}
+		else {
+			pastEnd = gateGenomeHandler->atEOC();
+			translation.endSites.push_back(pastEnd ? translation.genomeSize : gateGenomeHandler->getSiteIndex());
+		}
+		if (newGate == nullptr) {
+			translation.gateIndex.push_back(-1);
+		}
+		else {
+			translation.gateIndex.push_back((int)gates.size());
+			translation.reused.push_back(false);
+			gates.push_back(newGate);
+		}
+	}
+	return gates;
+}
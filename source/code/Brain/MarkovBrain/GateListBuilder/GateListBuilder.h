@@ -11,6 +11,7 @@
 
 #pragma once
 
+#include <algorithm>
 #include <math.h>
 #include <memory>
 #include <iostream>
@@ -21,6 +22,17 @@
 #include <Genome/AbstractGenome.h>
 #include <Utilities/Parameters.h>
 
+// where in a genome a gate list was translated from. a gate list built from a point mutated copy of
+// that genome can reuse (copies of) the gates whose sites were not changed (see buildGateListFrom)
+struct GateListTranslation {
+	std::weak_ptr<AbstractGenome> genome; // the genome translated (expired if the gates did not come from a translation)
+	int genomeSize = 0;
+	std::vector<int> startSites; // start codons translated (in order)
+	std::vector<int> endSites; // one past the last site read when translating each start codon
+	std::vector<int> gateIndex; // index in the gate list of the gate made from each start codon (-1 if no gate was made)
+	std::vector<bool> reused; // for each gate, true if it is a copy of a parent gate (so nodeMap has already been applied)
+};
+
 class AbstractGateListBuilder {
 
  public:
@@ -63,6 +75,16 @@ class AbstractGateListBuilder {
             int maxValue, std::vector<int> &genomeHeadValues, int genomeHeadValuesCount,
             std::vector<std::vector<int>> &genomePerGateValues, int genomePerGateValuesCount, std::shared_ptr<ParametersTable> gatePT) = 0;
 
+	// build a gate list from genome, reusing copies of parentGates (translated as described by parentTranslation) where
+	// the genome has not changed. translation describes the new gate list (the default builds every gate and leaves
+	// translation empty, so nothing can be reused from it)
+	virtual std::vector<std::shared_ptr<AbstractGate>> buildGateListFrom(std::shared_ptr<AbstractGenome> genome, int nrOfBrainStates,
+            const std::vector<std::shared_ptr<AbstractGate>> &parentGates, const GateListTranslation &parentTranslation,
+            GateListTranslation &translation, std::shared_ptr<ParametersTable> gatePT) {
+		translation = GateListTranslation();
+		return buildGateList(genome, nrOfBrainStates, gatePT);
+	}
+
 };
 
 class ClassicGateListBuilder : public AbstractGateListBuilder {
@@ -79,5 +101,19 @@ class ClassicGateListBuilder : public AbstractGateListBuilder {
 	virtual std::vector<std::shared_ptr<AbstractGate>> buildGateListAndGetAllValues(std::shared_ptr<AbstractGenome> genome, int nrOfBrainStates,
 	                                               int maxValue, std::vector<int> &genomeHeadValues, int genomeHeadValuesCount,
 	                                               std::vector<std::vector<int>> &genomePerGateValues, int genomePerGateValuesCount, std::shared_ptr<ParametersTable> gatePT);
+
+	virtual std::vector<std::shared_ptr<AbstractGate>> buildGateListFrom(std::shared_ptr<AbstractGenome> genome, int nrOfBrainStates,
+	                                               const std::vector<std::shared_ptr<AbstractGate>> &parentGates, const GateListTranslation &parentTranslation,
+	                                               GateListTranslation &translation, std::shared_ptr<ParametersTable> gatePT) override;
+
+ protected:
+	// the start codon index for genome (see AbstractGenome::getStartCodonSites), nullptr if the genome must be scanned
+	const std::vector<int>* getStartCodonSites(std::shared_ptr<AbstractGenome> genome, int codonMax);
+
+	// make the gate (of type gateType) whose start codon ends just before genomeHandler, reading with gateGenomeHandler.
+	// genomePerGateValuesCount values are read into perGateValues after the gate. returns nullptr if no gate was made
+	std::shared_ptr<AbstractGate> translateGate(int gateType, int gateCount, int codonMax, std::shared_ptr<AbstractGenome::Handler> genomeHandler,
+	                                            std::shared_ptr<AbstractGenome::Handler> gateGenomeHandler, int maxValue,
+	                                            std::vector<int> &perGateValues, int genomePerGateValuesCount, std::shared_ptr<ParametersTable> gatePT);
 };
 
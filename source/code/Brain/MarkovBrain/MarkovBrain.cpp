@@ -81,6 +81,11 @@ Parameters::register_parameter(
     "BRAIN_MARKOV-evaluationsPreUpdate", 1,
     "number of times brain will be evaluated (i.e. have all gates run and hidden cycled) per call to brain update");
 
+std::shared_ptr<ParameterLink<bool>> MarkovBrain::compileGatesPL =
+Parameters::register_parameter(
+    "BRAIN_MARKOV_ADVANCED-compileGates", true,
+    "if true, brains made only of deterministic and ANN gates are run from flat compiled tables rather then gate by gate (results are the same, but faster)");
+
 std::shared_ptr<ParameterLink<int>> MarkovBrain::hiddenNodesPL =
     Parameters::register_parameter("BRAIN_MARKOV-hiddenNodes", 8,
                                    "number of hidden nodes");
@@ -98,6 +103,7 @@ void MarkovBrain::readParameters() {
   randomizeUnconnectedOutputsMin = randomizeUnconnectedOutputsMinPL->get(PT);
   randomizeUnconnectedOutputsMax = randomizeUnconnectedOutputsMaxPL->get(PT);
   evaluationsPreUpdate = evaluationsPreUpdatePL->get(PT);
+  compileGates = compileGatesPL->get(PT);
 
   useOutputThreshold = useOutputThresholdPL->get(PT);
   outputThreshold = outputThresholdPL->get(PT);
@@ -131,6 +137,7 @@ MarkovBrain::MarkovBrain(std::vector<std::shared_ptr<AbstractGate>> _gates,
   }
 
   fillInConnectionsLists();
+  compileGateList();
 }
 
 MarkovBrain::MarkovBrain(std::shared_ptr<AbstractGateListBuilder> GLB_,
@@ -153,19 +160,27 @@ MarkovBrain::MarkovBrain(std::shared_ptr<AbstractGateListBuilder> GLB_,
   }
 
   fillInConnectionsLists();
+  compileGateList();
 }
 
 MarkovBrain::MarkovBrain(
     std::shared_ptr<AbstractGateListBuilder> GLB_,
     std::unordered_map<std::string, std::shared_ptr<AbstractGenome>> &_genomes, int _nrInNodes,
-    int _nrOutNodes, std::shared_ptr<ParametersTable> PT_)
+    int _nrOutNodes, std::shared_ptr<ParametersTable> PT_,
+    std::shared_ptr<MarkovBrain> parent)
     : MarkovBrain(GLB_, _nrInNodes, _nrOutNodes, PT_) {
   // cout << "in MarkovBrain::MarkovBrain(std::shared_ptr<Base_GateListBuilder> GLB_,
   // std::shared_ptr<AbstractGenome> genome, int _nrOfBrainStates)\n\tabout to -
   // gates = GLB->buildGateList(genome, nrOfBrainStates);" << endl;
 
     if (!useGateRegulation) {
-        gates = GLB->buildGateList(_genomes[genomeName], nrNodes, PT_);
+        // gates translated from sites which are unchanged from the parents genome are copied from parent
+        static const std::vector<std::shared_ptr<AbstractGate>> noGates;
+        static const GateListTranslation noTranslation;
+        gates = GLB->buildGateListFrom(_genomes[genomeName], nrNodes,
+            parent != nullptr ? parent->gates : noGates,
+            parent != nullptr ? parent->translation : noTranslation,
+            translation, PT_);
     }
     else { // useGateRegulation
         std::vector<std::vector<int>> genomePerGateValues;
@@ -196,6 +211,7 @@ MarkovBrain::MarkovBrain(
     }
   inOutReMap(); // map ins and outs from genome values to brain states
   fillInConnectionsLists();
+  compileGateList();
 }
 
 // Make a brain like the brain that called this function, using genomes and
@@ -207,6 +223,26 @@ std::shared_ptr<AbstractBrain> MarkovBrain::makeBrain(
   return newBrain;
 }
 
+// like makeBrain, but gates that are unchanged in the genome (i.e. the genome was made from
+// parents genome with makeMutatedGenomeFrom and the gates sites were not mutated) are copied
+// from parent rather then translated again
+std::shared_ptr<AbstractBrain> MarkovBrain::makeBrainFrom(
+    std::shared_ptr<AbstractBrain> parent,
+    std::unordered_map<std::string, std::shared_ptr<AbstractGenome>> &_genomes) {
+  std::shared_ptr<MarkovBrain> newBrain = std::make_shared<MarkovBrain>(
+      GLB, _genomes, nrInputValues, nrOutputValues, PT,
+      std::dynamic_pointer_cast<MarkovBrain>(parent));
+  return newBrain;
+}
+
+// gates can only be reused if the genome came from a single parent, which
+// makeBrainFrom checks, so any parent will do
+std::shared_ptr<AbstractBrain> MarkovBrain::makeBrainFromMany(
+    std::vector<std::shared_ptr<AbstractBrain>> parents,
+    std::unordered_map<std::string, std::shared_ptr<AbstractGenome>> &_genomes) {
+  return makeBrainFrom(parents[0], _genomes);
+}
+
 void MarkovBrain::resetBrain() {
   AbstractBrain::resetBrain();
   nodes.assign(nrNodes, 0.0);
@@ -269,27 +305,32 @@ void MarkovBrain::update() {
         }
 
         if (recordActivity) {
-            InputStates.push_back(std::vector<double>(nrInputValues));
+            double* inputState = InputStates.addRow(nrInputValues);
             for (int i = 0; i < nrInputValues; i++) {
-                InputStates.back()[i] = nodes[i];
+                inputState[i] = nodes[i];
             }
             if (lifeTimes.back() == 0) {
-                HiddenStates.push_back(std::vector<double>(nodes.size() - (nrInputValues + nrOutputValues)));
+                double* hiddenState = HiddenStates.addRow(nodes.size() - (nrInputValues + nrOutputValues));
                 for (int i = 0; i < nodes.size() - (nrInputValues + nrOutputValues); i++) {
-                    HiddenStates.back()[i] = nodes[i + nrInputValues + nrOutputValues];
+                    hiddenState[i] = nodes[i + nrInputValues + nrOutputValues];
                 }
                 if (recurrentOutput) {
-                    OutputStates.push_back(std::vector<double>(nrOutputValues));
+                    double* outputState = OutputStates.addRow(nrOutputValues);
                     for (int i = 0; i < nrOutputValues; i++) {
-                        OutputStates.back()[i] = nodes[nrInputValues + i];
+                        outputState[i] = nodes[nrInputValues + i];
                     }
                 }
             }
         }
 
         if (!useGateRegulation) {
-            for (auto& g : gates) {// update each gate
-                g->update(nodes, nextNodes);
+            if (compiledGates.isCompiled()) {
+                compiledGates.update(nodes, nextNodes);
+            }
+            else {
+                for (auto& g : gates) {// update each gate
+                    g->update(nodes, nextNodes);
+                }
             }
         }
         else { //useGateRegulation
@@ -434,14 +475,14 @@ void MarkovBrain::update() {
 
         // if recordActivity, add output and hidden states
         if (recordActivity) {
-            OutputStates.push_back(std::vector<double>(nrOutputValues));
+            double* outputState = OutputStates.addRow(nrOutputValues);
             for (int i = 0; i < nrOutputValues; i++) {
-                OutputStates.back()[i] = nextNodes[nrInputValues + i];
+                outputState[i] = nextNodes[nrInputValues + i];
             }
 
-            HiddenStates.push_back(std::vector<double>(nodes.size() - (nrInputValues + nrOutputValues)));
+            double* hiddenState = HiddenStates.addRow(nodes.size() - (nrInputValues + nrOutputValues));
             for (int i = 0; i < nodes.size() - (nrInputValues + nrOutputValues); i++) {
-                HiddenStates.back()[i] = nextNodes[i + nrInputValues + nrOutputValues];
+                hiddenState[i] = nextNodes[i + nrInputValues + nrOutputValues];
             }
             lifeTimes.back()++;
         }
@@ -471,10 +512,137 @@ void MarkovBrain::update() {
     }
 }
 
+// lanes can only be used if nothing in update depends on more then if node values are > 0
+// (or draws random numbers), and the brain is made only of deterministic gates
+bool MarkovBrain::canUpdateLanes() {
+  return compiledGates.canUpdateLanes() && !useGateRegulation &&
+         !useOutputThreshold && !useHiddenThreshold &&
+         !randomizeUnconnectedOutputs && !recordIOMapPL->get();
+}
+
+void MarkovBrain::resetLanes(int _laneCount) {
+  if (_laneCount < 1 || _laneCount > 64) {
+    std::cout << "in MarkovBrain::resetLanes() : laneCount must be in range [1,64], but got " << _laneCount << "\nExiting" << std::endl;
+    exit(1);
+  }
+  laneCount = _laneCount;
+  laneLifeTime = 0;
+
+  // counts are only needed if activity is being recorded, otherwise it's enough to know if a node is > 0
+  lanePlaneCount = 1;
+  if (recordActivity) {
+    while ((1 << lanePlaneCount) <= compiledGates.getMaxWriters()) {
+      lanePlaneCount++;
+    }
+  }
+
+  laneInputs.assign(nrInputValues, 0);
+  laneOutputs.assign(nrOutputValues, 0);
+  laneNodes.assign(nrNodes, 0);
+  laneNextNodes.assign(nrNodes * lanePlaneCount, 0);
+  laneInputStates.assign(recordActivity ? laneCount : 0, {});
+  laneOutputStates.assign(recordActivity ? laneCount : 0, {});
+  laneHiddenStates.assign(recordActivity ? laneCount : 0, {});
+}
+
+void MarkovBrain::setInputLanes(int inputAddress, uint64_t value) {
+  laneInputs[inputAddress] = value;
+}
+
+uint64_t MarkovBrain::readOutputLanes(int outputAddress) {
+  return laneOutputs[outputAddress];
+}
+
+// same as update(), but for each lane
+void MarkovBrain::updateLanes() {
+  int hiddenStart = nrInputValues + nrOutputValues;
+  // value of node in lane (only used when recording activity)
+  auto laneValue = [this](int node, int lane) {
+    int value = 0;
+    for (int p = 0; p < lanePlaneCount; p++) {
+      value |= (int)((laneNextNodes[node * lanePlaneCount + p] >> lane) & 1) << p;
+    }
+    return (double)value;
+  };
+
+  for (int eval = 0; eval < evaluationsPreUpdate; eval++) {
+    std::fill(laneNextNodes.begin(), laneNextNodes.end(), 0);
+    for (int i = 0; i < nrInputValues; i++) {
+      laneNodes[i] = laneInputs[i];
+    }
+
+    if (recordActivity) {
+      for (int l = 0; l < laneCount; l++) {
+        double* inputState = laneInputStates[l].addRow(nrInputValues);
+        for (int i = 0; i < nrInputValues; i++) {
+          inputState[i] = (double)((laneNodes[i] >> l) & 1);
+        }
+        if (laneLifeTime == 0) { // nodes are all 0 at the start of a lifetime
+          double* hiddenState = laneHiddenStates[l].addRow(nrNodes - hiddenStart);
+          std::fill(hiddenState, hiddenState + (nrNodes - hiddenStart), 0.0);
+          if (recurrentOutput) {
+            double* outputState = laneOutputStates[l].addRow(nrOutputValues);
+            std::fill(outputState, outputState + nrOutputValues, 0.0);
+          }
+        }
+      }
+    }
+
+    compiledGates.updateLanes(laneNodes, laneNextNodes, lanePlaneCount);
+
+    // copy outputs (if recurrentOutput) and hidden
+    for (int n = recurrentOutput ? nrInputValues : hiddenStart; n < nrNodes; n++) {
+      laneNodes[n] = 0;
+      for (int p = 0; p < lanePlaneCount; p++) {
+        laneNodes[n] |= laneNextNodes[n * lanePlaneCount + p];
+      }
+    }
+
+    if (recordActivity) {
+      for (int l = 0; l < laneCount; l++) {
+        double* outputState = laneOutputStates[l].addRow(nrOutputValues);
+        for (int i = 0; i < nrOutputValues; i++) {
+          outputState[i] = laneValue(nrInputValues + i, l);
+        }
+        double* hiddenState = laneHiddenStates[l].addRow(nrNodes - hiddenStart);
+        for (int i = hiddenStart; i < nrNodes; i++) {
+          hiddenState[i - hiddenStart] = laneValue(i, l);
+        }
+      }
+    }
+    laneLifeTime++;
+  }
+
+  for (int i = 0; i < nrOutputValues; i++) {
+    laneOutputs[i] = 0;
+    for (int p = 0; p < lanePlaneCount; p++) {
+      laneOutputs[i] |= laneNextNodes[(nrInputValues + i) * lanePlaneCount + p];
+    }
+  }
+}
+
+void MarkovBrain::finishLanes() {
+  if (recordActivity) {
+    for (int l = 0; l < laneCount; l++) {
+      if (lifeTimes.back() != 0) { // as in resetBrain
+        lifeTimes.push_back(0);
+      }
+      InputStates.append(laneInputStates[l]);
+      OutputStates.append(laneOutputStates[l]);
+      HiddenStates.append(laneHiddenStates[l]);
+      lifeTimes.back() += laneLifeTime;
+    }
+  }
+  laneInputStates.clear();
+  laneOutputStates.clear();
+  laneHiddenStates.clear();
+}
+
 void MarkovBrain::inOutReMap() { // remaps genome site values to valid brain
                                  // state addresses
-  for (auto &g : gates)
-    g->applyNodeMap(nodeMap, nrNodes);
+  for (size_t g = 0; g < gates.size(); g++)
+    if (g >= translation.reused.size() || !translation.reused[g]) // copied gates are already mapped
+      gates[g]->applyNodeMap(nodeMap, nrNodes);
 }
 
 std::string MarkovBrain::description() {
@@ -496,6 +664,13 @@ void MarkovBrain::fillInConnectionsLists() {
   }
 }
 
+// lower gates into compiledGates (if allowed). gate regulation needs per gate
+// control, so in that case the gates are always run one at a time
+void MarkovBrain::compileGateList() {
+  if (compileGates && !useGateRegulation) {
+    compiledGates.compile(gates);
+  }
+}
 
 DataMap MarkovBrain::getStats(std::string &prefix) {
   DataMap dataMap;
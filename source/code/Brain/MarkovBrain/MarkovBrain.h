@@ -16,6 +16,7 @@
 #include <set>
 #include <vector>
 
+#include "CompiledGateList.h"
 #include "GateListBuilder/GateListBuilder.h"
 #include "../../Genome/AbstractGenome.h"
 
@@ -50,6 +51,7 @@ public:
     static std::shared_ptr<ParameterLink<double>> randomizeUnconnectedOutputsMaxPL;
 
     static std::shared_ptr<ParameterLink<int>> evaluationsPreUpdatePL;
+    static std::shared_ptr<ParameterLink<bool>> compileGatesPL;
 
     static std::shared_ptr<ParameterLink<int>> hiddenNodesPL;
     static std::shared_ptr<ParameterLink<std::string>> genomeNamePL;
@@ -67,6 +69,7 @@ public:
     double randomizeUnconnectedOutputsMin;
     double randomizeUnconnectedOutputsMax;
     int evaluationsPreUpdate;
+    bool compileGates;
 
     int hiddenNodes;
     std::string genomeName;
@@ -77,6 +80,18 @@ public:
     int nrNodes;
 
     std::shared_ptr<AbstractGateListBuilder> GLB;
+    CompiledGateList compiledGates; // used by update() in place of gates if compileGates and gates could be compiled
+    GateListTranslation translation; // where gates were translated from in the genome (used by makeBrainFrom to reuse gates)
+
+    // lane evaluation state (see AbstractBrain::canUpdateLanes)
+    int laneCount = 0;
+    int lanePlaneCount = 1;     // words per node in laneNextNodes (see CompiledGateList::updateLanes)
+    int laneLifeTime = 0;       // number of evaluations since resetLanes
+    std::vector<uint64_t> laneInputs;
+    std::vector<uint64_t> laneOutputs;
+    std::vector<uint64_t> laneNodes;
+    std::vector<uint64_t> laneNextNodes;
+    std::vector<TS::StateBuffer> laneInputStates, laneOutputStates, laneHiddenStates; // only used if recordActivity
     std::vector<int> nodesConnections, nextNodesConnections;
 
     //	static bool& cacheResults;
@@ -111,7 +126,8 @@ public:
     MarkovBrain(std::shared_ptr<AbstractGateListBuilder> GLB_,
         std::unordered_map<std::string, std::shared_ptr<AbstractGenome>>& _genomes,
         int _nrInNodes, int _nrOutNodes,
-        std::shared_ptr<ParametersTable> PT_ = nullptr);
+        std::shared_ptr<ParametersTable> PT_ = nullptr,
+        std::shared_ptr<MarkovBrain> parent = nullptr);
 
     virtual ~MarkovBrain() = default;
 
@@ -129,8 +145,16 @@ public:
     virtual std::shared_ptr<AbstractBrain> makeBrain(
         std::unordered_map<std::string, std::shared_ptr<AbstractGenome>>& _genomes) override;
 
+    virtual std::shared_ptr<AbstractBrain> makeBrainFrom(
+        std::shared_ptr<AbstractBrain> parent,
+        std::unordered_map<std::string, std::shared_ptr<AbstractGenome>>& _genomes) override;
+    virtual std::shared_ptr<AbstractBrain> makeBrainFromMany(
+        std::vector<std::shared_ptr<AbstractBrain>> parents,
+        std::unordered_map<std::string, std::shared_ptr<AbstractGenome>>& _genomes) override;
+
     virtual std::string description() override;
     void fillInConnectionsLists();
+    void compileGateList();
     virtual DataMap getStats(std::string& prefix) override;
     virtual std::string getType() override { return "Markov"; }
 
@@ -138,6 +162,13 @@ public:
     virtual void resetOutputs() override;
     virtual void resetInputs() override;
 
+    virtual bool canUpdateLanes() override;
+    virtual void resetLanes(int laneCount) override;
+    virtual void setInputLanes(int inputAddress, uint64_t value) override;
+    virtual void updateLanes() override;
+    virtual uint64_t readOutputLanes(int outputAddress) override;
+    virtual void finishLanes() override;
+
     virtual std::string gateList();
     virtual std::vector<std::vector<int>> getConnectivityMatrix();
     virtual int brainSize();
@@ -9,6 +9,10 @@
 //         github.com/Hintzelab/MABE/wiki/License
 
 #include "../RNNBrain/RNNBrain.h"
+#include "../RNNBrain/RNNBrainBatch.h"
+
+#include <algorithm>
+#include <cmath>
 
 
 std::shared_ptr<ParameterLink<std::string>> RNNBrain::genomeNamePL = Parameters::register_parameter(
@@ -41,12 +45,39 @@ std::shared_ptr<ParameterLink<std::string>> RNNBrain::activationFunctionPL = Par
     "choose from \"linear\"(or \"none\"),\"tanh\",\"tanh(0-1)\",\"bit\",\"triangle\",\"invtriangle\",\"sin\",\n"
     "or, \"genome\" to allow evolution to pick");
 
+std::shared_ptr<ParameterLink<bool>> RNNBrain::useFloatPL = Parameters::register_parameter("BRAIN_RNN-useFloat", false,
+    "if true, network is updated with float (single precision) values rather then double. This is faster, but results will not match double runs");
+
+namespace {
+
+    // out = activation(bias + in * W), W is input-major (inSize rows of outSize weights)
+    // each out[j] is summed in input order, so results match the nested loop version
+    template <typename T>
+    void updateLayer(const T* in, int inSize, const T* W, const T* bias, const int* functions, T* out, int outSize) {
+        for (int j = 0; j < outSize; j++) {
+            out[j] = bias[j];
+        }
+        for (int i = 0; i < inSize; i++) {
+            const T x = in[i];
+            const T* row = W + (size_t)i * outSize;
+            for (int j = 0; j < outSize; j++) {
+                out[j] += row[j] * x;
+            }
+        }
+        for (int j = 0; j < outSize; j++) {
+            out[j] = RNNBrain::activate(out[j], functions[j]);
+        }
+    }
+
+}
+
 
 
 RNNBrain::RNNBrain(int _nrInNodes, int _nrOutNodes, std::shared_ptr<ParametersTable> _PT) : AbstractBrain(_nrInNodes, _nrOutNodes, _PT) {
     genomeName = genomeNamePL->get(_PT);
     nrRecurrentValues = nrOfRecurrentNodesPL->get(_PT);
     discretizeRecurrent = discretizeRecurrentPL->get(_PT);
+    useFloat = useFloatPL->get(_PT);
     if (activationFunctionPL->get(_PT) == "none" || activationFunctionPL->get(_PT) == "linear") {
         activationFunction = 1;
     }
@@ -164,6 +195,8 @@ std::shared_ptr<AbstractBrain> RNNBrain::makeBrain(std::unordered_map<std::strin
         }
     }
 
+    newBrain->packWeights();
+
     //newBrain->showBrain();
     //exit(0);
 
@@ -223,14 +256,14 @@ std::vector<double> RNNBrain::getRawHiddenNodes() {
 void RNNBrain::update() {
     // input and hidden have been set so it's time to record state...
     if (recordActivity) {
-        InputStates.push_back(std::vector<double>(nrInputValues));
+        double* inputState = InputStates.addRow(nrInputValues);
         for (size_t i = 0; i < nrInputValues; i++) {
-            InputStates.back()[i] = nodes[0][i];
+            inputState[i] = nodes[0][i];
         }
         if (lifeTimes.back() == 0) {
-            HiddenStates.push_back(std::vector<double>(nrRecurrentValues));
+            double* hiddenState = HiddenStates.addRow(nrRecurrentValues);
             for (size_t i = 0; i < nrRecurrentValues; i++) {
-                HiddenStates.back()[i] = nodes[0][(size_t)(nrInputValues) + i];
+                hiddenState[i] = nodes[0][(size_t)(nrInputValues) + i];
             }
         }
     }
@@ -239,55 +272,38 @@ void RNNBrain::update() {
     
     //std::cout << std::endl;
 
-    for (size_t layer = 1; layer < nodes.size(); layer++) {
-        for (size_t i = 0; i < nodes[layer].size(); i++) {
-            nodes[layer][i] = initialValues[layer][i];
-            //std::cout << "init val: " << layer << "," << i << "  " << nodes[layer][i] << std::endl;
+    if (useFloat) {
+        for (size_t i = 0; i < nodes[0].size(); i++) {
+            nodesFloat[0][i] = (float)nodes[0][i];
         }
-        // for each node in the prior layer
-        for (size_t j = 0; j < nodes[layer].size(); j++) {
-            // for each node in this layer
-            for (size_t i = 0; i < nodes[layer - 1].size(); i++) {
-                //std::cout << ":: " << layer << "  " << j << "," << i << "  " << nodes[layer][j] << " + " << weights[(size_t)(layer)-1][i][j] << " * " << nodes[(size_t)(layer)-1][i] <<std::endl;
-                // add the node value from the prior layer * that nodes weight for this node to this node
-                nodes[layer][j] += weights[(size_t)(layer) - 1][i][j] * nodes[(size_t)(layer) - 1][i];
+        for (size_t layer = 1; layer < nodes.size(); layer++) {
+            updateLayer(nodesFloat[layer - 1].data(), (int)nodesFloat[layer - 1].size(), flatWeightsFloat[layer - 1].data(),
+                initialValuesFloat[layer].data(), activationFunctions[layer].data(), nodesFloat[layer].data(), (int)nodesFloat[layer].size());
+            for (size_t i = 0; i < nodes[layer].size(); i++) {
+                nodes[layer][i] = nodesFloat[layer][i];
             }
-            applyActivation(nodes[layer][j], activationFunctions[layer][j]);
         }
-        // apply apply Activation Function to this layer
+    }
+    else {
+        for (size_t layer = 1; layer < nodes.size(); layer++) {
+            updateLayer(nodes[layer - 1].data(), (int)nodes[layer - 1].size(), flatWeights[layer - 1].data(),
+                initialValues[layer].data(), activationFunctions[layer].data(), nodes[layer].data(), (int)nodes[layer].size());
+        }
     }
     int lastLayer = nodes.size() - 1;
     for (size_t i = 0; i < nrRecurrentValues; i++) {
-        if (discretizeRecurrent < 1) {
-            nodes[0][(size_t)(nrInputValues) + i] = nodes[lastLayer][(size_t)(nrOutputValues) + i];
-        }
-        else if (discretizeRecurrent == 1) {
-            nodes[0][(size_t)(nrInputValues) + i] = Bit(nodes[lastLayer][(size_t)(nrOutputValues) + i]);
-        }
-        else {
-            // move value is in to range 0 to discretizeRecurrent
-            nodes[0][(size_t)(nrInputValues)+i] = std::max(-1.0, std::min(1.0, nodes[lastLayer][(size_t)(nrOutputValues)+i]));
-            nodes[0][(size_t)(nrInputValues)+i] = (((nodes[0][(size_t)(nrInputValues)+i]) + 1.0)/2.0)* discretizeRecurrent;
-            // use int to discretize
-            nodes[0][(size_t)(nrInputValues)+i] = (double)(int)(nodes[0][(size_t)(nrInputValues)+i]);
-            
-            if (nodes[0][(size_t)(nrInputValues)+i] == discretizeRecurrent) { // if node value was exactly 1
-                nodes[0][(size_t)(nrInputValues)+i]--;
-            }
-            // move back to [0..1] (with / discretizeRecurrent-1) and then to [-1...1] (with * 2 - 1)
-            nodes[0][(size_t)(nrInputValues)+i]  = (nodes[0][(size_t)(nrInputValues)+i] / (double)(discretizeRecurrent-1) * 2.0) - 1.0;
-        }
+        nodes[0][(size_t)(nrInputValues) + i] = discretizeRecurrentValue(nodes[lastLayer][(size_t)(nrOutputValues) + i]);
     }
 
     // output and hidden+1 have been set so it's time to record state...
     if (recordActivity) {
-        OutputStates.push_back(std::vector<double>(nrOutputValues));
+        double* outputState = OutputStates.addRow(nrOutputValues);
         for (size_t i = 0; i < nrOutputValues; i++) {
-            OutputStates.back()[i] = nodes[lastLayer][i];
+            outputState[i] = nodes[lastLayer][i];
         }
-        HiddenStates.push_back(std::vector<double>(nrRecurrentValues));
+        double* hiddenState = HiddenStates.addRow(nrRecurrentValues);
         for (size_t i = 0; i < nrRecurrentValues; i++) {
-            HiddenStates.back()[i] = nodes[0][(size_t)(nrInputValues)+i];
+            hiddenState[i] = nodes[0][(size_t)(nrInputValues)+i];
         }
         lifeTimes.back()++;
     }
@@ -305,6 +321,49 @@ void RNNBrain::update() {
     
 }
 
+// value of a recurrent node when it is copied back to the input layer (see discretizeRecurrentPL)
+double RNNBrain::discretizeRecurrentValue(double value) {
+    if (discretizeRecurrent < 1) {
+        return value;
+    }
+    if (discretizeRecurrent == 1) {
+        return Bit(value);
+    }
+    // move value is in to range 0 to discretizeRecurrent
+    value = std::max(-1.0, std::min(1.0, value));
+    value = ((value + 1.0) / 2.0) * discretizeRecurrent;
+    // use int to discretize
+    value = (double)(int)(value);
+    if (value == discretizeRecurrent) { // if node value was exactly 1
+        value--;
+    }
+    // move back to [0..1] (with / discretizeRecurrent-1) and then to [-1...1] (with * 2 - 1)
+    return (value / (double)(discretizeRecurrent - 1) * 2.0) - 1.0;
+}
+
+// brains can be batched if they are all RNN brains with the same shape and settings
+std::shared_ptr<AbstractBrainBatch> RNNBrain::makeBatch(const std::vector<std::shared_ptr<AbstractBrain>>& brains) {
+    std::vector<std::shared_ptr<RNNBrain>> rnnBrains;
+    for (auto& brain : brains) {
+        auto rnnBrain = std::dynamic_pointer_cast<RNNBrain>(brain);
+        if (rnnBrain == nullptr || rnnBrain->useFloat || rnnBrain->nrInputValues != nrInputValues ||
+            rnnBrain->nrOutputValues != nrOutputValues || rnnBrain->nrRecurrentValues != nrRecurrentValues ||
+            rnnBrain->discretizeRecurrent != discretizeRecurrent || rnnBrain->nodes.size() != nodes.size()) {
+            return nullptr;
+        }
+        for (size_t l = 0; l < nodes.size(); l++) {
+            if (rnnBrain->nodes[l].size() != nodes[l].size()) {
+                return nullptr;
+            }
+        }
+        rnnBrains.push_back(rnnBrain);
+    }
+    if (rnnBrains.empty()) {
+        return nullptr;
+    }
+    return std::make_shared<RNNBrainBatch>(rnnBrains);
+}
+
 void inline RNNBrain::resetOutputs() {
     for (int o = 0; o < nrOutputValues; o++) {
         nodes[(int)nodes.size() - 1][o] = 0.0;
@@ -357,42 +416,34 @@ DataMap RNNBrain::getStats(std::string& prefix) {
 }
 
 void RNNBrain::applyActivation(double &val, int functionID){
-    //std::cout << " in applyActivationToLayer " << activationFunction << std::endl;
-        // select activation function (if none/linear, do nothing)
-        if (functionID == 1) {
-            // if none / linear, do nothing
-            //std::cout << val << " > linear > " << val << std::endl;
-        }
-        else if (functionID == 2) {
-            //std::cout << val << " > tanh > ";
-            val = tanh(val);
-            //std::cout << val << std::endl;
-        }
-        else if (functionID == 3) {
-            //std::cout << val << " > tanh(0-1) > ";
-            val = tanh(val) * .5 + .5;
-            //std::cout << val << std::endl;
-        }
-        else if (functionID == 4) {
-            //std::cout << val << " > Bit > ";
-            val = Bit(val);
-            //std::cout << val << std::endl;
+    // select activation function (if none/linear, do nothing)
+    val = RNNBrain::activate(val, functionID);
+}
+
+// build flat (and float if useFloat) copies of weights, biases and nodes for update
+void RNNBrain::packWeights() {
+    flatWeights.resize(weights.size());
+    for (size_t l = 0; l < weights.size(); l++) {
+        size_t nextLayerSize = nodes[l + 1].size();
+        flatWeights[l].assign(weights[l].size() * nextLayerSize, 0.0);
+        for (size_t i = 0; i < weights[l].size(); i++) {
+            std::copy(weights[l][i].begin(), weights[l][i].end(), flatWeights[l].begin() + i * nextLayerSize);
         }
-        else if (functionID == 5) {
-            //std::cout << val << " > triangle > ";
-            val = std::max(1.0 - std::abs(val * 2.0), -1.0);
-            //std::cout << val << std::endl;
+    }
+    if (useFloat) {
+        flatWeightsFloat.resize(flatWeights.size());
+        for (size_t l = 0; l < flatWeights.size(); l++) {
+            flatWeightsFloat[l].assign(flatWeights[l].begin(), flatWeights[l].end());
         }
-        else if (functionID == 6) {
-            //std::cout << val << " > invtirangle > ";
-            val = std::min(std::abs(val * 2.0)-1.0, 1.0);
-            //std::cout << val << std::endl;
+        initialValuesFloat.resize(initialValues.size());
+        for (size_t l = 0; l < initialValues.size(); l++) {
+            initialValuesFloat[l].assign(initialValues[l].begin(), initialValues[l].end());
         }
-        else if (functionID == 7) {
-            //std::cout << val << " > sin > ";
-            val = sin(val * 3.14159);
-            //std::cout << val << std::endl;
+        nodesFloat.resize(nodes.size());
+        for (size_t l = 0; l < nodes.size(); l++) {
+            nodesFloat[l].assign(nodes[l].size(), 0.0f);
         }
+    }
 }
 
 std::shared_ptr<AbstractBrain> RNNBrain::makeCopy(std::shared_ptr<ParametersTable> _PT){
@@ -403,7 +454,9 @@ std::shared_ptr<AbstractBrain> RNNBrain::makeCopy(std::shared_ptr<ParametersTabl
     newBrain->nodes = nodes;
     newBrain->weights = weights;
     newBrain->initialValues = initialValues;
-    
+    newBrain->activationFunctions = activationFunctions;
+    newBrain->packWeights();
+
     return newBrain;
 }
 
@@ -11,6 +11,8 @@
 #pragma once
 
 #include <math.h>
+#include <algorithm>
+#include <cmath>
 #include <memory>
 #include <iostream>
 #include <set>
@@ -36,6 +38,7 @@ public:
 
     static std::shared_ptr<ParameterLink<std::string>> biasRangePL;
     static std::shared_ptr<ParameterLink<std::string>> activationFunctionPL;
+    static std::shared_ptr<ParameterLink<bool>> useFloatPL;
 
 
     int nrRecurrentValues;
@@ -52,6 +55,19 @@ public:
     std::vector<std::vector<double>> nodes;
     std::vector<std::vector<std::vector<double>>> weights;
 
+    // flat copies of weights used by update, one buffer per weight layer.
+    // stored input-major (flatWeights[layer][i * nextLayerSize + j] = weights[layer][i][j])
+    // so that each input adds a contiguous row into the next layer (this vectorizes well
+    // and each node still sums it's inputs in the same order as the nested weights)
+    // these are built by packWeights() and must be rebuilt if weights are changed
+    std::vector<std::vector<double>> flatWeights;
+
+    // if useFloat, update runs on float copies of weights, biases and nodes
+    bool useFloat;
+    std::vector<std::vector<float>> flatWeightsFloat;
+    std::vector<std::vector<float>> initialValuesFloat;
+    std::vector<std::vector<float>> nodesFloat;
+
 
     //   activation Function Types: 0:none, 1:linear, 2:tanh, 3:tanh0_1, 4:bit, 5:triangle, 6:invtriangle, 7:sin, 8:genome
     std::vector<std::vector<int>> activationFunctions; // activation function for each node
@@ -79,6 +95,32 @@ public:
 
     void applyActivation(double &val, int functionID);
 
+    // activation function for a single value (functionID as in activationFunctions)
+    template <typename T>
+    static inline T activate(T val, int functionID) {
+        switch (functionID) {
+        case 2: // tanh
+            return std::tanh(val);
+        case 3: // tanh(0-1)
+            return std::tanh(val) * (T).5 + (T).5;
+        case 4: // bit
+            return (T)Bit(val);
+        case 5: // triangle
+            return std::max((T)1.0 - std::abs(val * (T)2.0), (T)-1.0);
+        case 6: // invtriangle
+            return std::min(std::abs(val * (T)2.0) - (T)1.0, (T)1.0);
+        case 7: // sin
+            return std::sin(val * (T)3.14159);
+        default: // none / linear
+            return val;
+        }
+    }
+
+    void packWeights();
+    double discretizeRecurrentValue(double value);
+
+    virtual std::shared_ptr<AbstractBrainBatch> makeBatch(const std::vector<std::shared_ptr<AbstractBrain>>& brains) override;
+
     virtual std::shared_ptr<AbstractBrain> makeCopy(std::shared_ptr<ParametersTable> _PT = nullptr) override;
 
 	virtual std::unordered_set<std::string> requiredGenomes() override {
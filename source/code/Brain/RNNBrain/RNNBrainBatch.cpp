@@ -0,0 +1,152 @@
+//  MABE is a product of The Hintze Lab @ MSU
+//     for general research information:
+//         hintzelab.msu.edu
+//     for MABE documentation:
+//         github.com/Hintzelab/MABE/wiki
+//
+//  Copyright (c) 2015 Michigan State University. All rights reserved.
+//     to view the full license, visit:
+//         github.com/Hintzelab/MABE/wiki/License
+
+#include "../RNNBrain/RNNBrainBatch.h"
+#include "../RNNBrain/RNNBrain.h"
+
+RNNBrainBatch::RNNBrainBatch(const std::vector<std::shared_ptr<RNNBrain>>& _brains) : brains(_brains) {
+	batchSize = static_cast<int>(brains.size());
+	auto& first = brains[0];
+	nrInputValues = first->nrInputValues;
+	nrOutputValues = first->nrOutputValues;
+	nrRecurrentValues = first->nrRecurrentValues;
+
+	int layerCount = static_cast<int>(first->nodes.size());
+	for (auto& layer : first->nodes) {
+		layerSizes.push_back(static_cast<int>(layer.size()));
+	}
+
+	values.resize(layerCount);
+	biases.resize(layerCount);
+	activationFunctions.resize(layerCount);
+	weights.resize(layerCount - 1);
+	for (int l = 0; l < layerCount; l++) {
+		values[l].resize((size_t)layerSizes[l] * batchSize);
+		if (l > 0) {
+			biases[l].resize((size_t)layerSizes[l] * batchSize);
+			activationFunctions[l].resize((size_t)layerSizes[l] * batchSize);
+			weights[l - 1].resize((size_t)layerSizes[l - 1] * layerSizes[l] * batchSize);
+		}
+	}
+
+	// interleave brains
+	for (int b = 0; b < batchSize; b++) {
+		auto& brain = brains[b];
+		for (int l = 0; l < layerCount; l++) {
+			for (int j = 0; j < layerSizes[l]; j++) {
+				values[l][j * batchSize + b] = brain->nodes[l][j];
+				if (l > 0) {
+					biases[l][j * batchSize + b] = brain->initialValues[l][j];
+					activationFunctions[l][j * batchSize + b] = brain->activationFunctions[l][j];
+				}
+			}
+			if (l > 0) {
+				for (int i = 0; i < layerSizes[l - 1]; i++) {
+					for (int j = 0; j < layerSizes[l]; j++) {
+						weights[l - 1][((size_t)i * layerSizes[l] + j) * batchSize + b] = brain->weights[l - 1][i][j];
+					}
+				}
+			}
+		}
+	}
+}
+
+void RNNBrainBatch::resetBrains() {
+	for (auto& layer : values) {
+		std::fill(layer.begin(), layer.end(), 0.0);
+	}
+	for (auto& brain : brains) {
+		if (brain->recordActivity && brain->lifeTimes.back() != 0) {
+			brain->lifeTimes.push_back(0);
+		}
+	}
+}
+
+void RNNBrainBatch::update() {
+	// input and hidden have been set so it's time to record state...
+	for (int b = 0; b < batchSize; b++) {
+		auto& brain = brains[b];
+		if (brain->recordActivity) {
+			double* inputState = brain->InputStates.addRow(nrInputValues);
+			for (int i = 0; i < nrInputValues; i++) {
+				inputState[i] = values[0][i * batchSize + b];
+			}
+			if (brain->lifeTimes.back() == 0) {
+				double* hiddenState = brain->HiddenStates.addRow(nrRecurrentValues);
+				for (int i = 0; i < nrRecurrentValues; i++) {
+					hiddenState[i] = values[0][(nrInputValues + i) * batchSize + b];
+				}
+			}
+		}
+	}
+
+	// for every layer (other then input/recurrent) values = activation(bias + prior values * weights)
+	// the inner loops run over brains, so each row of weights is one contiguous run
+	for (size_t layer = 1; layer < values.size(); layer++) {
+		const int inSize = layerSizes[layer - 1];
+		const int outSize = layerSizes[layer];
+		const double* in = values[layer - 1].data();
+		const double* W = weights[layer - 1].data();
+		double* out = values[layer].data();
+		const int rowSize = outSize * batchSize;
+
+		std::copy(biases[layer].begin(), biases[layer].end(), values[layer].begin());
+		for (int i = 0; i < inSize; i++) {
+			const double* x = in + (size_t)i * batchSize;
+			const double* row = W + (size_t)i * rowSize;
+			for (int j = 0; j < outSize; j++) {
+				double* o = out + (size_t)j * batchSize;
+				const double* w = row + (size_t)j * batchSize;
+				for (int b = 0; b < batchSize; b++) {
+					o[b] += w[b] * x[b];
+				}
+			}
+		}
+		const int* functions = activationFunctions[layer].data();
+		for (int k = 0; k < rowSize; k++) {
+			out[k] = RNNBrain::activate(out[k], functions[k]);
+		}
+	}
+
+	// copy recurrent values back to the input layer
+	auto& lastValues = values.back();
+	for (int i = 0; i < nrRecurrentValues; i++) {
+		for (int b = 0; b < batchSize; b++) {
+			values[0][(nrInputValues + i) * batchSize + b] = brains[b]->discretizeRecurrentValue(lastValues[(nrOutputValues + i) * batchSize + b]);
+		}
+	}
+
+	// output and hidden+1 have been set so it's time to record state...
+	for (int b = 0; b < batchSize; b++) {
+		auto& brain = brains[b];
+		if (brain->recordActivity) {
+			double* outputState = brain->OutputStates.addRow(nrOutputValues);
+			for (int i = 0; i < nrOutputValues; i++) {
+				outputState[i] = lastValues[i * batchSize + b];
+			}
+			double* hiddenState = brain->HiddenStates.addRow(nrRecurrentValues);
+			for (int i = 0; i < nrRecurrentValues; i++) {
+				hiddenState[i] = values[0][(nrInputValues + i) * batchSize + b];
+			}
+			brain->lifeTimes.back()++;
+		}
+	}
+}
+
+// copy node values back into the brains
+void RNNBrainBatch::finish() {
+	for (int b = 0; b < batchSize; b++) {
+		for (size_t l = 0; l < values.size(); l++) {
+			for (int j = 0; j < layerSizes[l]; j++) {
+				brains[b]->nodes[l][j] = values[l][j * batchSize + b];
+			}
+		}
+	}
+}
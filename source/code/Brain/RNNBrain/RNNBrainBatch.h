@@ -0,0 +1,61 @@
+//  MABE is a product of The Hintze Lab @ MSU
+//     for general research information:
+//         hintzelab.msu.edu
+//     for MABE documentation:
+//         github.com/Hintzelab/MABE/wiki
+//
+//  Copyright (c) 2015 Michigan State University. All rights reserved.
+//     to view the full license, visit:
+//         github.com/Hintzelab/MABE/wiki/License
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "../AbstractBrain.h"
+
+class RNNBrain;
+
+// a batch of RNN brains with the same shape (see RNNBrain::makeBatch)
+// weights, biases and node values of all brains are interleaved so that brain is the
+// innermost index (i.e. values[layer][node * batchSize + brain]). Each step of update then
+// runs over all brains at once, while each brain still sums it's inputs in the same order
+// as RNNBrain::update, so results are the same as updating each brain on it's own.
+class RNNBrainBatch : public AbstractBrainBatch {
+public:
+	std::vector<std::shared_ptr<RNNBrain>> brains;
+	int batchSize;
+
+	int nrInputValues;
+	int nrOutputValues;
+	int nrRecurrentValues;
+
+	std::vector<int> layerSizes;
+	std::vector<std::vector<double>> weights; // [layer-1][(i * layerSizes[layer] + j) * batchSize + b]
+	std::vector<std::vector<double>> biases; // [layer][j * batchSize + b] (layer 0 is empty)
+	std::vector<std::vector<int>> activationFunctions; // [layer][j * batchSize + b] (layer 0 is empty)
+	std::vector<std::vector<double>> values; // [layer][j * batchSize + b]
+
+	RNNBrainBatch() = delete;
+	RNNBrainBatch(const std::vector<std::shared_ptr<RNNBrain>>& _brains);
+	virtual ~RNNBrainBatch() = default;
+
+	virtual int size() override {
+		return batchSize;
+	}
+
+	virtual void resetBrains() override;
+
+	virtual void setInput(int brain, int inputAddress, double value) override {
+		values[0][inputAddress * batchSize + brain] = value;
+	}
+
+	virtual double readOutput(int brain, int outputAddress) override {
+		return values.back()[outputAddress * batchSize + brain];
+	}
+
+	virtual void update() override;
+
+	virtual void finish() override;
+};
@@ -10,6 +10,8 @@
 
 #include "WireBrain.h"
 
+#include <algorithm>
+
 std::shared_ptr<ParameterLink<bool>> WireBrain::allowNegativeChargePL =
     Parameters::register_parameter("BRAIN_WIRE-allowNegativeCharge", false,
                                    "if true, wire brain can interpret negative "
@@ -751,7 +753,6 @@ std::shared_ptr<AbstractBrain> WireBrain::makeBrain(
 
 void WireBrain::initialize() {
   allCells.resize(width * depth * height);
-  nextAllCells.resize(width * depth * height);
   neighbors.resize(width * depth * height);
 
   nodesAddresses.resize(nrValues);
@@ -1050,6 +1051,7 @@ void WireBrain::connectPruneAndSetPopColumns(
     newAllCells[w] = 1;
   }
   swap(newAllCells, allCells);
+  buildCellPlanes();
 
   // displayBrainState();
 
@@ -1062,54 +1064,286 @@ void WireBrain::connectPruneAndSetPopColumns(
   popFileColumns.push_back("wireBrainConnectionsCount");
 }
 
-void WireBrain::chargeUpdate() {
-  // std::cout << "in chargeUpdate()" << endl;
-  // int wireCount = 0;
-  // int evalCount = 0;
-  // int evalToCharge = 0;
-  // int evalToDecay = 0;
-  // int evalToWire = 0;
+// bit plane helpers, a "plane" is one bit of a value for 64 cells at a time
+
+// destination bit t = source bit t + offset (0 if outside of source)
+static void shiftCells(const uint64_t *source, uint64_t *destination,
+                       int words, int offset) {
+  int wordShift = offset >= 0 ? offset / 64 : -((63 - offset) / 64);
+  int bitShift = offset - wordShift * 64;
+  for (int w = 0; w < words; w++) {
+    int s = w + wordShift;
+    uint64_t low = (s >= 0 && s < words) ? source[s] : 0;
+    uint64_t high = (s + 1 >= 0 && s + 1 < words) ? source[s + 1] : 0;
+    destination[w] =
+        bitShift == 0 ? low : (low >> bitShift) | (high << (64 - bitShift));
+  }
+}
 
-  nextAllCells = allCells;
+// sum = a + b, one word of each plane (missing planes are 0, overflow past
+// sumBits is dropped)
+static void addPlanes(const uint64_t *a, int aBits, const uint64_t *b,
+                      int bBits, uint64_t *sum, int sumBits) {
+  uint64_t carry = 0;
+  for (int p = 0; p < sumBits; p++) {
+    uint64_t x = p < aBits ? a[p] : 0;
+    uint64_t y = p < bBits ? b[p] : 0;
+    sum[p] = x ^ y ^ carry;
+    carry = (x & y) | (carry & (x ^ y));
+  }
+}
 
-  // propagate charge in the brain
-  int chargeCount;
-  for (auto cellAddress : wireAddresses) {
-    // wireCount++;
-    if (allCells[cellAddress] == WIRE) {
-      chargeCount = 0;
-      int nc = (int)neighbors[cellAddress].size() -
-               1; // get the number of neighbors which are wire
-      while (nc >= 0 &&
-             chargeCount < overchargeThreshold) { // for each neighbor
-        if (allCells[neighbors[cellAddress][nc]] ==
-            CHARGE) { // if that neighbor is charged
-          chargeCount++;
-          nextAllCells[cellAddress] = CHARGE; // set this WIRE to CHARGE
-        }
-        nc--;
+// cells where value (unsigned) < constant
+static uint64_t lessThan(const uint64_t *value, int bits, int constant) {
+  if (constant <= 0) {
+    return 0;
+  }
+  if (constant >= (1 << bits)) {
+    return ~0ull;
+  }
+  uint64_t less = 0;
+  uint64_t equal = ~0ull;
+  for (int p = bits - 1; p >= 0; p--) {
+    if ((constant >> p) & 1) {
+      less |= equal & ~value[p];
+      equal &= value[p];
+    } else {
+      equal &= ~value[p];
+    }
+  }
+  return less;
+}
+
+// cells where value (two's complement) == constant
+static uint64_t equalTo(const uint64_t *value, int bits, int constant) {
+  uint64_t equal = ~0ull;
+  for (int p = 0; p < bits; p++) {
+    equal &= (((unsigned)constant >> p) & 1) ? value[p] : ~value[p];
+  }
+  return equal;
+}
+
+// all ones if bit p of constant is set
+static uint64_t constantPlane(int constant, int p) {
+  return (((unsigned)constant >> p) & 1) ? ~0ull : 0;
+}
+
+static const int countBits = 5; // enough for 26 neighbors
+
+void WireBrain::buildCellPlanes() {
+  int cellCount = (int)allCells.size(); // 0 if this brain was never built
+  cellWords = (cellCount + 63) / 64;
+  // room for NEGCHARGE - 1 to CHARGE + 1
+  statePlanes = 2;
+  while ((1 << (statePlanes - 1)) - 1 < std::abs(CHARGE) + 1) {
+    statePlanes++;
+  }
+  cellPlanes.assign(statePlanes * cellWords, 0);
+  nextCellPlanes.assign(statePlanes * cellWords, 0);
+  wireMask.assign(cellWords, 0);
+  notFirstX.assign(cellWords, 0);
+  notLastX.assign(cellWords, 0);
+  notFirstY.assign(cellWords, 0);
+  notLastY.assign(cellWords, 0);
+  for (int l = 0; l < cellCount; l++) {
+    int cellX = (l % (width * height)) % width;
+    int cellY = (l % (width * height)) / width;
+    uint64_t bit = 1ull << (l % 64);
+    notFirstX[l / 64] |= cellX > 0 ? bit : 0;
+    notLastX[l / 64] |= cellX < width - 1 ? bit : 0;
+    notFirstY[l / 64] |= cellY > 0 ? bit : 0;
+    notLastY[l / 64] |= cellY < height - 1 ? bit : 0;
+    setCellValue(cellPlanes, l, allCells[l]);
+  }
+  for (auto w : wireAddresses) {
+    wireMask[w / 64] |= 1ull << (w % 64);
+  }
+
+  // every wired cell in the 3x3x3 cube around a cell is counted by shifting,
+  // anything else in neighbors (wormholes, and wormholes that doubled a
+  // neighbor) is counted one by one
+  wormholeTargets.clear();
+  wormholeSources.clear();
+  for (auto l : wireAddresses) {
+    std::vector<int> shifted, extra;
+    for (auto n : neighbors[l]) {
+      int layer = width * height;
+      bool adjacent = n != l && std::abs(n % width - l % width) <= 1 &&
+                      std::abs(n % layer / width - l % layer / width) <= 1 &&
+                      std::abs(n / layer - l / layer) <= 1;
+      if (adjacent &&
+          std::find(shifted.begin(), shifted.end(), n) == shifted.end()) {
+        shifted.push_back(n);
+      } else {
+        extra.push_back(n);
       }
-      if (chargeCount >= overchargeThreshold) {
-        nextAllCells[cellAddress] = WIRE; // if overcharged, change back to WIRE
-        // evalToCharge++;
+    }
+    if (!extra.empty()) {
+      wormholeTargets.push_back(l);
+      wormholeSources.push_back(extra);
+    }
+  }
+
+  chargedCells.assign(cellWords, 0);
+  negChargedCells.assign(cellWords, 0);
+  chargedCounts.assign(countBits * cellWords, 0);
+  negChargedCounts.assign(countBits * cellWords, 0);
+  neighborScratch.assign(20 * cellWords, 0);
+}
+
+int WireBrain::cellValue(const std::vector<uint64_t> &planes, int cell) const {
+  unsigned value = 0;
+  for (int p = 0; p < statePlanes; p++) {
+    value |= (unsigned)((planes[p * cellWords + cell / 64] >> (cell % 64)) & 1)
+             << p;
+  }
+  if ((value >> (statePlanes - 1)) & 1) { // negative
+    value |= ~0u << statePlanes;
+  }
+  return (int)value;
+}
+
+void WireBrain::setCellValue(std::vector<uint64_t> &planes, int cell,
+                             int value) {
+  uint64_t bit = 1ull << (cell % 64);
+  for (int p = 0; p < statePlanes; p++) {
+    auto &word = planes[p * cellWords + cell / 64];
+    word = (((unsigned)value >> p) & 1) ? word | bit : word & ~bit;
+  }
+}
+
+// counts (countBits planes) gets the number of marked cells in the 3x3x3 cube
+// around each cell. Summed a row, then a column and then a layer at a time.
+void WireBrain::countNeighbors(const uint64_t *marked, uint64_t *counts) {
+  const int words = cellWords;
+  uint64_t *left = neighborScratch.data();
+  uint64_t *right = left + words;
+  uint64_t *rows = right + words;      // 2 planes
+  uint64_t *below = rows + 2 * words;  // 2 planes
+  uint64_t *above = below + 2 * words; // 2 planes
+  uint64_t *columns = above + 2 * words; // 4 planes
+  uint64_t *back = columns + 4 * words;  // 4 planes
+  uint64_t *front = back + 4 * words;    // 4 planes
+  uint64_t a[countBits], b[countBits], c[countBits], sum[countBits];
+
+  if (std::all_of(marked, marked + words, [](uint64_t m) { return m == 0; })) {
+    std::fill(counts, counts + countBits * words, 0);
+    return;
+  }
+  shiftCells(marked, left, words, -1);
+  shiftCells(marked, right, words, 1);
+  for (int w = 0; w < words; w++) {
+    uint64_t l = left[w] & notFirstX[w];
+    uint64_t r = right[w] & notLastX[w];
+    rows[w] = l ^ r ^ marked[w];
+    rows[words + w] = (l & r) | (marked[w] & (l ^ r));
+  }
+
+  for (int p = 0; p < 2; p++) {
+    shiftCells(rows + p * words, below + p * words, words, -width);
+    shiftCells(rows + p * words, above + p * words, words, width);
+  }
+  for (int w = 0; w < words; w++) {
+    for (int p = 0; p < 2; p++) {
+      a[p] = rows[p * words + w];
+      b[p] = below[p * words + w] & notFirstY[w];
+      c[p] = above[p * words + w] & notLastY[w];
+    }
+    addPlanes(a, 2, b, 2, sum, 3);
+    addPlanes(sum, 3, c, 2, a, 4);
+    for (int p = 0; p < 4; p++) {
+      columns[p * words + w] = a[p];
+    }
+  }
+
+  for (int p = 0; p < 4; p++) {
+    shiftCells(columns + p * words, back + p * words, words,
+               -width * height);
+    shiftCells(columns + p * words, front + p * words, words, width * height);
+  }
+  for (int w = 0; w < words; w++) {
+    for (int p = 0; p < 4; p++) {
+      a[p] = columns[p * words + w];
+      b[p] = back[p * words + w];
+      c[p] = front[p * words + w];
+    }
+    addPlanes(a, 4, b, 4, sum, countBits);
+    addPlanes(sum, countBits, c, 4, a, countBits);
+    uint64_t borrow = marked[w]; // a cell is not it's own neighbor
+    for (int p = 0; p < countBits; p++) {
+      counts[p * words + w] = a[p] ^ borrow;
+      borrow &= ~a[p];
+    }
+  }
+}
+
+// value of one cell in count planes
+static int countAt(const std::vector<uint64_t> &counts, int words, int cell) {
+  int count = 0;
+  for (int p = 0; p < countBits; p++) {
+    count |= (int)((counts[p * words + cell / 64] >> (cell % 64)) & 1) << p;
+  }
+  return count;
+}
+
+void WireBrain::chargeUpdate() {
+  const int words = cellWords;
+  uint64_t value[32], count[countBits];
+
+  // propagate charge in the brain
+  for (int w = 0; w < words; w++) {
+    for (int p = 0; p < statePlanes; p++) {
+      value[p] = cellPlanes[p * words + w];
+    }
+    chargedCells[w] = wireMask[w] & equalTo(value, statePlanes, CHARGE);
+  }
+  countNeighbors(chargedCells.data(), chargedCounts.data());
+  for (int w = 0; w < words; w++) {
+    for (int p = 0; p < statePlanes; p++) {
+      value[p] = cellPlanes[p * words + w];
+    }
+    for (int p = 0; p < countBits; p++) {
+      count[p] = chargedCounts[p * words + w];
+    }
+    // WIRE with at least one and less then overchargeThreshold charged
+    // neighbors is charged, if overcharged it stays WIRE
+    uint64_t isWire = wireMask[w] & equalTo(value, statePlanes, WIRE);
+    uint64_t toCharge = isWire & ~lessThan(count, countBits, 1) &
+                        lessThan(count, countBits, overchargeThreshold);
+    // this wire is currently either charged or in decay
+    uint64_t decaying = wireMask[w] & ~isWire;
+    uint64_t borrow = ~0ull;
+    for (int p = 0; p < statePlanes; p++) {
+      uint64_t decayed = value[p] ^ borrow;
+      borrow &= ~value[p];
+      nextCellPlanes[p * words + w] =
+          (value[p] & ~(decaying | toCharge)) | (decayed & decaying) |
+          (toCharge & constantPlane(CHARGE, p));
+    }
+  }
+  for (size_t i = 0; i < wormholeTargets.size(); i++) {
+    int cell = wormholeTargets[i];
+    if (cellValue(cellPlanes, cell) == WIRE) {
+      int chargeCount = countAt(chargedCounts, words, cell);
+      for (auto n : wormholeSources[i]) {
+        chargeCount += cellValue(cellPlanes, n) == CHARGE;
       }
-      // std::cout << "  " << cellAddress << " " << nextAllCells[cellAddress] <<
-      // endl;
-    } else { // this wire is currently either charged or in decay
-      nextAllCells[cellAddress] = allCells[cellAddress] - 1;
+      setCellValue(nextCellPlanes, cell,
+                   (chargeCount > 0 && chargeCount < overchargeThreshold)
+                       ? CHARGE
+                       : WIRE);
     }
   }
-  allCells = nextAllCells;
+  swap(cellPlanes, nextCellPlanes);
 
   // if constantInputs, rechage the inputs
   if (constantInputs) {
     for (int i = 0; i < nrValues; i++) { // for each input cell
-      // evalCount++;
-      if (nodes[i] != 0) { // if this node is on
-        if (allCells[nodesAddresses[i]] !=
+      if (nodes[i] != 0) {               // if this node is on
+        if (cellValue(cellPlanes, nodesAddresses[i]) !=
             HOLLOW) { // if the connected location is uncharged wireAddresses...
-          allCells[nodesAddresses[i]] = CHARGE * Bit(nodes[i]); // charge it.
-          // evalToCharge++;
+          setCellValue(cellPlanes, nodesAddresses[i],
+                       CHARGE * Bit(nodes[i])); // charge it.
         }
       }
     }
@@ -1117,84 +1351,88 @@ void WireBrain::chargeUpdate() {
   // read and accumulate outputs
   // NOTE: output cells can go into charge/decay sets
   for (int i = 0; i < nrValues; i++) {
-    nextNodes[i] = nextNodes[i] + (allCells[nodesNextAddresses[i]] == CHARGE);
+    nextNodes[i] = nextNodes[i] +
+                   (cellValue(cellPlanes, nodesNextAddresses[i]) == CHARGE);
   }
 }
 
 void WireBrain::chargeUpdateTrit() {
-  // std::cout << "in chargeUpdate()" << endl;
-  // int wireCount = 0;
-  // int evalCount = 0;
-  // int evalToCharge = 0;
-  // int evalToDecay = 0;
-  // int evalToWire = 0;
-
-  nextAllCells = allCells;
+  const int words = cellWords;
+  uint64_t value[32], positive[countBits], negative[countBits],
+      balance[countBits + 1];
 
   // propagate charge in the brain
-  int chargeCount;
-  for (auto cellAddress : wireAddresses) {
-    // wireCount++;
-    nextAllCells[cellAddress] = 1;
-    if (allCells[cellAddress] == WIRE) {
-      chargeCount = 0;
-      //				int nc = (int)
-      //neighbors[cellAddress].size() - 1;  // get the number of neighbors which
-      //are wire
-      //				while (nc >= 0) {  // for each neighbor
-      //					if
-      //(allCells[neighbors[cellAddress][nc]] == CHARGE) {  // if that neighbor
-      //is charged
-      //						chargeCount++;
-      //						//nextAllCells[cellAddress]
-      //= CHARGE;  // set this WIRE to CHARGE
-      //					}
-      //					if
-      //(allCells[neighbors[cellAddress][nc]] == NEGCHARGE) {  // if that
-      //neighbor is charged
-      //						chargeCount--;
-      //						//nextAllCells[cellAddress]
-      //= CHARGE;  // set this WIRE to CHARGE
-      //					}
-      //					nc--;
-      //				}
-
-      for (auto n : neighbors[cellAddress]) {
-        if (allCells[n] == CHARGE) { // if that neighbor is charged
-          chargeCount++;
-          // nextAllCells[cellAddress] = CHARGE;  // set this WIRE to CHARGE
-        }
-        if (allCells[n] == NEGCHARGE) { // if that neighbor is charged
-          chargeCount--;
-          // nextAllCells[cellAddress] = CHARGE;  // set this WIRE to CHARGE
-        }
+  for (int w = 0; w < words; w++) {
+    for (int p = 0; p < statePlanes; p++) {
+      value[p] = cellPlanes[p * words + w];
+    }
+    chargedCells[w] = wireMask[w] & equalTo(value, statePlanes, CHARGE);
+    negChargedCells[w] = wireMask[w] & equalTo(value, statePlanes, NEGCHARGE);
+  }
+  countNeighbors(chargedCells.data(), chargedCounts.data());
+  countNeighbors(negChargedCells.data(), negChargedCounts.data());
+  for (int w = 0; w < words; w++) {
+    for (int p = 0; p < statePlanes; p++) {
+      value[p] = cellPlanes[p * words + w];
+    }
+    for (int p = 0; p < countBits; p++) {
+      positive[p] = chargedCounts[p * words + w];
+      negative[p] = ~negChargedCounts[p * words + w];
+    }
+    // balance = charged - negatively charged neighbors + 31
+    addPlanes(positive, countBits, negative, countBits, balance,
+              countBits + 1);
+    uint64_t isWire = wireMask[w] & equalTo(value, statePlanes, WIRE);
+    uint64_t isNegCharge = wireMask[w] & equalTo(value, statePlanes, NEGCHARGE);
+    uint64_t toCharge =
+        isWire & ~lessThan(balance, countBits + 1, 32) &
+        lessThan(balance, countBits + 1, 31 + overchargeThreshold);
+    uint64_t toNegCharge =
+        isWire & lessThan(balance, countBits + 1, 31) &
+        ~lessThan(balance, countBits + 1, 32 - overchargeThreshold);
+    uint64_t stayWire = isWire & ~(toCharge | toNegCharge);
+    // this wire is currently either charged or in decay
+    uint64_t decaying = wireMask[w] & ~isWire & ~isNegCharge;
+    uint64_t borrow = ~0ull;
+    for (int p = 0; p < statePlanes; p++) {
+      uint64_t decayed = value[p] ^ borrow;
+      borrow &= ~value[p];
+      nextCellPlanes[p * words + w] =
+          (value[p] & ~wireMask[w]) | (decayed & decaying) |
+          (stayWire & constantPlane(WIRE, p)) |
+          (toCharge & constantPlane(CHARGE, p)) |
+          (toNegCharge & constantPlane(NEGCHARGE, p)) |
+          (isNegCharge & constantPlane(CHARGE - 1, p));
+    }
+  }
+  for (size_t i = 0; i < wormholeTargets.size(); i++) {
+    int cell = wormholeTargets[i];
+    if (cellValue(cellPlanes, cell) == WIRE) {
+      int chargeCount = countAt(chargedCounts, words, cell) -
+                        countAt(negChargedCounts, words, cell);
+      for (auto n : wormholeSources[i]) {
+        int neighborValue = cellValue(cellPlanes, n);
+        chargeCount += (neighborValue == CHARGE) - (neighborValue == NEGCHARGE);
       }
+      int next = WIRE;
       if (chargeCount > 0 && chargeCount < overchargeThreshold) {
-        nextAllCells[cellAddress] =
-            CHARGE; // if overcharged, change back to WIRE
-        // evalToCharge++;
+        next = CHARGE;
       } else if (chargeCount < 0 && chargeCount > (overchargeThreshold * -1)) {
-        nextAllCells[cellAddress] = NEGCHARGE;
+        next = NEGCHARGE;
       }
-      // std::cout << "  " << cellAddress << " " << nextAllCells[cellAddress] <<
-      // endl;
-    } else if (allCells[cellAddress] == NEGCHARGE) {
-      nextAllCells[cellAddress] = CHARGE - 1;
-    } else { // this wire is currently either charged or in decay
-      nextAllCells[cellAddress] = allCells[cellAddress] - 1;
+      setCellValue(nextCellPlanes, cell, next);
     }
   }
-  allCells = nextAllCells;
+  swap(cellPlanes, nextCellPlanes);
 
   // if constantInputs, rechage the inputs
   if (constantInputs) {
     for (int i = 0; i < nrValues; i++) { // for each input cell
-      // evalCount++;
-      if (nodes[i] != 0) { // if this node is on
-        if (allCells[nodesAddresses[i]] !=
+      if (nodes[i] != 0) {               // if this node is on
+        if (cellValue(cellPlanes, nodesAddresses[i]) !=
             HOLLOW) { // if the connected location is uncharged wireAddresses...
-          allCells[nodesAddresses[i]] = CHARGE * Trit(nodes[i]); // charge it.
-          // evalToCharge++;
+          setCellValue(cellPlanes, nodesAddresses[i],
+                       CHARGE * Trit(nodes[i])); // charge it.
         }
       }
     }
@@ -1202,11 +1440,7 @@ void WireBrain::chargeUpdateTrit() {
   // read and accumulate outputs
   // NOTE: output cells can go into charge/decay sets
   for (int i = 0; i < nrValues; i++) {
-    // std::cout << i << " " << nodesNextAddresses[i] << " " << nodesNext[i]
-    // <<endl;
-    nextNodes[i] = nextNodes[i] + allCells[nodesNextAddresses[i]];
-    // std::cout << i << " " << nodesNextAddresses[i] << " " << nodesNext[i]
-    // <<endl;
+    nextNodes[i] = nextNodes[i] + cellValue(cellPlanes, nodesNextAddresses[i]);
   }
 }
 
@@ -1255,24 +1489,25 @@ void WireBrain::update() {
       // std::cout << endl;
     } else { // we have not seen this input value enough times, and we will need
              // to actually do the work
-      for (auto w : wireAddresses) { // clear out any wire that is charged or
-                                     // decay from last update
-        allCells[w] = 1;
-      }
+      // clear out any wire that is charged or decay from last update
+      std::fill(cellPlanes.begin(), cellPlanes.end(), 0);
+      std::copy(wireMask.begin(), wireMask.end(),
+                cellPlanes.begin()); // bit 0 of WIRE
       for (int i = 0; i < nrValues; i++) { // set up inputs and outputs
         nextNodes[i] = 0;                  // reset all nodesNext
         if (!allowNegativeCharge) {
           if (Bit(nodes[i]) == 1 &&
-              allCells[nodesAddresses[i]] ==
+              cellValue(cellPlanes, nodesAddresses[i]) ==
                   WIRE) { // for each node if it is on and connects to wire
-            allCells[nodesAddresses[i]] = CHARGE; // charge the wire
+            setCellValue(cellPlanes, nodesAddresses[i],
+                         CHARGE); // charge the wire
           }
         } else {
           if (Trit(nodes[i]) != 0 &&
-              allCells[nodesAddresses[i]] ==
+              cellValue(cellPlanes, nodesAddresses[i]) ==
                   WIRE) { // for each node if it is on and connects to wire
-            allCells[nodesAddresses[i]] =
-                CHARGE * Trit(nodes[i]); // charge the wire
+            setCellValue(cellPlanes, nodesAddresses[i],
+                         CHARGE * Trit(nodes[i])); // charge the wire
           }
         }
         //// for testing only!!!////
@@ -1289,7 +1524,7 @@ void WireBrain::update() {
           chargeUpdateTrit();
         }
         if (recordActivity) {
-          SaveBrainState(recordActivityFileName);
+          SaveBrainState("wireBrain.run");
         }
       }
       //////
@@ -1324,24 +1559,25 @@ void WireBrain::update() {
             chargeUpdate();
     }
     */
-    for (auto w : wireAddresses) { // clear out any wire that is charged or
-                                   // decay from last update
-      allCells[w] = 1;
-    }
+    // clear out any wire that is charged or decay from last update
+    std::fill(cellPlanes.begin(), cellPlanes.end(), 0);
+    std::copy(wireMask.begin(), wireMask.end(),
+              cellPlanes.begin()); // bit 0 of WIRE
     for (int i = 0; i < nrValues; i++) { // set up inputs and outputs
       nextNodes[i] = 0;                  // reset all nodesNext
       if (!allowNegativeCharge) {
         if (Bit(nodes[i]) == 1 &&
-            allCells[nodesAddresses[i]] ==
+            cellValue(cellPlanes, nodesAddresses[i]) ==
                 WIRE) { // for each node if it is on and connects to wire
-          allCells[nodesAddresses[i]] = CHARGE; // charge the wire
+          setCellValue(cellPlanes, nodesAddresses[i],
+                       CHARGE); // charge the wire
         }
       } else {
         if (Trit(nodes[i]) != 0 &&
-            allCells[nodesAddresses[i]] ==
+            cellValue(cellPlanes, nodesAddresses[i]) ==
                 WIRE) { // for each node if it is on and connects to wire
-          allCells[nodesAddresses[i]] =
-              CHARGE * Trit(nodes[i]); // charge the wire
+          setCellValue(cellPlanes, nodesAddresses[i],
+                       CHARGE * Trit(nodes[i])); // charge the wire
         }
       }
       //// for testing only!!!////
@@ -1358,7 +1594,7 @@ void WireBrain::update() {
         chargeUpdateTrit();
       }
       if (recordActivity) {
-        SaveBrainState(recordActivityFileName);
+        SaveBrainState("wireBrain.run");
       }
     }
   }
@@ -1390,7 +1626,8 @@ void WireBrain::SaveBrainState(std::string fileName) {
 
   std::string stateNow = "";
 
-  for (auto cell : allCells) {
+  for (int l = 0; l < (int)allCells.size(); l++) {
+    int cell = cellValue(cellPlanes, l);
     if (cell == 0) {
       stateNow += "E";
     } else if (cell == 1) {
@@ -1442,7 +1679,8 @@ void WireBrain::displayBrainState() {
   int w = 0;
   int d = 0;
 
-  for (auto cell : allCells) {
+  for (int l = 0; l < (int)allCells.size(); l++) {
+    int cell = cellValue(cellPlanes, l);
     if (cell == 0) {
       std::cout << " ";
     } else if (cell == 1) {
@@ -1539,6 +1777,7 @@ WireBrain::makeCopy(std::shared_ptr<ParametersTable> PT_) {
   newBrain->inputLookUpTable = inputLookUpTable;
   newBrain->inputCount = inputCount;
   newBrain->connectionsCount = connectionsCount;
+  newBrain->buildCellPlanes();
 
   newBrain->nrValues = nrValues;
 
@@ -11,6 +11,7 @@
 #pragma once
 
 #include <cmath>
+#include <cstdint>
 #include <memory>
 #include <iostream>
 #include <set>
@@ -117,13 +118,31 @@ public:
   std::vector<int> nodesAddresses,
       nodesNextAddresses; // where the nodes connect to the brain
 
-  std::vector<int> allCells, nextAllCells; // list of all cells in this brain
+  std::vector<int> allCells; // layout of all cells in this brain (WIRE or
+                             // HOLLOW), the charge state is in cellPlanes
   std::vector<std::vector<int>>
       neighbors; // for every cell list of wired neighbors (most will be empty)
   std::vector<int> wireAddresses; // list of addresses for all cells which are
                                   // wireAddresses (uncharged, charged and
                                   // decay)
 
+  // charge state of every cell as bit planes, plane p holds bit p of every
+  // cells (two's complement) value, cell l is bit l % 64 of word l / 64.
+  // charge updates write nextCellPlanes and then swap.
+  int cellWords = 0;   // words in one plane
+  int statePlanes = 0; // bits in a cell value
+  std::vector<uint64_t> cellPlanes, nextCellPlanes;
+  std::vector<uint64_t> wireMask; // cells in wireAddresses
+  // cells which have a neighbor on that side in the cube
+  std::vector<uint64_t> notFirstX, notLastX, notFirstY, notLastY;
+  // neighbors which can not be found by shifting planes (i.e. wormholes),
+  // wormholeSources[i] are the extra neighbors of cell wormholeTargets[i]
+  std::vector<int> wormholeTargets;
+  std::vector<std::vector<int>> wormholeSources;
+  // scratch space for charge updates
+  std::vector<uint64_t> chargedCells, negChargedCells;
+  std::vector<uint64_t> chargedCounts, negChargedCounts, neighborScratch;
+
   std::vector<std::vector<long>>
       inputLookUpTable;        // table that contains output for a given input
   std::vector<int> inputCount; // table that contains a count of the number of
@@ -155,6 +174,10 @@ public:
   virtual std::shared_ptr<AbstractBrain>
   makeCopy(std::shared_ptr<ParametersTable> PT_ = nullptr) override;
 
+  virtual void buildCellPlanes();
+  int cellValue(const std::vector<uint64_t> &planes, int cell) const;
+  void setCellValue(std::vector<uint64_t> &planes, int cell, int value);
+  void countNeighbors(const uint64_t *marked, uint64_t *counts);
   virtual void chargeUpdate();
   virtual void chargeUpdateTrit();
   virtual void update() override;
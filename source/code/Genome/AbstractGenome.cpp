@@ -28,3 +28,17 @@ std::shared_ptr<ParameterLink<std::string>> AbstractGenome::genomeSitesTypePL =
                                                                // parameter for
                                                                // outputMethod;
 
+void AbstractGenome::saveCheckpoint(CheckpointWriter &checkpoint,
+                                    std::string &name) {
+  serializeBinary(name).saveCheckpoint(checkpoint);
+  dataMap.saveCheckpoint(checkpoint);
+}
+
+void AbstractGenome::loadCheckpoint(CheckpointReader &checkpoint,
+                                    std::string &name) {
+  DataMap serialDataMap;
+  serialDataMap.loadCheckpoint(checkpoint);
+  auto orgData = serialDataMap.getStringMap();
+  deserialize(PT, orgData, name);
+  dataMap.loadCheckpoint(checkpoint);
+}
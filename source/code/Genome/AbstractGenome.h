@@ -19,6 +19,7 @@
 #include <utility>
 
 #include <Utilities/Utilities.h>
+#include <Utilities/Checkpoint.h>
 #include <Utilities/Data.h>
 #include <Utilities/Parameters.h>
 #include <Utilities/Random.h>
@@ -120,6 +121,9 @@ public:
 
     virtual void printIndex() = 0;
 
+    // the site the next read will start at (or -1 if this genome does not have a single site index)
+    virtual int getSiteIndex() { return -1; }
+
     virtual bool inTelomere(int length) { return false; }
 
     virtual void randomize() = 0;
@@ -173,6 +177,11 @@ public:
     exit(1);
   }
 
+  // like serialize, but for binary organism archives (see OrganismArchive.h).
+  // genomes may store their sites as raw bytes in [name]_sitesBinary (which
+  // deserialize must then accept). the default is to use serialize.
+  virtual DataMap serializeBinary(std::string &name) { return serialize(name); }
+
   // given a an unordered_map<string, string> and PT, load data into this genome
   virtual void deserialize(std::shared_ptr<ParametersTable> PT,
                            std::unordered_map<std::string, std::string> &orgData,
@@ -182,6 +191,13 @@ public:
     exit(1);
   }
 
+  // save / load everything needed to continue a run with this genome (see
+  // Utilities/Checkpoint.h). the default uses serializeBinary and deserialize
+  // and keeps dataMap. genomes with state that serialize does not write (i.e.
+  // mutation counts) should override these and call them.
+  virtual void saveCheckpoint(CheckpointWriter &checkpoint, std::string &name);
+  virtual void loadCheckpoint(CheckpointReader &checkpoint, std::string &name);
+
   virtual std::string genomeToStr() {
     std::cout << "Warning! In AbstractGenome::genomeToStr()...\n";
     return "";
@@ -235,5 +251,22 @@ public:
   }
 
   virtual void recordDataMap() = 0;
+
+  // start codon index (used by ClassicGateListBuilder)
+  // startCodes[first] is the second codon value of the start codon which begins with first (or -1)
+  // and codonMax is startCodes.size() - 1. returns the (ordered) list of sites p where the codon
+  // values (as read by readInt(0, codonMax)) at p and p+1 are a start codon, or nullptr if this
+  // genome can not index start codons (in which case the genome must be scanned)
+  virtual const std::vector<int> *getStartCodonSites(const std::vector<int> &startCodes) {
+    return nullptr;
+  }
+
+  // mutation log (used by MarkovBrain to reuse gates from the parent brain)
+  // if this genome was made by makeMutatedGenomeFrom and has only been changed by point mutations
+  // since, changedSites is set to the sites those mutations changed (unordered, may repeat) and the
+  // genome it was made from is returned. otherwise returns nullptr
+  virtual std::shared_ptr<AbstractGenome> getPointMutations(std::vector<int> &changedSites) {
+    return nullptr;
+  }
 };
 
@@ -12,6 +12,7 @@
 #include <Global.h>
 #include <cmath> // std::nextbefore
 #include <cfloat> // DBL_MAX
+#include <cstring> // std::memcpy
 
 // Initialize Parameters
 std::shared_ptr<ParameterLink<int>> CircularGenomeParameters::sizeInitialPL = Parameters::register_parameter("GENOME_CIRCULAR-sizeInitial", 5000, "starting size for genome");
@@ -220,8 +221,9 @@ void CircularGenome<T>::Handler::writeInt(int value, int valueMin, int valueMax)
 		writeValueBase = (int)((double)writeValueBase / genome->alphabetSize);
 	}
 	decomposedValue.push_back(value);
+	genome->clearSiteTracking();
 	while ((int)decomposedValue.size() > 0) {  // starting with the last element in decomposedValue, copy into genome.
-		genome->sites[siteIndex] = decomposedValue[(int)decomposedValue.size() - 1];
+		genome->sites.set(siteIndex, decomposedValue[(int)decomposedValue.size() - 1]);
 		advanceIndex();
 		decomposedValue.pop_back();
 	}
@@ -242,7 +244,8 @@ void CircularGenome<double>::Handler::writeInt(int value, int valueMin, int valu
 	//	cout << "ERROR : attempting to write value to <double> Circular Genome. \n value is too large!" << endl;
 	//	exit(1);
 	//}
-	genome->sites[siteIndex] = (((double)(value - valueMin) / (double)(valueMax - valueMin)) * genome->alphabetSize);
+	genome->clearSiteTracking();
+	genome->sites.set(siteIndex, (((double)(value - valueMin) / (double)(valueMax - valueMin)) * genome->alphabetSize));
 	advanceIndex();
 }
 
@@ -264,7 +267,8 @@ void CircularGenome<T>::Handler::writeDouble(double value, double valueMin, doub
 	//std::cout << value << "   " << valueMax << "   " << valueMin << " = ";
 	value = ((value - valueMin) / (valueMax - valueMin)) * (genome->alphabetSize - 1.0);
 	//std::cout << value << std::endl;
-	genome->sites[siteIndex] = (T)value;
+	genome->clearSiteTracking();
+	genome->sites.set(siteIndex, (T)value);
 	advanceIndex();
 }
 
@@ -280,7 +284,8 @@ void CircularGenome<double>::Handler::writeDouble(double value, double valueMin,
 		exit(1);
 	}
 	value = ((value - valueMin) / (valueMax - valueMin)) * genome->alphabetSize;
-	genome->sites[siteIndex] = value;
+	genome->clearSiteTracking();
+	genome->sites.set(siteIndex, value);
 	advanceIndex();
 }
 
@@ -353,6 +358,7 @@ std::vector<std::vector<int>> CircularGenome<T>::Handler::readTable(std::pair<in
 
 template<class T>
 void CircularGenome<T>::setupCircularGenome(int _size, double _alphabetSize) {
+	clearSiteTracking();
 	sites.resize(_size);
 	alphabetSize = _alphabetSize;
 	// define columns to be written to genome files
@@ -428,6 +434,8 @@ std::shared_ptr<AbstractGenome> CircularGenome<T>::makeCopy(std::shared_ptr<Para
 	auto newGenome = std::make_shared<CircularGenome>(alphabetSize, 1, PT_);
 
 	newGenome->sites = sites; 
+	newGenome->startCodonCodes = startCodonCodes;
+	newGenome->startCodonSites = startCodonSites;
 	newGenome->countPoint = countPoint;
 	newGenome->countPointOffset = countPointOffset;
 	newGenome->countDelete = countDelete;
@@ -457,20 +465,23 @@ double CircularGenome<T>::getAlphabetSize() {
 // randomize this genomes contents
 template<class T>
 void CircularGenome<T>::fillRandom() {
+	clearSiteTracking();
 	for (size_t i = 0; i < sites.size(); i++) {
-		sites[i] = (T) Random::getDouble(alphabetSize);
+		sites.set(i, (T) Random::getDouble(alphabetSize));
 	}
 }
 
 template<> inline void CircularGenome<double>::fillRandom() {
+	clearSiteTracking();
 	for (size_t i = 0; i < sites.size(); i++) {
-		sites[i] = Random::getDouble(0, alphabetSize);
+		sites.set(i, Random::getDouble(0, alphabetSize));
 	}
 }
 
 template<> inline void CircularGenome<bool>::fillRandom() {
+	clearSiteTracking();
 	for (size_t i = 0; i < sites.size(); i++) {
-		sites[i] = (bool)((int)Random::getDouble(alphabetSize));
+		sites.set(i, (bool)((int)Random::getDouble(alphabetSize)));
 	}
 }
 
@@ -478,8 +489,9 @@ template<> inline void CircularGenome<bool>::fillRandom() {
 // This function is to make testing easy.
 template<class T>
 void CircularGenome<T>::fillAcending() {
+	clearSiteTracking();
 	for (size_t i = 0; i < sites.size(); i++) {
-		sites[i] = ((int)i) % (int) alphabetSize;
+		sites.set(i, ((int)i) % (int) alphabetSize);
 	}
 }
 
@@ -488,8 +500,9 @@ void CircularGenome<T>::fillAcending() {
 // This function is to make testing easy.
 template<class T>
 void CircularGenome<T>::fillConstant(int value) {
+	clearSiteTracking();
 	for (size_t i = 0; i < sites.size(); i++) {
-		sites[i] = value;
+		sites.set(i, value);
 	}
 }
 
@@ -501,10 +514,11 @@ template<class T>
 void CircularGenome<T>::copyFrom(std::shared_ptr<AbstractGenome> from) {
 	auto castFrom = std::dynamic_pointer_cast<CircularGenome<T>>(from);  // we will be pulling all sorts of stuff from this genome so lets just cast it once.
 	alphabetSize = castFrom->alphabetSize;
-	sites.clear();
-	for (auto site : castFrom->sites) {
-		sites.push_back(site);
-	}
+	sites = castFrom->sites; // shares sites with from until either is changed
+	startCodonCodes = castFrom->startCodonCodes;
+	startCodonSites = castFrom->startCodonSites;
+	mutatedFrom.reset();
+	mutatedSites.clear();
 	countPoint = castFrom->countPoint;
 	countPointOffset = castFrom->countPointOffset;
 	countDelete = castFrom->countDelete;
@@ -537,7 +551,10 @@ bool CircularGenome<T>::isEmpty() {
 template<class T>
 void CircularGenome<T>::pointMutate(double range) {
 	if (range == -1) {
-		sites[Random::getIndex((int)sites.size())] = Random::getIndex((int)alphabetSize);
+		T value = Random::getIndex((int)alphabetSize); // value is drawn before the site (as it always has been)
+		int siteIndex = Random::getIndex((int)sites.size());
+		sites.set(siteIndex, value);
+		pointMutated(siteIndex);
 	}
 	else {
 		int siteIndex = Random::getIndex((int)sites.size());
@@ -550,14 +567,18 @@ void CircularGenome<T>::pointMutate(double range) {
 		else { //normal/gaussian
 			offsetValue = (int)Random::getNormal(0, range);
 		}
-		sites[siteIndex] = std::max(0, std::min((int)alphabetSize - 1, sites[siteIndex] + offsetValue));
+		sites.set(siteIndex, std::max(0, std::min((int)alphabetSize - 1, sites[siteIndex] + offsetValue)));
+		pointMutated(siteIndex);
 	}
 }
 
 template<>
 void CircularGenome<double>::pointMutate(double range) {
 	if (range == -1) {
-		sites[Random::getIndex((int)sites.size())] = Random::getDouble(alphabetSize);
+		double value = Random::getDouble(alphabetSize); // value is drawn before the site (as it always has been)
+		int siteIndex = Random::getIndex((int)sites.size());
+		sites.set(siteIndex, value);
+		pointMutated(siteIndex);
 	}
 	else {
 		int siteIndex = Random::getIndex((int)sites.size());
@@ -570,7 +591,8 @@ void CircularGenome<double>::pointMutate(double range) {
 			offsetValue = Random::getNormal(0, range);
 		}
 		double maxValue = alphabetSize - (std::nextafter(alphabetSize, DBL_MAX) - alphabetSize); // next smallest double value for alphabetSize
-		sites[siteIndex] = std::max(0.0, std::min(maxValue, sites[siteIndex] + (offsetValue)));
+		sites.set(siteIndex, std::max(0.0, std::min(maxValue, sites[siteIndex] + (offsetValue))));
+		pointMutated(siteIndex);
 	}
 }
 
@@ -618,6 +640,8 @@ void CircularGenome<T>::mutate() {
 		pointMutate(pointOffsetRange);
 		incrementPointOffset();
 	}
+	// segment is reused by copy and indel mutations
+	std::vector<T> segment;
 	// do some copy mutations
 	int MaxGenomeSize = CircularGenomeParameters::sizeMaxPL->get(PT);
 	int IMax = CircularGenomeParameters::mutationCopyMaxSizePL->get(PT);
@@ -636,14 +660,10 @@ void CircularGenome<T>::mutate() {
 			exit(1);
 		}
 		int segmentStart = Random::getInt((int)sites.size() - segmentSize);
-		std::vector<T> segment;
-		segment.clear();
-		auto it = sites.begin();
-		segment.insert(segment.begin(), it + segmentStart, it + segmentStart + segmentSize);
+		sites.copySegment(segmentStart, segmentSize, segment);
 
 		////insertSegment(segment);
-		it = sites.begin();
-		sites.insert(it + Random::getInt((int)sites.size()), segment.begin(), segment.end());
+		insertSites(Random::getInt((int)sites.size()), segment);
 
 		//cout << sites.size() << endl;
 
@@ -665,7 +685,7 @@ void CircularGenome<T>::mutate() {
 			exit(1);
 		}
 		int segmentStart = Random::getInt(((int)sites.size()) - segmentSize);
-		sites.erase(sites.begin() + segmentStart, sites.begin() + segmentStart + segmentSize);
+		eraseSites(segmentStart, segmentStart + segmentSize);
 
 		incrementDelete();
 	}
@@ -685,17 +705,12 @@ void CircularGenome<T>::mutate() {
 			exit(1);
 		}
 
-		// create a new genome segment
-		std::vector<T> segment;
-		auto it = sites.begin(); // i.e. iterator
-
 		if (copyFirst) {
 			// if copy before delete
 			// copy a portion of the genome into segment
 			int segmentStart = Random::getInt((int)sites.size() - segmentSize); // where to copy from
 			int deleteStart = Random::getInt((int)sites.size() - segmentSize); // where to delete from
-			segment.clear();
-			segment.insert(segment.begin(), it + segmentStart, it + segmentStart + segmentSize);
+			sites.copySegment(segmentStart, segmentSize, segment);
 
 /*
             std::cout << "\ncopyFirst\ngenome: ";
@@ -711,7 +726,7 @@ void CircularGenome<T>::mutate() {
 */
 
 			// delete a portion of the genome of the same size
-			sites.erase(it + deleteStart, it + deleteStart + segmentSize);
+			eraseSites(deleteStart, deleteStart + segmentSize);
 
 /*
 			std::cout << "\ngenome after delete: ";
@@ -722,18 +737,18 @@ void CircularGenome<T>::mutate() {
 			// insert the copied sites back into genome
 			if (insertMethod == 0) {
 				// copy to random location
-				sites.insert(it + Random::getInt((int)sites.size()), segment.begin(), segment.end());
+				insertSites(Random::getInt((int)sites.size()), segment);
 			}
 			else if (insertMethod == 1) {
 				// replace deleted segment
-				sites.insert(it + deleteStart, segment.begin(), segment.end());
+				insertSites(deleteStart, segment);
 			}
 			else if (insertMethod == 2) {
 				// insert segment just in front of copied sites
 				if (segmentStart > deleteStart) { // note if deleteStart is in copied segment things are weird.
 					segmentStart -= deleteStart;  // but no matter what we do, it's going to be weird...
 				}
-				sites.insert(it + segmentStart, segment.begin(), segment.end());
+				insertSites(segmentStart, segment);
 			}
 /*
 			std::cout << "\ngenome after insert: ";
@@ -746,7 +761,7 @@ void CircularGenome<T>::mutate() {
 			// delete before copy (deleted sites cannot be copied)
 			// delete a portion of the genome
 			int deleteStart = Random::getInt((int)sites.size() - segmentSize); // where to delete from
-			sites.erase(it + deleteStart, it + deleteStart + segmentSize);
+			eraseSites(deleteStart, deleteStart + segmentSize);
 
             if (segmentSize > sites.size()){
                 std::cout << "ERROR: in curlarGenome<T>::mutate(), segmentSize for indel is > then sites.size() after deletion!\nUse a larger genome relitive to Indel min/max.\nExiting!" << std::endl;
@@ -755,21 +770,20 @@ void CircularGenome<T>::mutate() {
             }
 			// copy a portion of the genome into segment
 			int segmentStart = Random::getInt((int)sites.size() - segmentSize);
-			segment.clear();
-			segment.insert(segment.begin(), it + segmentStart, it + segmentStart + segmentSize);
+			sites.copySegment(segmentStart, segmentSize, segment);
 
 			// insert the copied sites back into genome
 			if (insertMethod == 0) {
 				// copy to random location
-				sites.insert(it + Random::getInt((int)sites.size()), segment.begin(), segment.end());
+				insertSites(Random::getInt((int)sites.size()), segment);
 			}
 			else if (insertMethod == 1) {
 				// replace deleted segment
-				sites.insert(it + deleteStart, segment.begin(), segment.end());
+				insertSites(deleteStart, segment);
 			}
 			else if (insertMethod == 2) {
 				// insert segment just in front of copied sites
-				sites.insert(it + segmentStart, segment.begin(), segment.end());
+				insertSites(segmentStart, segment);
 			}
 		}
 		incrementIndel();
@@ -782,6 +796,7 @@ template<class T>
 std::shared_ptr<AbstractGenome> CircularGenome<T>::makeMutatedGenomeFrom(std::shared_ptr<AbstractGenome> parent) {
 	auto newGenome = std::make_shared<CircularGenome<T>>(PT);
 	newGenome->copyFrom(parent);
+	newGenome->mutatedFrom = parent; // start the mutation log
     newGenome->mutate();
 	newGenome->recordDataMap();
 	return newGenome;
@@ -821,7 +836,7 @@ std::shared_ptr<AbstractGenome> CircularGenome<T>::makeMutatedGenomeFromMany(std
 		//cout << "many parent" << endl;
 
 		// extract the sites list from each parent
-		std::vector<std::vector<T>> parentSites;
+		std::vector<CircularGenomeSites<T>> parentSites;
 		for (auto parent : parents) {
 			parentSites.push_back(std::dynamic_pointer_cast<CircularGenome<T>>(parent)->sites);
 		}
@@ -856,7 +871,7 @@ std::shared_ptr<AbstractGenome> CircularGenome<T>::makeMutatedGenomeFromMany(std
 			lastPick = pick;
 			// add the segment to this chromosome
 			//cout << "(" << parentSites[pick].size() << ") "<< c << ": " << (int)((double)parentSites[pick].size()*crossLocations[c]) << " " << (int)((double)parentSites[pick].size()*crossLocations[c+1]) << " " << flush;
-			newGenome->sites.insert(newGenome->sites.end(), parentSites[pick].begin() + (int) ((double) parentSites[pick].size() * crossLocations[c]), parentSites[pick].begin() + (int) ((double) parentSites[pick].size() * crossLocations[c + 1]));
+			newGenome->sites.append(parentSites[pick], (int) ((double) parentSites[pick].size() * crossLocations[c]), (int) ((double) parentSites[pick].size() * crossLocations[c + 1]));
 			//cout << " ++ " << flush;
 		}
 	}
@@ -893,6 +908,47 @@ DataMap CircularGenome<T>::serialize(std::string& name) {
 	return serialDataMap;
 }
 
+// sites are written as raw bytes (sizeof(T) per site) to [name]_sitesBinary
+template<class T>
+DataMap CircularGenome<T>::serializeBinary(std::string& name) {
+	DataMap serialDataMap;
+	serialDataMap.set(name + "_genomeLength", countSites());
+	std::vector<T> allSites;
+	sites.copySegment(0, sites.size(), allSites);
+	std::string bytes(allSites.size() * sizeof(T), '\0');
+	for (size_t i = 0; i < allSites.size(); i++) {
+		T value = allSites[i];
+		std::memcpy(&bytes[i * sizeof(T)], &value, sizeof(T));
+	}
+	serialDataMap.set(name + "_sitesBinary", bytes);
+	return serialDataMap;
+}
+
+// load sites written by serializeBinary, returns false if orgData does not have [name]_sitesBinary
+template<class T>
+static bool deserializeBinarySites(CircularGenomeSites<T>& sites, std::unordered_map<std::string, std::string>& orgData, std::string& name) {
+	auto binarySites = orgData.find(name + "_sitesBinary");
+	if (binarySites == orgData.end()) {
+		return false;
+	}
+	const std::string& bytes = binarySites->second;
+	int genomeLength;
+	convertString(orgData[name + "_genomeLength"], genomeLength);
+	if (bytes.size() != genomeLength * sizeof(T)) {
+		std::cout << "  In CircularGenome<T>::deserialize :: " + name + "_sitesBinary does not have " << genomeLength << " sites.\n  exiting" << std::endl;
+		exit(1);
+	}
+	std::vector<T> allSites(genomeLength);
+	for (int i = 0; i < genomeLength; i++) {
+		T value;
+		std::memcpy(&value, &bytes[i * sizeof(T)], sizeof(T));
+		allSites[i] = value;
+	}
+	sites.clear();
+	sites.insert(0, allSites);
+	return true;
+}
+
 // given a DataMap and PT, return genome [name] from the DataMap
 template<class T>
 void CircularGenome<T>::deserialize(std::shared_ptr<ParametersTable> PT, std::unordered_map<std::string, std::string>& orgData, std::string& name) {
@@ -900,6 +956,10 @@ void CircularGenome<T>::deserialize(std::shared_ptr<ParametersTable> PT, std::un
 	std::string nextString;
 	T value;
 	// make sure that data has needed columns
+	if (orgData.find(name + "_genomeLength") != orgData.end() && deserializeBinarySites(sites, orgData, name)) {
+		clearSiteTracking();
+		return;
+	}
 	if (orgData.find(name + "_sites") == orgData.end() || orgData.find(name + "_genomeLength") == orgData.end()) {
 		std::cout << "  In CircularGenome<T>::deserialize :: can not find either " + name + "_sites or " + name + "_genomeLength.\n  exiting" << std::endl;
 		exit(1);
@@ -912,6 +972,7 @@ void CircularGenome<T>::deserialize(std::shared_ptr<ParametersTable> PT, std::un
 
   bool streamNotEmpty(true);
 	sites.clear();
+	clearSiteTracking();
   streamNotEmpty = static_cast<bool>(ss >> nextChar);
 	for (int i = 0; i < genomeLength; i++) {
 		nextString = "";
@@ -934,6 +995,10 @@ void CircularGenome<unsigned char>::deserialize(std::shared_ptr<ParametersTable>
 	int value;
 	// make sure that data has needed columns
 	std::cout << "name: " << name << "  " << name + "_sites" << std::endl;
+	if (orgData.find(name + "_genomeLength") != orgData.end() && deserializeBinarySites(sites, orgData, name)) {
+		clearSiteTracking();
+		return;
+	}
 	if (orgData.find(name + "_sites") == orgData.end() || orgData.find(name + "_genomeLength") == orgData.end()) {
 		std::cout << "  In CircularGenome<T>::deserialize :: can not find either " + name + "_sites or " + name + "_genomeLength.\n  exiting" << std::endl;
 		exit(1);
@@ -945,6 +1010,7 @@ void CircularGenome<unsigned char>::deserialize(std::shared_ptr<ParametersTable>
 	std::stringstream ss(allSites);
 
 	sites.clear();
+	clearSiteTracking();
   bool streamNotEmpty(true);
   streamNotEmpty = static_cast<bool>(ss >> nextChar);
 	for (int i = 0; i < genomeLength; i++) {
@@ -963,6 +1029,138 @@ void CircularGenome<unsigned char>::deserialize(std::shared_ptr<ParametersTable>
 
 
 
+// insert segment before index (and keep start codon index up to date)
+template<class T>
+void CircularGenome<T>::insertSites(int index, const std::vector<T>& segment) {
+	sites.insert(index, segment);
+	insertStartCodonSites(index, (int)segment.size());
+	mutatedFrom.reset(); // sites have moved, the mutation log can no longer describe this genome
+}
+
+// remove sites [start, end) (and keep start codon index up to date)
+template<class T>
+void CircularGenome<T>::eraseSites(int start, int end) {
+	sites.erase(start, end);
+	eraseStartCodonSites(start, end);
+	mutatedFrom.reset();
+}
+
+// siteIndex was changed by a point mutation (keep start codon index and mutation log up to date)
+template<class T>
+void CircularGenome<T>::pointMutated(int siteIndex) {
+	updateStartCodonSites(siteIndex - 1, siteIndex + 1);
+	if (!mutatedFrom.expired()) {
+		mutatedSites.push_back(siteIndex);
+	}
+}
+
+template<class T>
+std::shared_ptr<AbstractGenome> CircularGenome<T>::getPointMutations(std::vector<int>& changedSites) {
+	auto parent = mutatedFrom.lock();
+	if (parent != nullptr) {
+		changedSites = mutatedSites;
+	}
+	return parent;
+}
+
+// the value readInt(0, codonMax) would return for site (when codonMax + 1 <= alphabetSize)
+template<class T>
+int CircularGenome<T>::codonValue(T site, int codonMax) {
+	return (int)site % (codonMax + 1);
+}
+
+template<>
+int CircularGenome<double>::codonValue(double site, int codonMax) {
+	return (int)((site / alphabetSize) * (codonMax + 1));
+}
+
+template<class T>
+const std::vector<int>* CircularGenome<T>::getStartCodonSites(const std::vector<int>& startCodes) {
+	int codonMax = (int)startCodes.size() - 1;
+	if (codonMax < 1 || codonMax + 1 > alphabetSize) { // codons would span more then one site
+		return nullptr;
+	}
+	if (startCodonCodes != startCodes) {
+		// build index, convert sites to codon values one chunk at a time and then look for start codons
+		startCodonCodes = startCodes;
+		startCodonSites.clear();
+		std::vector<int> codons(sites.size());
+		std::vector<T> chunk;
+		for (size_t start = 0; start < sites.size(); start += chunk.size()) {
+			sites.copySegment(start, std::min(sites.size() - start, CircularGenomeSites<T>::chunkSize), chunk);
+			for (size_t i = 0; i < chunk.size(); i++) {
+				codons[start + i] = codonValue(chunk[i], codonMax);
+			}
+		}
+		for (int p = 0; p + 1 < (int)codons.size(); p++) {
+			if (startCodes[codons[p]] == codons[p + 1]) {
+				startCodonSites.push_back(p);
+			}
+		}
+	}
+	return &startCodonSites;
+}
+
+template<class T>
+void CircularGenome<T>::clearSiteTracking() {
+	startCodonCodes.clear();
+	startCodonSites.clear();
+	mutatedFrom.reset();
+	mutatedSites.clear();
+}
+
+template<class T>
+void CircularGenome<T>::updateStartCodonSites(int start, int end) {
+	if (startCodonCodes.empty()) {
+		return;
+	}
+	// there is no pair starting at the last site
+	while (!startCodonSites.empty() && startCodonSites.back() >= (int)sites.size() - 1) {
+		startCodonSites.pop_back();
+	}
+	start = std::max(0, start);
+	end = std::min((int)sites.size() - 1, end);
+	if (start >= end) {
+		return;
+	}
+	int codonMax = (int)startCodonCodes.size() - 1;
+	auto first = std::lower_bound(startCodonSites.begin(), startCodonSites.end(), start);
+	first = startCodonSites.erase(first, std::lower_bound(first, startCodonSites.end(), end));
+	std::vector<int> found;
+	for (int p = start; p < end; p++) {
+		if (startCodonCodes[codonValue(sites[p], codonMax)] == codonValue(sites[p + 1], codonMax)) {
+			found.push_back(p);
+		}
+	}
+	startCodonSites.insert(first, found.begin(), found.end());
+}
+
+template<class T>
+void CircularGenome<T>::insertStartCodonSites(int index, int count) {
+	if (startCodonCodes.empty()) {
+		return;
+	}
+	for (auto it = std::lower_bound(startCodonSites.begin(), startCodonSites.end(), index); it != startCodonSites.end(); it++) {
+		*it += count;
+	}
+	// the pair ending at index and all pairs starting in the new sites have changed
+	updateStartCodonSites(index - 1, index + count);
+}
+
+template<class T>
+void CircularGenome<T>::eraseStartCodonSites(int start, int end) {
+	if (startCodonCodes.empty()) {
+		return;
+	}
+	auto first = std::lower_bound(startCodonSites.begin(), startCodonSites.end(), start);
+	first = startCodonSites.erase(first, std::lower_bound(first, startCodonSites.end(), end));
+	for (auto it = first; it != startCodonSites.end(); it++) {
+		*it -= (end - start);
+	}
+	// the pair which now spans the deleted sites has changed
+	updateStartCodonSites(start - 1, start);
+}
+
 template<class T>
 void CircularGenome<T>::recordDataMap() {
 	dataMap.set("alphabetSize", alphabetSize);
@@ -973,6 +1171,27 @@ void CircularGenome<T>::recordDataMap() {
     dataMap.set("countDelete", countDelete);
     dataMap.set("countIndel", countIndel);
 }
+
+// serialize does not write the mutation counts
+template<class T>
+void CircularGenome<T>::saveCheckpoint(CheckpointWriter& checkpoint, std::string& name) {
+	AbstractGenome::saveCheckpoint(checkpoint, name);
+	checkpoint.write(countPoint);
+	checkpoint.write(countPointOffset);
+	checkpoint.write(countDelete);
+	checkpoint.write(countCopy);
+	checkpoint.write(countIndel);
+}
+
+template<class T>
+void CircularGenome<T>::loadCheckpoint(CheckpointReader& checkpoint, std::string& name) {
+	AbstractGenome::loadCheckpoint(checkpoint, name);
+	checkpoint.read(countPoint);
+	checkpoint.read(countPointOffset);
+	checkpoint.read(countDelete);
+	checkpoint.read(countCopy);
+	checkpoint.read(countIndel);
+}
 /*
 // load all genomes from a file
 template<class T>
@@ -25,6 +25,8 @@
 #include <Utilities/Random.h>
 #include <Genome/AbstractGenome.h>
 
+#include "CircularGenomeSites.h"
+
 // needed to move static values to own class because of templating.
 class CircularGenomeParameters {
 public:
@@ -91,6 +93,9 @@ public:
 		virtual bool atEOC() override;
 
 		virtual void printIndex() override;
+		virtual int getSiteIndex() override {
+			return siteIndex;
+		}
 		virtual int readInt(int valueMin, int valueMax, int code = -1, int CodingRegionIndex = 0) override;
 		virtual double readDouble(double valueMin, double valueMax, int code = -1, int CodingRegionIndex = 0) override;
 
@@ -109,7 +114,7 @@ public:
 
 	};
 
-	std::vector<T> sites;
+	CircularGenomeSites<T> sites; // copies share unchanged chunks of sites (see CircularGenomeSites)
 	double alphabetSize;
 
 	CircularGenome() = delete;
@@ -205,10 +210,38 @@ public:
 	}
 
 	virtual DataMap serialize(std::string& name) override;
+	virtual DataMap serializeBinary(std::string& name) override;
 	virtual void deserialize(std::shared_ptr<ParametersTable> PT, std::unordered_map<std::string, std::string>& orgData, std::string& name) override;
 
+	virtual void saveCheckpoint(CheckpointWriter& checkpoint, std::string& name) override;
+	virtual void loadCheckpoint(CheckpointReader& checkpoint, std::string& name) override;
+
 	virtual void recordDataMap() override;
 
+	// start codon index (see AbstractGenome::getStartCodonSites)
+	// the index is built on first use and then kept up to date by mutate, copies of this genome
+	// (and genomes made from it with makeMutatedGenomeFrom) inherit the index
+	std::vector<int> startCodonCodes; // the startCodes the index was built for (empty if there is no index)
+	std::vector<int> startCodonSites; // every site p (for all p < size()-1) where p and p+1 are a start codon
+
+	virtual const std::vector<int>* getStartCodonSites(const std::vector<int>& startCodes) override;
+	int codonValue(T site, int codonMax);
+
+	// mutation log (see AbstractGenome::getPointMutations)
+	std::weak_ptr<AbstractGenome> mutatedFrom; // set by makeMutatedGenomeFrom, reset if sites are changed other then by point mutations
+	std::vector<int> mutatedSites; // sites changed by point mutations since this genome was copied from mutatedFrom
+
+	virtual std::shared_ptr<AbstractGenome> getPointMutations(std::vector<int>& changedSites) override;
+	void pointMutated(int siteIndex);
+	// sites were changed in a way which is not tracked, drop the start codon index and the mutation log
+	void clearSiteTracking();
+	// update startCodonSites for sites [start, end) (i.e. the pairs starting at these sites have changed)
+	void updateStartCodonSites(int start, int end);
+	void insertStartCodonSites(int index, int count); // count sites were inserted at index
+	void eraseStartCodonSites(int start, int end); // sites [start, end) were removed
+	void insertSites(int index, const std::vector<T>& segment);
+	void eraseSites(int start, int end);
+
 	// load all genomes from a file
 	//virtual void loadGenomeFile(string fileName, vector<std::shared_ptr<AbstractGenome>> &genomes) override;
 // load a genome from CSV file with headers - will return genome from saved organism with key / keyvalue pair
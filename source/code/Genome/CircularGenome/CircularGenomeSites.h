@@ -0,0 +1,204 @@
+//  MABE is a product of The Hintze Lab @ MSU
+//     for general research information:
+//         hintzelab.msu.edu
+//     for MABE documentation:
+//         github.com/Hintzelab/MABE/wiki
+//
+//  Copyright (c) 2015 Michigan State University. All rights reserved.
+//     to view the full license, visit:
+//         github.com/Hintzelab/MABE/wiki/License
+
+#pragma once
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+// storage for the sites of a CircularGenome.
+// sites are kept in chunks (of about chunkSize sites) which are shared between copies.
+// copying sites only copies the chunk list, and a chunk is only copied when it is changed
+// (copy on write), so an offspring shares all unmutated chunks with it's parent.
+// point mutations copy at most one chunk, and insert/erase only move sites in the chunks
+// they touch (plus the chunk list) rather then shifting the whole genome.
+template<class T>
+class CircularGenomeSites {
+public:
+	// chunks larger then 2 * chunkSize are split, chunks smaller then chunkSize / 2 are merged
+	static const size_t chunkSize = 1024;
+
+	size_t size() const {
+		return siteCount;
+	}
+
+	bool empty() const {
+		return siteCount == 0;
+	}
+
+	T operator[](size_t index) const {
+		size_t chunk = findChunk(index);
+		return (*chunks[chunk])[index - chunkStarts[chunk]];
+	}
+
+	void set(size_t index, T value) {
+		size_t chunk = findChunk(index);
+		writableChunk(chunk)[index - chunkStarts[chunk]] = value;
+	}
+
+	void clear() {
+		chunks.clear();
+		chunkStarts.clear();
+		siteCount = 0;
+	}
+
+	void push_back(T value) {
+		if (chunks.empty() || chunks.back()->size() >= chunkSize) {
+			chunks.push_back(std::make_shared<std::vector<T>>());
+			chunks.back()->reserve(chunkSize);
+			chunkStarts.push_back(siteCount);
+		}
+		writableChunk(chunks.size() - 1).push_back(value);
+		siteCount++;
+	}
+
+	// resize to newSize sites, new sites are T()
+	void resize(size_t newSize) {
+		if (newSize < siteCount) {
+			erase(newSize, siteCount);
+		}
+		while (siteCount < newSize) {
+			push_back(T());
+		}
+	}
+
+	// set segment to sites [start, start + length)
+	void copySegment(size_t start, size_t length, std::vector<T>& segment) const {
+		segment.clear();
+		while (length > 0) {
+			size_t chunk = findChunk(start);
+			size_t offset = start - chunkStarts[chunk];
+			size_t count = std::min(length, chunks[chunk]->size() - offset);
+			segment.insert(segment.end(), chunks[chunk]->begin() + offset, chunks[chunk]->begin() + offset + count);
+			start += count;
+			length -= count;
+		}
+	}
+
+	// insert segment before index (index == size() adds to the end)
+	void insert(size_t index, const std::vector<T>& segment) {
+		if (segment.empty()) {
+			return;
+		}
+		if (chunks.empty()) {
+			chunks.push_back(std::make_shared<std::vector<T>>(segment));
+			chunkStarts.push_back(0);
+		}
+		else {
+			size_t chunk = (index == siteCount) ? chunks.size() - 1 : findChunk(index);
+			auto& sites = writableChunk(chunk);
+			sites.insert(sites.begin() + (index - chunkStarts[chunk]), segment.begin(), segment.end());
+		}
+		siteCount += segment.size();
+		rebalance();
+	}
+
+	// remove sites [start, end)
+	void erase(size_t start, size_t end) {
+		size_t remaining = end - start;
+		while (remaining > 0) {
+			size_t chunk = findChunk(start);
+			size_t offset = start - chunkStarts[chunk];
+			size_t count = std::min(remaining, chunks[chunk]->size() - offset);
+			if (count == chunks[chunk]->size()) { // whole chunk, no need to copy it
+				chunks.erase(chunks.begin() + chunk);
+				chunkStarts.erase(chunkStarts.begin() + chunk);
+			}
+			else {
+				auto& sites = writableChunk(chunk);
+				sites.erase(sites.begin() + offset, sites.begin() + offset + count);
+			}
+			siteCount -= count;
+			remaining -= count;
+			updateChunkStarts();
+		}
+		rebalance();
+	}
+
+	// add sites [start, end) from other to the end of these sites. whole chunks are shared
+	void append(const CircularGenomeSites& other, size_t start, size_t end) {
+		while (start < end) {
+			size_t chunk = other.findChunk(start);
+			size_t offset = start - other.chunkStarts[chunk];
+			size_t count = std::min(end - start, other.chunks[chunk]->size() - offset);
+			chunkStarts.push_back(siteCount);
+			if (count == other.chunks[chunk]->size()) {
+				chunks.push_back(other.chunks[chunk]);
+			}
+			else {
+				chunks.push_back(std::make_shared<std::vector<T>>(other.chunks[chunk]->begin() + offset, other.chunks[chunk]->begin() + offset + count));
+			}
+			siteCount += count;
+			start += count;
+		}
+		rebalance();
+	}
+
+private:
+	std::vector<std::shared_ptr<std::vector<T>>> chunks;
+	std::vector<size_t> chunkStarts; // index of the first site in each chunk
+	size_t siteCount = 0;
+
+	size_t findChunk(size_t index) const {
+		return (std::upper_bound(chunkStarts.begin(), chunkStarts.end(), index) - chunkStarts.begin()) - 1;
+	}
+
+	// make a private copy of chunk if it is shared
+	std::vector<T>& writableChunk(size_t chunk) {
+		if (chunks[chunk].use_count() > 1) {
+			chunks[chunk] = std::make_shared<std::vector<T>>(*chunks[chunk]);
+		}
+		return *chunks[chunk];
+	}
+
+	void updateChunkStarts() {
+		chunkStarts.resize(chunks.size());
+		size_t start = 0;
+		for (size_t chunk = 0; chunk < chunks.size(); chunk++) {
+			chunkStarts[chunk] = start;
+			start += chunks[chunk]->size();
+		}
+	}
+
+	// split chunks which have grown too large and merge chunks which have become too small
+	// (only chunks changed by insert/erase/append are ever out of range, so others are not copied)
+	void rebalance() {
+		size_t chunk = 0;
+		while (chunk < chunks.size()) {
+			if (chunks[chunk]->size() > 2 * chunkSize) {
+				// split into chunkSize pieces (the last piece takes any remainder)
+				auto sites = chunks[chunk];
+				std::vector<std::shared_ptr<std::vector<T>>> pieces;
+				size_t start = 0;
+				while (start < sites->size()) {
+					size_t pieceEnd = (sites->size() - start < 2 * chunkSize) ? sites->size() : start + chunkSize;
+					pieces.push_back(std::make_shared<std::vector<T>>(sites->begin() + start, sites->begin() + pieceEnd));
+					start = pieceEnd;
+				}
+				chunks.erase(chunks.begin() + chunk);
+				chunks.insert(chunks.begin() + chunk, pieces.begin(), pieces.end());
+				chunk += pieces.size();
+			}
+			else if (chunks[chunk]->size() < chunkSize / 2 && chunks.size() > 1) {
+				// merge with the next chunk (or the prior chunk if this is the last chunk)
+				// and check the merged chunk again (it may now be too large)
+				chunk = (chunk + 1 < chunks.size()) ? chunk : chunk - 1;
+				auto& sites = writableChunk(chunk);
+				sites.insert(sites.end(), chunks[chunk + 1]->begin(), chunks[chunk + 1]->end());
+				chunks.erase(chunks.begin() + chunk + 1);
+			}
+			else {
+				chunk++;
+			}
+		}
+		updateChunkStarts();
+	}
+};
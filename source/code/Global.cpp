@@ -42,6 +42,45 @@ std::shared_ptr<ParameterLink<std::string>> Global::outputPrefixPL =
         "GLOBAL-outputPrefix", std::string("./"),
         "Directory and prefix specifying where data files will be written");
 
+std::shared_ptr<ParameterLink<int>> Global::threadsPL =
+    Parameters::register_parameter(
+        "GLOBAL-threads", 1,
+        "number of threads used to evaluate organisms (in worlds that support "
+        "it), to select parents (Lexicase) and make offspring when "
+        "numberParents is 1 (Tournament). "
+        "each organism (or offspring) gets it's own random number stream "
+        "(seeded from GLOBAL-randomSeed) so results do not depend on the number "
+        "of threads. "
+        "if -1, use all available cores");
+
+std::shared_ptr<ParameterLink<bool>> Global::asyncFileWritingPL =
+    Parameters::register_parameter(
+        "GLOBAL-asyncFileWriting", false,
+        "if true, output files are written by a background thread (data is "
+        "buffered and written to disk shortly after, and always before MABE "
+        "exits)");
+
+std::shared_ptr<ParameterLink<int>> Global::checkpointIntervalPL =
+    Parameters::register_parameter(
+        "GLOBAL-checkpointInterval", 0,
+        "in run mode, save a checkpoint (the full state of the run) every this "
+        "many updates. a run can be continued from a checkpoint with the same "
+        "results with -r on the command line. if 0, checkpoints are only "
+        "saved when checkpointTimeLimit is reached");
+
+std::shared_ptr<ParameterLink<std::string>> Global::checkpointFilePL =
+    Parameters::register_parameter(
+        "GLOBAL-checkpointFile", std::string("checkpoint.mabc"),
+        "name of the checkpoint file (in outputPrefix). each checkpoint "
+        "replaces the last");
+
+std::shared_ptr<ParameterLink<int>> Global::checkpointTimeLimitPL =
+    Parameters::register_parameter(
+        "GLOBAL-checkpointTimeLimit", -1,
+        "if > 0, when this many minutes have passed (i.e. just before a job "
+        "time limit), save a checkpoint after the current update and stop "
+        "without flushing the archivist. if -1, there is no time limit");
+
 // shared_ptr<ParameterLink<string>> Global::groupNameSpacesPL =
 // Parameters::register_parameter("GLOBAL-groups", (string) "[]", "name spaces
 // (also names) of groups to be created (in addition to the default 'no name'
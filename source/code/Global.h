@@ -42,6 +42,18 @@ public:
   static std::shared_ptr<ParameterLink<std::string>>
       outputPrefixPL; // where files will be written
 
+  static std::shared_ptr<ParameterLink<int>>
+      threadsPL; // number of threads used to evaluate organisms
+  static std::shared_ptr<ParameterLink<bool>>
+      asyncFileWritingPL; // write files on a background thread
+
+  static std::shared_ptr<ParameterLink<int>>
+      checkpointIntervalPL; // how often to save a checkpoint
+  static std::shared_ptr<ParameterLink<std::string>>
+      checkpointFilePL; // where checkpoints are saved
+  static std::shared_ptr<ParameterLink<int>>
+      checkpointTimeLimitPL; // save a checkpoint and stop after this many minutes
+
   // static shared_ptr<ParameterLink<string>> groupNameSpacesPL;
 
   //	static shared_ptr<ParameterLink<int>> bitsPerBrainAddressPL;  // how
@@ -29,3 +29,93 @@ void Group::optimize() { optimizer->optimize(population); }
 
 void Group::cleanup() { optimizer->cleanup(population); }
 
+void Group::saveCheckpoint(CheckpointWriter &checkpoint) {
+  // find every organism in memory, starting with the population and following
+  // parents. (offspring is not followed, every offspring is found from the
+  // population since an offspring is only kept if something holds it)
+  std::vector<std::shared_ptr<Organism>> organisms;
+  std::unordered_set<Organism *> found;
+  auto add = [&](const std::shared_ptr<Organism> &org) {
+    if (found.insert(org.get()).second) {
+      organisms.push_back(org);
+    }
+  };
+  std::vector<std::shared_ptr<Organism>> held = population;
+  optimizer->checkpointOrganisms(held);
+  for (auto const &org : held) {
+    add(org);
+  }
+  for (size_t i = 0; i < organisms.size(); i++) {
+    for (auto const &parent : organisms[i]->parents) {
+      add(parent);
+    }
+  }
+
+  checkpoint.section("GROUP");
+  checkpoint.write(static_cast<uint64_t>(organisms.size()));
+  for (auto const &org : organisms) {
+    org->saveCheckpoint(checkpoint);
+  }
+  for (auto const &org : organisms) {
+    std::vector<int> IDs;
+    for (auto const &parent : org->parents) {
+      IDs.push_back(parent->ID);
+    }
+    checkpoint.write(IDs);
+    IDs.clear();
+    for (auto offspring : org->offspring) {
+      if (found.find(offspring) == found.end()) {
+        std::cout << "  WARNING :: In Group::saveCheckpoint :: offspring "
+                  << offspring->ID << " of organism " << org->ID
+                  << " is not held by the population or optimizer, it will "
+                     "not be in the checkpoint."
+                  << std::endl;
+        continue;
+      }
+      IDs.push_back(offspring->ID);
+    }
+    checkpoint.write(IDs);
+  }
+  std::vector<int> populationIDs;
+  for (auto const &org : population) {
+    populationIDs.push_back(org->ID);
+  }
+  checkpoint.write(populationIDs);
+  optimizer->saveCheckpoint(checkpoint);
+  archivist->saveCheckpoint(checkpoint);
+}
+
+void Group::loadCheckpoint(CheckpointReader &checkpoint) {
+  checkpoint.section("GROUP");
+  population.clear();
+  std::vector<std::shared_ptr<Organism>> organisms(checkpoint.read<uint64_t>());
+  std::unordered_map<int, std::shared_ptr<Organism>> organismsByID;
+  for (auto &org : organisms) {
+    org = std::make_shared<Organism>(optimizer->PT);
+    org->loadCheckpoint(checkpoint, templateOrg, optimizer->PT);
+    organismsByID[org->ID] = org;
+  }
+  auto lookup = [&](int ID) {
+    auto org = organismsByID.find(ID);
+    if (org == organismsByID.end()) {
+      std::cout << "  In Group::loadCheckpoint :: organism " << ID
+                << " is not in checkpoint \"" << checkpoint.getFileName()
+                << "\".\n  Exiting." << std::endl;
+      exit(1);
+    }
+    return org->second;
+  };
+  for (auto const &org : organisms) {
+    for (auto ID : checkpoint.read<std::vector<int>>()) {
+      org->parents.push_back(lookup(ID));
+    }
+    for (auto ID : checkpoint.read<std::vector<int>>()) {
+      org->offspring.push_back(lookup(ID).get());
+    }
+  }
+  for (auto ID : checkpoint.read<std::vector<int>>()) {
+    population.push_back(lookup(ID));
+  }
+  optimizer->loadCheckpoint(checkpoint, organismsByID);
+  archivist->loadCheckpoint(checkpoint, organismsByID);
+}
@@ -31,5 +31,11 @@ public:
   bool archive(int flush = 0);
   void optimize();
   void cleanup();
+
+  // save (or load) the population, the organisms that are still in memory
+  // because of them (parents, ancestors not yet written by the archivist),
+  // and the optimizer and archivist. loadCheckpoint replaces the population.
+  void saveCheckpoint(CheckpointWriter &checkpoint);
+  void loadCheckpoint(CheckpointReader &checkpoint);
 };
 
@@ -9,6 +9,10 @@
 //         github.com/Hintzelab/MABE/wiki/License
 
 #include "AbstractOptimizer.h"
+#include <Global.h>
+
+#include <algorithm>
+#include <thread>
 
 /*
 #include <algorithm>
@@ -26,6 +30,17 @@ std::shared_ptr<ParameterLink<std::string>>
                                             // outputMethod;
 ////// OPTIMIZER-optimizer is actually set by Modules.h //////
 
+ThreadPool &AbstractOptimizer::getThreadPool() {
+  if (!threadPool) {
+    int threads = Global::threadsPL->get(PT);
+    if (threads < 1) {
+      threads = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+    }
+    threadPool = std::make_shared<ThreadPool>(threads);
+  }
+  return *threadPool;
+}
+
 /*
  * Optimizer::makeNextGeneration(vector<Genome*> population, vector<double> W)
  * place holder function, copies population to make new population
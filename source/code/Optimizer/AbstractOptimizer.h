@@ -21,6 +21,7 @@
 #include <Utilities/MTree.h>
 #include <Utilities/Parameters.h>
 #include <Utilities/Random.h>
+#include <Utilities/ThreadPool.h>
 
 class AbstractOptimizer {
 public:
@@ -59,6 +60,16 @@ public:
   //	return("score");
   //}
 
+  // checkpoints (see Group::saveCheckpoint). optimizers that keep organisms
+  // between updates add them to organisms so they are saved with the group,
+  // saveCheckpoint and loadCheckpoint can then refer to them by ID
+  virtual void
+  checkpointOrganisms(std::vector<std::shared_ptr<Organism>> &organisms) {}
+  virtual void saveCheckpoint(CheckpointWriter &checkpoint) {}
+  virtual void loadCheckpoint(
+      CheckpointReader &checkpoint,
+      std::unordered_map<int, std::shared_ptr<Organism>> &organisms) {}
+
   virtual bool requireGenome() { return false; }
   virtual bool requireBrain() { return false; }
 
@@ -69,5 +80,13 @@ public:
     // "blah" = use "blah namespace at root level
     // "Group::blah" = use "blah" name space inside of group name space
   }
+
+  // GLOBAL-threads threads, for optimizers that select parents or make
+  // offspring in parallel. created on first use (i.e. after IslandsOptimizer
+  // has made it's worker processes)
+  ThreadPool &getThreadPool();
+
+private:
+  std::shared_ptr<ThreadPool> threadPool;
 };
 
@@ -10,6 +10,14 @@
 
 
 #include "IslandsOptimizer.h"
+#include <Utilities/Filesystem.h>
+
+#include <limits>
+
+#if defined(OS_UNIX)
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
 
 std::shared_ptr<ParameterLink<std::string>> IslandsOptimizer::IslandNameSpaceListPL =
 Parameters::register_parameter(
@@ -32,6 +40,26 @@ std::shared_ptr<ParameterLink<double>> IslandsOptimizer::migrationRatePL =
 Parameters::register_parameter(
 	"OPTIMIZER_ISLANDS-migrationRate", .02,
 	"% of new organisms which migrate to a random island at birth");
+std::shared_ptr<ParameterLink<int>> IslandsOptimizer::processesPL =
+Parameters::register_parameter(
+	"OPTIMIZER_ISLANDS-processes", 1,
+	"number of processes to run islands in. if > 1, island i is run by process (i % processes).\n"
+	"each process evaluates and optimizes only the organisms on it's own islands, with it's own copy of\n"
+	"the world (so worlds do not need to be thread safe). new organisms that migrate to an island in\n"
+	"another process are sent there (see migrationInterval). process 0 writes output files as usual,\n"
+	"process n writes output files with the prefix \"process[n]_\". migrants arrive as organisms with\n"
+	"no parents, so LOD files only follow lines of descent within a process. processes do not wait\n"
+	"for each other, so runs are not repeatable. each process uses GLOBAL-threads threads.\n"
+	"only available on unix like systems, and can not be used with checkpoints");
+std::shared_ptr<ParameterLink<int>> IslandsOptimizer::migrationIntervalPL =
+Parameters::register_parameter(
+	"OPTIMIZER_ISLANDS-migrationInterval", 1,
+	"if processes > 1, organisms migrating to other processes are sent every migrationInterval updates");
+std::shared_ptr<ParameterLink<int>> IslandsOptimizer::migrationBufferSizePL =
+Parameters::register_parameter(
+	"OPTIMIZER_ISLANDS-migrationBufferSize", 16,
+	"if processes > 1, size (in MB) of the shared memory which holds migrants waiting for each process.\n"
+	"migrants which do not fit are lost");
 
 IslandsOptimizer::IslandsOptimizer(std::shared_ptr<ParametersTable> PT_)
     : AbstractOptimizer(PT_) {
@@ -50,6 +78,21 @@ IslandsOptimizer::IslandsOptimizer(std::shared_ptr<ParametersTable> PT_)
 	}
 
 	migrationRate = migrationRatePL->get(PT);
+	islandSlot = DataMap::slotOf("IsOp_island");
+
+	processes = processesPL->get(PT);
+	migrationInterval = migrationIntervalPL->get(PT);
+	if (processes < 1 || processes > static_cast<int>(islands)) {
+		std::cout << "  In IslandsOptimizer :: OPTIMIZER_ISLANDS-processes must be between 1 and the number of islands (" << islands << ").\n  Exiting." << std::endl;
+		exit(1);
+	}
+	if (processes > 1) {
+		if (migrationInterval < 1) {
+			std::cout << "  In IslandsOptimizer :: OPTIMIZER_ISLANDS-migrationInterval must be 1 or more.\n  Exiting." << std::endl;
+			exit(1);
+		}
+		startProcesses();
+	}
 
 	// leave this undefined so that max.csv is not generated
 	//optimizeFormula = optimizeValueMT;
@@ -58,36 +101,125 @@ IslandsOptimizer::IslandsOptimizer(std::shared_ptr<ParametersTable> PT_)
 	// since diffrent optimizers may generate diffrent values, we will leave this empty
 }
 
+IslandsOptimizer::~IslandsOptimizer() {
+#if defined(OS_UNIX)
+	for (auto workerID : workerIDs) {
+		int status;
+		waitpid(workerID, &status, 0);
+	}
+#endif
+}
+
+void IslandsOptimizer::startProcesses() {
+#if defined(OS_UNIX)
+	static bool started = false;
+	if (started) {
+		std::cout << "  In IslandsOptimizer :: only one IslandsOptimizer may use OPTIMIZER_ISLANDS-processes > 1.\n  Exiting." << std::endl;
+		exit(1);
+	}
+	started = true;
+	if (Global::checkpointIntervalPL->get() > 0 || Global::checkpointTimeLimitPL->get() > 0 || !Parameters::resume_file.empty()) {
+		std::cout << "  In IslandsOptimizer :: checkpoints can not be used with OPTIMIZER_ISLANDS-processes > 1.\n  Exiting." << std::endl;
+		exit(1);
+	}
+
+	// the buffers must exist before the fork so that they are shared
+	auto bufferSize = static_cast<size_t>(migrationBufferSizePL->get(PT)) * 1024 * 1024;
+	for (int p = 0; p < processes; p++) {
+		migrationBuffers.push_back(std::make_shared<SharedRingBuffer>(bufferSize));
+	}
+	outgoingMigrants.resize(processes);
+
+	// each process needs it's own random numbers
+	std::vector<int> seeds;
+	for (int p = 0; p < processes; p++) {
+		seeds.push_back(Random::getInt(std::numeric_limits<int>::max()));
+	}
+
+	// a thread is not copied by fork, so stop the file writer thread (if any) until after the fork
+	auto async = FileManager::isAsync();
+	FileManager::setAsync(false);
+	std::cout << std::flush;
+	for (int p = 1; p < processes; p++) {
+		auto workerID = fork();
+		if (workerID < 0) {
+			std::cout << "  In IslandsOptimizer :: unable to start process " << p << ".\n  Exiting." << std::endl;
+			exit(1);
+		}
+		if (workerID == 0) { // this is the new process
+			process = p;
+			workerIDs.clear();
+			break;
+		}
+		workerIDs.push_back(workerID);
+	}
+	Random::getCommonGenerator().seed(seeds[process]);
+	if (process > 0) {
+		FileManager::outputPrefix += "process" + std::to_string(process) + "_";
+	}
+	FileManager::setAsync(async);
+
+	std::cout << "  process " << process << " runs islands:";
+	for (size_t island = 0; island < islands; island++) {
+		if (ownsIsland(island)) {
+			std::cout << " " << island;
+		}
+	}
+	std::cout << std::endl;
+#else
+	std::cout << "  In IslandsOptimizer :: OPTIMIZER_ISLANDS-processes > 1 is not available on this system.\n  Exiting." << std::endl;
+	exit(1);
+#endif
+}
+
 void IslandsOptimizer::optimize(std::vector<std::shared_ptr<Organism>> &population) {
 	std::vector<std::vector<std::shared_ptr<Organism>>> islandPopulations(islands);
 
 	int popSize = static_cast<int>(population.size());
 	if (Global::update == 0) {
 		for (auto org : population) {
-			org->dataMap.set("IsOp_island", Random::getIndex(islands));
+			org->dataMap.set(islandSlot, Random::getIndex(islands));
 		}
 		allKeys = population[0]->dataMap.getKeys(); // get all keys from a dataMap before optimizing
 		sort(allKeys.begin(), allKeys.end());
+		if (processes > 1) { // migrants are built like these
+			templateGenomes = population[0]->genomes;
+			templateBrains = population[0]->brains;
+			organismPT = population[0]->PT;
+		}
 	}
 
 	for (auto org : population) {
-		islandPopulations[org->dataMap.getIntVector("IsOp_island")[0]].push_back(org);
+		auto island = org->dataMap.getIntVector(islandSlot)[0];
+		// (at update 0 every process has a whole population, each keeps only the organisms on it's islands)
+		if (ownsIsland(island)) {
+			islandPopulations[island].push_back(org);
+		}
 	}
 
 	population.clear();
 	killList.clear();
 	std::cout << "\n  optimizing...";
 	for (size_t island = 0; island < islands; island++){
+		if (!ownsIsland(island)) {
+			continue;
+		}
 		std::cout << "\n    island " << island << " : " << islandOptimizers[island]->PT->getTableNameSpace() << "   (" << islandPopulations[island].size() << ")  ";
 		islandOptimizers[island]->optimize(islandPopulations[island]);
 		for (auto org : islandPopulations[island]) {
 			population.push_back(org);
 			if (org->timeOfBirth == Global::update) { // if an org is brand new there is a chance is will migrate
 				if (Random::P(migrationRate)) { // chance for migration
-					org->dataMap.set("IsOp_island", Random::getIndex(islands));
+					auto newIsland = Random::getIndex(islands);
+					if (!ownsIsland(newIsland)) { // leave this process (org is not kept here)
+						population.pop_back();
+						outgoingMigrants[newIsland % processes].push_back(emigrate(org, newIsland));
+						continue;
+					}
+					org->dataMap.set(islandSlot, newIsland);
 				}
 				else { // stay on your island
-					org->dataMap.set("IsOp_island", static_cast<int>(island));
+					org->dataMap.set(islandSlot, static_cast<int>(island));
 				}
 			}
 		}
@@ -96,10 +228,17 @@ void IslandsOptimizer::optimize(std::vector<std::shared_ptr<Organism>> &populati
 		}
 	}
 
+	if (processes > 1 && Global::update % migrationInterval == 0) {
+		migrate(population);
+	}
+
 	// now, look at how dataMaps were changed by island optimizers, and figure out what will
 	// need to be added so that all orgs have the same values in their data maps
 	if (Global::update == 0) {
 		for (auto ipop : islandPopulations) {
+			if (ipop.empty()) { // (i.e. island is in another process)
+				continue;
+			}
 			// for each island, look at the 0th organisms datamap, and see if it adds any columns
 			auto thisIslandsKeys = ipop[0]->dataMap.getKeys();
 			sort(thisIslandsKeys.begin(), thisIslandsKeys.end());
@@ -116,6 +255,9 @@ void IslandsOptimizer::optimize(std::vector<std::shared_ptr<Organism>> &populati
 			// for each island, again look at the 0th element, but this time, make a list for each island of the
 			// columns we will need to add
 			fillerKeys.push_back({}); // add an empty vector for this island
+			if (islandPopulations[i].empty()) {
+				continue;
+			}
 			for (auto fillerPair : fillerLookup) {
 				auto thisIslandsKeys = islandPopulations[i][0]->dataMap.getKeys();
 				if (find(thisIslandsKeys.begin(), thisIslandsKeys.end(), fillerPair.first) == thisIslandsKeys.end()){ // if not found
@@ -129,7 +271,7 @@ void IslandsOptimizer::optimize(std::vector<std::shared_ptr<Organism>> &populati
 	// fillerKeys tells us for each island what we need to add
 	// fillerLookup tells us the type of the data that we need to add (0 = number, 1 = string)
 	for (auto org : population) {
-		for (auto key : fillerKeys[org->dataMap.getIntVector("IsOp_island")[0]]) {
+		for (auto key : fillerKeys[org->dataMap.getIntVector(islandSlot)[0]]) {
 			if (fillerLookup[key] == 0) {
 				org->dataMap.set(key, 0);
 			}
@@ -140,3 +282,133 @@ void IslandsOptimizer::optimize(std::vector<std::shared_ptr<Organism>> &populati
 	}
 }
 
+
+std::string IslandsOptimizer::emigrate(const std::shared_ptr<Organism> &org, int island) {
+	CheckpointWriter migrant; // (in memory)
+	migrant.section("MIGRANT");
+	migrant.write(island);
+	migrant.write(static_cast<uint64_t>(org->genomes.size()));
+	for (auto const &genome : org->genomes) {
+		auto name = "GENOME_" + genome.first;
+		migrant.write(genome.first);
+		genome.second->saveCheckpoint(migrant, name);
+	}
+	migrant.write(static_cast<uint64_t>(org->brains.size()));
+	for (auto const &brain : org->brains) {
+		auto name = "BRAIN_" + brain.first;
+		migrant.write(brain.first);
+		brain.second->saveCheckpoint(migrant, name);
+	}
+	return migrant.data();
+}
+
+// a migrant arrives as a new organism with no parents
+std::shared_ptr<Organism> IslandsOptimizer::immigrate(const std::string &data, int &island) {
+	CheckpointReader migrant(data.data(), data.size());
+	migrant.section("MIGRANT");
+	migrant.read(island);
+	std::unordered_map<std::string, std::shared_ptr<AbstractGenome>> genomes;
+	std::unordered_map<std::string, std::shared_ptr<AbstractBrain>> brains;
+	auto genomeCount = migrant.read<uint64_t>();
+	for (uint64_t i = 0; i < genomeCount; i++) {
+		auto genomeName = migrant.read<std::string>();
+		auto name = "GENOME_" + genomeName;
+		genomes[genomeName] = templateGenomes.at(genomeName)->makeLike();
+		genomes[genomeName]->loadCheckpoint(migrant, name);
+	}
+	auto brainCount = migrant.read<uint64_t>();
+	for (uint64_t i = 0; i < brainCount; i++) {
+		auto brainName = migrant.read<std::string>();
+		auto name = "BRAIN_" + brainName;
+		brains[brainName] = templateBrains.at(brainName)->makeBrain(genomes);
+		brains[brainName]->loadCheckpoint(migrant, name);
+	}
+	return std::make_shared<Organism>(genomes, brains, organismPT);
+}
+
+void IslandsOptimizer::migrate(std::vector<std::shared_ptr<Organism>> &population) {
+	int sent = 0;
+	int lost = 0;
+	for (int p = 0; p < processes; p++) {
+		for (auto const &migrant : outgoingMigrants[p]) {
+			if (migrationBuffers[p]->push(migrant)) {
+				sent++;
+			}
+			else {
+				lost++;
+			}
+		}
+		outgoingMigrants[p].clear();
+	}
+	std::vector<std::string> arrived;
+	migrationBuffers[process]->popAll(arrived);
+	for (auto const &migrant : arrived) {
+		int island;
+		auto org = immigrate(migrant, island);
+		org->dataMap.set(islandSlot, island);
+		population.push_back(org);
+	}
+	std::cout << "\n    process " << process << " migrants sent: " << sent << "   received: " << arrived.size();
+	if (lost > 0) {
+		std::cout << "   lost: " << lost << " (OPTIMIZER_ISLANDS-migrationBufferSize is full)";
+	}
+}
+
+void IslandsOptimizer::checkpointOrganisms(std::vector<std::shared_ptr<Organism>> &organisms) {
+	for (auto &islandOptimizer : islandOptimizers) {
+		islandOptimizer->checkpointOrganisms(organisms);
+	}
+}
+
+void IslandsOptimizer::saveCheckpoint(CheckpointWriter &checkpoint) {
+	checkpoint.section("OPTIMIZER_ISLANDS");
+	checkpoint.write(static_cast<uint64_t>(islandOptimizers.size()));
+	for (auto &islandOptimizer : islandOptimizers) {
+		islandOptimizer->saveCheckpoint(checkpoint);
+	}
+	// the filler columns are found at update 0
+	checkpoint.write(static_cast<uint64_t>(allKeys.size()));
+	for (auto const &key : allKeys) {
+		checkpoint.write(key);
+	}
+	checkpoint.write(static_cast<uint64_t>(fillerKeys.size()));
+	for (auto const &keys : fillerKeys) {
+		checkpoint.write(static_cast<uint64_t>(keys.size()));
+		for (auto const &key : keys) {
+			checkpoint.write(key);
+		}
+	}
+	checkpoint.write(static_cast<uint64_t>(fillerLookup.size()));
+	for (auto const &filler : fillerLookup) {
+		checkpoint.write(filler.first);
+		checkpoint.write(filler.second);
+	}
+}
+
+void IslandsOptimizer::loadCheckpoint(CheckpointReader &checkpoint, std::unordered_map<int, std::shared_ptr<Organism>> &organisms) {
+	checkpoint.section("OPTIMIZER_ISLANDS");
+	if (checkpoint.read<uint64_t>() != islandOptimizers.size()) {
+		std::cout << "  In IslandsOptimizer::loadCheckpoint :: checkpoint was saved with a different number of islands.\n  Exiting." << std::endl;
+		exit(1);
+	}
+	for (auto &islandOptimizer : islandOptimizers) {
+		islandOptimizer->loadCheckpoint(checkpoint, organisms);
+	}
+	allKeys.resize(checkpoint.read<uint64_t>());
+	for (auto &key : allKeys) {
+		checkpoint.read(key);
+	}
+	fillerKeys.resize(checkpoint.read<uint64_t>());
+	for (auto &keys : fillerKeys) {
+		keys.resize(checkpoint.read<uint64_t>());
+		for (auto &key : keys) {
+			checkpoint.read(key);
+		}
+	}
+	fillerLookup.clear();
+	auto fillerCount = checkpoint.read<uint64_t>();
+	for (uint64_t i = 0; i < fillerCount; i++) {
+		auto key = checkpoint.read<std::string>();
+		checkpoint.read(fillerLookup[key]);
+	}
+}
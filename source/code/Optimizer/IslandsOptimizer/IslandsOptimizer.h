@@ -14,6 +14,7 @@
 
 #include <Optimizer/AbstractOptimizer.h>
 #include <Utilities/MTree.h>
+#include <Utilities/SharedRingBuffer.h>
 
 #include <iostream>
 #include <sstream>
@@ -24,9 +25,13 @@ public:
 
 	static std::shared_ptr<ParameterLink<std::string>> IslandNameSpaceListPL;
 	static std::shared_ptr<ParameterLink<double>> migrationRatePL;
+	static std::shared_ptr<ParameterLink<int>> processesPL;
+	static std::shared_ptr<ParameterLink<int>> migrationIntervalPL;
+	static std::shared_ptr<ParameterLink<int>> migrationBufferSizePL;
 
 	std::vector <std::shared_ptr<AbstractOptimizer>> islandOptimizers;
 	size_t islands;
+	DataMap::Slot islandSlot; // "IsOp_island", the island each org is on
 	double migrationRate;
 	std::vector<std::string> allKeys;
 	std::vector<std::vector<std::string>> fillerKeys;
@@ -34,8 +39,34 @@ public:
 
 	std::shared_ptr<Abstract_MTree> nextPopSizeMT;
 
+	// with processes > 1, the islands are divided between processes (made with fork when this optimizer
+	// is constructed). each process evaluates and optimizes the organisms on it's own islands and new
+	// organisms that migrate to an island in another process are sent there (through shared memory) as
+	// serialized genomes (and brains).
+	int processes;
+	int process = 0; // which process this is (0 is the process MABE was started as)
+	std::vector<int> workerIDs; // process IDs of the other processes (process 0 only)
+	int migrationInterval;
+	std::vector<std::shared_ptr<SharedRingBuffer>> migrationBuffers; // migrants waiting for each process
+	std::vector<std::vector<std::string>> outgoingMigrants; // migrants waiting for migrationInterval, by process
+	std::unordered_map<std::string, std::shared_ptr<AbstractGenome>> templateGenomes; // to build migrants
+	std::unordered_map<std::string, std::shared_ptr<AbstractBrain>> templateBrains;
+	std::shared_ptr<ParametersTable> organismPT;
+
 	IslandsOptimizer(std::shared_ptr<ParametersTable> PT_ = nullptr);
+	virtual ~IslandsOptimizer(); // process 0 waits for the other processes to finish
 
 	virtual void optimize(std::vector<std::shared_ptr<Organism>> &population) override;
+
+	bool ownsIsland(size_t island) { return static_cast<int>(island % processes) == process; }
+	void startProcesses();
+	std::string emigrate(const std::shared_ptr<Organism> &org, int island); // serialize a migrant
+	std::shared_ptr<Organism> immigrate(const std::string &migrant, int &island); // rebuild a migrant
+	void migrate(std::vector<std::shared_ptr<Organism>> &population); // send and receive migrants
+
+	// each island optimizer saves (and loads) it's own state
+	virtual void checkpointOrganisms(std::vector<std::shared_ptr<Organism>> &organisms) override;
+	virtual void saveCheckpoint(CheckpointWriter &checkpoint) override;
+	virtual void loadCheckpoint(CheckpointReader &checkpoint, std::unordered_map<int, std::shared_ptr<Organism>> &organisms) override;
 };
 
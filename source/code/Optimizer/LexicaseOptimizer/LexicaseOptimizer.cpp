@@ -9,6 +9,8 @@
 //         github.com/Hintzelab/MABE/wiki/License
 
 #include "LexicaseOptimizer.h"
+
+#include <cmath>
 #include <iostream>
 #include <numeric>
 #include <algorithm>
@@ -57,6 +59,13 @@ std::shared_ptr<ParameterLink<bool>> LexicaseOptimizer::recordOptimizeValuesPL =
 Parameters::register_parameter("OPTIMIZER_LEXICASE-recordOptimizeValues", true,
 	"record optimize values to data files using optimizeFormulaNames");
 
+std::shared_ptr<ParameterLink<double>> LexicaseOptimizer::downSamplePL =
+Parameters::register_parameter("OPTIMIZER_LEXICASE-downSample", 1.0,
+	"fraction of optimizeFormulas used to select parents (down-sampled lexicase)."
+	"\na new random sample of formulas is drawn each generation (at least one formula is always used)."
+	"\n1.0 uses all formulas. parents are selected using GLOBAL-threads threads, results do not"
+	"\ndepend on the number of threads");
+
 
 LexicaseOptimizer::LexicaseOptimizer(std::shared_ptr<ParametersTable> PT_)
     : AbstractOptimizer(PT_) {
@@ -66,6 +75,7 @@ LexicaseOptimizer::LexicaseOptimizer(std::shared_ptr<ParametersTable> PT_)
 
 	for (auto s : optimizeFormulasStrings) {
 		optimizeFormulasMTs.push_back(stringToMTree(s));
+		optimizeFormulasCompiled.push_back(std::make_shared<CompiledMTree>(optimizeFormulasMTs.back()));
 	}
 
 	// get names to use with scores
@@ -79,6 +89,9 @@ LexicaseOptimizer::LexicaseOptimizer(std::shared_ptr<ParametersTable> PT_)
 		// user has defined names, use those
 		convertCSVListToVector(optimizeFormulaNamesPL->get(PT), scoreNames);
 	}
+	for (auto &name : scoreNames) {
+		scoreSlots.push_back(DataMap::slotOf(name));
+	}
 
 
 	epsilon = epsilonPL->get(PT);
@@ -95,6 +108,13 @@ LexicaseOptimizer::LexicaseOptimizer(std::shared_ptr<ParametersTable> PT_)
 		exit(1);
 	}
 	poolSize = poolSizePL->get(PT);
+	downSample = downSamplePL->get(PT);
+	if (downSample <= 0.0 || downSample > 1.0) {
+		std::cout << "  while setting up LexicaseOptimizer, found downSample value " << downSample <<
+			" but this value must be in (0.0,1.0]."
+			"\n  exiting." << std::endl;
+		exit(1);
+	}
 	nextPopSizeFormula = stringToMTree(nextPopSizePL->get(PT));
 	numberParents = numberParentsPL->get(PT);
 	recordOptimizeValues = recordOptimizeValuesPL->get(PT);
@@ -110,97 +130,128 @@ LexicaseOptimizer::LexicaseOptimizer(std::shared_ptr<ParametersTable> PT_)
 	}
 }
 
-// return n nonrepeating elements for [0..m)
-auto m_choose_n = [](auto const m, auto const n) {
-	std::vector<int> v(m);
-	std::iota(std::begin(v), std::end(v), 0);
-	std::shuffle(std::begin(v), std::end(v), Random::getCommonGenerator());
-	std::vector<int> r;
-	std::copy_n(std::begin(v), n, std::back_inserter(r));
-	return r;
-};
+// put poolSize random population indexes in work.keepers. this is a partial
+// shuffle of work.poolOrder, which is then undone so that poolOrder is in order
+// again for the next draw (and results do not depend on earlier draws)
+void LexicaseOptimizer::drawPool(Random::Generator &gen, SelectScratch &work) {
+	auto &poolOrder = work.poolOrder;
+	if (poolOrder.size() != populationSize) {
+		poolOrder.resize(populationSize);
+		iota(poolOrder.begin(), poolOrder.end(), 0);
+	}
+	int count = std::min(poolSize, static_cast<int>(populationSize));
+	work.keepers.clear();
+	work.poolSwaps.clear();
+	for (int i = 0; i < count; i++) {
+		int j = i + Random::getIndex(static_cast<int>(populationSize) - i, gen);
+		std::swap(poolOrder[i], poolOrder[j]);
+		work.poolSwaps.push_back(j);
+		work.keepers.push_back(poolOrder[i]);
+	}
+	for (int i = count - 1; i >= 0; i--) {
+		std::swap(poolOrder[i], poolOrder[work.poolSwaps[i]]);
+	}
+}
+
+double LexicaseOptimizer::scoreCutoff(const std::vector<double> &keeperScores,
+	std::vector<double> &rankScores) const {
+	if (epsilonRelativeTo) { // get scoreCutoff relitive to score
+		auto scoreRange = std::minmax_element(std::begin(keeperScores), std::end(keeperScores));
+		return *scoreRange.second - ((*scoreRange.second - *scoreRange.first) * epsilon);
+	}
+	// get scoreCutoff relitive to rank
+	// based on the number of keepers, calculate how many to keep.
+	size_t cull_index = std::ceil(std::max((((1.0 - epsilon) * keeperScores.size()) - 1.0), 0.0));
+
+	// get score at the cull index position
+	rankScores.assign(keeperScores.begin(), keeperScores.end());
+	std::nth_element(std::begin(rankScores),
+		std::begin(rankScores) + cull_index,
+		std::end(rankScores));
+	return rankScores[cull_index];
+}
+
+void LexicaseOptimizer::filterKeepers(int formula, SelectScratch &work) const {
+	auto &keepers = work.keepers;
+	auto &keeperScores = work.keeperScores;
+	const double *formulaScores = scores.data() + formula * populationSize;
 
+	size_t count = keepers.size();
+	keeperScores.resize(count);
+	for (size_t i = 0; i < count; i++) {
+		keeperScores[i] = formulaScores[keepers[i]];
+	}
+	double cutoff = scoreCutoff(keeperScores, work.rankScores);
+
+	// keep orgs with score >= scoreCutoff. there are no branches in this loop,
+	// so the compiler can vectorize the comparisons and it does not suffer from
+	// mispredictions when about half of the keepers are removed
+	size_t kept = 0;
+	for (size_t i = 0; i < count; i++) {
+		keepers[kept] = keepers[i];
+		kept += keeperScores[i] >= cutoff;
+	}
+	keepers.resize(kept);
+}
+
+int LexicaseOptimizer::lexiSelect(Random::Generator &gen, SelectScratch &work) {
+	auto &keepers = work.keepers;
+	auto &cases = work.cases;
 
-int LexicaseOptimizer::lexiSelect(const std::vector<int> &orgIndexList) {
 	if (!scoresHaveDelta) { // if all scores are the same! pick random
-		return Random::getIndex(orgIndexList.size());
+		if (wholePopulationPool) {
+			return Random::getIndex(static_cast<int>(populationSize), gen);
+		}
+		drawPool(gen, work);
+		return keepers[Random::getIndex(static_cast<int>(keepers.size()), gen)];
 	}
 
-	// generate a vector with formulasSize and fill with values from 0 to formulasSize - 1, in a random order.
-	std::vector<int> formulasOrder(optimizeFormulasMTs.size());
-	iota(formulasOrder.begin(), formulasOrder.end(), 0);
-	std::shuffle(formulasOrder.begin(), formulasOrder.end(), Random::getCommonGenerator());
-	// now we have a random order in formulasOrder
+	// formulas are taken in a random order, cases[0..used) have been used
+	cases.assign(activeFormulas.begin(), activeFormulas.end());
+	size_t used = 0;
+	auto nextFormula = [&] {
+		auto pick = used + Random::getIndex(static_cast<int>(cases.size() - used), gen);
+		std::swap(cases[used], cases[pick]);
+		return cases[used++];
+	};
 
 	// keepers is the current list of indexes into population for orgs which
 	// have passed all tests so far.
-	std::vector<int> keepers  = orgIndexList;
+	if (wholePopulationPool) {
+		auto &first = firstKeepers[nextFormula()];
+		keepers.assign(first.begin(), first.end());
+	}
+	else {
+		drawPool(gen, work);
+	}
 
-	while (keepers.size() > 1 && formulasOrder.size() > 0) {
+	while (keepers.size() > 1 && used < cases.size()) {
 		// while there are still atleast one keeper and there are still formulas
-		int formulaIndex = formulasOrder.back();
-		formulasOrder.pop_back();
-
-		double scoreCutoff;
-
-		// create a vector of remaning scores
-		std::vector<double> keeperScores;
-		for (size_t i = 0; i < keepers.size(); i++) {
-			keeperScores.push_back(scores[formulaIndex][keepers[i]]);
-		}
-
-		if (epsilonRelativeTo) { // get scoreCutoff relitive to score
-			auto scoreRange = std::minmax_element(std::begin(keeperScores), std::end(keeperScores));
-			scoreCutoff = (*scoreRange.second - ((*scoreRange.second - *scoreRange.first) * epsilon));
-		}
-		else { // get scoreCutoff relitive to rank
-			// based on the number of keepers, calculate how many to keep.
-			size_t cull_index = std::ceil(std::max((((1.0 - epsilon) * keeperScores.size()) - 1.0), 0.0));
-
-			// get score at the cull index position
-			std::nth_element(std::begin(keeperScores),
-				std::begin(keeperScores) + cull_index,
-				std::end(keeperScores));
-			scoreCutoff = keeperScores[cull_index];
-
-			//std::cout << "cull_index: " << cull_index << "  keeperScores.size(): " << keeperScores.size() << std::endl;
-			//std::cout << "scoreCutoff: " << scoreCutoff << std::endl;
-		}
-
-		// for each keeper, see if there are still a keeper, i.e. they have score >= scoreCutoff. remove if not
-		keepers.erase(std::remove_if(std::begin(keepers), std::end(keepers), [&](auto k) {
-			return scores[formulaIndex][k] < scoreCutoff;
-		}), std::end(keepers));
+		filterKeepers(nextFormula(), work);
 	}
-	int pickHere = Random::getIndex(keepers.size()); 
-	//std::cout << "    keeping: " << tournamentPopulation[keepers[pickHere]]->ID << std::endl;
 	// if there is only one keeper left, return that, otherwise select randomly from keepers.
-	return keepers[pickHere];
+	return keepers[Random::getIndex(static_cast<int>(keepers.size()), gen)];
 }
 
 
 void LexicaseOptimizer::optimize(
     std::vector<std::shared_ptr<Organism>> &population) {
 
+  size_t formulaCount = optimizeFormulasMTs.size();
   std::vector<double> aveScores;
-  aveScores.reserve(optimizeFormulasMTs.size());
+  aveScores.reserve(formulaCount);
   std::vector<double> maxScores;
-  maxScores.reserve(optimizeFormulasMTs.size());
+  maxScores.reserve(formulaCount);
   std::vector<double> minScores;
-  minScores.reserve(optimizeFormulasMTs.size());
-
-  scoresHaveDelta = false;
-
-  scores.clear();
-  for (auto &opt_formula : optimizeFormulasMTs) {
+  minScores.reserve(formulaCount);
 
-    std::vector<double> pop_scores;
-    pop_scores.reserve(population.size());
-
-    for (auto &org : population)
-      pop_scores.push_back(opt_formula->eval(org->dataMap, PT)[0]);
-
-    scores.push_back(pop_scores);
+  populationSize = population.size();
+  scores.resize(formulaCount * populationSize);
+  std::vector<double> pop_scores;
+  for (size_t fIndex = 0; fIndex < formulaCount; fIndex++) {
+    optimizeFormulasCompiled[fIndex]->evalAll(population, PT, pop_scores);
+    std::copy(pop_scores.begin(), pop_scores.end(),
+              scores.begin() + fIndex * populationSize);
 
     aveScores.push_back(
         std::accumulate(std::begin(pop_scores), std::end(pop_scores), 0.0) /
@@ -209,47 +260,106 @@ void LexicaseOptimizer::optimize(
     auto const minmax =
         std::minmax_element(std::begin(pop_scores), std::end(pop_scores));
 
-    scoresHaveDelta |= *minmax.first < *minmax.second;
-
     minScores.push_back(*minmax.first);
     maxScores.push_back(*minmax.second);
   }
 
   if (recordOptimizeValues)
     for (size_t i = 0; i < population.size(); i++)
-      for (size_t fIndex = 0; fIndex < optimizeFormulasMTs.size(); fIndex++)
-        population[i]->dataMap.set(scoreNames[fIndex], scores[fIndex][i]);
+      for (size_t fIndex = 0; fIndex < formulaCount; fIndex++)
+        population[i]->dataMap.set(scoreSlots[fIndex],
+                                   scores[fIndex * populationSize + i]);
+
+  // pick the formulas used this generation. a formula where all organisms
+  // have the same score would not remove anyone, so it is left out
+  std::vector<int> sampledFormulas(formulaCount);
+  iota(sampledFormulas.begin(), sampledFormulas.end(), 0);
+  if (downSample < 1.0) {
+    std::shuffle(sampledFormulas.begin(), sampledFormulas.end(),
+                 Random::getCommonGenerator());
+    sampledFormulas.resize(std::max(
+        1, static_cast<int>(std::round(downSample * formulaCount))));
+  }
+  activeFormulas.clear();
+  for (auto fIndex : sampledFormulas) {
+    if (minScores[fIndex] < maxScores[fIndex]) {
+      activeFormulas.push_back(fIndex);
+    }
+  }
+  scoresHaveDelta = !activeFormulas.empty();
 
   poolSize = poolSize == -1 ? population.size() : poolSize;
-
+  wholePopulationPool = poolSize >= static_cast<int>(populationSize);
+
+  if (wholePopulationPool && scoresHaveDelta) {
+    firstKeepers.resize(formulaCount);
+    if (scratch.empty()) {
+      scratch.resize(1);
+    }
+    auto &work = scratch[0];
+    for (auto fIndex : activeFormulas) {
+      work.keepers.resize(populationSize);
+      iota(work.keepers.begin(), work.keepers.end(), 0);
+      filterKeepers(fIndex, work);
+      firstKeepers[fIndex].assign(work.keepers.begin(), work.keepers.end());
+    }
+  }
 
   size_t nextPopulationTargetSize = nextPopSizeFormula->eval(PT)[0];
   nextPopulationTargetSize = nextPopulationTargetSize == -1
                                  ? population.size()
                                  : nextPopulationTargetSize;
 
-  // generate new organisms
+  // select all parents first. each offspring gets it's own random generator
+  // (seeded, in order, from the common generator) which is used for all of
+  // it's parents, so the selections can be split over threads and the results
+  // only depend on the random seed.
+  selectionSeeds.resize(nextPopulationTargetSize);
+  for (auto &seed : selectionSeeds) {
+    seed = Random::getCommonGenerator()();
+  }
+  parentIndexes.resize(nextPopulationTargetSize * numberParents);
+
+  auto &threadPool = getThreadPool();
+  int batchCount = static_cast<int>(std::min(
+      static_cast<size_t>(threadPool.size()), nextPopulationTargetSize));
+  if (static_cast<int>(scratch.size()) < batchCount) {
+    scratch.resize(batchCount);
+  }
+  auto selectBatch = [&](int batch) {
+    size_t first = nextPopulationTargetSize * batch / batchCount;
+    size_t last = nextPopulationTargetSize * (batch + 1) / batchCount;
+    for (size_t o = first; o < last; o++) {
+      Random::Generator gen(selectionSeeds[o]);
+      for (int p = 0; p < numberParents; p++) {
+        parentIndexes[o * numberParents + p] = lexiSelect(gen, scratch[batch]);
+      }
+    }
+  };
+  if (batchCount == 1) {
+    selectBatch(0);
+  } else if (batchCount > 1) {
+    threadPool.parallelFor(batchCount, selectBatch);
+  }
+
+  // generate new organisms (in order, on this thread, making offspring changes
+  // the parents and uses the common generator)
   // do not add to population until all have been
   // selected
   newPopulation.clear();
   newPopulation.reserve(nextPopulationTargetSize);
-
-  // generate a list of 'nextPopulationTargetSize' new orgs into 'newPopulation'
-  // for each, generate a 'parents' vector with 'numberParents' parent orgs
-  // parents are selected with lexiSelect( m_choose_n(population.size(), poolSize))
-  //   where the m_choose_n command selects 'poolSize' number of population indexes
-  std::generate_n(
-      std::back_inserter(newPopulation), nextPopulationTargetSize, [&] {
-        std::vector<std::shared_ptr<Organism>> parents;
-        std::generate_n(std::back_inserter(parents), numberParents, [&] {
-          return population[lexiSelect(m_choose_n(population.size(), poolSize))];
-        });
-        return parents[0]->makeMutatedOffspringFromMany(parents);
-      });
+  std::vector<std::shared_ptr<Organism>> parents;
+  for (size_t o = 0; o < nextPopulationTargetSize; o++) {
+    parents.clear();
+    for (int p = 0; p < numberParents; p++) {
+      parents.push_back(population[parentIndexes[o * numberParents + p]]);
+    }
+    newPopulation.push_back(parents[0]->makeMutatedOffspringFromMany(parents));
+  }
 
   oldPopulation = population;
   population.insert(population.end(), newPopulation.begin(), newPopulation.end());
-  for (size_t fIndex = 0; fIndex < optimizeFormulasMTs.size(); fIndex++) {
+  for (size_t fIndex = 0; fIndex < formulaCount; fIndex++) {
     std::cout << std::endl
               << "   " << scoreNames[fIndex]
               << ":  max = " << std::to_string(maxScores[fIndex])
@@ -265,3 +375,26 @@ void LexicaseOptimizer::cleanup(std::vector<std::shared_ptr<Organism>> &populati
 	newPopulation.clear();
 }
 
+
+void LexicaseOptimizer::checkpointOrganisms(std::vector<std::shared_ptr<Organism>> &organisms) {
+	organisms.insert(organisms.end(), oldPopulation.begin(), oldPopulation.end());
+}
+
+void LexicaseOptimizer::saveCheckpoint(CheckpointWriter &checkpoint) {
+	checkpoint.section("OPTIMIZER_LEXICASE");
+	checkpoint.write(poolSize);
+	std::vector<int> oldPopulationIDs;
+	for (auto const &org : oldPopulation) {
+		oldPopulationIDs.push_back(org->ID);
+	}
+	checkpoint.write(oldPopulationIDs);
+}
+
+void LexicaseOptimizer::loadCheckpoint(CheckpointReader &checkpoint, std::unordered_map<int, std::shared_ptr<Organism>> &organisms) {
+	checkpoint.section("OPTIMIZER_LEXICASE");
+	checkpoint.read(poolSize);
+	oldPopulation.clear();
+	for (auto ID : checkpoint.read<std::vector<int>>()) {
+		oldPopulation.push_back(organisms.at(ID));
+	}
+}
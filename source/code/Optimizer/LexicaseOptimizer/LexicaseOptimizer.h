@@ -12,6 +12,8 @@
 
 #include <Optimizer/AbstractOptimizer.h>
 #include <Utilities/MTree.h>
+#include <Utilities/CompiledMTree.h>
+#include <Utilities/Random.h>
 
 #include <iostream>
 #include <numeric>
@@ -29,13 +31,41 @@ public:
 	static std::shared_ptr<ParameterLink<std::string>> nextPopSizePL;
 	static std::shared_ptr<ParameterLink<int>> numberParentsPL;
 	static std::shared_ptr<ParameterLink<bool>> recordOptimizeValuesPL;
+	static std::shared_ptr<ParameterLink<double>> downSamplePL;
 
-	std::vector<std::vector<double>> scores;
+	// one column per formula: scores[formula * populationSize + orgIndex]
+	std::vector<double> scores;
+	size_t populationSize = 0;
 	std::vector<std::string> scoreNames;
+	std::vector<DataMap::Slot> scoreSlots; // scoreNames as dataMap slots
 	bool scoresHaveDelta = false;
 	double epsilon;
 	bool epsilonRelativeTo;
 	int poolSize;
+	double downSample;
+
+	// formulas used to select parents this generation (the down-sample, less
+	// any formula where all organisms have the same score)
+	std::vector<int> activeFormulas;
+	// when the pool is the whole population, every selection starts from the
+	// same organisms, so the keepers after the first formula are found once per
+	// generation (firstKeepers[formula])
+	bool wholePopulationPool = false;
+	std::vector<std::vector<int>> firstKeepers;
+
+	// working space for lexiSelect, one per batch of selections. These are kept
+	// between generations so that selection does not allocate.
+	struct SelectScratch {
+		std::vector<int> keepers; // population indexes still being considered
+		std::vector<double> keeperScores; // score of each keeper on the current formula
+		std::vector<double> rankScores; // copy of keeperScores for nth_element
+		std::vector<int> cases; // formulas not yet used by this selection
+		std::vector<int> poolOrder; // permutation of population indexes (used to draw pools)
+		std::vector<int> poolSwaps; // swaps made in poolOrder (undone after each draw)
+	};
+	std::vector<SelectScratch> scratch;
+	std::vector<Random::Generator::result_type> selectionSeeds; // one per offspring
+	std::vector<int> parentIndexes; // numberParents per offspring
 
 	std::shared_ptr<Abstract_MTree> nextPopSizeFormula;
 	std::vector<std::shared_ptr<Organism>> newPopulation;
@@ -46,6 +76,7 @@ public:
 	bool recordOptimizeValues;
 
 	std::vector<std::shared_ptr<Abstract_MTree>> optimizeFormulasMTs;
+	std::vector<std::shared_ptr<CompiledMTree>> optimizeFormulasCompiled; // run once per org
 
 	LexicaseOptimizer(std::shared_ptr<ParametersTable> PT_ = nullptr);
 
@@ -53,6 +84,16 @@ public:
 
 	virtual void cleanup(std::vector<std::shared_ptr<Organism>> &population) override;
 
+	// oldPopulation is kept until the next optimize
+	virtual void checkpointOrganisms(std::vector<std::shared_ptr<Organism>> &organisms) override;
+	virtual void saveCheckpoint(CheckpointWriter &checkpoint) override;
+	virtual void loadCheckpoint(CheckpointReader &checkpoint, std::unordered_map<int, std::shared_ptr<Organism>> &organisms) override;
+
 
-	int lexiSelect(const std::vector<int> &tournamentIndexList);
+	// select one parent (index into population) using gen for all random choices
+	int lexiSelect(Random::Generator &gen, SelectScratch &work);
+	void drawPool(Random::Generator &gen, SelectScratch &work);
+	double scoreCutoff(const std::vector<double> &keeperScores, std::vector<double> &rankScores) const;
+	// remove keepers that score below the cutoff on formula
+	void filterKeepers(int formula, SelectScratch &work) const;
 };
@@ -55,6 +55,7 @@ RouletteOptimizer::RouletteOptimizer(std::shared_ptr<ParametersTable> PT_)
 	numberParents = numberParentsPL->get(PT);
 
 	optimizeValueMT = stringToMTree(optimizeValuePL->get(PT));
+	optimizeValueCompiled = std::make_shared<CompiledMTree>(optimizeValueMT);
 
 	if (remapFunctionPL->get(PT) == "NONE") {
 		doRemap = false;
@@ -67,31 +68,36 @@ RouletteOptimizer::RouletteOptimizer(std::shared_ptr<ParametersTable> PT_)
 		stringReplace(remapString, "$maxOptVal$", "VECT[0,2]");
 		stringReplace(remapString, "$optVal$", "VECT[0,3]");
 		remapFunctionMT = stringToMTree(remapString);
+		remapFunctionCompiled = std::make_shared<CompiledMTree>(remapFunctionMT);
 	}
 	popFileColumns.clear();
 	popFileColumns.push_back("optimizeValue");
 	if (doRemap) {
 		popFileColumns.push_back("remappedOptimizeValue");
 	}
+
+	optimizeValueSlot = DataMap::slotOf("optimizeValue");
+	remappedValueSlot = DataMap::slotOf("remappedOptimizeValue");
+	numOffspringSlot = DataMap::slotOf("roulette_numOffspring");
 }
 
 void RouletteOptimizer::optimize(std::vector<std::shared_ptr<Organism>>& population) {
 	auto popSize = population.size();
 
-	std::vector<double> scores(popSize, 0);
+	std::vector<double> scores;
+	optimizeValueCompiled->evalAll(population, PT, scores);
 	std::vector<double> remappedScores(popSize, 0);
 	double aveScore = 0;
-	double maxScore = optimizeValueMT->eval(population[0]->dataMap, PT)[0];
+	double maxScore = scores[0];
 	double minScore = maxScore;
 
 	killList.clear();
 
 	for (size_t i = 0; i < popSize; i++) {
 		killList.insert(population[i]);
-		double opVal = optimizeValueMT->eval(population[i]->dataMap, PT)[0];
-		scores[i] = opVal;
+		double opVal = scores[i];
 		aveScore += opVal;
-		population[i]->dataMap.set("optimizeValue", opVal);
+		population[i]->dataMap.set(optimizeValueSlot, opVal);
 		maxScore = std::max(maxScore, opVal);
 		minScore = std::min(minScore, opVal);
 	}
@@ -102,8 +108,8 @@ void RouletteOptimizer::optimize(std::vector<std::shared_ptr<Organism>>& populat
 	if (doRemap) {
 		for (size_t i = 0; i < popSize; i++) {
 			remapVect[0][3] = scores[i];
-			remappedScores[i] = remapFunctionMT->eval(population[i]->dataMap, PT, remapVect)[0];
-			population[i]->dataMap.set("remappedOptimizeValue", remappedScores[i]);
+			remappedScores[i] = remapFunctionCompiled->eval(population[i]->dataMap, PT, remapVect);
+			population[i]->dataMap.set(remappedValueSlot, remappedScores[i]);
 		}
 	}
 	else {
@@ -131,7 +137,7 @@ void RouletteOptimizer::optimize(std::vector<std::shared_ptr<Organism>>& populat
 
 	}
 	for (int i = 0; i < popSize; i++) {
-		population[i]->dataMap.set("roulette_numOffspring", population[i]->offspringCount);
+		population[i]->dataMap.set(numOffspringSlot, population[i]->offspringCount);
 	}
 	std::cout << "max = " << std::to_string(maxScore) << "   ave = " << std::to_string(aveScore) << "   min = " << std::to_string(minScore);
 }
@@ -10,6 +10,7 @@
 
 #include "../AbstractOptimizer.h"
 #include "../../Utilities/MTree.h"
+#include "../../Utilities/CompiledMTree.h"
 
 #include <iostream>
 #include <sstream>
@@ -27,6 +28,8 @@ public:
 	int numberParents;
 	std::shared_ptr<Abstract_MTree> optimizeValueMT;
 	std::shared_ptr<Abstract_MTree> remapFunctionMT;
+	std::shared_ptr<CompiledMTree> optimizeValueCompiled, remapFunctionCompiled; // run once per org
+	DataMap::Slot optimizeValueSlot, remappedValueSlot, numOffspringSlot; // dataMap keys set on every org
 	bool doRemap;
 
 	RouletteOptimizer(std::shared_ptr<ParametersTable> PT_ = nullptr);
@@ -10,6 +10,9 @@
 
 #include "TournamentOptimizer.h"
 
+#include <algorithm>
+#include <numeric>
+
 std::shared_ptr<ParameterLink<int>> TournamentOptimizer::tournamentSizePL =
 	Parameters::register_parameter("OPTIMIZER_TOURNAMENT-tournamentSize", 5, "number of organisims compaired in each tournament");
 
@@ -23,7 +26,7 @@ std::shared_ptr<ParameterLink<std::string>> TournamentOptimizer::optimizeValuePL
 	Parameters::register_parameter("OPTIMIZER_TOURNAMENT-optimizeValue", (std::string) "DM_AVE[score]", "value to optimize (MTree)");
 
 
-int TournamentOptimizer::selectParent(int tournamentSize, bool minimizeError, std::vector<double> scores, int popSize){
+int TournamentOptimizer::selectParent(int tournamentSize, bool minimizeError, const std::vector<double> &scores, int popSize){
 	int winner, challanger;
 	winner = Random::getIndex(popSize);
 	for (int i = 0; i < tournamentSize - 1; i++) {
@@ -44,6 +47,7 @@ TournamentOptimizer::TournamentOptimizer(std::shared_ptr<ParametersTable> PT_)
 	minimizeError = minimizeErrorPL->get(PT);
 
 	optimizeValueMT = stringToMTree(optimizeValuePL->get(PT));
+	optimizeValueCompiled = std::make_shared<CompiledMTree>(optimizeValueMT);
 
 	if (!minimizeError) {
 		optimizeFormula = optimizeValueMT; // set this so Archivist knows which org is max
@@ -54,49 +58,111 @@ TournamentOptimizer::TournamentOptimizer(std::shared_ptr<ParametersTable> PT_)
 
 	popFileColumns.clear();
 	popFileColumns.push_back("optimizeValue");
+
+	optimizeValueSlot = DataMap::slotOf("optimizeValue");
+	numOffspringSlot = DataMap::slotOf("tournament_numOffspring");
 }
 
 void TournamentOptimizer::optimize(std::vector<std::shared_ptr<Organism>> &population) {
 	auto popSize = population.size();
 
-	std::vector<double> scores(popSize, 0);
+	std::vector<double> scores;
+	optimizeValueCompiled->evalAll(population, PT, scores);
 	double aveScore = 0;
-	double maxScore = optimizeValueMT->eval(population[0]->dataMap, PT)[0];
+	double maxScore = scores[0];
 	double minScore = maxScore;
 
 	killList.clear();
 
 	for (size_t i = 0; i < popSize; i++) {
 		killList.insert(population[i]);
-		double opVal = optimizeValueMT->eval(population[i]->dataMap, PT)[0];
-		scores[i] = opVal;
+		double opVal = scores[i];
 		aveScore += opVal;
-		population[i]->dataMap.set("optimizeValue", opVal);
+		population[i]->dataMap.set(optimizeValueSlot, opVal);
 		maxScore = std::max(maxScore, opVal);
 		minScore = std::min(minScore, opVal);
 	}
 	
 	aveScore /= popSize;
 
-	std::vector<std::shared_ptr<Organism>> parents;
+	// select all parents
+	parentIndexes.resize(popSize * numberParents);
+	for (auto &parentIndex : parentIndexes) {
+		parentIndex = selectParent(tournamentSize, minimizeError, scores, popSize);
+	}
+	offspringSeeds.resize(popSize);
+	for (auto &seed : offspringSeeds) {
+		seed = Random::getCommonGenerator()();
+	}
 
-	for (int i = 0; i < popSize; i++) {
+	// make genomes and brains. genomes and brains may change the parent genome
+	// or brain they are made from, so all offspring of a parent are made on the
+	// same thread. with more then one parent an organism can be a parent in
+	// many groups, so then the groups are all made on this thread.
+	makeOrder.resize(popSize);
+	std::iota(makeOrder.begin(), makeOrder.end(), 0);
+	std::stable_sort(makeOrder.begin(), makeOrder.end(), [&](int a, int b) {
+		return parentIndexes[a * numberParents] < parentIndexes[b * numberParents];
+	});
+	makeGroupStarts.clear();
+	for (int i = 0; i < static_cast<int>(popSize); i++) {
+		if (i == 0 || parentIndexes[makeOrder[i] * numberParents] != parentIndexes[makeOrder[i - 1] * numberParents]) {
+			makeGroupStarts.push_back(i);
+		}
+	}
+	makeGroupStarts.push_back(static_cast<int>(popSize));
+
+	offspringGenomes.resize(popSize);
+	offspringBrains.resize(popSize);
+	auto makeGroup = [&](int group) {
+		std::vector<std::shared_ptr<Organism>> parents;
+		for (int i = makeGroupStarts[group]; i < makeGroupStarts[group + 1]; i++) {
+			int o = makeOrder[i];
+			Random::Generator generator(offspringSeeds[o]);
+			Random::ScopedGenerator scope(generator);
+			auto &parent = population[parentIndexes[o * numberParents]];
+			if (numberParents == 1) {
+				parent->makeMutatedGenomesAndBrainsFrom(parent, offspringGenomes[o], offspringBrains[o]);
+			}
+			else {
+				parents.clear();
+				for (int p = 0; p < numberParents; p++) {
+					parents.push_back(population[parentIndexes[o * numberParents + p]]);
+				}
+				parent->makeMutatedGenomesAndBrainsFromMany(parents, offspringGenomes[o], offspringBrains[o]);
+			}
+		}
+	};
+	int groupCount = static_cast<int>(makeGroupStarts.size()) - 1;
+	if (getThreadPool().size() == 1 || numberParents > 1) {
+		for (int group = 0; group < groupCount; group++) {
+			makeGroup(group);
+		}
+	}
+	else {
+		getThreadPool().parallelFor(groupCount, makeGroup);
+	}
+
+	// make the offspring (in order, this changes the parents and gives IDs)
+	std::vector<std::shared_ptr<Organism>> parents;
+	for (int o = 0; o < static_cast<int>(popSize); o++) {
+		auto parent = population[parentIndexes[o * numberParents]];
 		if (numberParents == 1) {
-			auto parent = population[selectParent(tournamentSize, minimizeError, scores, popSize)];
-			population.push_back(parent->makeMutatedOffspringFrom(parent)); // add to population
+			population.push_back(std::make_shared<Organism>(parent, offspringGenomes[o], offspringBrains[o], parent->PT)); // add to population
 		}
 		else {
 			parents.clear();
-			parents.push_back(population[selectParent(tournamentSize, minimizeError, scores, popSize)]);
-			while (static_cast<int>(parents.size()) < numberParents) {
-				parents.push_back(population[selectParent(tournamentSize, minimizeError, scores, popSize)]); // select from culled
+			for (int p = 0; p < numberParents; p++) {
+				parents.push_back(population[parentIndexes[o * numberParents + p]]);
 			}
-			population.push_back(parents[0]->makeMutatedOffspringFromMany(parents)); // push to population
+			population.push_back(std::make_shared<Organism>(parents, offspringGenomes[o], offspringBrains[o], parent->PT)); // push to population
 		}
+		offspringGenomes[o].clear();
+		offspringBrains[o].clear();
 	}
 
 	for (int i = 0; i < popSize; i++) {
-		population[i]->dataMap.set("tournament_numOffspring", population[i]->offspringCount);
+		population[i]->dataMap.set(numOffspringSlot, population[i]->offspringCount);
 	}
 
 	if (!minimizeError) {
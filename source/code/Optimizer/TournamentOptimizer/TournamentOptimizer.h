@@ -10,6 +10,7 @@
 
 #include "../AbstractOptimizer.h"
 #include "../../Utilities/MTree.h"
+#include "../../Utilities/CompiledMTree.h"
 
 #include <iostream>
 #include <sstream>
@@ -25,8 +26,22 @@ public:
 	int numberParents;
 	bool minimizeError;
 	std::shared_ptr<Abstract_MTree> optimizeValueMT;
-
-	int selectParent(int tournamentSize, bool minimizeError, std::vector<double> scores, int popSize);
+	std::shared_ptr<CompiledMTree> optimizeValueCompiled; // optimizeValueMT, run once per org
+	DataMap::Slot optimizeValueSlot, numOffspringSlot; // dataMap keys set on every org
+
+	// offspring are made in two steps: parents for all offspring are selected
+	// (on this thread), then the genomes and brains are made on GLOBAL-threads
+	// threads. Each offspring gets it's own random generator, so results do not
+	// depend on the number of threads. these are kept between updates so the
+	// space can be reused.
+	std::vector<int> parentIndexes; // numberParents per offspring
+	std::vector<Random::Generator::result_type> offspringSeeds;
+	std::vector<int> makeOrder; // offspring sorted by first parent
+	std::vector<int> makeGroupStarts; // where each first parent starts in makeOrder
+	std::vector<std::unordered_map<std::string, std::shared_ptr<AbstractGenome>>> offspringGenomes;
+	std::vector<std::unordered_map<std::string, std::shared_ptr<AbstractBrain>>> offspringBrains;
+
+	int selectParent(int tournamentSize, bool minimizeError, const std::vector<double> &scores, int popSize);
 
 	TournamentOptimizer(std::shared_ptr<ParametersTable> PT_ = nullptr);
 
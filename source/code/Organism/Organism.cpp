@@ -33,6 +33,7 @@ void Organism::initOrganism(std::shared_ptr<ParametersTable> PT_) {
   offspringCount = 0;           // because it's alive;
   timeOfBirth = Global::update; // happy birthday!
   timeOfDeath = -1;             // still alive
+  lineageID = ID;               // until a parent says otherwise
   dataMap.set("ID", ID);
   dataMap.set("alive", alive);
   dataMap.set("timeOfBirth", timeOfBirth);
@@ -113,6 +114,8 @@ Organism::Organism(
 
   parents.push_back(from);
   from->offspringCount++; // this parent has an(other) offspring
+  from->offspring.push_back(this);
+  lineageID = from->lineageID;
   for (auto ancestorID : from->ancestors) {
     ancestors.insert(ancestorID); // union all parents ancestors into this
                                   // organisms ancestor set.
@@ -155,6 +158,7 @@ Organism::Organism(
   for (auto const &parent : from) {
     parents.push_back(parent); // add this parent to the parents set
     parent->offspringCount++;  // this parent has an(other) offspring
+    parent->offspring.push_back(this);
     for (auto ancestorID : parent->ancestors) {
       ancestors.insert(ancestorID); // union all parents ancestors into this
                                     // organisms ancestor set
@@ -164,6 +168,9 @@ Organism::Organism(
                                             // this organisms ancestor set.
     }
   }
+  if (!from.empty()) {
+    lineageID = from[0]->lineageID;
+  }
 }
 
 // this function provides a unique ID value for every org
@@ -172,9 +179,27 @@ int Organism::registerOrganism() {
   ;
 }
 
+// remove org from parents list of offspring (one entry per call)
+static void unlinkOffspring(const std::shared_ptr<Organism> &parent,
+                            Organism *org) {
+  auto link = std::find(parent->offspring.begin(), parent->offspring.end(), org);
+  if (link != parent->offspring.end()) {
+    *link = parent->offspring.back();
+    parent->offspring.pop_back();
+  }
+}
+
 Organism::~Organism() {
   for (auto const &parent : parents) {
     parent->offspringCount--; // this parent has one less child in memory
+    unlinkOffspring(parent, this);
+  }
+  parents.clear();
+}
+
+void Organism::clearParents() {
+  for (auto const &parent : parents) {
+    unlinkOffspring(parent, this);
   }
   parents.clear();
 }
@@ -197,6 +222,14 @@ Organism::makeMutatedOffspringFrom(std::shared_ptr<Organism> from) {
 
   std::unordered_map<std::string, std::shared_ptr<AbstractGenome>> newGenomes;
   std::unordered_map<std::string, std::shared_ptr<AbstractBrain>> newBrains;
+  makeMutatedGenomesAndBrainsFrom(from, newGenomes, newBrains);
+  return std::make_shared<Organism>(from, newGenomes, newBrains, PT);
+}
+
+void Organism::makeMutatedGenomesAndBrainsFrom(
+    std::shared_ptr<Organism> from,
+    std::unordered_map<std::string, std::shared_ptr<AbstractGenome>> &newGenomes,
+    std::unordered_map<std::string, std::shared_ptr<AbstractBrain>> &newBrains) {
 
   for (auto genome : from->genomes) {
     newGenomes[genome.first] =
@@ -208,8 +241,6 @@ Organism::makeMutatedOffspringFrom(std::shared_ptr<Organism> from) {
         brain.second->makeBrainFrom(brain.second, newGenomes);
     newBrains[brain.first]->mutate();
   }
-
-  return std::make_shared<Organism>(from, newGenomes, newBrains, PT);
 }
 
 std::shared_ptr<Organism> Organism::makeMutatedOffspringFromMany(
@@ -217,12 +248,20 @@ std::shared_ptr<Organism> Organism::makeMutatedOffspringFromMany(
 
   std::unordered_map<std::string, std::shared_ptr<AbstractGenome>> newGenomes;
   std::unordered_map<std::string, std::shared_ptr<AbstractBrain>> newBrains;
+  makeMutatedGenomesAndBrainsFromMany(from, newGenomes, newBrains);
+  return std::make_shared<Organism>(from, newGenomes, newBrains, PT);
+}
+
+void Organism::makeMutatedGenomesAndBrainsFromMany(
+    std::vector<std::shared_ptr<Organism>> from,
+    std::unordered_map<std::string, std::shared_ptr<AbstractGenome>> &newGenomes,
+    std::unordered_map<std::string, std::shared_ptr<AbstractBrain>> &newBrains) {
 
   for (auto genome : from[0]->genomes) {
     std::vector<std::shared_ptr<AbstractGenome>>
         parentGenomes; // make a list of parents genomes
     for (auto const &p : from) {
-      parentGenomes.push_back(p->genomes[genome.first]);
+      parentGenomes.push_back(p->genomes.at(genome.first));
     }
     newGenomes[genome.first] =
         genome.second->makeMutatedGenomeFromMany(parentGenomes);
@@ -232,15 +271,13 @@ std::shared_ptr<Organism> Organism::makeMutatedOffspringFromMany(
     std::vector<std::shared_ptr<AbstractBrain>>
         parentBrains; // make a list of parents genomes
     for (auto const &p : from) {
-      parentBrains.push_back(p->brains[brain.first]);
+      parentBrains.push_back(p->brains.at(brain.first));
     }
 
     newBrains[brain.first] =
         brain.second->makeBrainFromMany(parentBrains, newGenomes);
     newBrains[brain.first]->mutate();
   }
-
-  return std::make_shared<Organism>(from, newGenomes, newBrains, PT);
 }
 
 /*
@@ -302,8 +339,8 @@ Organism::getMostRecentCommonAncestor(std::shared_ptr<Organism> org) {
               // may be the Most Recent Common Ancestor
 }
 std::shared_ptr<Organism> Organism::getMostRecentCommonAncestor(
-    std::vector<std::shared_ptr<Organism>> LOD) {
-  for (auto org :
+    const std::vector<std::shared_ptr<Organism>> &LOD) {
+  for (auto const &org :
        LOD) { // starting at the oldest parent, moving to the youngest
     if (org->offspringCount >
         1) // the first (oldest) ancestor with more then one surviving offspring
@@ -313,6 +350,44 @@ std::shared_ptr<Organism> Organism::getMostRecentCommonAncestor(
                      // but may be the Most Recent Common Ancestor
 }
 
+/*
+ * given root, the oldest ancestor of org still in memory (i.e. the first
+ * element of getLOD(org)), return the part of org's LOD from root to the Most
+ * Recent Common Ancestor (oldest first, the MRCA is last).
+ * This walks forward from root through offspring, since every organism before
+ * the MRCA has exactly one offspring in memory (the next organism on the LOD).
+ * Organisms after the MRCA are only checked (to confirm that org descends from
+ * the MRCA), they are not collected.
+ * Returns an empty list if org can not be reached this way (use getLOD).
+ */
+std::vector<std::shared_ptr<Organism>>
+Organism::getLODToMostRecentCommonAncestor(std::shared_ptr<Organism> root,
+                                           std::shared_ptr<Organism> org) {
+  std::vector<std::shared_ptr<Organism>> list;
+  if (!root->parents.empty()) {
+    return list; // root is not the oldest ancestor in memory
+  }
+  auto current = root;
+  while (current->offspringCount <= 1 && current != org) {
+    list.push_back(current);
+    if (current->offspringCount != 1 || current->offspring.size() != 1 ||
+        current->offspring[0]->parents.size() != 1) {
+      return {}; // org is not on this line (or the line has more then one parent)
+    }
+    current = current->offspring[0]->shared_from_this();
+  }
+  list.push_back(current);
+  Organism *descendant = org.get();
+  while (descendant != current.get()) {
+    if (descendant->parents.size() != 1 ||
+        descendant->timeOfBirth < current->timeOfBirth) {
+      return {}; // org does not descend from this MRCA
+    }
+    descendant = descendant->parents[0].get();
+  }
+  return list;
+}
+
 std::shared_ptr<Organism>
 Organism::makeCopy(std::shared_ptr<ParametersTable> PT_) {
   auto newOrg = std::make_shared<Organism>(PT_);
@@ -329,10 +404,128 @@ Organism::makeCopy(std::shared_ptr<ParametersTable> PT_) {
   newOrg->parents = parents;
   for (auto const &parent : parents) {
     parent->offspringCount++;
+    parent->offspring.push_back(newOrg.get());
   }
+  newOrg->lineageID = lineageID;
   newOrg->ancestors = ancestors;
   newOrg->timeOfBirth = timeOfBirth;
   newOrg->timeOfDeath = timeOfDeath;
   newOrg->alive = alive;
   return newOrg;
 }
+
+// genomes and brains are saved in iteration order (with the bucket count) and
+// added back in reverse order, so they are iterated in the same order after a
+// checkpoint is loaded (i.e. mutations happen in the same order)
+template <class T>
+static void saveNames(CheckpointWriter &checkpoint,
+                      std::unordered_map<std::string, T> &map) {
+  checkpoint.write(static_cast<uint64_t>(map.bucket_count()));
+  std::vector<std::string> names;
+  for (auto const &element : map) {
+    names.push_back(element.first);
+  }
+  checkpoint.write(names);
+}
+
+template <class T>
+static std::vector<std::string> loadNames(CheckpointReader &checkpoint,
+                                          std::unordered_map<std::string, T> &map) {
+  auto bucketCount = checkpoint.read<uint64_t>();
+  map = {};
+  if (bucketCount > 1) {
+    map.rehash(bucketCount);
+  }
+  auto names = checkpoint.read<std::vector<std::string>>();
+  std::reverse(names.begin(), names.end());
+  return names;
+}
+
+void Organism::saveCheckpoint(CheckpointWriter &checkpoint) {
+  checkpoint.write(ID);
+  checkpoint.write(lineageID);
+  checkpoint.write(timeOfBirth);
+  checkpoint.write(timeOfDeath);
+  checkpoint.write(alive);
+  checkpoint.write(trackOrganism);
+  checkpoint.write(offspringCount);
+  checkpoint.write(ancestors);
+  checkpoint.write(snapshotAncestors);
+  dataMap.saveCheckpoint(checkpoint);
+  checkpoint.write(static_cast<uint64_t>(snapShotDataMaps.size()));
+  for (auto &snapShot : snapShotDataMaps) {
+    checkpoint.write(snapShot.first);
+    snapShot.second.saveCheckpoint(checkpoint);
+  }
+
+  saveNames(checkpoint, genomes);
+  for (auto const &genome : genomes) {
+    auto name = "GENOME_" + genome.first;
+    genome.second->saveCheckpoint(checkpoint, name);
+  }
+  saveNames(checkpoint, brains);
+  for (auto const &brain : brains) {
+    auto name = "BRAIN_" + brain.first;
+    brain.second->saveCheckpoint(checkpoint, name);
+  }
+}
+
+void Organism::loadCheckpoint(CheckpointReader &checkpoint,
+                              const std::shared_ptr<Organism> &templateOrg,
+                              std::shared_ptr<ParametersTable> PT_) {
+  PT = std::move(PT_);
+  checkpoint.read(ID);
+  checkpoint.read(lineageID);
+  checkpoint.read(timeOfBirth);
+  checkpoint.read(timeOfDeath);
+  checkpoint.read(alive);
+  checkpoint.read(trackOrganism);
+  checkpoint.read(offspringCount);
+  checkpoint.read(ancestors);
+  checkpoint.read(snapshotAncestors);
+  dataMap.loadCheckpoint(checkpoint);
+  snapShotDataMaps.clear();
+  auto snapShotCount = checkpoint.read<uint64_t>();
+  for (uint64_t i = 0; i < snapShotCount; i++) {
+    auto update = checkpoint.read<int>();
+    snapShotDataMaps[update].loadCheckpoint(checkpoint);
+  }
+
+  auto genomeNames = loadNames(checkpoint, genomes);
+  std::unordered_map<std::string, std::shared_ptr<AbstractGenome>> loaded;
+  for (auto genomeName = genomeNames.rbegin(); genomeName != genomeNames.rend();
+       ++genomeName) {
+    auto templateGenome = templateOrg->genomes.find(*genomeName);
+    if (templateGenome == templateOrg->genomes.end()) {
+      std::cout << "  In Organism::loadCheckpoint :: checkpoint has genome \""
+                << *genomeName << "\" which is not used in this run.\n  Exiting."
+                << std::endl;
+      exit(1);
+    }
+    auto name = "GENOME_" + *genomeName;
+    loaded[*genomeName] = templateGenome->second->makeLike();
+    loaded[*genomeName]->loadCheckpoint(checkpoint, name);
+  }
+  for (auto const &genomeName : genomeNames) {
+    genomes[genomeName] = loaded[genomeName];
+  }
+
+  auto brainNames = loadNames(checkpoint, brains);
+  std::unordered_map<std::string, std::shared_ptr<AbstractBrain>> loadedBrains;
+  for (auto brainName = brainNames.rbegin(); brainName != brainNames.rend();
+       ++brainName) {
+    auto templateBrain = templateOrg->brains.find(*brainName);
+    if (templateBrain == templateOrg->brains.end()) {
+      std::cout << "  In Organism::loadCheckpoint :: checkpoint has brain \""
+                << *brainName << "\" which is not used in this run.\n  Exiting."
+                << std::endl;
+      exit(1);
+    }
+    auto name = "BRAIN_" + *brainName;
+    loadedBrains[*brainName] = templateBrain->second->makeBrain(genomes);
+    loadedBrains[*brainName]->loadCheckpoint(checkpoint, name);
+  }
+  for (auto const &brainName : brainNames) {
+    brains[brainName] = loadedBrains[brainName];
+  }
+}
@@ -11,16 +11,18 @@
 #pragma once
 
 #include <cstdlib>
+#include <memory>
 #include <vector>
 #include <unordered_set>
 
 #include <Brain/AbstractBrain.h>
 #include <Genome/AbstractGenome.h>
 
+#include <Utilities/Checkpoint.h>
 #include <Utilities/Data.h>
 #include <Utilities/Parameters.h>
 
-class Organism {
+class Organism : public std::enable_shared_from_this<Organism> {
 private:
   static int organismIDCounter; // used to issue unique ids to Genomes
   int registerOrganism();       // get an Organism_id (uses organismIDCounter)
@@ -44,6 +46,12 @@ public:
       parents; // parents are pointers to parents of
                // this organism. In asexual populations
                // this will have one element
+  std::vector<Organism *>
+      offspring; // offspring in memory which list this organism in their
+                 // parents (kept in step with parents, see clearParents)
+  int lineageID; // ID of the parentless organism this organism's line
+                 // (through parents[0]) started from. This does not change
+                 // when older ancestors are pruned.
   std::unordered_set<int>
       ancestors; // list of the IDs of organisms in the last data
                  // files who are ancestors of this organism
@@ -97,17 +105,49 @@ public:
 
   virtual void kill(); // sets alive = 0 (on org and in dataMap)
 
+  void clearParents(); // release parents (parents offspringCount is not changed)
+
   virtual std::vector<std::shared_ptr<Organism>>
   getLOD(std::shared_ptr<Organism> org);
   virtual std::shared_ptr<Organism>
   getMostRecentCommonAncestor(std::shared_ptr<Organism> org);
   virtual std::shared_ptr<Organism>
-  getMostRecentCommonAncestor(std::vector<std::shared_ptr<Organism>> LOD);
+  getMostRecentCommonAncestor(const std::vector<std::shared_ptr<Organism>> &LOD);
+  virtual std::vector<std::shared_ptr<Organism>>
+  getLODToMostRecentCommonAncestor(std::shared_ptr<Organism> root,
+                                   std::shared_ptr<Organism> org);
   virtual std::shared_ptr<Organism>
   makeMutatedOffspringFrom(std::shared_ptr<Organism> parent);
   virtual std::shared_ptr<Organism>
   makeMutatedOffspringFromMany(std::vector<std::shared_ptr<Organism>> from);
+  // the first half of makeMutatedOffspringFrom(Many): make mutated genomes and
+  // brains for an offspring, without making the offspring (which changes the
+  // parents). The offspring is then made with Organism(parent(s), newGenomes,
+  // newBrains, PT). Genomes and brains may change the parent genome/brain they
+  // are called on (but nothing else that is shared), so offspring with
+  // different first parents can be made on different threads
+  // (see TournamentOptimizer)
+  virtual void makeMutatedGenomesAndBrainsFrom(
+      std::shared_ptr<Organism> parent,
+      std::unordered_map<std::string, std::shared_ptr<AbstractGenome>> &newGenomes,
+      std::unordered_map<std::string, std::shared_ptr<AbstractBrain>> &newBrains);
+  virtual void makeMutatedGenomesAndBrainsFromMany(
+      std::vector<std::shared_ptr<Organism>> from,
+      std::unordered_map<std::string, std::shared_ptr<AbstractGenome>> &newGenomes,
+      std::unordered_map<std::string, std::shared_ptr<AbstractBrain>> &newBrains);
   virtual std::shared_ptr<Organism>
   makeCopy(std::shared_ptr<ParametersTable> PT_ = nullptr);
+
+  // save (or load) this organism, but not parents or offspring (see
+  // Group::saveCheckpoint). when loading, genomes are made like the genomes
+  // in templateOrg and brains are built from them by the brains in templateOrg
+  virtual void saveCheckpoint(CheckpointWriter &checkpoint);
+  virtual void loadCheckpoint(CheckpointReader &checkpoint,
+                              const std::shared_ptr<Organism> &templateOrg,
+                              std::shared_ptr<ParametersTable> PT_);
+
+  // the next ID that will be issued (saved in checkpoints)
+  static int getOrganismIDCounter() { return organismIDCounter; }
+  static void setOrganismIDCounter(int counter) { organismIDCounter = counter; }
 };
 
@@ -0,0 +1,140 @@
+#include <Genome/CircularGenome/CircularGenomeSites.h>
+
+#include <random>
+
+// CircularGenomeSites must always hold the same sites as a plain vector given the same edits
+// (edits are large enough that chunks are split, merged and shared between copies)
+
+// check sites against expected, site by site and with copySegment
+static void expectSameSites(const CircularGenomeSites<int>& sites, const std::vector<int>& expected, int edit) {
+	ASSERT_EQ(sites.size(), expected.size()) << "size differs after edit " << edit;
+	EXPECT_EQ(sites.empty(), expected.empty()) << "empty differs after edit " << edit;
+	for (size_t i = 0; i < expected.size(); i++) {
+		ASSERT_EQ(sites[i], expected[i]) << "site " << i << " differs after edit " << edit;
+	}
+	std::vector<int> segment;
+	sites.copySegment(0, sites.size(), segment);
+	EXPECT_EQ(segment, expected) << "copySegment of all sites differs after edit " << edit;
+}
+
+TEST(CircularGenomeSites, PushBackAndSet) {
+	CircularGenomeSites<int> sites;
+	std::vector<int> expected;
+	for (int i = 0; i < 5000; i++) {
+		sites.push_back(i);
+		expected.push_back(i);
+	}
+	expectSameSites(sites, expected, 0);
+	for (int i = 0; i < 5000; i += 7) {
+		sites.set(i, -i);
+		expected[i] = -i;
+	}
+	expectSameSites(sites, expected, 1);
+}
+
+TEST(CircularGenomeSites, RandomEdits) {
+	std::mt19937 generator(101);
+	auto randomInt = [&](int low, int high) { // [low, high]
+		return std::uniform_int_distribution<int>(low, high)(generator);
+	};
+
+	CircularGenomeSites<int> sites;
+	std::vector<int> expected;
+	sites.resize(3000);
+	expected.resize(3000);
+	expectSameSites(sites, expected, -1);
+
+	// copies made during the edits, with the sites they had when made. editing
+	// the sites must never change a copy (chunks are shared until written)
+	std::vector<CircularGenomeSites<int>> copies;
+	std::vector<std::vector<int>> copiesExpected;
+
+	for (int edit = 0; edit < 2000; edit++) {
+		int size = (int)expected.size();
+		switch (randomInt(0, 7)) {
+		case 0: case 1: { // point changes
+			for (int i = randomInt(1, 20); i > 0 && size > 0; i--) {
+				int index = randomInt(0, size - 1);
+				int value = randomInt(0, 255);
+				sites.set(index, value);
+				expected[index] = value;
+			}
+			break;
+		}
+		case 2: { // insert a segment (some large enough to split chunks)
+			std::vector<int> segment(randomInt(1, 2) == 1 ? randomInt(1, 50) : randomInt(1, 5000));
+			for (auto& value : segment) {
+				value = randomInt(0, 255);
+			}
+			int index = randomInt(0, size);
+			sites.insert(index, segment);
+			expected.insert(expected.begin() + index, segment.begin(), segment.end());
+			break;
+		}
+		case 3: { // erase (some large enough to remove whole chunks)
+			if (size > 0) {
+				int start = randomInt(0, size - 1);
+				int end = std::min(size, start + (randomInt(1, 2) == 1 ? randomInt(1, 50) : randomInt(1, 3000)));
+				sites.erase(start, end);
+				expected.erase(expected.begin() + start, expected.begin() + end);
+			}
+			break;
+		}
+		case 4: { // copySegment
+			if (size > 0) {
+				int start = randomInt(0, size - 1);
+				int length = randomInt(0, size - start);
+				std::vector<int> segment;
+				sites.copySegment(start, length, segment);
+				EXPECT_EQ(segment, std::vector<int>(expected.begin() + start, expected.begin() + start + length)) << "copySegment(" << start << ", " << length << ") differs at edit " << edit;
+			}
+			break;
+		}
+		case 5: { // append part of a copy
+			CircularGenomeSites<int> other = sites;
+			if (size > 0) {
+				int start = randomInt(0, size - 1);
+				int end = randomInt(start, size);
+				sites.append(other, start, end);
+				expected.insert(expected.end(), expected.begin() + start, expected.begin() + end);
+			}
+			break;
+		}
+		case 6: { // resize (grow with T() or shrink), or push_back
+			if (randomInt(0, 1) == 0) {
+				int newSize = randomInt(0, size + 2000);
+				sites.resize(newSize);
+				expected.resize(newSize);
+			}
+			else {
+				int value = randomInt(0, 255);
+				sites.push_back(value);
+				expected.push_back(value);
+			}
+			break;
+		}
+		case 7: { // keep a copy, or clear
+			if (randomInt(0, 30) == 0) {
+				sites.clear();
+				expected.clear();
+			}
+			else {
+				copies.push_back(sites);
+				copiesExpected.push_back(expected);
+			}
+			break;
+		}
+		}
+		if (expected.size() > 20000) { // keep the test fast
+			sites.erase(10000, expected.size());
+			expected.resize(10000);
+		}
+		expectSameSites(sites, expected, edit);
+		if (::testing::Test::HasFatalFailure()) {
+			return;
+		}
+	}
+	for (size_t c = 0; c < copies.size(); c++) {
+		expectSameSites(copies[c], copiesExpected[c], -(int)c - 2);
+	}
+}
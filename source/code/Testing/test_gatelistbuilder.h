@@ -0,0 +1,111 @@
+#include <Brain/MarkovBrain/GateListBuilder/GateListBuilder.h>
+#include <Genome/CircularGenome/CircularGenome.h>
+#include <Utilities/Random.h>
+
+// the start codon index of a CircularGenome, and gate lists built with buildGateListFrom (which reuses
+// the parent's gates where sites have not changed) must match what is found by reading the whole genome
+
+// a random genome seeded with start codons (like MarkovBrain::initializeGenomes)
+static std::shared_ptr<AbstractGenome> makeSeededGenome(ClassicGateListBuilder& builder, int codonMax) {
+	auto genome = std::make_shared<CircularGenome<int>>(codonMax + 1, 5000, Parameters::root);
+	genome->fillRandom();
+	auto genomeHandler = genome->newHandler(genome);
+	for (auto gateType : builder.gateBuilder.inUseGateTypes) {
+		for (int i = 0; i < 30; i++) {
+			genomeHandler->randomize();
+			for (auto value : builder.gateBuilder.gateStartCodes[gateType]) {
+				genomeHandler->writeInt(value, 0, codonMax);
+			}
+		}
+	}
+	return genome;
+}
+
+// gates are made with genome values as addresses, the brain then maps them to nodes (see MarkovBrain::makeNodeMap)
+static std::vector<std::string> describeGates(std::vector<std::shared_ptr<AbstractGate>>& gates, const GateListTranslation& translation, int nrNodes) {
+	std::vector<int> nodeMap;
+	for (int i = 0; i < (1 << Gate_Builder::bitsPerBrainAddressPL->get()); i++) {
+		nodeMap.push_back(i % nrNodes);
+	}
+	std::vector<std::string> descriptions;
+	for (size_t g = 0; g < gates.size(); g++) {
+		if (g >= translation.reused.size() || !translation.reused[g]) { // copied gates are already mapped
+			gates[g]->applyNodeMap(nodeMap, nrNodes);
+		}
+		descriptions.push_back(gates[g]->description());
+	}
+	return descriptions;
+}
+
+TEST(CircularGenome, StartCodonSitesMatchScan) {
+	Random::getCommonGenerator().seed(102);
+	int codonMax = 255;
+	std::vector<int> startCodes(codonMax + 1);
+	for (int codon = 0; codon <= codonMax; codon++) {
+		startCodes[codon] = codonMax - codon;
+	}
+
+	std::shared_ptr<AbstractGenome> genome = std::make_shared<CircularGenome<int>>(codonMax + 1, 5000, Parameters::root);
+	genome->fillRandom();
+	genome->getStartCodonSites(startCodes); // build the index, from here on mutate must keep it up to date
+	for (int generation = 0; generation < 300; generation++) {
+		genome = genome->makeMutatedGenomeFrom(genome);
+
+		// every site p where p and p+1 are a start codon, found by reading the genome in order
+		std::vector<int> scanned;
+		auto handler = genome->newHandler(genome);
+		int size = genome->countSites();
+		int previous = handler->readInt(0, codonMax);
+		for (int p = 0; p + 1 < size; p++) {
+			int next = handler->readInt(0, codonMax);
+			if (startCodes[previous] == next) {
+				scanned.push_back(p);
+			}
+			previous = next;
+		}
+
+		auto indexed = genome->getStartCodonSites(startCodes);
+		ASSERT_NE(indexed, nullptr) << "CircularGenome did not provide a start codon index";
+		ASSERT_EQ(*indexed, scanned) << "start codon index differs from scan in generation " << generation;
+	}
+}
+
+TEST(ClassicGateListBuilder, BuildGateListFromMatchesBuildGateList) {
+	Random::getCommonGenerator().seed(103);
+	int nrNodes = 16;
+	ClassicGateListBuilder builder(Parameters::root);
+	int codonMax = (1 << Gate_Builder::bitsPerCodonPL->get()) - 1;
+
+	int reusedCount = 0;
+	// without selection gates are lost as the genome mutates, so each lineage starts from a new seeded genome
+	for (int lineage = 0; lineage < 15; lineage++) {
+		auto genome = makeSeededGenome(builder, codonMax);
+		GateListTranslation translation;
+		auto gates = builder.buildGateListFrom(genome, nrNodes, {}, GateListTranslation(), translation, Parameters::root);
+		describeGates(gates, translation, nrNodes);
+
+		for (int generation = 0; generation < 20; generation++) {
+			// the child is made (with some point mutations, and sometimes an insertion or deletion)
+			// from the last child, so reused gates are also reused from gates which were reused
+			auto childGenome = genome->makeMutatedGenomeFrom(genome);
+			GateListTranslation childTranslation;
+			auto childGates = builder.buildGateListFrom(childGenome, nrNodes, gates, translation, childTranslation, Parameters::root);
+			auto childDescriptions = describeGates(childGates, childTranslation, nrNodes);
+
+			auto fullGates = builder.buildGateList(childGenome, nrNodes, Parameters::root);
+			auto fullDescriptions = describeGates(fullGates, GateListTranslation(), nrNodes);
+
+			ASSERT_EQ(childDescriptions.size(), fullDescriptions.size()) << "gate count differs in lineage " << lineage << " generation " << generation;
+			for (size_t g = 0; g < fullDescriptions.size(); g++) {
+				ASSERT_EQ(childDescriptions[g], fullDescriptions[g]) << "gate " << g << " differs in lineage " << lineage << " generation " << generation;
+				ASSERT_EQ(childGates[g]->ID, fullGates[g]->ID) << "gate " << g << " ID differs in lineage " << lineage << " generation " << generation;
+			}
+			reusedCount += (int)std::count(childTranslation.reused.begin(), childTranslation.reused.end(), true);
+
+			genome = childGenome;
+			gates = childGates;
+			translation = childTranslation;
+		}
+	}
+	EXPECT_GT(reusedCount, 0) << "no gates were reused, so buildGateListFrom was not tested";
+}
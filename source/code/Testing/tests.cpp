@@ -1,7 +1,11 @@
 #include <gtest/gtest.h>
 #include <iostream>
 
+#include <Utilities/gitversion.h> // defines gitversion (in mabe this is done by main.cpp)
+
 #include "test_graycode.h"
+#include "test_circulargenomesites.h"
+#include "test_gatelistbuilder.h"
 
 int main(int argc, char* argv[]) {
 	testing::InitGoogleTest(&argc, argv);
@@ -0,0 +1,154 @@
+//  MABE is a product of The Hintze Lab @ MSU
+//     for general research information:
+//         hintzelab.msu.edu
+//     for MABE documentation:
+//         github.com/Hintzelab/MABE/wiki
+//
+//  Copyright (c) 2015 Michigan State University. All rights reserved.
+//     to view the full license, visit:
+//         github.com/Hintzelab/MABE/wiki/License
+
+#include "Checkpoint.h"
+
+#include <cstdio>
+#include <iostream>
+
+static const std::string checkpointMagic = "MABECKP1";
+
+CheckpointWriter::CheckpointWriter(const std::string &_fileName)
+    : fileName(_fileName), out(&file) {
+  file.open(fileName + ".tmp", std::ios::out | std::ios::binary);
+  if (!file.is_open()) {
+    std::cout << "  In CheckpointWriter :: unable to open \"" << fileName
+              << ".tmp\" for writing.\n  Exiting." << std::endl;
+    exit(1);
+  }
+  file.write(checkpointMagic.data(), checkpointMagic.size());
+}
+
+CheckpointWriter::CheckpointWriter()
+    : memory(std::ios::out | std::ios::binary), out(&memory) {
+  memory.write(checkpointMagic.data(), checkpointMagic.size());
+}
+
+CheckpointWriter::~CheckpointWriter() { close(); }
+
+void CheckpointWriter::close() {
+  if (closed) {
+    return;
+  }
+  closed = true;
+  if (fileName.empty()) { // memory
+    return;
+  }
+  file.close();
+  if (file.fail()) {
+    std::cout << "  In CheckpointWriter :: error while writing \"" << fileName
+              << ".tmp\".\n  Exiting." << std::endl;
+    exit(1);
+  }
+  std::remove(fileName.c_str()); // (rename will not replace a file on windows)
+  if (std::rename((fileName + ".tmp").c_str(), fileName.c_str()) != 0) {
+    std::cout << "  In CheckpointWriter :: unable to rename \"" << fileName
+              << ".tmp\" to \"" << fileName << "\".\n  Exiting." << std::endl;
+    exit(1);
+  }
+}
+
+std::string CheckpointWriter::data() const { return memory.str(); }
+
+void CheckpointWriter::section(const std::string &name) { write(name); }
+
+void CheckpointWriter::write(const std::string &value) {
+  write(static_cast<uint64_t>(value.size()));
+  out->write(value.data(), value.size());
+}
+
+void CheckpointWriter::write(const std::unordered_set<int> &values) {
+  write(static_cast<uint64_t>(values.bucket_count()));
+  write(static_cast<uint64_t>(values.size()));
+  for (auto value : values) {
+    write(value);
+  }
+}
+
+CheckpointReader::CheckpointReader(const std::string &_fileName)
+    : fileName(_fileName), in(&file) {
+  file.open(fileName, std::ios::in | std::ios::binary);
+  if (!file.is_open()) {
+    std::cout << "  In CheckpointReader :: unable to open checkpoint file \""
+              << fileName << "\".\n  Exiting." << std::endl;
+    exit(1);
+  }
+  checkMagic();
+}
+
+CheckpointReader::CheckpointReader(const char *data, size_t size)
+    : fileName("memory"), memory(std::string(data, size),
+                                 std::ios::in | std::ios::binary),
+      in(&memory) {
+  checkMagic();
+}
+
+void CheckpointReader::checkMagic() {
+  std::string magic(checkpointMagic.size(), ' ');
+  in->read(&magic[0], magic.size());
+  if (!*in || magic != checkpointMagic) {
+    std::cout << "  In CheckpointReader :: \"" << fileName
+              << "\" is not a MABE checkpoint file.\n  Exiting." << std::endl;
+    exit(1);
+  }
+}
+
+void CheckpointReader::check() {
+  if (!*in) {
+    std::cout << "  In CheckpointReader :: checkpoint file \"" << fileName
+              << "\" is truncated or corrupt.\n  Exiting." << std::endl;
+    exit(1);
+  }
+}
+
+void CheckpointReader::section(const std::string &name) {
+  std::string found;
+  read(found);
+  if (found != name) {
+    std::cout << "  In CheckpointReader :: expected \"" << name
+              << "\" but found \"" << found << "\" in checkpoint file \""
+              << fileName
+              << "\".\n  The checkpoint may have been made with different "
+                 "settings.\n  Exiting."
+              << std::endl;
+    exit(1);
+  }
+}
+
+void CheckpointReader::read(std::string &value) {
+  uint64_t size;
+  read(size);
+  if (size > (1ull << 40)) { // not a real string
+    in->setstate(std::ios::failbit);
+    check();
+  }
+  value.resize(size);
+  in->read(&value[0], size);
+  check();
+}
+
+void CheckpointReader::read(std::unordered_set<int> &values) {
+  uint64_t bucketCount, size;
+  read(bucketCount);
+  read(size);
+  std::vector<int> order(size);
+  for (auto &value : order) {
+    read(value);
+  }
+  values = std::unordered_set<int>(); // (clear would keep the old buckets)
+  if (bucketCount > 1) {
+    values.rehash(bucketCount);
+  }
+  // an insert places a value first in it's bucket (or first in the set if the
+  // bucket was empty), so inserting in reverse gives back the written order
+  for (auto value = order.rbegin(); value != order.rend(); ++value) {
+    values.insert(*value);
+  }
+}
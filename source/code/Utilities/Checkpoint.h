@@ -0,0 +1,117 @@
+//  MABE is a product of The Hintze Lab @ MSU
+//     for general research information:
+//         hintzelab.msu.edu
+//     for MABE documentation:
+//         github.com/Hintzelab/MABE/wiki
+//
+//  Copyright (c) 2015 Michigan State University. All rights reserved.
+//     to view the full license, visit:
+//         github.com/Hintzelab/MABE/wiki/License
+
+#pragma once
+
+#include <cstdint>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <type_traits>
+#include <unordered_set>
+#include <vector>
+
+// A checkpoint holds the state of a run (population, lineage, archivists,
+// random number generator, output files...) so that the run can be stopped
+// and later continued (see GLOBAL-checkpointInterval and the -r command line
+// option) with the same results as if it had never stopped.
+// Each part of MABE writes its own state with a CheckpointWriter and reads it
+// back, in the same order, with a CheckpointReader.
+// A writer made without a file name writes to memory (see data()), i.e. to
+// send organisms to another process (see IslandsOptimizer).
+//
+// file layout (native byte order):
+//   "MABECKP1", then sections. a section is a name (see section()) followed by
+//   what ever the owner of the section wrote.
+// Strings and vectors are stored as a uint64 size followed by the elements.
+
+class CheckpointWriter {
+public:
+  // data is written to fileName.tmp, close() replaces fileName, so an
+  // existing checkpoint is not lost if MABE stops while writing
+  explicit CheckpointWriter(const std::string &fileName);
+  CheckpointWriter(); // write to memory
+  ~CheckpointWriter(); // calls close()
+
+  std::string data() const; // everything written so far (memory only)
+
+  void close();
+
+  void section(const std::string &name); // start a section
+
+  template <typename T> void write(const T &value) {
+    static_assert(std::is_trivially_copyable<T>::value,
+                  "CheckpointWriter::write - use a write for this type");
+    out->write(reinterpret_cast<const char *>(&value), sizeof(T));
+  }
+  void write(const std::string &value);
+  template <typename T> void write(const std::vector<T> &values) {
+    write(static_cast<uint64_t>(values.size()));
+    for (auto value : values) { // (by value, for vector<bool>)
+      write(static_cast<T>(value));
+    }
+  }
+  // sets are written in iteration order with the bucket count, so that the
+  // set read back is iterated in the same order (and stays that way)
+  void write(const std::unordered_set<int> &values);
+
+private:
+  std::string fileName; // empty if writing to memory
+  std::ofstream file;
+  std::ostringstream memory;
+  std::ostream *out;
+  bool closed = false;
+};
+
+class CheckpointReader {
+public:
+  explicit CheckpointReader(const std::string &fileName);
+  CheckpointReader(const char *data, size_t size); // read from memory
+
+  const std::string &getFileName() const { return fileName; }
+
+  // read a section name and exit with an error if it is not name (i.e. the
+  // checkpoint was made with different settings)
+  void section(const std::string &name);
+
+  template <typename T> void read(T &value) {
+    static_assert(std::is_trivially_copyable<T>::value,
+                  "CheckpointReader::read - use a read for this type");
+    in->read(reinterpret_cast<char *>(&value), sizeof(T));
+    check();
+  }
+  void read(std::string &value);
+  template <typename T> void read(std::vector<T> &values) {
+    uint64_t size;
+    read(size);
+    values.clear();
+    for (uint64_t i = 0; i < size; i++) {
+      T value;
+      read(value);
+      values.push_back(value);
+    }
+  }
+  void read(std::unordered_set<int> &values);
+
+  template <typename T> T read() {
+    T value;
+    read(value);
+    return value;
+  }
+
+private:
+  std::string fileName; // "memory" if reading from memory
+  std::ifstream file;
+  std::istringstream memory;
+  std::istream *in;
+
+  void checkMagic();
+  void check(); // exit if the last read failed
+};
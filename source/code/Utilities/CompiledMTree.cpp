@@ -0,0 +1,322 @@
+//  MABE is a product of The Hintze Lab @ MSU
+//     for general research information:
+//         hintzelab.msu.edu
+//     for MABE documentation:
+//         github.com/Hintzelab/MABE/wiki
+//
+//  Copyright (c) 2015 Michigan State University. All rights reserved.
+//     to view the full license, visit:
+//         github.com/Hintzelab/MABE/wiki/License
+
+#include "CompiledMTree.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <map>
+
+#include "Random.h"
+#include "../Global.h"
+
+CompiledMTree::CompiledMTree(std::shared_ptr<Abstract_MTree> _tree)
+    : tree(_tree) {
+  compile(tree, code);
+  stack.resize(code.size() + 1); // no instruction pushes more then one value
+}
+
+double CompiledMTree::eval(DataMap &dataMap, std::shared_ptr<ParametersTable> PT,
+                           const std::vector<std::vector<double>> &vectorData) {
+  return run(code, stack.data(), dataMap, PT, vectorData);
+}
+
+bool CompiledMTree::compile(std::shared_ptr<Abstract_MTree> node,
+                            std::vector<Instruction> &program) {
+  static const std::map<std::string, Op> branchOps = {
+      {"SUM", SUM},         {"MULT", MULT},       {"SUBTRACT", SUBTRACT},
+      {"DIVIDE", DIVIDE},   {"POW", POW},         {"SIN", SIN},
+      {"COS", COS},         {"ABS", ABS},         {"MOD", MOD},
+      {"MIN", MIN},         {"MAX", MAX},         {"REMAP", REMAP},
+      {"SIGMOID", SIGMOID}, {"RANDOM", RANDOM},   {"VECT", VECT},
+      {"IF", JUMP_IF_NOT_POSITIVE}};
+
+  auto type = node->type();
+  Instruction instruction;
+
+  // leaves
+  if (type == "CONST" && std::dynamic_pointer_cast<CONST_MTree>(node)) {
+    instruction.op = CONST;
+    instruction.value = std::dynamic_pointer_cast<CONST_MTree>(node)->value;
+    program.push_back(instruction);
+    return true;
+  }
+  if (type == "DM_AVE" && std::dynamic_pointer_cast<fromDataMapAve_MTree>(node)) {
+    instruction.op = DM_AVE;
+    instruction.slot = std::dynamic_pointer_cast<fromDataMapAve_MTree>(node)->slot;
+    program.push_back(instruction);
+    return true;
+  }
+  if (type == "DM_SUM" && std::dynamic_pointer_cast<fromDataMapSum_MTree>(node)) {
+    instruction.op = DM_SUM;
+    instruction.slot = std::dynamic_pointer_cast<fromDataMapSum_MTree>(node)->slot;
+    program.push_back(instruction);
+    return true;
+  }
+  if (type == "UPDATE") {
+    instruction.op = UPDATE;
+    program.push_back(instruction);
+    return true;
+  }
+
+  auto branchOp = branchOps.find(type);
+  bool known = branchOp != branchOps.end();
+  std::vector<std::vector<Instruction>> parts(node->branches.size());
+  std::vector<bool> partIsPure(node->branches.size());
+  bool pure = true;
+  bool constant = true; // all branches are a single CONST
+  if (known) {
+    for (size_t i = 0; i < node->branches.size(); i++) {
+      partIsPure[i] = compile(node->branches[i], parts[i]);
+      pure = pure && partIsPure[i];
+      constant = constant && parts[i].size() == 1 && parts[i][0].op == CONST;
+    }
+  }
+  Op op = known ? branchOp->second : TREE;
+
+  if (!known || (!pure && (op == MOD || op == DIVIDE || op == RANDOM))) {
+    // run this node with it's own eval
+    instruction.op = TREE;
+    instruction.arg = static_cast<int>(trees.size());
+    trees.push_back(node);
+    program.push_back(instruction);
+    return false;
+  }
+
+  std::vector<Instruction> fragment;
+  auto append = [&fragment](const std::vector<Instruction> &part) {
+    fragment.insert(fragment.end(), part.begin(), part.end());
+  };
+
+  if (op == JUMP_IF_NOT_POSITIVE) { // IF[test,then,else]
+    if (parts[0].size() == 1 && parts[0][0].op == CONST) { // test is constant
+      auto taken = parts[0][0].value > 0 ? 1 : 2;
+      program.insert(program.end(), parts[taken].begin(), parts[taken].end());
+      return partIsPure[taken];
+    }
+    append(parts[0]);
+    instruction.op = JUMP_IF_NOT_POSITIVE;
+    instruction.arg = static_cast<int>(parts[1].size()) + 1;
+    fragment.push_back(instruction);
+    append(parts[1]);
+    instruction.op = JUMP;
+    instruction.arg = static_cast<int>(parts[2].size());
+    fragment.push_back(instruction);
+    append(parts[2]);
+  } else if (op == DIVIDE) { // numerator is only used if denominator is not 0
+    append(parts[1]);
+    instruction.op = JUMP_IF_ZERO;
+    instruction.arg = static_cast<int>(parts[0].size()) + 1;
+    fragment.push_back(instruction);
+    append(parts[0]);
+    instruction.op = DIVIDE;
+    fragment.push_back(instruction);
+  } else if (op == MOD) { // MOD evaluates the divisor first
+    append(parts[1]);
+    append(parts[0]);
+    instruction.op = MOD;
+    fragment.push_back(instruction);
+  } else {
+    for (auto &part : parts) {
+      append(part);
+    }
+    instruction.op = op;
+    instruction.arg = static_cast<int>(parts.size());
+    fragment.push_back(instruction);
+  }
+
+  if (constant && op != RANDOM && op != VECT) { // fold
+    std::vector<double> foldStack(fragment.size() + 1);
+    DataMap emptyDataMap;
+    instruction = Instruction();
+    instruction.op = CONST;
+    instruction.value =
+        run(fragment, foldStack.data(), emptyDataMap, nullptr, {});
+    program.push_back(instruction);
+    return true;
+  }
+
+  program.insert(program.end(), fragment.begin(), fragment.end());
+  return pure && op != RANDOM;
+}
+
+// the math here must match the eval functions in MTree.h and MTree.cpp
+double CompiledMTree::run(const std::vector<Instruction> &program,
+                          double *stackBase, DataMap &dataMap,
+                          std::shared_ptr<ParametersTable> PT,
+                          const std::vector<std::vector<double>> &vectorData) {
+  double *top = stackBase - 1; // last value on the stack
+  size_t programSize = program.size();
+  for (size_t pc = 0; pc < programSize; pc++) {
+    const Instruction &instruction = program[pc];
+    int n = instruction.arg;
+    switch (instruction.op) {
+    case CONST:
+      *++top = instruction.value;
+      break;
+    case DM_AVE:
+      *++top = dataMap.getAverage(instruction.slot);
+      break;
+    case DM_SUM:
+      *++top = dataMap.getSum(instruction.slot);
+      break;
+    case UPDATE:
+      *++top = (double)Global::update;
+      break;
+    case TREE:
+      *++top = trees[n]->eval(dataMap, PT, vectorData)[0];
+      break;
+    case SUM: {
+      top -= n; // values are top[1] ... top[n]
+      double value = 0;
+      for (int i = 1; i <= n; i++) {
+        value += top[i];
+      }
+      *++top = value;
+      break;
+    }
+    case MULT: {
+      top -= n;
+      double value = 1;
+      for (int i = 1; i <= n; i++) {
+        value *= top[i];
+      }
+      *++top = value;
+      break;
+    }
+    case SUBTRACT:
+      top--;
+      *top = *top - top[1];
+      break;
+    case DIVIDE: { // stack is denominator, numerator
+      double numerator = *top--;
+      *top = numerator / *top;
+      break;
+    }
+    case POW:
+      top--;
+      *top = pow(*top, top[1]);
+      break;
+    case SIN:
+      *top = sin(*top);
+      break;
+    case COS:
+      *top = cos(*top);
+      break;
+    case ABS:
+      *top = std::abs(*top);
+      break;
+    case MOD: { // stack is divisor, value
+      int value = (int)*top--;
+      int divisor = ((int)*top == 0) ? (int)1 : (int)*top;
+      *top = value % divisor;
+      break;
+    }
+    case MIN: {
+      top -= n;
+      double value = top[1];
+      for (int i = 2; i <= n; i++) {
+        value = std::min(value, top[i]);
+      }
+      *++top = value;
+      break;
+    }
+    case MAX: {
+      top -= n;
+      double value = top[1];
+      for (int i = 2; i <= n; i++) {
+        value = std::max(value, top[i]);
+      }
+      *++top = value;
+      break;
+    }
+    case REMAP: {
+      top -= n;
+      double v = top[1];
+      double oldMin = (n > 2) ? top[2] : 0;
+      double oldMax = (n > 2) ? top[3] : 1;
+      double newMin = (n > 4) ? top[4] : 0;
+      double newMax = (n > 4) ? top[5] : 1;
+      // if min and max are the same, return middle of new range
+      *++top = (oldMax == oldMin)
+                   ? ((newMax + newMin) / 2)
+                   : ((std::max(std::min(v, oldMax), oldMin) - oldMin) *
+                      (1 / (oldMax - oldMin)) * (newMax - newMin)) +
+                         newMin;
+      break;
+    }
+    case SIGMOID: {
+      top -= n;
+      double v = top[1];
+      double e = top[2];
+      if (n > 2) { // if oldMin/oldMax are provided, use them
+        double oldMin = top[3];
+        double oldMax = top[4];
+        v = ((std::max(std::min(v, oldMax), oldMin)) - oldMin) * (1 / (oldMax - oldMin));
+      } else { // if not, clamp to [0,1]
+        v = std::max(std::min(v, 1.0), 0.0);
+      }
+      *++top = (v <= .5) ? pow(v * 2, e) / 2 : 1 - pow((1 - v) * 2, e) / 2;
+      break;
+    }
+    case RANDOM:
+      top--;
+      *top = Random::getDouble(*top, top[1]);
+      break;
+    case VECT: {
+      top--;
+      int whichVect = std::max(0, (int)*top % (int)vectorData.size());
+      int whichVal =
+          std::max(0, (int)top[1] % (int)vectorData[whichVect].size());
+      *top = vectorData[whichVect][whichVal];
+      break;
+    }
+    case JUMP:
+      pc += n;
+      break;
+    case JUMP_IF_NOT_POSITIVE:
+      if (!(*top-- > 0)) {
+        pc += n;
+      }
+      break;
+    case JUMP_IF_ZERO:
+      if (*top == 0) {
+        *top = 0;
+        pc += n;
+      }
+      break;
+    }
+  }
+  return *top;
+}
+
+void CompiledMTree::show() {
+  static const std::vector<std::string> opNames = {
+      "CONST", "DM_AVE", "DM_SUM", "UPDATE",  "TREE",    "SUM",
+      "MULT",  "SUBTRACT", "DIVIDE", "POW",   "SIN",     "COS",
+      "ABS",   "MOD",    "MIN",    "MAX",     "REMAP",   "SIGMOID",
+      "RANDOM", "VECT",  "JUMP",   "JUMP_IF_NOT_POSITIVE", "JUMP_IF_ZERO"};
+  std::cout << "compiled " << tree->getFormula() << " :" << std::endl;
+  for (size_t pc = 0; pc < code.size(); pc++) {
+    auto &instruction = code[pc];
+    std::cout << "  " << pc << "\t" << opNames[instruction.op];
+    if (instruction.op == CONST) {
+      std::cout << " " << instruction.value;
+    } else if (instruction.op == DM_AVE || instruction.op == DM_SUM) {
+      std::cout << " " << DataMap::keyOf(instruction.slot);
+    } else if (instruction.op == TREE) {
+      std::cout << " " << trees[instruction.arg]->getFormula();
+    } else if (instruction.arg != 0) {
+      std::cout << " " << instruction.arg;
+    }
+    std::cout << std::endl;
+  }
+}
@@ -0,0 +1,96 @@
+//  MABE is a product of The Hintze Lab @ MSU
+//     for general research information:
+//         hintzelab.msu.edu
+//     for MABE documentation:
+//         github.com/Hintzelab/MABE/wiki
+//
+//  Copyright (c) 2015 Michigan State University. All rights reserved.
+//     to view the full license, visit:
+//         github.com/Hintzelab/MABE/wiki/License
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "Data.h"
+#include "MTree.h"
+#include "Parameters.h"
+
+// A flat (bytecode) version of an MTree, for formulas that are evaluated once
+// per organism (i.e. optimizeValue). When compiled, DataMap keys are resolved
+// to slots and sub trees with only constants are folded. eval runs the code on
+// a stack that is allocated once, so nothing is allocated per node.
+// eval returns the same value as tree->eval(...)[0].
+// Nodes that can not be compiled (MANY, MTrees that are not known here, or
+// MOD, DIVIDE, RANDOM and VECT with branches that use RANDOM, since these
+// evaluate branches more then once or out of order) are run with their own eval.
+// eval is not thread safe (each CompiledMTree has one stack).
+class CompiledMTree {
+public:
+  explicit CompiledMTree(std::shared_ptr<Abstract_MTree> _tree);
+
+  double eval(DataMap &dataMap, std::shared_ptr<ParametersTable> PT = nullptr,
+              const std::vector<std::vector<double>> &vectorData = {});
+
+  // scores[i] = eval(population[i]->dataMap, PT)
+  template <typename Population>
+  void evalAll(Population &population, std::shared_ptr<ParametersTable> PT,
+               std::vector<double> &scores) {
+    scores.resize(population.size());
+    for (size_t i = 0; i < population.size(); i++) {
+      scores[i] = eval(population[i]->dataMap, PT);
+    }
+  }
+
+  std::shared_ptr<Abstract_MTree> getTree() { return tree; }
+  size_t size() { return code.size(); } // number of instructions
+  void show();                          // print the code
+
+private:
+  enum Op {
+    CONST,
+    DM_AVE,
+    DM_SUM,
+    UPDATE,
+    TREE, // eval trees[arg]
+    SUM,  // arg = number of values
+    MULT, // arg = number of values
+    SUBTRACT,
+    DIVIDE,
+    POW,
+    SIN,
+    COS,
+    ABS,
+    MOD,
+    MIN,     // arg = number of values
+    MAX,     // arg = number of values
+    REMAP,   // arg = number of values
+    SIGMOID, // arg = number of values
+    RANDOM,
+    VECT,
+    JUMP,                 // skip arg instructions
+    JUMP_IF_NOT_POSITIVE, // pop, skip arg instructions if value <= 0
+    JUMP_IF_ZERO          // if top is 0, skip arg instructions
+  };
+
+  struct Instruction {
+    Op op;
+    int arg = 0;
+    double value = 0;
+    DataMap::Slot slot;
+  };
+
+  std::shared_ptr<Abstract_MTree> tree;
+  std::vector<std::shared_ptr<Abstract_MTree>> trees; // for TREE
+  std::vector<Instruction> code;
+  std::vector<double> stack;
+
+  // append code for node to program, return true if the code has no side
+  // effects (i.e. does not use RANDOM or TREE)
+  bool compile(std::shared_ptr<Abstract_MTree> node,
+               std::vector<Instruction> &program);
+  double run(const std::vector<Instruction> &program, double *stackBase,
+             DataMap &dataMap, std::shared_ptr<ParametersTable> PT,
+             const std::vector<std::vector<double>> &vectorData);
+};
@@ -9,12 +9,18 @@
 //         github.com/Hintzelab/MABE/wiki/License
 
 #include "Data.h"
+#include "Checkpoint.h"
+#include "Filesystem.h"
 
+#include <algorithm>
+#include <condition_variable>
 #include <cstring>
 #include <fstream>
 #include <iostream>
 #include <map>
 #include <memory>
+#include <shared_mutex>
+#include <thread>
 
 
 // global variables that should be accessible to all
@@ -22,69 +28,485 @@
 
 std::string FileManager::outputPrefix;
 std::map<std::string, std::vector<std::string>> FileManager::fileColumns;
-std::map<std::string, std::ofstream>
-    FileManager::files; // list of files (NAME,ofstream)
-std::map<std::string, bool>
-    FileManager::fileStates; // list of files states (NAME,open?)
+std::recursive_mutex FileManager::filesMutex;
+std::vector<std::unique_ptr<FileManager::OutputFile>> FileManager::outputFiles;
+std::unordered_map<std::string, FileManager::FileHandle>
+    FileManager::fileHandles;
+
+// Runs FileOps on it's own thread. submit only appends to a queue, the writer
+// takes the whole queue at once, writes it and then flushes the files it wrote
+// to. If the writer falls behind by more then maxQueuedBytes, submit waits.
+class FileManager::BackgroundWriter {
+  std::mutex queueMutex;
+  std::condition_variable hasWork;   // signaled when ops are queued (or on shutdown)
+  std::condition_variable hasSpace;  // signaled when the writer takes the queue
+  std::condition_variable isDrained; // signaled when the writer is idle
+  std::vector<FileOp> queue;
+  size_t queuedBytes = 0;
+  bool busy = false; // writer is working on ops taken from the queue
+  bool shuttingDown = false;
+  std::thread writer; // last, so everything above exists before it starts
+
+  static const size_t maxQueuedBytes = 64 * 1024 * 1024;
+
+  void writerLoop() {
+    std::vector<FileOp> batch;
+    std::vector<OutputFile *> written;
+    std::unique_lock<std::mutex> lock(queueMutex);
+    while (true) {
+      hasWork.wait(lock, [this] { return !queue.empty() || shuttingDown; });
+      if (queue.empty()) { // and shutting down
+        return;
+      }
+      batch.swap(queue);
+      queuedBytes = 0;
+      busy = true;
+      hasSpace.notify_all();
+      lock.unlock();
+
+      for (auto &op : batch) {
+        FileManager::performFileOp(op, true);
+        if (op.kind == FileOp::WRITE) {
+          written.push_back(op.file);
+        }
+      }
+      for (auto file : written) {
+        if (file->stream.is_open()) {
+          file->stream.flush();
+        }
+      }
+      batch.clear();
+      written.clear();
+
+      lock.lock();
+      busy = false;
+      if (queue.empty()) {
+        isDrained.notify_all();
+      }
+    }
+  }
+
+public:
+  BackgroundWriter() : writer(&BackgroundWriter::writerLoop, this) {}
+
+  ~BackgroundWriter() {
+    {
+      std::lock_guard<std::mutex> lock(queueMutex);
+      shuttingDown = true;
+    }
+    hasWork.notify_one();
+    writer.join(); // the writer empties the queue before it stops
+  }
+
+  void submit(FileOp op) {
+    std::unique_lock<std::mutex> lock(queueMutex);
+    hasSpace.wait(lock, [this] { return queuedBytes < maxQueuedBytes; });
+    queuedBytes += op.data.size();
+    queue.push_back(std::move(op));
+    hasWork.notify_one();
+  }
+
+  void waitUntilDrained() {
+    std::unique_lock<std::mutex> lock(queueMutex);
+    isDrained.wait(lock, [this] { return queue.empty() && !busy; });
+  }
+};
+
+// declared after outputFiles so it is destroyed (and finishes writing) first
+std::unique_ptr<FileManager::BackgroundWriter> FileManager::backgroundWriter;
+
 std::map<std::string, int> DataMap::knownOutputBehaviors = {
     {"LIST", LIST},     {"AVE", AVE},     {"SUM", SUM}, {"PROD", PROD},
     {"STDERR", STDERR}, {"FIRST", FIRST}, {"VAR", VAR}};
 
+FileManager::FileHandle FileManager::getHandle(const std::string &fileName) {
+  std::lock_guard<std::recursive_mutex> lock(filesMutex);
+  auto handle = fileHandles.find(fileName);
+  if (handle != fileHandles.end()) {
+    return handle->second;
+  }
+  outputFiles.push_back(std::make_unique<OutputFile>());
+  outputFiles.back()->name = fileName;
+  fileHandles[fileName] = static_cast<FileHandle>(outputFiles.size()) - 1;
+  return fileHandles[fileName];
+}
+
+bool FileManager::hasFile(const std::string &fileName) {
+  std::lock_guard<std::recursive_mutex> lock(filesMutex);
+  auto handle = fileHandles.find(fileName);
+  return handle != fileHandles.end() && outputFiles[handle->second]->created;
+}
+
 void FileManager::writeToFile(const std::string &fileName,
                               const std::string &data,
                               const std::string &header) {
-  openFile(
-      fileName,
-      header); // make sure that the file is open and ready to be written to
-  files[fileName] << data << "\n" << std::flush;
+  writeToFile(getHandle(fileName), data, header);
+}
+
+void FileManager::writeToFile(FileHandle file, const std::string &data,
+                              const std::string &header) {
+  std::lock_guard<std::recursive_mutex> lock(filesMutex);
+  auto &outputFile = *outputFiles.at(file);
+  openFile(outputFile,
+           header); // make sure that the file is open and ready to be written to
+  submit({FileOp::WRITE, &outputFile, data + "\n"});
 }
 
 void FileManager::openFile(const std::string &fileName, const std::string &header) {
-  if (files.find(fileName) ==
-      files.end()) { // if file has not be initialized yet
-    files.emplace(make_pair(fileName, std::ofstream())); // make an ofstream for the
-                                                    // new file and place in
-                                                    // FileManager::files
-    files[fileName].open(
-        std::string(outputPrefix) +
-        fileName);               // clear file contents and open in write mode
-    fileStates[fileName] = true; // this file is now open
+  std::lock_guard<std::recursive_mutex> lock(filesMutex);
+  openFile(*outputFiles[getHandle(fileName)], header);
+}
+
+void FileManager::openFile(OutputFile &file, const std::string &header) {
+  if (!file.created) { // if file has not be initialized yet
+    file.created = true;
+    file.open = true;
+    submit({FileOp::CREATE, &file,
+            std::string(outputPrefix) +
+                file.name}); // clear file contents and open in write mode
     if (!header.empty()) { // if there is a header string, write this to the new
                            // file
-      files[fileName] << header << "\n";
+      submit({FileOp::WRITE, &file, header + "\n"});
     }
   }
-  if (fileStates[fileName] == false) { // if file is closed ...
-    files[fileName].open(std::string(outputPrefix) + fileName,
-                         std::ios::out |
-                             std::ios::app); // open file in append mode
+  if (!file.open) { // if file is closed ...
+    file.open = true;
+    submit({FileOp::REOPEN, &file,
+            std::string(outputPrefix) + file.name}); // open file in append mode
   }
 }
 
 void FileManager::closeFile(const std::string &fileName) {
-  if (files.find(fileName) == files.end()) {
+  std::lock_guard<std::recursive_mutex> lock(filesMutex);
+  if (!hasFile(fileName)) {
     std::cout << "  In FileManager::closeFile :: ERROR, attempt to close file '"
          << fileName
          << "' but this file has not been opened or created! Exiting." << std::endl;
     exit(1);
   }
-  files[fileName].close();
-  fileStates[fileName] = false; // make a note that this file is closed
+  auto &file = *outputFiles[getHandle(fileName)];
+  submit({FileOp::CLOSE, &file, ""});
+  file.open = false; // make a note that this file is closed
+}
+
+void FileManager::setAsync(bool async) {
+  std::lock_guard<std::recursive_mutex> lock(filesMutex);
+  if (async && !backgroundWriter) {
+    backgroundWriter = std::make_unique<BackgroundWriter>();
+  }
+  if (!async) {
+    backgroundWriter.reset(); // finishes writing queued data
+  }
+}
+
+bool FileManager::isAsync() {
+  std::lock_guard<std::recursive_mutex> lock(filesMutex);
+  return backgroundWriter != nullptr;
+}
+
+void FileManager::flush() {
+  std::lock_guard<std::recursive_mutex> lock(filesMutex);
+  if (backgroundWriter) {
+    backgroundWriter->waitUntilDrained();
+  }
+}
+
+void FileManager::saveCheckpoint(CheckpointWriter &checkpoint) {
+  std::lock_guard<std::recursive_mutex> lock(filesMutex);
+  flush();
+  for (auto &file : outputFiles) {
+    if (file->open) {
+      file->stream.flush(); // (async files are flushed by the writer)
+    }
+  }
+  checkpoint.section("FILES");
+  checkpoint.write(static_cast<uint64_t>(outputFiles.size()));
+  for (auto &file : outputFiles) {
+    checkpoint.write(file->name);
+    checkpoint.write(file->created);
+    checkpoint.write(
+        file->created ? fileSize(std::string(outputPrefix) + file->name) : -1LL);
+  }
+  checkpoint.write(static_cast<uint64_t>(fileColumns.size()));
+  for (auto &columns : fileColumns) {
+    checkpoint.write(columns.first);
+    checkpoint.write(columns.second);
+  }
+}
+
+void FileManager::loadCheckpoint(CheckpointReader &checkpoint) {
+  std::lock_guard<std::recursive_mutex> lock(filesMutex);
+  checkpoint.section("FILES");
+  auto fileCount = checkpoint.read<uint64_t>();
+  for (uint64_t i = 0; i < fileCount; i++) {
+    auto name = checkpoint.read<std::string>();
+    auto created = checkpoint.read<bool>();
+    auto size = checkpoint.read<long long>();
+    auto &file = *outputFiles[getHandle(name)];
+    if (file.open) {
+      submit({FileOp::CLOSE, &file, ""});
+      file.open = false;
+    }
+    file.created = created;
+    if (created) { // remove anything written after the checkpoint was saved
+      auto path = std::string(outputPrefix) + name;
+      if (fileSize(path) < size || !resizeFile(path, size)) {
+        std::cout << "  In FileManager::loadCheckpoint :: output file \""
+                  << path << "\" is missing or shorter then when the "
+                  << "checkpoint was saved.\n  Exiting." << std::endl;
+        exit(1);
+      }
+    } // the file will be opened in append mode when it is next written to
+  }
+  fileColumns.clear();
+  auto columnsCount = checkpoint.read<uint64_t>();
+  for (uint64_t i = 0; i < columnsCount; i++) {
+    auto name = checkpoint.read<std::string>();
+    checkpoint.read(fileColumns[name]);
+  }
+  flush();
+}
+
+// run op now, or queue it for the background writer
+void FileManager::submit(FileOp op) {
+  if (backgroundWriter) {
+    backgroundWriter->submit(std::move(op));
+  } else {
+    performFileOp(op, false);
+  }
+}
+
+void FileManager::performFileOp(FileOp &op, bool async) {
+  auto &file = *op.file;
+  switch (op.kind) {
+  case FileOp::CREATE:
+  case FileOp::REOPEN:
+    if (async && file.buffer.empty()) {
+      file.buffer.resize(1024 * 1024); // must be set before the file is opened
+      file.stream.rdbuf()->pubsetbuf(file.buffer.data(), file.buffer.size());
+    }
+    file.stream.open(op.data, op.kind == FileOp::CREATE
+                                  ? std::ios::out
+                                  : std::ios::out | std::ios::app);
+    break;
+  case FileOp::WRITE:
+    file.stream << op.data;
+    if (!async) {
+      file.stream << std::flush;
+    }
+    break;
+  case FileOp::CLOSE:
+    file.stream.close();
+    break;
+  }
+}
+
+// interned keys. slotIndices is only read when a thread sees a key for the
+// first time, after that the thread uses its own cache (see slotOf)
+static std::shared_mutex &slotsMutex() {
+  static std::shared_mutex mutex;
+  return mutex;
+}
+static std::unordered_map<std::string, int> &slotIndices() {
+  static std::unordered_map<std::string, int> indices;
+  return indices;
+}
+static std::vector<std::unique_ptr<const std::string>> &slotKeys() {
+  static std::vector<std::unique_ptr<const std::string>> keys;
+  return keys;
+}
+
+DataMap::Slot DataMap::slotOf(const std::string &key) {
+  thread_local std::unordered_map<std::string, int> knownSlots;
+  auto known = knownSlots.find(key);
+  if (known != knownSlots.end()) {
+    return {known->second};
+  }
+  Slot slot;
+  {
+    std::shared_lock<std::shared_mutex> lock(slotsMutex());
+    auto found = slotIndices().find(key);
+    if (found != slotIndices().end()) {
+      slot.index = found->second;
+    }
+  }
+  if (slot.index == -1) {
+    std::unique_lock<std::shared_mutex> lock(slotsMutex());
+    auto found = slotIndices().find(key); // another thread may have added key
+    if (found != slotIndices().end()) {
+      slot.index = found->second;
+    } else {
+      slot.index = static_cast<int>(slotKeys().size());
+      slotKeys().push_back(std::make_unique<const std::string>(key));
+      slotIndices()[key] = slot.index;
+    }
+  }
+  knownSlots[key] = slot.index;
+  return slot;
+}
+
+const std::string &DataMap::keyOf(Slot slot) {
+  std::shared_lock<std::shared_mutex> lock(slotsMutex());
+  if (slot.index < 0 || slot.index >= static_cast<int>(slotKeys().size())) {
+    std::cout << "  In DataMap::keyOf :: slot " << slot.index
+         << " is not an interned key. Exiting." << std::endl;
+    exit(1);
+  }
+  return *slotKeys()[slot.index];
 }
 
 // copy constructor
 DataMap::DataMap(std::shared_ptr<DataMap> source) {
-  boolData = source->boolData;
-  doubleData = source->doubleData;
-  intData = source->intData;
-  stringData = source->stringData;
-  for (auto entry : source->inUse) {
-    inUse[entry.first] = entry.second;
+  entries = source->entries;
+}
+
+DataMap::Entry &DataMap::addEntry(Slot slot, dataMapType type) {
+  auto &key = keyOf(slot);
+  auto position = std::lower_bound(
+      entries.begin(), entries.end(), key,
+      [](const Entry &entry, const std::string &k) { return *entry.key < k; });
+  Entry entry;
+  entry.slot = slot;
+  entry.key = &key;
+  entry.type = type;
+  entry.outputBehavior = 0;
+  return *entries.insert(position, std::move(entry));
+}
+
+void DataMap::merge(DataMap otherDataMap, int replace) {
+  for (auto &other : otherDataMap.entries) {
+    if (other.outputBehavior == NO_OUTPUT) { // not in otherDataMap.getKeys()
+      continue;
+    }
+    dataMapType typeOfKey = findKeyInData(other.slot);
+    if (replace == 0) { // no replacement allowed!
+      if (typeOfKey != NONE) { // make sure key is not in both data maps
+        std::cout << "  In DataMap::merge() - attempt to merge key: \"" << *other.key
+             << "\" but key exists in both data maps and replace = 0!\n  Exiting." << std::endl;
+      }
+    }
+    // keep other either because:
+    //   rule is keep other (replace = 2)
+    //  or
+    //   rule is default (and test to make sure key is not in both passed) (replace 0)
+    //  or
+    //   rule is keep current, and this key is not already in this data map (replace = 1)
+    if (replace == 2 || replace == 0 || (replace == 1 && typeOfKey == NONE)) {
+      auto otherType = listType(other.type);
+      if (otherType == STRING) {
+        set(other.slot, other.strings);
+      } else { // values are copied as a list (like set with a vector)
+        Entry &entry = entryOfType(other.slot, otherType, "merge");
+        entry.values = other.values;
+        entry.type = otherType;
+      }
+      findEntry(other.slot)->outputBehavior = other.outputBehavior;
+    }
+  }
+}
+
+void DataMap::saveCheckpoint(CheckpointWriter &checkpoint) {
+  checkpoint.write(static_cast<uint64_t>(entries.size()));
+  for (auto &entry : entries) {
+    checkpoint.write(*entry.key);
+    checkpoint.write(static_cast<int>(entry.type));
+    checkpoint.write(entry.outputBehavior);
+    checkpoint.write(std::vector<double>(entry.values.begin(), entry.values.end()));
+    checkpoint.write(entry.strings);
   }
-  // inUse = source->inUse; // replaced with for loop.
-  outputBehavior = source->outputBehavior;
 }
 
+void DataMap::loadCheckpoint(CheckpointReader &checkpoint) {
+  entries.clear();
+  auto entryCount = checkpoint.read<uint64_t>();
+  std::vector<double> values;
+  for (uint64_t i = 0; i < entryCount; i++) {
+    auto key = checkpoint.read<std::string>();
+    auto &entry = addEntry(slotOf(key),
+                           static_cast<dataMapType>(checkpoint.read<int>()));
+    checkpoint.read(entry.outputBehavior);
+    checkpoint.read(values);
+    entry.values.append(values.begin(), values.end());
+    checkpoint.read(entry.strings);
+  }
+}
+
+std::unordered_map<std::string, std::string> DataMap::getStringMap() {
+  std::unordered_map<std::string, std::string> stringMap;
+  for (auto &entry : entries) {
+    auto typeOfKey = listType(entry.type);
+    std::string text;
+    if (typeOfKey == STRING) {
+      for (size_t i = 0; i < entry.strings.size(); i++) {
+        text += (i == 0 ? "" : ",") + entry.strings[i];
+      }
+    } else {
+      for (size_t i = 0; i < entry.values.size(); i++) {
+        text += (i == 0) ? "" : ",";
+        if (typeOfKey == BOOL) {
+          text += std::to_string((int)(bool)entry.values[i]);
+        } else if (typeOfKey == DOUBLE) {
+          text += std::to_string(entry.values[i]);
+        } else {
+          text += std::to_string((int)entry.values[i]);
+        }
+      }
+    }
+    stringMap[*entry.key] = text;
+  }
+  return stringMap;
+}
+
+std::string DataMap::getStringOfVector(const std::string &key) {
+  std::string returnString = "";
+  Entry *entry = findEntry(slotOf(key));
+  if (entry == nullptr) {
+    std::cout << "  In DataMap::GetString() :: key \"" << key
+         << "\" is not in data map!\n  exiting." << std::endl;
+    exit(1);
+  } else {
+    auto typeOfKey = listType(entry->type);
+    if (typeOfKey == BOOL) {
+      for (auto e : entry->values) {
+        returnString += std::to_string((int)(bool)e) + ",";
+      }
+    } else if (typeOfKey == DOUBLE) {
+      for (auto e : entry->values) {
+        returnString += std::to_string(e) + ",";
+      }
+    } else if (typeOfKey == INT) {
+      for (auto e : entry->values) {
+        returnString += std::to_string((int)e) + ",";
+      }
+    } else if (typeOfKey == STRING) {
+      for (auto &e : entry->strings) {
+        returnString += e + ",";
+      }
+    }
+  }
+  if (returnString.size() > 2) { // if vector was not empty
+    returnString.pop_back();     // remove trailing ","
+  }
+  return returnString;
+}
+
+DataMap DataMap::remakeDataMapWithPrefix(std::string prefix, bool stringify) {
+  DataMap copyDataMap;
+  for (auto &entry : entries) {
+    if (entry.outputBehavior == NO_OUTPUT) { // not in getKeys()
+      continue;
+    }
+    auto &copy = copyDataMap.addEntry(slotOf(prefix + "_" + *entry.key),
+                                      listType(entry.type));
+    copy.values = entry.values;
+    copy.strings = entry.strings;
+    // keep outputBehavior, or use what set with a vector would give
+    copy.outputBehavior = !stringify ? entry.outputBehavior
+                          : listType(entry.type) == STRING ? (int)LIST
+                                                           : (LIST | AVE);
+  }
+  return copyDataMap;
+}
 
 // take two strings (header and data), and a list of keys, and whether or not to
 // save "{LIST}"s. convert data from data map to header and data strings
@@ -97,21 +519,23 @@ void DataMap::constructHeaderAndDataStrings(std::string &headerStr, std::string
   unsigned int OB; // holds output behavior so it can be over ridden for ave file output!
   if (!keys.empty()) { // if keys is not empty
     for (auto const &i : keys) {
-      typeOfKey = findKeyInData(i);
-      if (typeOfKey == NONE) {
+      auto slot = slotOf(i);
+      Entry *entry = findEntry(slot);
+      if (entry == nullptr) {
         std::cout << "  in DataMap::writeToFile() - key \"" << i
              << "\" can not be found in data map!\n  exiting." << std::endl;
         exit(1);
       }
+      typeOfKey = listType(entry->type);
 
       // the following code makes use of bit masks! in short, AVE,SUM,LIST,etc
       // each use only one bit of an int.
       // therefore if we apply that mask the the outputBehavior, we can see if
       // that type of output is needed.
 
-      OB = outputBehavior[i];
+      OB = entry->outputBehavior;
 
-      if (typeOfKey == STRING || typeOfKey == STRINGSOLO) {
+      if (typeOfKey == STRING) {
         if (!(OB == LIST || OB == FIRST || OB == NO_OUTPUT)) {
 			std::cout << std::endl << OB << std::endl;
           std::cout << "  in constructHeaderAndDataStrings :: attempt to write "
@@ -120,10 +544,10 @@ void DataMap::constructHeaderAndDataStrings(std::string &headerStr, std::string
                << std::endl;
           exit(1);
         }
-      } 
+      }
 
       if (aveOnly) {
-		  if (typeOfKey == STRING || typeOfKey == STRINGSOLO) {
+		  if (typeOfKey == STRING) {
 			  OB = NO_OUTPUT;
 		  }
 		  else {
@@ -135,60 +559,35 @@ void DataMap::constructHeaderAndDataStrings(std::string &headerStr, std::string
       if (OB & FIRST) { // save first (only?) element in vector with key as
                         // column name
         headerStr += FileManager::separator + i;
-        if (typeOfKey == BOOL || typeOfKey == BOOLSOLO) {
-          if (!getBoolVector(i).empty()) {
-            dataStr += FileManager::separator + to_string(getBoolVector(i)[0]);
-          } else {
-            dataStr += '0';
-            std::cout << "  WARNING!! In DataMap::constructHeaderAndDataStrings :: "
-                    "while getting value for FIRST with key \""
-                 << i << "\" vector is empty!" << std::endl;
-          }
-        }
-        if (typeOfKey == DOUBLE || typeOfKey == DOUBLESOLO) {
-          if (!getDoubleVector(i).empty()) {
-            dataStr +=
-                FileManager::separator + std::to_string(getDoubleVector(i)[0]);
-          } else {
-            dataStr += '0';
-            std::cout << "  WARNING!! In DataMap::constructHeaderAndDataStrings :: "
-                    "while getting value for FIRST with key \""
-                 << i << "\" vector is empty!" << std::endl;
-          }
-        }
-        if (typeOfKey == INT || typeOfKey == INTSOLO) {
-          if (!getIntVector(i).empty()) {
-            dataStr +=
-                FileManager::separator + std::to_string(getIntVector(i)[0]);
-          } else {
-            dataStr += '0';
-            std::cout << "  WARNING!! In DataMap::constructHeaderAndDataStrings :: "
-                    "while getting value for FIRST with key \""
-                 << i << "\" vector is empty!" << std::endl;
-          }
-        }
-        if (typeOfKey == STRING || typeOfKey == STRINGSOLO) {
-          if (!getStringVector(i).empty()) {
-            dataStr += FileManager::separator + (std::string)"\"" + getStringVector(i)[0] + (std::string)"\"";
-          } else {
-            dataStr += (std::string)"\"0\"";
-            std::cout << "  WARNING!! In DataMap::constructHeaderAndDataStrings :: "
-                    "while getting value for FIRST with key \""
-                 << i << "\" vector is empty!" << std::endl;
-          }
+        bool isEmpty =
+            typeOfKey == STRING ? entry->strings.empty() : entry->values.empty();
+        if (isEmpty) {
+          dataStr += typeOfKey == STRING ? (std::string)"\"0\"" : (std::string)"0";
+          std::cout << "  WARNING!! In DataMap::constructHeaderAndDataStrings :: "
+                  "while getting value for FIRST with key \""
+               << i << "\" vector is empty!" << std::endl;
+        } else if (typeOfKey == BOOL) {
+          dataStr += FileManager::separator +
+                     std::to_string((int)(bool)entry->values[0]);
+        } else if (typeOfKey == DOUBLE) {
+          dataStr += FileManager::separator + std::to_string(entry->values[0]);
+        } else if (typeOfKey == INT) {
+          dataStr += FileManager::separator + std::to_string((int)entry->values[0]);
+        } else if (typeOfKey == STRING) {
+          dataStr += FileManager::separator + (std::string)"\"" + entry->strings[0] + (std::string)"\"";
         }
       }
       if (OB & AVE) { // key_AVE = ave of vector (will error if of type string!)
         headerStr += FileManager::separator + i + "_AVE";
-        dataStr += FileManager::separator + std::to_string(getAverage(i));
+        dataStr += FileManager::separator + std::to_string(getAverage(slot));
       }
       if (OB & VAR) { // key_VAR = variance of vector (will error if of type string!)
         headerStr += FileManager::separator + i + "_VAR";
-        dataStr += FileManager::separator + std::to_string(getVariance(i));
+        dataStr += FileManager::separator + std::to_string(getVariance(slot));
       }
       if (OB & SUM) { // key_SUM = sum of vector
         headerStr += FileManager::separator + i + "_SUM";
-        dataStr += FileManager::separator + std::to_string(getSum(i));
+        dataStr += FileManager::separator + std::to_string(getSum(slot));
       }
       if (OB & PROD) { // key_PROD = product of vector
         std::cout << "  WARNING OUTPUT METHOD PROD IS HAS YET TO BE WRITTEN!"
@@ -17,32 +17,87 @@
 #include <sstream>
 #include <map>
 #include <memory>
+#include <mutex>
+#include <shared_mutex>
 #include <unordered_map>
 #include <vector>
 
 #include "Utilities.h"
 
+class CheckpointWriter;
+class CheckpointReader;
+
 class FileManager {
 public:
+  typedef int FileHandle; // stable id for a file, see getHandle
+
   static std::map<std::string, std::vector<std::string>>
       fileColumns;                     // list of files (NAME,LIST OF COLUMNS)
-  static std::map<std::string, std::ofstream> files;  // list of files (NAME,ofstream)
-  static std::map<std::string, bool> fileStates; // list of files states (NAME,open?)
 
   static std::string outputPrefix;
 
   static const char separator = ',';
 
+  static std::recursive_mutex filesMutex; // guards the file list so
+                                          // organisms being evaluated on
+                                          // diffrent threads can write
+
+  static FileHandle getHandle(const std::string &fileName); // look up (or add)
+                                                            // fileName once,
+                                                            // then use handle
+  static bool hasFile(const std::string &fileName); // true if fileName has
+                                                    // been opened
+
   static void writeToFile(const std::string &fileName, const std::string &data,
                           const std::string &header = ""); // fileName, data, header
                                                       // - used when you want to
                                                       // output formatted data
                                                       // (i.e. genomes)
+  static void writeToFile(FileHandle file, const std::string &data,
+                          const std::string &header = "");
   static void openFile(const std::string &fileName,
                        const std::string &header = ""); // open file and write header
                                                    // to file if file is new and
                                                    // header is provided
   static void closeFile(const std::string &fileName);   // close file
+
+  // if async, files are written (and flushed) by a background thread, so
+  // writeToFile only copies data into a queue.
+  static void setAsync(bool async);
+  static bool isAsync();
+  // return once all data given to writeToFile has been written and flushed
+  static void flush();
+
+  // save the list of files (and how much has been written to each) in a
+  // checkpoint. loadCheckpoint cuts the files back to what they were when the
+  // checkpoint was saved, so a resumed run appends where the checkpoint was
+  static void saveCheckpoint(CheckpointWriter &checkpoint);
+  static void loadCheckpoint(CheckpointReader &checkpoint);
+
+private:
+  struct OutputFile {
+    std::string name;
+    std::ofstream stream;
+    std::vector<char> buffer; // large stream buffer (async only)
+    bool created = false;     // has been opened (and truncated) once
+    bool open = false;
+  };
+
+  struct FileOp { // one step for the writer (run in order)
+    enum Kind { CREATE, REOPEN, WRITE, CLOSE } kind;
+    OutputFile *file;
+    std::string data; // path for CREATE and REOPEN
+  };
+
+  class BackgroundWriter;
+
+  static std::vector<std::unique_ptr<OutputFile>> outputFiles; // by handle
+  static std::unordered_map<std::string, FileHandle> fileHandles;
+  static std::unique_ptr<BackgroundWriter> backgroundWriter; // null if sync
+
+  static void openFile(OutputFile &file, const std::string &header);
+  static void submit(FileOp op);
+  static void performFileOp(FileOp &op, bool async);
 };
 
 class DataMap {
@@ -57,11 +112,18 @@ public:
     VAR = 64,
 	 NO_OUTPUT = 128
   };                               // 0 = do not save or default..?
-  std::map<std::string, int> outputBehavior; // Defines how each element should be written
-                                   // to file - if element not found, LIST
-                                   // (write out list) is used.
   static std::map<std::string, int> knownOutputBehaviors;
 
+  // A key is interned once (see slotOf) and then names the same column in every
+  // DataMap. Code that uses a key over and over (i.e. once per organism) should
+  // look up the slot once and then use the Slot versions of set, append,
+  // getAverage, etc. which do not hash or compare strings.
+  struct Slot {
+    int index = -1; // -1 = not a key
+  };
+  static Slot slotOf(const std::string &key); // intern key (thread safe)
+  static const std::string &keyOf(Slot slot); // name of an interned key
+
 private:
   enum dataMapType {
     NONE = 0,
@@ -75,13 +137,187 @@ private:
     STRINGSOLO = 14
   }; // NONE = not found in this data map
 
-  std::unordered_map<std::string, std::vector<bool>> boolData;
-  std::unordered_map<std::string, std::vector<double>> doubleData;
-  std::unordered_map<std::string, std::vector<int>> intData;
-  std::unordered_map<std::string, std::vector<std::string>> stringData;
+  // bool, double and int values of an entry (int and bool are stored exactly
+  // as double). The first few values are stored inline, so a set with a single
+  // value (the common case) does not allocate.
+  class Values {
+  public:
+    static const size_t inlineCapacity = 4;
+
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+    const double *begin() const {
+      return count > inlineCapacity ? spilled.data() : stored;
+    }
+    const double *end() const { return begin() + count; }
+    double operator[](size_t i) const { return begin()[i]; }
+
+    void clear() {
+      count = 0;
+      spilled.clear();
+    }
+    void push_back(double value) {
+      if (count < inlineCapacity) {
+        stored[count++] = value;
+        return;
+      }
+      if (count == inlineCapacity) { // move inline values to the heap
+        spilled.assign(stored, stored + inlineCapacity);
+      }
+      spilled.push_back(value);
+      count++;
+    }
+    template <typename Iterator> void append(Iterator first, Iterator last) {
+      for (; first != last; ++first) {
+        push_back((double)*first);
+      }
+    }
 
-  std::map<std::string, dataMapType>
-      inUse; // holds list of keys with type 1=bool, 2=double, 3=int, 4=string
+  private:
+    double stored[inlineCapacity] = {};
+    std::vector<double> spilled; // all values, once there are more then
+                                 // inlineCapacity
+    size_t count = 0;
+  };
+
+  struct Entry {
+    Slot slot;
+    const std::string *key; // interned key, never freed
+    dataMapType type;
+    int outputBehavior; // Defines how this element should be written to file
+    Values values;                    // bool, double and int data
+    std::vector<std::string> strings; // string data
+  };
+
+  std::vector<Entry> entries; // sorted by key, so getKeys (and so output
+                              // column order) is alphabetical
+
+  static dataMapType listType(dataMapType t) {
+    return t > 10 ? (dataMapType)(t - 10) : t;
+  }
+  static dataMapType soloType(dataMapType t) {
+    return (dataMapType)(listType(t) + 10);
+  }
+
+  inline Entry *findEntry(Slot slot) { // nullptr if slot is not in this map
+    for (auto &entry : entries) {
+      if (entry.slot.index == slot.index) {
+        return &entry;
+      }
+    }
+    return nullptr;
+  }
+
+  Entry &addEntry(Slot slot, dataMapType type); // insert in key order
+
+  // return entry for slot, with type t (or t solo). If slot is not in this
+  // data map a new entry of type t is added.
+  inline Entry &entryOfType(Slot slot, dataMapType t, const char *function) {
+    Entry *entry = findEntry(slot);
+    if (entry == nullptr) {
+      return addEntry(slot, t);
+    }
+    if (listType(entry->type) != t) {
+      std::cout << "  ERROR :: a call to DataMap::" << function
+           << " was called where the key was already in use with another type."
+           << std::endl;
+      std::cout << "  function was called with : key = \"" << keyOf(slot)
+           << "\" where value is " << lookupDataMapTypeName(t) << "." << std::endl;
+      std::cout << "  but ... key is already associated with type "
+           << entry->type << ". Exiting." << std::endl;
+      exit(1);
+    }
+    return *entry;
+  }
+
+  // return entry for slot which must hold numbers (used by getAverage...)
+  inline Entry &numericEntry(Slot slot, const char *function) {
+    Entry *entry = findEntry(slot);
+    if (entry == nullptr) {
+      std::cout << "  in DataMap::" << function
+           << " attempt to get value from nonexistent key \"" << keyOf(slot)
+           << "\".\n  Exiting." << std::endl;
+      exit(1);
+    }
+    if (listType(entry->type) == STRING) {
+      std::cout << "  in DataMap::" << function
+           << " attempt to use with vector of type string associated key \""
+           << keyOf(slot) << "\".\n  Cannot average strings!\n  Exiting."
+           << std::endl;
+      exit(1);
+    }
+    return *entry;
+  }
+
+  inline Entry &entryForGet(Slot slot, dataMapType t, const char *function) {
+    Entry *entry = findEntry(slot);
+    if (entry == nullptr || listType(entry->type) != t) {
+      std::cout << "  in DataMap::" << function << " :: attempt to use "
+           << function << " with key \"" << keyOf(slot)
+           << "\" but this key is associated with type "
+           << (entry == nullptr ? NONE : entry->type) << "\n  exiting."
+           << std::endl;
+      std::cout << "  (if type is NONE, then the key was not found in dataMap)"
+           << std::endl;
+      exit(1);
+    }
+    return *entry;
+  }
+
+  inline void setValue(Slot slot, dataMapType t, double value) {
+    Entry &entry = entryOfType(slot, t, "set");
+    entry.values.clear();
+    entry.values.push_back(value);
+    entry.type = soloType(t); // since this is set with SET, it is a single value
+    entry.outputBehavior = FIRST;
+  }
+  template <typename T>
+  inline void setValues(Slot slot, dataMapType t, const std::vector<T> &value) {
+    Entry &entry = entryOfType(slot, t, "set");
+    entry.values.clear();
+    entry.values.append(value.begin(), value.end());
+    entry.type = t;
+    entry.outputBehavior = LIST | AVE;
+  }
+  inline void appendValue(Slot slot, dataMapType t, double value) {
+    Entry &entry = entryOfType(slot, t, "append");
+    entry.values.push_back(value);
+    entry.type = t; // set the in use to be a list rather then a solo
+    entry.outputBehavior = LIST | AVE;
+  }
+  // soloAllowed = false : appending to a key that was set with a single value
+  // is an error
+  template <typename T>
+  inline void appendValues(Slot slot, dataMapType t, const std::vector<T> &value,
+                           bool soloAllowed) {
+    Entry *entry = findEntry(slot);
+    if (entry == nullptr) { // this key is not in data map, use Set.
+      setValues(slot, t, value);
+      return;
+    }
+    if (entry->type != t && !(soloAllowed && entry->type == soloType(t))) {
+      std::cout << "  In DataMap::append :: attempt to append a vector of type "
+           << lookupDataMapTypeName(t) << " to \"" << keyOf(slot)
+           << "\" but this key is already associated with "
+           << lookupDataMapTypeName(entry->type) << ".\n  exiting." << std::endl;
+      exit(1);
+    }
+    entry->values.append(value.begin(), value.end());
+    entry->type = t; // may have been solo - make sure it's list
+    entry->outputBehavior = LIST | AVE;
+  }
+
+  template <typename T>
+  inline std::vector<T> getValues(Slot slot, dataMapType t,
+                                  const char *function) {
+    Entry &entry = entryForGet(slot, t, function);
+    std::vector<T> values;
+    values.reserve(entry.values.size());
+    for (auto value : entry.values) {
+      values.push_back((T)value);
+    }
+    return values;
+  }
 
 public:
   DataMap() = default;
@@ -89,29 +325,35 @@ public:
   // copy constructor
   DataMap(std::shared_ptr<DataMap> source);
 
+  inline void setOutputBehavior(Slot slot, int _outputBehavior) {
+    Entry *entry = findEntry(slot);
+    if (entry != nullptr) { // (set and append always set outputBehavior, so
+                            // there is no need to save it for other keys)
+      entry->outputBehavior = _outputBehavior;
+    }
+  }
   inline void setOutputBehavior(const std::string &key, int _outputBehavior) {
-    outputBehavior[key] = _outputBehavior;
+    setOutputBehavior(slotOf(key), _outputBehavior);
   }
 
   // find key in this data map and return type (NONE = not found)
+  inline dataMapType findKeyInData(Slot slot) {
+    Entry *entry = findEntry(slot);
+    return entry == nullptr ? NONE : entry->type;
+  }
   inline dataMapType findKeyInData(const std::string &key, bool printType = false) {
+    auto typeOfKey = findKeyInData(slotOf(key));
     if (printType) {
-      std::cout << key << "is of type " << inUse[key] << std::endl;
-    }
-    if (inUse.find(key) != inUse.end()) {
-      return inUse[key];
-    } else {
-      return NONE;
+      std::cout << key << "is of type " << typeOfKey << std::endl;
     }
+    return typeOfKey;
   }
 
   // find key in this data map and return type (NONE = not found)
   inline bool isKeySolo(const std::string &key) {
-    if (inUse.find(key) != inUse.end()) {
-      return ((findKeyInData(key) == BOOLSOLO) ||
-              (findKeyInData(key) == DOUBLESOLO) ||
-              (findKeyInData(key) == INTSOLO) ||
-              (findKeyInData(key) == STRINGSOLO));
+    Entry *entry = findEntry(slotOf(key));
+    if (entry != nullptr) {
+      return entry->type > 10;
     } else {
       std::cout << "  ERROR :: in DataMap::isKeySolo, key name " << key
            << " is not defined in DataMap. Exiting!" << std::endl;
@@ -141,321 +383,106 @@ public:
   // return vector of strings will all keys in this data map
   inline std::vector<std::string> getKeys() {
     std::vector<std::string> keys;
-    for (auto e : inUse) {
-		 if (outputBehavior[e.first] != NO_OUTPUT) keys.push_back(e.first); // just push back the whole key
+    for (auto &entry : entries) {
+      if (entry.outputBehavior != NO_OUTPUT) keys.push_back(*entry.key);
     }
     return (keys);
   }
 
   // set functions (bool,double,int,string) that take a **single** value -
   // either make new map entry or replace existing
-  inline void set(const std::string &key, const bool &value) {
-    dataMapType typeOfKey = findKeyInData(key);
-    if (typeOfKey == NONE || typeOfKey == BOOL ||
-        typeOfKey ==
-            BOOLSOLO) { // if key is unused or associates with correct type
-      boolData[key] = std::vector<bool>({value});
-      inUse[key] = BOOLSOLO; // since this is set with SET, it is a single value
-    } else {
-      std::cout << "  ERROR :: a call to DataMap::set was called where the key was "
-              "already in use with another type."
-           << std::endl;
-      std::cout << "  function was called with : key = \"" << key << "\" value = \""
-           << value << "\" where value is bool." << std::endl;
-      std::cout << "  but ... key is already associated with type "
-           << findKeyInData(key) << ". Exiting." << std::endl;
-      exit(1);
-    }
-	 setOutputBehavior(key, FIRST);
-  }
-  inline void set(const std::string &key, const double &value) {
-    dataMapType typeOfKey = findKeyInData(key);
-    if (typeOfKey == NONE || typeOfKey == DOUBLE ||
-        typeOfKey ==
-            DOUBLESOLO) { // if key is unused or associates with correct type
-      doubleData[key] = std::vector<double>({value});
-      inUse[key] =
-          DOUBLESOLO; // since this is set with SET, it is a single value
-    } else {
-      std::cout << "  ERROR :: a call to DataMap::set was called where the key was "
-              "already in use with another type."
-           << std::endl;
-      std::cout << "  function was called with : key = \"" << key << "\" value = \""
-           << value << "\" where value is double." << std::endl;
-      std::cout << "  but ... key is already associated with type "
-           << findKeyInData(key) << ". Exiting." << std::endl;
-      exit(1);
-    }
-	 setOutputBehavior(key, FIRST);
-  }
-  inline void set(const std::string &key, const int &value) {
-    dataMapType typeOfKey = findKeyInData(key);
-    if (typeOfKey == NONE || typeOfKey == INT ||
-        typeOfKey ==
-            INTSOLO) { // if key is unused or associates with correct type
-      intData[key] = std::vector<int>({value});
-      inUse[key] = INTSOLO; // since this is set with SET, it is a single value
-    } else {
-      std::cout << "  ERROR :: a call to DataMap::set was called where the key was "
-              "already in use with another type."
-           << std::endl;
-      std::cout << "  function was called with : key = \"" << key << "\" value = \""
-           << value << "\" where value is int." << std::endl;
-      std::cout << "  but ... key is already associated with type "
-           << findKeyInData(key) << ". Exiting." << std::endl;
-      exit(1);
-    }
-	 setOutputBehavior(key, FIRST);
-  }
+  inline void set(Slot slot, const bool &value) { setValue(slot, BOOL, value); }
+  inline void set(Slot slot, const double &value) { setValue(slot, DOUBLE, value); }
+  inline void set(Slot slot, const int &value) { setValue(slot, INT, value); }
+  inline void set(Slot slot, const std::string &value) {
+    Entry &entry = entryOfType(slot, STRING, "set");
+    entry.strings = {value};
+    entry.type = STRINGSOLO;
+    entry.outputBehavior = FIRST;
+  }
+  inline void set(const std::string &key, const bool &value) { set(slotOf(key), value); }
+  inline void set(const std::string &key, const double &value) { set(slotOf(key), value); }
+  inline void set(const std::string &key, const int &value) { set(slotOf(key), value); }
   inline void set(const std::string &key, const std::string &value) {
-    dataMapType typeOfKey = findKeyInData(key);
-    if (typeOfKey == NONE || typeOfKey == STRING ||
-        typeOfKey ==
-            STRINGSOLO) { // if key is unused or associates with correct type
-      stringData[key] = std::vector<std::string>({value});
-      inUse[key] = STRINGSOLO;
-    } else {
-      std::cout << "  ERROR :: a call to DataMap::set was called where the key was "
-              "already in use with another type."
-           << std::endl;
-      std::cout << "  function was called with : key = \"" << key << "\" value = \""
-           << value << "\" where value is string." << std::endl;
-      std::cout << "  but ... key is already associated with type "
-           << findKeyInData(key) << ". Exiting." << std::endl;
-      exit(1);
-    }
-	 setOutputBehavior(key, FIRST);
+    set(slotOf(key), value);
   }
 
   // set functions (bool,double,int,string) that take a **vector** of value -
   // either make new map entry or replace existing
   // outputBehavior is set as though there was an append (i.e. list)
+  inline void set(Slot slot, const std::vector<bool> &value) { setValues(slot, BOOL, value); }
+  inline void set(Slot slot, const std::vector<double> &value) { setValues(slot, DOUBLE, value); }
+  inline void set(Slot slot, const std::vector<int> &value) { setValues(slot, INT, value); }
+  inline void set(Slot slot, const std::vector<std::string> &value) {
+    Entry &entry = entryOfType(slot, STRING, "set");
+    entry.strings = value;
+    entry.type = STRING;
+    entry.outputBehavior = LIST;
+  }
   inline void set(const std::string &key, const std::vector<bool> &value) {
-    dataMapType typeOfKey = findKeyInData(key);
-    if (typeOfKey == NONE || typeOfKey == BOOL ||
-        typeOfKey ==
-            BOOLSOLO) { // if key is unused or associates with correct type
-      boolData[key] = value;
-      inUse[key] = BOOL;
-    } else {
-      std::cout << "  ERROR :: a call to DataMap::set was called where the key was "
-              "already in use with another type."
-           << std::endl;
-      std::cout << "  function was called with : key = \"" << key
-           << "\" value is a vector of bool." << std::endl;
-      std::cout << "  but ... key is already associated with type "
-           << findKeyInData(key) << ". Exiting." << std::endl;
-      exit(1);
-    }
-	setOutputBehavior(key, LIST | AVE);
+    set(slotOf(key), value);
   }
   inline void set(const std::string &key, const std::vector<double> &value) {
-    dataMapType typeOfKey = findKeyInData(key);
-    if (typeOfKey == NONE || typeOfKey == DOUBLE ||
-        typeOfKey ==
-            DOUBLESOLO) { // if key is unused or associates with correct type
-      doubleData[key] = value;
-      inUse[key] = DOUBLE;
-    } else {
-      std::cout << "  ERROR :: a call to DataMap::set was called where the key was "
-              "already in use with another type."
-           << std::endl;
-      std::cout << "  function was called with : key = \"" << key
-           << "\" value is a vector of double." << std::endl;
-      std::cout << "  but ... key is already associated with type "
-           << findKeyInData(key) << ". Exiting." << std::endl;
-      exit(1);
-    }
-	setOutputBehavior(key, LIST | AVE);
+    set(slotOf(key), value);
   }
   inline void set(const std::string &key, const std::vector<int> &value) {
-    dataMapType typeOfKey = findKeyInData(key);
-    if (typeOfKey == NONE || typeOfKey == INT ||
-        typeOfKey ==
-            INTSOLO) { // if key is unused or associates with correct type
-      intData[key] = value;
-      inUse[key] = INT;
-    } else {
-      std::cout << "  ERROR :: a call to DataMap::set was called where the key was "
-              "already in use with another type."
-           << std::endl;
-      std::cout << "  function was called with : key = \"" << key
-           << "\" value is a vector of int." << std::endl;
-      std::cout << "  but ... key is already associated with type "
-           << findKeyInData(key) << ". Exiting." << std::endl;
-      exit(1);
-    }
-	setOutputBehavior(key, LIST | AVE);
+    set(slotOf(key), value);
   }
   inline void set(const std::string &key, const std::vector<std::string> &value) {
-    dataMapType typeOfKey = findKeyInData(key);
-    if (typeOfKey == NONE || typeOfKey == STRING ||
-        typeOfKey ==
-            STRINGSOLO) { // if key is unused or associates with correct type
-      stringData[key] = value;
-      inUse[key] = STRING;
-    } else {
-      std::cout << "  ERROR :: a call to DataMap::set was called where the key was "
-              "already in use with another type."
-           << std::endl;
-      std::cout << "  function was called with : key = \"" << key
-           << "\" value is a vector of string." << std::endl;
-      std::cout << "  but ... key is already associated with type "
-           << findKeyInData(key) << ". Exiting." << std::endl;
-      exit(1);
-    }
-	setOutputBehavior(key, LIST);
+    set(slotOf(key), value);
   }
 
   // append a value to the end of vector associated with key. If key is not
   // found, start a new vector for key
+  inline void append(Slot slot, const bool &value) { appendValue(slot, BOOL, value); }
+  inline void append(Slot slot, const double &value) { appendValue(slot, DOUBLE, value); }
+  inline void append(Slot slot, const int &value) { appendValue(slot, INT, value); }
+  inline void append(Slot slot, const std::string &value) {
+    Entry &entry = entryOfType(slot, STRING, "append");
+    entry.strings.push_back(value);
+    entry.type = STRING; // set the in use to be a list rather then a solo
+    entry.outputBehavior = LIST;
+  }
   inline void append(const std::string &key, const bool &value) {
-    dataMapType typeOfKey = findKeyInData(key);
-    if (typeOfKey == NONE) { // this key is not in data map, use Set.
-      set(key, value);
-      inUse[key] = BOOL; // set the in use to be a list rather then a solo
-    } else if (typeOfKey == BOOL ||
-               typeOfKey == BOOLSOLO) { // if this key is in data map as a
-                                        // string, append to vector
-      boolData[key].push_back(value);
-      inUse[key] = BOOL;
-    } else {
-      std::cout << "  In DataMap::append :: attempt to append value \"" << value
-           << "\" of type bool to \"" << key
-           << "\" but this key is already associated with "
-           << lookupDataMapTypeName(typeOfKey) << ".\n  exiting." << std::endl;
-      exit(1);
-    }
-	setOutputBehavior(key, LIST | AVE);
+    append(slotOf(key), value);
   }
   inline void append(const std::string &key, const double &value) {
-    dataMapType typeOfKey = findKeyInData(key);
-    if (typeOfKey == NONE) { // this key is not in data map, use Set.
-      set(key, value);
-      inUse[key] = DOUBLE; // set the in use to be a list rather then a solo
-    } else if (typeOfKey == DOUBLE ||
-               typeOfKey == DOUBLESOLO) { // if this key is in data map as a
-                                          // string, append to vector
-      doubleData[key].push_back(value);
-      inUse[key] = DOUBLE;
-    } else {
-      std::cout << "  In DataMap::append :: attempt to append value \"" << value
-           << "\" of type double to \"" << key
-           << "\" but this key is already associated with "
-           << lookupDataMapTypeName(typeOfKey) << ".\n  exiting." << std::endl;
-      exit(1);
-    }
-	setOutputBehavior(key, LIST | AVE);
+    append(slotOf(key), value);
   }
   inline void append(const std::string &key, const int &value) {
-    dataMapType typeOfKey = findKeyInData(key);
-    if (typeOfKey == NONE) { // this key is not in data map, use Set.
-      set(key, value);
-      inUse[key] = INT; // set the in use to be a list rather then a solo
-    } else if (typeOfKey == INT ||
-               typeOfKey == INTSOLO) { // if this key is in data map as a
-                                       // string, append to vector
-      intData[key].push_back(value);
-      inUse[key] = INT; // set the in use to be a list rather then a solo
-    } else {
-      std::cout << "  In DataMap::append :: attempt to append value \"" << value
-           << "\" of type int to \"" << key
-           << "\" but this key is already associated with "
-           << lookupDataMapTypeName(typeOfKey) << ".\n  exiting." << std::endl;
-      exit(1);
-    }
-	setOutputBehavior(key, LIST | AVE);
+    append(slotOf(key), value);
   }
   inline void append(const std::string &key, const std::string &value) {
-    dataMapType typeOfKey = findKeyInData(key);
-    if (typeOfKey == NONE) { // this key is not in data map, use Set.
-      set(key, value);
-      inUse[key] = STRING; // set the in use to be a list rather then a solo
-    } else if (typeOfKey == STRING ||
-               typeOfKey == STRINGSOLO) { // if this key is in data map as a
-                                          // string, append to vector
-      stringData[key].push_back(value);
-      inUse[key] = STRING; // set the in use to be a list rather then a solo
-    } else {
-      std::cout << "  In DataMap::append :: attempt to append value \"" << value
-           << "\" of type string to \"" << key
-           << "\" but this key is already associated with "
-           << lookupDataMapTypeName(typeOfKey) << ".\n  exiting." << std::endl;
-      exit(1);
-    }
-	setOutputBehavior(key, LIST);
+    append(slotOf(key), value);
   }
 
   // append a vector of values to the end of vector associated with key. If key
   // is not found, start a new vector for key
   inline void append(const std::string &key, const std::vector<bool> &value) {
-    dataMapType typeOfKey = findKeyInData(key);
-    if (typeOfKey == NONE) { // this key is not in data map, use Set.
-      set(key, value);
-    } else if (typeOfKey == BOOL ||
-               typeOfKey == BOOLSOLO) { // if this key is in data map as a
-                                        // string, append to vector
-      boolData[key].insert(boolData[key].end(), value.begin(), value.end());
-      inUse[key] = BOOL; // may have been solo - make sure it's list
-    } else {
-      std::cout << "  In DataMap::append :: attempt to append a vector of type bool "
-              "to \""
-           << key << "\" but this key is already associated with "
-           << lookupDataMapTypeName(typeOfKey) << ".\n  exiting." << std::endl;
-      exit(1);
-    }
-	setOutputBehavior(key, LIST | AVE);
+    appendValues(slotOf(key), BOOL, value, true);
   }
   inline void append(const std::string &key, const std::vector<double> &value) {
-    dataMapType typeOfKey = findKeyInData(key);
-    if (typeOfKey == NONE) { // this key is not in data map, use Set.
-      set(key, value);
-    } else if (typeOfKey == DOUBLE) { // if this key is in data map as a string,
-                                      // append to vector
-      doubleData[key].insert(doubleData[key].end(), value.begin(), value.end());
-      inUse[key] = DOUBLE; // may have been solo - make sure it's list
-    } else {
-      std::cout << "  In DataMap::append :: attempt to append a vector of type "
-              "double to \""
-           << key << "\" but this key is already associated with "
-           << lookupDataMapTypeName(typeOfKey) << ".\n  exiting." << std::endl;
-      exit(1);
-    }
-	setOutputBehavior(key, LIST | AVE);
+    appendValues(slotOf(key), DOUBLE, value, false);
   }
   inline void append(const std::string &key, const std::vector<int> &value) {
-    dataMapType typeOfKey = findKeyInData(key);
-    if (typeOfKey == NONE) { // this key is not in data map, use Set.
-      set(key, value);
-    } else if (typeOfKey == INT) { // if this key is in data map as a string,
-                                   // append to vector
-      intData[key].insert(intData[key].end(), value.begin(), value.end());
-      inUse[key] = INT; // may have been solo - make sure it's list
-    } else {
-      std::cout << "  In DataMap::append :: attempt to append a vector of type int "
-              "to \""
-           << key << "\" but this key is already associated with "
-           << lookupDataMapTypeName(typeOfKey) << ".\n  exiting." << std::endl;
-      exit(1);
-    }
-	setOutputBehavior(key, LIST | AVE);
+    appendValues(slotOf(key), INT, value, false);
   }
   inline void append(const std::string &key, const std::vector<std::string> &value) {
-    dataMapType typeOfKey = findKeyInData(key);
-    if (typeOfKey == NONE) { // this key is not in data map, use Set.
-      set(key, value);
-    } else if (typeOfKey == STRING) { // if this key is in data map as a string,
-                                      // concat new string with existing value
-		stringData[key] = { stringData[key][0] + value[0] };
-      inUse[key] = STRING; // may have been solo - make sure it's list
+    auto slot = slotOf(key);
+    Entry *entry = findEntry(slot);
+    if (entry == nullptr) { // this key is not in data map, use Set.
+      set(slot, value);
+    } else if (entry->type == STRING) { // if this key is in data map as a string,
+                                        // concat new string with existing value
+      entry->strings = {entry->strings[0] + value[0]};
+      entry->outputBehavior = LIST;
     } else {
       std::cout << "  In DataMap::append :: attempt to append a vector of type "
               "string to \""
            << key << "\" but this key is already associated with "
-           << lookupDataMapTypeName(typeOfKey) << ".\n  exiting." << std::endl;
+           << lookupDataMapTypeName(entry->type) << ".\n  exiting." << std::endl;
       exit(1);
     }
-	setOutputBehavior(key, LIST);
   }
 
   // merge contents of two data maps - if common keys are found behavior is determined by 'replace'
@@ -463,315 +490,118 @@ public:
   // replace 1 = keep current value - if the same key exists in both maps, keep the current value
   // replace 3 = keep the other value - if the same key exists in both maps, keep the other value
   // merge will attempt to merge outputBehavior
-  inline void merge(DataMap otherDataMap, int replace = 0) {
-	  for (std::string key : otherDataMap.getKeys()) {
-		  dataMapType typeOfKey = findKeyInData(key);
-		  dataMapType typeOfOtherKey = otherDataMap.findKeyInData(key);
-		  if (replace == 0) { // no replacement allowed!
-			  if (typeOfKey != NONE) { // make sure key is not in both data maps
-				  std::cout << "  In DataMap::merge() - attempt to merge key: \"" << key
-					  << "\" but key exists in both data maps and replace = 0!\n  Exiting." << std::endl;
-			  }
-		  }
-		  // keep other either because:
-		  //   rule is keep other (replace = 2)
-		  //  or
-		  //   rule is default (and test to make sure key is not in both passed) (replace 0)
-		  //  or
-		  //   rule is keep current, and this key is not already in this data map (replace = 1)
-		  if (replace == 2 || replace == 0 || (replace == 1 && typeOfKey == NONE)) {
-			  if (typeOfOtherKey == BOOL || typeOfOtherKey == BOOLSOLO) {
-				  set(key, otherDataMap.getBoolVector(key));
-				  outputBehavior[key] = otherDataMap.outputBehavior[key];
-			  }
-			  if (typeOfOtherKey == DOUBLE || typeOfOtherKey == DOUBLESOLO) {
-				  set(key, otherDataMap.getDoubleVector(key));
-				  outputBehavior[key] = otherDataMap.outputBehavior[key];
-			  }
-			  if (typeOfOtherKey == INT || typeOfOtherKey == INTSOLO) {
-				  set(key, otherDataMap.getIntVector(key));
-				  outputBehavior[key] = otherDataMap.outputBehavior[key];
-			  }
-			  if (typeOfOtherKey == STRING || typeOfOtherKey == STRINGSOLO) {
-				  set(key, otherDataMap.getStringVector(key));
-				  outputBehavior[key] = otherDataMap.outputBehavior[key];
-			  }
-		  }
-	  }
-  }
+  void merge(DataMap otherDataMap, int replace = 0);
 
+  inline std::vector<bool> getBoolVector(Slot slot) {
+    return getValues<bool>(slot, BOOL, "getBoolVector");
+  }
+  inline std::vector<double> getDoubleVector(Slot slot) {
+    return getValues<double>(slot, DOUBLE, "getDoubleVector");
+  }
+  inline std::vector<int> getIntVector(Slot slot) {
+    return getValues<int>(slot, INT, "getIntVector");
+  }
+  inline std::vector<std::string> getStringVector(Slot slot) {
+    return entryForGet(slot, STRING, "getStringVector").strings;
+  }
   inline std::vector<bool> getBoolVector(
       const std::string &key) { // retrieve a double from a dataMap with "key"
-    dataMapType typeOfKey = findKeyInData(key);
-    if (typeOfKey == BOOL || typeOfKey == BOOLSOLO) {
-      return boolData[key];
-    } else {
-      std::cout << "  in DataMap::getBoolVector :: attempt to use getBoolVector "
-              "with key \""
-           << key << "\" but this key is associated with type " << typeOfKey
-           << "\n  exiting." << std::endl;
-      std::cout << "  (if type is NONE, then the key was not found in dataMap)"
-           << std::endl;
-      exit(1);
-    }
+    return getBoolVector(slotOf(key));
   }
   inline std::vector<double> getDoubleVector(
       const std::string &key) { // retrieve a double from a dataMap with "key"
-    dataMapType typeOfKey = findKeyInData(key);
-    if (typeOfKey == DOUBLE || typeOfKey == DOUBLESOLO) {
-      return doubleData[key];
-    } else {
-      std::cout << "  in DataMap::getDoubleVector :: attempt to use getDoubleVector "
-              "with key \""
-           << key << "\" but this key is associated with type " << typeOfKey
-           << "\n  exiting." << std::endl;
-      std::cout << "  (if type is NONE, then the key was not found in dataMap)"
-           << std::endl;
-      exit(1);
-    }
+    return getDoubleVector(slotOf(key));
   }
   inline std::vector<int> getIntVector(
       const std::string &key) { // retrieve a double from a dataMap with "key"
-    dataMapType typeOfKey = findKeyInData(key);
-    if (typeOfKey == INT || typeOfKey == INTSOLO) {
-      return intData[key];
-    } else {
-      std::cout << "  in DataMap::getIntVector :: attempt to use getIntVector with "
-              "key \""
-           << key << "\" but this key is associated with type " << typeOfKey
-           << "\n  exiting." << std::endl;
-      std::cout << "  (if type is NONE, then the key was not found in dataMap)"
-           << std::endl;
-      exit(1);
-    }
+    return getIntVector(slotOf(key));
   }
   inline std::vector<std::string> getStringVector(
       const std::string &key) { // retrieve a double from a dataMap with "key"
-    dataMapType typeOfKey = findKeyInData(key);
-    if (typeOfKey == STRING || typeOfKey == STRINGSOLO) {
-      return stringData[key];
-    } else {
-      std::cout << "  in DataMap::getStringVector :: attempt to use getStringVector "
-              "with key \""
-           << key << "\" but this key is associated with type " << typeOfKey
-           << "\n  exiting." << std::endl;
-      std::cout << "  (if type is NONE, then the key was not found in dataMap)"
-           << std::endl;
-      exit(1);
-    }
+    return getStringVector(slotOf(key));
   }
 
-  inline std::string getStringOfVector(const std::string &key) { // retrieve a string from
-                                                       // a dataMap with "key" -
-                                                       // if not already string,
-                                                       // will be converted
-    std::string returnString = "";
-    dataMapType typeOfKey = findKeyInData(key);
-    if (typeOfKey == NONE) {
-      std::cout << "  In DataMap::GetString() :: key \"" << key
-           << "\" is not in data map!\n  exiting." << std::endl;
-      exit(1);
-    } else {
-      if (typeOfKey == BOOL || typeOfKey == BOOLSOLO) {
-        for (auto e : boolData[key]) {
-          returnString += to_string(e) + ",";
-        }
-      } else if (typeOfKey == DOUBLE || typeOfKey == DOUBLESOLO) {
-        for (auto e : doubleData[key]) {
-          returnString += std::to_string(e) + ",";
-        }
-      } else if (typeOfKey == INT || typeOfKey == INTSOLO) {
-        for (auto e : intData[key]) {
-          returnString += std::to_string(e) + ",";
-        }
-      } else if (typeOfKey == STRING || typeOfKey == STRINGSOLO) {
-        for (auto e : stringData[key]) {
-          returnString += e + ",";
-        }
-      }
-    }
-    if (returnString.size() > 2) { // if vector was not empty
-      returnString.pop_back();     // remove trailing ","
-    }
-    returnString += "";
-    return returnString;
-  }
+  // retrieve a string from a dataMap with "key" - if not already string, will
+  // be converted
+  std::string getStringOfVector(const std::string &key);
 
   // get ave of values in a vector - must be bool, double or, int
-  inline double
-  getAverage(std::string key) { // not ref, we may need to change to a "{LIST}" key
-    dataMapType typeOfKey = findKeyInData(key);
+  inline double getAverage(Slot slot) {
+    auto &values = numericEntry(slot, "getAverage").values;
     double returnValue = 0;
-    if (typeOfKey == BOOL || typeOfKey == BOOLSOLO) {
-      for (auto e : boolData[key]) {
-        returnValue += (double)e;
-      }
-      if (boolData[key].size() > 1) {
-        returnValue /= boolData[key].size();
-      } // else vector is  size 1, no div needed or vector is empty, returnValue
-        // will be 0
-    } else if (typeOfKey == DOUBLE || typeOfKey == DOUBLESOLO) {
-      for (auto e : doubleData[key]) {
-        returnValue += (double)e;
-      }
-      if (doubleData[key].size() > 1) {
-        returnValue /= doubleData[key].size();
-      } // else vector is  size 1, no div needed or vector is empty, returnValue
-        // will be 0
-    } else if (typeOfKey == INT || typeOfKey == INTSOLO) {
-      for (auto e : intData[key]) {
-        returnValue += (double)e;
-      }
-      if (intData[key].size() > 1) {
-        returnValue /= intData[key].size();
-      } // else vector is  size 1, no div needed or vector is empty, returnValue
-        // will be 0
-    } else if (typeOfKey == STRING || typeOfKey == STRINGSOLO) {
-      std::cout << "  in DataMap::getAverage attempt to use with vector of type "
-              "string associated key \""
-           << key << "\".\n  Cannot average strings!\n  Exiting." << std::endl;
-      exit(1);
-    } else if (typeOfKey == NONE) {
-      std::cout << "  in DataMap::getAverage attempt to get average from "
-              "nonexistent key \""
-           << key << "\".\n  Exiting." << std::endl;
-      exit(1);
+    for (auto e : values) {
+      returnValue += e;
     }
+    if (values.size() > 1) {
+      returnValue /= values.size();
+    } // else vector is  size 1, no div needed or vector is empty, returnValue
+      // will be 0
     return returnValue;
   }
-
   inline double
-  getVariance(std::string key) { // not ref, we may need to change to a "{LIST}" key
-    dataMapType typeOfKey = findKeyInData(key);
+  getAverage(std::string key) { // not ref, we may need to change to a "{LIST}" key
+    return getAverage(slotOf(key));
+  }
+
+  inline double getVariance(Slot slot) {
+    auto &values = numericEntry(slot, "getVariance").values;
     double averageValue(0);
     double varianceValue(0);
-    if (typeOfKey == BOOL || typeOfKey == BOOLSOLO) {
-      for (auto e : boolData[key]) {
-        averageValue += (double)e;
-      }
-      averageValue /= boolData[key].size();
-      for (auto e : boolData[key]) {
-        varianceValue +=
-            ((double)e - averageValue) * ((double)e - averageValue);
-      }
-      if (boolData[key].size() > 0)
-        varianceValue /= boolData[key].size() - 1;
-      else
-        varianceValue = 0;
-    } else if (typeOfKey == DOUBLE || typeOfKey == DOUBLESOLO) {
-      for (auto e : doubleData[key]) {
-        averageValue += (double)e;
-      }
-      averageValue /= doubleData[key].size();
-      for (auto e : doubleData[key]) {
-        varianceValue +=
-            ((double)e - averageValue) * ((double)e - averageValue);
-      }
-      if (doubleData[key].size() > 0)
-        varianceValue /= doubleData[key].size() - 1;
-      else
-        varianceValue = 0;
-    } else if (typeOfKey == INT || typeOfKey == INTSOLO) {
-      for (auto e : intData[key]) {
-        averageValue += (double)e;
-      }
-      averageValue /= intData[key].size();
-      for (auto e : intData[key]) {
-        varianceValue +=
-            ((double)e - averageValue) * ((double)e - averageValue);
-      }
-      if (intData[key].size() > 0)
-        varianceValue /= intData[key].size() - 1;
-      else
-        varianceValue = 0;
-    } else if (typeOfKey == STRING || typeOfKey == STRINGSOLO) {
-      std::cout << "  in DataMap::getVariance attempt to use with vector of type "
-              "string associated key \""
-           << key << "\".\n  Cannot average strings!\n  Exiting." << std::endl;
-      exit(1);
-    } else if (typeOfKey == NONE) {
-      std::cout << "  in DataMap::getVariance attempt to get value from nonexistent "
-              "key \""
-           << key << "\".\n  Exiting." << std::endl;
-      exit(1);
+    for (auto e : values) {
+      averageValue += e;
     }
+    averageValue /= values.size();
+    for (auto e : values) {
+      varianceValue += (e - averageValue) * (e - averageValue);
+    }
+    if (values.size() > 0)
+      varianceValue /= values.size() - 1;
+    else
+      varianceValue = 0;
     return varianceValue;
   }
-
-  // get ave of values in a vector - must be bool, double or, int
   inline double
-  getSum(std::string key) { // not ref, we may need to change to a "{LIST}" key
-    dataMapType typeOfKey = findKeyInData(key);
+  getVariance(std::string key) { // not ref, we may need to change to a "{LIST}" key
+    return getVariance(slotOf(key));
+  }
+
+  // get sum of values in a vector - must be bool, double or, int
+  inline double getSum(Slot slot) {
     double returnValue = 0;
-    if (typeOfKey == BOOL || typeOfKey == BOOLSOLO) {
-      for (auto e : boolData[key]) {
-        returnValue += (double)e;
-      }
-      // if (boolData[key].size() > 1) {
-      //	returnValue /= boolData[key].size();
-      //} // else vector is  size 1, no div needed or vector is empty,
-      //returnValue will be 0
-    } else if (typeOfKey == DOUBLE || typeOfKey == DOUBLESOLO) {
-      for (auto e : doubleData[key]) {
-        returnValue += (double)e;
-      }
-      // if (doubleData[key].size() > 1) {
-      //	returnValue /= doubleData[key].size();
-      //} // else vector is  size 1, no div needed or vector is empty,
-      //returnValue will be 0
-    } else if (typeOfKey == INT || typeOfKey == INTSOLO) {
-      for (auto e : intData[key]) {
-        returnValue += (double)e;
-      }
-      // if (intData[key].size() > 1) {
-      //	returnValue /= intData[key].size();
-      //} // else vector is  size 1, no div needed or vector is empty,
-      //returnValue will be 0
-    } else if (typeOfKey == STRING || typeOfKey == STRINGSOLO) {
-      std::cout << "  in DataMap::getAverage attempt to use with vector of type "
-              "string associated key \""
-           << key << "\".\n  Cannot average strings!\n  Exiting." << std::endl;
-      exit(1);
-    } else if (typeOfKey == NONE) {
-      std::cout << "  in DataMap::getAverage attempt to get average from "
-              "nonexistent key \""
-           << key << "\".\n  Exiting." << std::endl;
-      exit(1);
+    for (auto e : numericEntry(slot, "getSum").values) {
+      returnValue += e;
     }
     return returnValue;
   }
+  inline double
+  getSum(std::string key) { // not ref, we may need to change to a "{LIST}" key
+    return getSum(slotOf(key));
+  }
 
   // Clear a field in a DataMap
-  inline void clear(const std::string &key) {
-    dataMapType typeOfKey = findKeyInData(key);
-    if (typeOfKey != NONE) {
-      if (typeOfKey == BOOL || typeOfKey == BOOLSOLO) { // data is bool
-        boolData.erase(key);
-      } else if (typeOfKey == DOUBLE ||
-                 typeOfKey == DOUBLESOLO) { // data is double
-        doubleData.erase(key);
-      } else if (typeOfKey == INT || typeOfKey == INTSOLO) { // data is int
-        intData.erase(key);
-      } else if (typeOfKey == STRING ||
-                 typeOfKey == STRINGSOLO) { // data is string
-        stringData.erase(key);
-      }
-      inUse.erase(key);
+  inline void clear(Slot slot) {
+    Entry *entry = findEntry(slot);
+    if (entry != nullptr) {
+      entries.erase(entries.begin() + (entry - entries.data()));
     }
   }
+  inline void clear(const std::string &key) { clear(slotOf(key)); }
 
   // Clear all data in a DataMap
-  inline void clearMap() {
-    boolData.clear();
-    doubleData.clear();
-    intData.clear();
-    stringData.clear();
-    inUse.clear();
-  }
+  inline void clearMap() { entries.clear(); }
+
+  // save (or load) all entries, including types and output behaviors
+  void saveCheckpoint(CheckpointWriter &checkpoint);
+  void loadCheckpoint(CheckpointReader &checkpoint);
 
+  // all values as strings, as they would be read back from a file (lists are
+  // comma separated). used to pass serialized genomes and brains to deserialize
+  std::unordered_map<std::string, std::string> getStringMap();
+
+  inline bool fieldExists(Slot slot) { return findEntry(slot) != nullptr; }
   inline bool
   fieldExists(const std::string &key) { // return true if a data map contains "key"
-    return (findKeyInData(key) > 0);
+    return fieldExists(slotOf(key));
   }
 
   // take two strings (header and data), and a list of keys, and whether or not
@@ -785,9 +615,8 @@ public:
                           bool aveOnly = false) {
     // Set("score{LIST}",10.0);
 
-    if (FileManager::files.find(fileName) ==
-        FileManager::files
-            .end()) { // first make sure that the dataFile has been set up.
+    if (!FileManager::hasFile(
+            fileName)) { // first make sure that the dataFile has been set up.
       if (keys.size() == 0) { // if no keys are given
         FileManager::fileColumns[fileName] = getKeys();
       } else {
@@ -808,42 +637,30 @@ public:
   inline std::vector<std::string> getColumnNames() {
     std::vector<std::string> columnNames;
 
-    for (auto element : inUse) {
-      //if (outputBehavior.find(element.first) == outputBehavior.end()) {
-      //  // this element has no defined output behavior, so it will be LIST
-      //  // (default) or FIRST (if it's a solo value)
-      //  if (element.second == BOOLSOLO || element.second == DOUBLESOLO ||
-      //      element.second == INTSOLO || element.second == STRINGSOLO) {
-      //    columnNames.push_back(element.first);
-      //  } else {
-      //    columnNames.push_back(element.first + "_LIST");
-      //  }
-      //} else { // there is an output behavior defined
-		 {
-        auto OB = outputBehavior[element.first];
-        if (OB & AVE) {
-          columnNames.push_back(element.first + "_AVE");
-        }
-        if (OB & FIRST) {
-          columnNames.push_back(element.first);
-        }
-        if (OB & SUM) {
-          std::cout << "  WARNING OUTPUT METHOD SUM IS HAS YET TO BE WRITTEN!"
-               << std::endl;
-        }
-        if (OB & PROD) {
-          std::cout << "  WARNING OUTPUT METHOD PROD IS HAS YET TO BE WRITTEN!"
-               << std::endl;
-        }
-        if (OB & STDERR) {
-          std::cout << "  WARNING OUTPUT METHOD STDERR IS HAS YET TO BE WRITTEN!"
-               << std::endl;
-        }
-        if (OB & LIST) {
-          columnNames.push_back(element.first + "_LIST");
-        }
-		  // if (OB & NO_OUTPUT) do nothing...
+    for (auto &entry : entries) {
+      auto OB = entry.outputBehavior;
+      if (OB & AVE) {
+        columnNames.push_back(*entry.key + "_AVE");
+      }
+      if (OB & FIRST) {
+        columnNames.push_back(*entry.key);
+      }
+      if (OB & SUM) {
+        std::cout << "  WARNING OUTPUT METHOD SUM IS HAS YET TO BE WRITTEN!"
+             << std::endl;
+      }
+      if (OB & PROD) {
+        std::cout << "  WARNING OUTPUT METHOD PROD IS HAS YET TO BE WRITTEN!"
+             << std::endl;
+      }
+      if (OB & STDERR) {
+        std::cout << "  WARNING OUTPUT METHOD STDERR IS HAS YET TO BE WRITTEN!"
+             << std::endl;
       }
+      if (OB & LIST) {
+        columnNames.push_back(*entry.key + "_LIST");
+      }
+      // if (OB & NO_OUTPUT) do nothing...
     }
     return columnNames;
   }
@@ -853,43 +670,5 @@ public:
   //	 */
   //	void SetMany(vector<string> dataPairs);
 
-  inline DataMap remakeDataMapWithPrefix(std::string prefix, bool stringify = 0) {
-    DataMap copyDataMap;
-    dataMapType entryType;
-    if (!stringify) {
-      for (auto key : getKeys()) {
-        entryType = findKeyInData(key);
-        if (entryType == BOOL || entryType == BOOLSOLO) {
-          copyDataMap.set(prefix + "_" + key, getBoolVector(key));
-        }
-        if (entryType == STRING || entryType == STRINGSOLO) {
-          copyDataMap.set(prefix + "_" + key, getStringVector(key));
-        }
-        if (entryType == INT || entryType == INTSOLO) {
-          copyDataMap.set(prefix + "_" + key, getIntVector(key));
-        }
-        if (entryType == DOUBLE || entryType == DOUBLESOLO) {
-          copyDataMap.set(prefix + "_" + key, getDoubleVector(key));
-        }
-        copyDataMap.setOutputBehavior(prefix + "_" + key, outputBehavior[key]);
-      }
-    } else {
-      for (auto key : getKeys()) {
-        entryType = findKeyInData(key);
-        if (entryType == BOOL || entryType == BOOLSOLO) {
-          copyDataMap.set(prefix + "_" + key, getBoolVector(key));
-        }
-        if (entryType == STRING || entryType == STRINGSOLO) {
-          copyDataMap.set(prefix + "_" + key, getStringVector(key));
-        }
-        if (entryType == INT || entryType == INTSOLO) {
-          copyDataMap.set(prefix + "_" + key, getIntVector(key));
-        }
-        if (entryType == DOUBLE || entryType == DOUBLESOLO) {
-          copyDataMap.set(prefix + "_" + key, getDoubleVector(key));
-        }
-      }
-    }
-    return copyDataMap;
-  }
+  DataMap remakeDataMapWithPrefix(std::string prefix, bool stringify = 0);
 };
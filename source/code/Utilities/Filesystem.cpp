@@ -3,6 +3,7 @@
 #include "Filesystem.h"
 #include <vector>
 #include <regex>
+#include <cstring>
 #include <string>
 
 // given a path or filename, return T or F if it exists already
@@ -30,6 +31,40 @@ bool isDirectory(const std::string& dirname) {
 #endif
 }
 
+// given a filename, return size of file in bytes (-1 if file does not exist)
+long long fileSize(const std::string& filename) {
+#if defined(OS_UNIX)
+    struct stat statbuf; // linux only
+    if (stat(filename.c_str(), &statbuf) != 0) {
+        return -1;
+    }
+    return (long long)statbuf.st_size;
+#elif defined(OS_WINDOWS)
+    WIN32_FILE_ATTRIBUTE_DATA fileData;
+    if (!GetFileAttributesExA(filename.c_str(), GetFileExInfoStandard, &fileData)) {
+        return -1;
+    }
+    return ((long long)fileData.nFileSizeHigh << 32) | fileData.nFileSizeLow;
+#endif
+}
+
+// given a filename, cut (or extend with 0s) file to size bytes, return T if successful
+bool resizeFile(const std::string& filename, long long size) {
+#if defined(OS_UNIX)
+    return (truncate(filename.c_str(), (off_t)size) == 0);
+#elif defined(OS_WINDOWS)
+    HANDLE file = CreateFileA(filename.c_str(), GENERIC_WRITE, 0, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+    LARGE_INTEGER position;
+    position.QuadPart = size;
+    bool resized = SetFilePointerEx(file, position, NULL, FILE_BEGIN) && SetEndOfFile(file);
+    CloseHandle(file);
+    return resized;
+#endif
+}
+
 // given a dir path, and a bash-style wildcard pattern, get all files that match the pattern, saving into given vector of strings (RECURSIVE)
 // curPath: string.  Ex: "./"
 // depthIntoFilterPathParts: uint.  Ex: 3  (this is which subpattern of the vector `filterPathParts` we're currently matching for)
@@ -19,6 +19,7 @@
   #include <sys/types.h> // linux only
   #include <dirent.h> // linux only
   #include <sys/stat.h> // linux only (stat, lstat)
+  #include <unistd.h> // linux only (truncate)
 #elif defined(OS_WINDOWS)
   #include <windows.h>
 #endif
@@ -35,6 +36,12 @@ bool fileExists(const std::string & /*filename*/);
 // given a path or filename, return T if directory, F if file
 bool isDirectory(const std::string & /*dirname*/);
 
+// given a filename, return size of file in bytes (-1 if file does not exist)
+long long fileSize(const std::string & /*filename*/);
+
+// given a filename, cut (or extend with 0s) file to size bytes, return T if successful
+bool resizeFile(const std::string & /*filename*/, long long /*size*/);
+
 // given a dir path, and a bash-style wildcard pattern, get all files that match the pattern, saving into given vector of strings (RECURSIVE)
 // curPath: string.  Ex: "./"
 // depthIntoFilterPathParts: uint.  Ex: 3  (this is which subpattern of the vector `filterPathParts` we're currently matching for)
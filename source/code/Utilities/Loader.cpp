@@ -4,10 +4,12 @@
 #include "Loader.h"
 #include "Filesystem.h"
 #include "CSV.h"
+#include "OrganismArchive.h"
 
 #include <fstream>
 #include <iostream>
 #include <map>
+#include <memory>
 #include <numeric>
 #include <random>
 #include <regex>
@@ -520,6 +522,10 @@ std::vector<std::string> Loader::expandFiles(const std::string &file) {
 
 std::pair<long, long> Loader::generatePopulation(const std::string &file_name) {
 
+  if (OrganismArchiveReader::isArchive(file_name)) {
+    return generatePopulationFromArchive(file_name);
+  }
+
   // store organism file in memory-mapped CSV
   CSV org_file_data = CSV(file_name);
   // setup the range of indices needed to identify all organisms from this file
@@ -560,6 +566,53 @@ std::pair<long, long> Loader::generatePopulation(const std::string &file_name) {
 } // end Loader::generatePopulation
 
 
+// same as generatePopulation, but for binary organism archives (see
+// OrganismArchive.h). The _data file is the csv file written next to the
+// archive (i.e. LOD_organisms.mabo -> LOD_data.csv)
+std::pair<long, long> Loader::generatePopulationFromArchive(const std::string &file_name) {
+
+  OrganismArchiveReader archive(file_name);
+  auto records = archive.readAll();
+  std::pair<long,long> file_contents_pair = std::make_pair(long(all_organism_infos.size()), long(records.size()));
+
+  std::string data_file_name(dataVersionOfFilename(file_name));
+  data_file_name = data_file_name.substr(0, data_file_name.rfind(".")) + ".csv";
+  std::shared_ptr<CSV> data_file_data;
+  std::set<std::string> data_file_ids;
+  if (fileExists(data_file_name)) {
+    data_file_data = std::make_shared<CSV>(data_file_name);
+    auto ids = data_file_data->singleColumn("ID");
+    data_file_ids.insert(ids.begin(), ids.end());
+  }
+
+  for (auto &record : records) {
+    if (record.find("ID") == record.end()) {
+      std::cout << " error: organism in " << file_name << " does not have an ID" << std::endl;
+      exit(1);
+    }
+    std::string id = record.at("ID");
+    OrganismInfo org_info;
+    org_info.orig_ID = std::stoi(id);
+    org_info.from_file = file_name;
+    org_info.attributes_map = std::move(record);
+    // merge the _data file data into the organism (organism file data is kept)
+    if (data_file_ids.count(id)) {
+      for (const std::string &attribute : data_file_data->column_names()) {
+        org_info.attributes_map.insert(std::make_pair(attribute, data_file_data->lookUp("ID", id, attribute)));
+      }
+    }
+    org_info.attributes_map.insert(std::make_pair("loadedFrom.ID",id));
+    org_info.attributes_map.insert(std::make_pair("loadedFrom.File",file_name));
+    if (org_info.attributes_map.find("update") != org_info.attributes_map.end()) {
+      org_info.attributes_map.insert(std::make_pair("loadedFrom.Update",org_info.attributes_map.at("update")));
+    }
+    all_organism_infos.push_back(std::move(org_info));
+  }
+
+  return file_contents_pair;
+} // end Loader::generatePopulationFromArchive
+
+
 void Loader::printOrganism(long i) {
 
   // strictly for debugging purposes 
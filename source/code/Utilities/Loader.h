@@ -40,6 +40,7 @@ private:
   
   std::vector<std::string> expandFiles(const std::string &);// for user inputted wildcards
   std::pair<long, long> generatePopulation(const std::string &);
+  std::pair<long, long> generatePopulationFromArchive(const std::string &); // binary organism archives
 	std::string findAndGenerateAllFiles(std::string /*all_lines*/);
   // read MABE generated files and constructs organsims 
   // redundant function from MABE - should be cleaned
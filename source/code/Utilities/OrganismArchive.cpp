@@ -0,0 +1,449 @@
+//  MABE is a product of The Hintze Lab @ MSU
+//     for general research information:
+//         hintzelab.msu.edu
+//     for MABE documentation:
+//         github.com/Hintzelab/MABE/wiki
+//
+//  Copyright (c) 2015 Michigan State University. All rights reserved.
+//     to view the full license, visit:
+//         github.com/Hintzelab/MABE/wiki/License
+
+#include "OrganismArchive.h"
+#include "Filesystem.h"
+
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <iterator>
+
+#ifdef MABE_ZLIB
+#include <zlib.h>
+#endif
+
+namespace {
+
+const char fileMagic[] = "MABEORG1";
+const char indexMagic[] = "MABEIDX1";
+const size_t magicSize = 8;
+
+// value types (same numbers as DataMap uses)
+const uint8_t boolType = 1;
+const uint8_t doubleType = 2;
+const uint8_t intType = 3;
+const uint8_t stringType = 4;
+
+const uint8_t noCompression = 0;
+const uint8_t zlibCompression = 1;
+
+// recordCount, compression, rawSize, storedSize
+const size_t blockHeaderSize = 4 + 1 + 8 + 8;
+
+template <class T> void append(std::string &buffer, T value) {
+  buffer.append(reinterpret_cast<const char *>(&value), sizeof(T));
+}
+
+template <class T> T extract(const std::string &buffer, size_t &pos) {
+  if (pos + sizeof(T) > buffer.size()) {
+    std::cout << "  In OrganismArchiveReader :: block is truncated or "
+                 "corrupt.\n  Exiting."
+              << std::endl;
+    exit(1);
+  }
+  T value;
+  std::memcpy(&value, buffer.data() + pos, sizeof(T));
+  pos += sizeof(T);
+  return value;
+}
+
+template <class T> void writeValue(std::ofstream &file, T value) {
+  file.write(reinterpret_cast<const char *>(&value), sizeof(T));
+}
+
+template <class T> bool readValue(std::ifstream &file, T &value) {
+  return static_cast<bool>(
+      file.read(reinterpret_cast<char *>(&value), sizeof(T)));
+}
+
+uint8_t typeOfKey(DataMap &record, const std::string &key) {
+  auto typeName = record.lookupDataMapTypeName(record.findKeyInData(key));
+  if (typeName == "bool") {
+    return boolType;
+  }
+  if (typeName == "double") {
+    return doubleType;
+  }
+  if (typeName == "int") {
+    return intType;
+  }
+  return stringType;
+}
+
+} // namespace
+
+OrganismArchiveWriter::OrganismArchiveWriter(const std::string &fileName,
+                                             bool compress_,
+                                             int recordsPerBlock_)
+    : path(FileManager::outputPrefix + fileName), compress(compress_),
+      recordsPerBlock(std::max(1, recordsPerBlock_)) {
+#ifndef MABE_ZLIB
+  if (compress) {
+    std::cout << "  WARNING :: MABE was built without zlib, organism archive "
+              << fileName << " will not be compressed." << std::endl;
+    compress = false;
+  }
+#endif
+  file.open(path, std::ios::out | std::ios::binary | std::ios::trunc);
+  if (!file.is_open()) {
+    std::cout << "  In OrganismArchiveWriter :: can not open file " << path
+              << ".\n  Exiting." << std::endl;
+    exit(1);
+  }
+  file.write(fileMagic, magicSize);
+}
+
+OrganismArchiveWriter::~OrganismArchiveWriter() { close(); }
+
+void OrganismArchiveWriter::write(DataMap &record) {
+  if (closed) {
+    std::cout << "  In OrganismArchiveWriter::write :: attempt to write to a "
+                 "closed archive.\n  Exiting."
+              << std::endl;
+    exit(1);
+  }
+  std::string encoded;
+  auto keys = record.getKeys();
+  append<uint32_t>(encoded, keys.size());
+  for (auto const &key : keys) {
+    auto type = typeOfKey(record, key);
+    auto column = columnIndex.find(key);
+    if (column == columnIndex.end()) {
+      column = columnIndex.emplace(key, columns.size()).first;
+      columns.push_back({key, type});
+    }
+    append<uint32_t>(encoded, column->second);
+    if (type == boolType) {
+      auto values = record.getBoolVector(key);
+      append<uint32_t>(encoded, values.size());
+      for (bool value : values) {
+        append<uint8_t>(encoded, value);
+      }
+    } else if (type == doubleType) {
+      auto values = record.getDoubleVector(key);
+      append<uint32_t>(encoded, values.size());
+      encoded.append(reinterpret_cast<const char *>(values.data()),
+                     values.size() * sizeof(double));
+    } else if (type == intType) {
+      auto values = record.getIntVector(key);
+      append<uint32_t>(encoded, values.size());
+      for (int value : values) {
+        append<int32_t>(encoded, value);
+      }
+    } else {
+      auto values = record.getStringVector(key);
+      append<uint32_t>(encoded, values.size());
+      for (auto const &value : values) {
+        append<uint32_t>(encoded, value.size());
+        encoded += value;
+      }
+    }
+  }
+  records.push_back(std::move(encoded));
+  int ID = -1; // ID is used for the block index
+  if (record.fieldExists("ID") && typeOfKey(record, "ID") == intType &&
+      !record.getIntVector("ID").empty()) {
+    ID = record.getIntVector("ID")[0];
+  }
+  recordIDs.push_back(ID);
+  if ((int)records.size() >= recordsPerBlock) {
+    flush();
+  }
+}
+
+void OrganismArchiveWriter::flush() {
+  if (records.empty()) {
+    return;
+  }
+  std::string payload;
+  append<uint32_t>(payload, columns.size());
+  for (auto const &column : columns) {
+    append<uint16_t>(payload, column.name.size());
+    payload += column.name;
+    append<uint8_t>(payload, column.type);
+  }
+  for (auto const &record : records) {
+    payload += record;
+  }
+
+  uint8_t compression = noCompression;
+  std::string stored;
+#ifdef MABE_ZLIB
+  if (compress) {
+    uLongf storedSize = compressBound(payload.size());
+    stored.resize(storedSize);
+    // favor write speed, most of the saving comes from not writing text
+    if (compress2(reinterpret_cast<Bytef *>(&stored[0]), &storedSize,
+                  reinterpret_cast<const Bytef *>(payload.data()),
+                  payload.size(), Z_BEST_SPEED) == Z_OK &&
+        storedSize < payload.size()) {
+      stored.resize(storedSize);
+      compression = zlibCompression;
+    }
+  }
+#endif
+  const std::string &block = compression == noCompression ? payload : stored;
+
+  blockOffsets.push_back(file.tellp());
+  blockCounts.push_back(records.size());
+  blockFirstIDs.push_back(recordIDs.front());
+  blockLastIDs.push_back(recordIDs.back());
+  writeValue<uint32_t>(file, records.size());
+  writeValue<uint8_t>(file, compression);
+  writeValue<uint64_t>(file, payload.size());
+  writeValue<uint64_t>(file, block.size());
+  file.write(block.data(), block.size());
+  file.flush();
+
+  columns.clear();
+  columnIndex.clear();
+  records.clear();
+  recordIDs.clear();
+}
+
+void OrganismArchiveWriter::close() {
+  if (closed) {
+    return;
+  }
+  flush();
+  uint64_t indexOffset = file.tellp();
+  for (size_t i = 0; i < blockOffsets.size(); i++) {
+    writeValue<uint64_t>(file, blockOffsets[i]);
+    writeValue<uint32_t>(file, blockCounts[i]);
+    writeValue<int32_t>(file, blockFirstIDs[i]);
+    writeValue<int32_t>(file, blockLastIDs[i]);
+  }
+  writeValue<uint64_t>(file, indexOffset);
+  writeValue<uint32_t>(file, blockOffsets.size());
+  file.write(indexMagic, magicSize);
+  file.close();
+  closed = true;
+}
+
+void OrganismArchiveWriter::saveCheckpoint(CheckpointWriter &checkpoint) {
+  file.flush();
+  checkpoint.section("ORGANISM_ARCHIVE");
+  checkpoint.write(closed);
+  checkpoint.write(static_cast<uint64_t>(closed ? 0 : (uint64_t)file.tellp()));
+  checkpoint.write(static_cast<uint64_t>(columns.size()));
+  for (auto const &column : columns) {
+    checkpoint.write(column.name);
+    checkpoint.write(column.type);
+  }
+  checkpoint.write(records);
+  checkpoint.write(recordIDs);
+  checkpoint.write(blockOffsets);
+  checkpoint.write(blockCounts);
+  checkpoint.write(blockFirstIDs);
+  checkpoint.write(blockLastIDs);
+}
+
+void OrganismArchiveWriter::loadCheckpoint(CheckpointReader &checkpoint) {
+  checkpoint.section("ORGANISM_ARCHIVE");
+  file.close();
+  checkpoint.read(closed);
+  auto size = checkpoint.read<uint64_t>();
+  if (!closed) {
+    if (fileSize(path) < (long long)size || !resizeFile(path, size)) {
+      std::cout << "  In OrganismArchiveWriter::loadCheckpoint :: file " << path
+                << " is missing or shorter then when the checkpoint was "
+                   "saved.\n  Exiting."
+                << std::endl;
+      exit(1);
+    }
+    file.open(path, std::ios::in | std::ios::out | std::ios::binary);
+    file.seekp(size);
+  }
+  columns.resize(checkpoint.read<uint64_t>());
+  columnIndex.clear();
+  for (size_t i = 0; i < columns.size(); i++) {
+    checkpoint.read(columns[i].name);
+    checkpoint.read(columns[i].type);
+    columnIndex[columns[i].name] = i;
+  }
+  checkpoint.read(records);
+  checkpoint.read(recordIDs);
+  checkpoint.read(blockOffsets);
+  checkpoint.read(blockCounts);
+  checkpoint.read(blockFirstIDs);
+  checkpoint.read(blockLastIDs);
+}
+
+const std::string OrganismArchiveReader::extension = ".mabo";
+
+bool OrganismArchiveReader::isArchive(const std::string &fileName) {
+  return fileName.size() >= extension.size() &&
+         fileName.compare(fileName.size() - extension.size(), extension.size(),
+                          extension) == 0;
+}
+
+OrganismArchiveReader::OrganismArchiveReader(const std::string &fileName_)
+    : fileName(fileName_) {
+  file.open(fileName, std::ios::in | std::ios::binary);
+  char magic[magicSize];
+  if (!file.is_open() || !file.read(magic, magicSize) ||
+      std::memcmp(magic, fileMagic, magicSize) != 0) {
+    std::cout << "  In OrganismArchiveReader :: " << fileName
+              << " is not a MABE organism archive.\n  Exiting." << std::endl;
+    exit(1);
+  }
+
+  // try the index at the end of the file
+  const int64_t trailerSize = 8 + 4 + magicSize;
+  file.seekg(0, std::ios::end);
+  int64_t fileSize = file.tellg();
+  if (fileSize >= (int64_t)magicSize + trailerSize) {
+    file.seekg(fileSize - trailerSize);
+    uint64_t indexOffset;
+    uint32_t blockCount;
+    readValue(file, indexOffset);
+    readValue(file, blockCount);
+    file.read(magic, magicSize);
+    if (file && std::memcmp(magic, indexMagic, magicSize) == 0) {
+      file.seekg(indexOffset);
+      blocks.resize(blockCount);
+      for (auto &block : blocks) {
+        readValue(file, block.offset);
+        readValue(file, block.recordCount);
+        readValue(file, block.firstID);
+        readValue(file, block.lastID);
+      }
+      if (file) {
+        return;
+      }
+      blocks.clear();
+    }
+  }
+  file.clear();
+  scanBlocks();
+}
+
+void OrganismArchiveReader::scanBlocks() {
+  file.seekg(0, std::ios::end);
+  uint64_t fileSize = file.tellg();
+  uint64_t offset = magicSize;
+  file.seekg(offset);
+  uint32_t recordCount;
+  uint8_t compression;
+  uint64_t rawSize, storedSize;
+  while (readValue(file, recordCount) && readValue(file, compression) &&
+         readValue(file, rawSize) && readValue(file, storedSize)) {
+    bool validHeader = (compression == noCompression && rawSize == storedSize) ||
+                       (compression == zlibCompression && storedSize < rawSize);
+    if (!validHeader || offset + blockHeaderSize + storedSize > fileSize) {
+      break; // block was not completely written (or this is a partial index)
+    }
+    blocks.push_back({offset, recordCount, -1, -1});
+    offset += blockHeaderSize + storedSize;
+    file.seekg(offset);
+  }
+  file.clear();
+}
+
+std::vector<std::unordered_map<std::string, std::string>>
+OrganismArchiveReader::readBlock(size_t block) {
+  file.clear();
+  file.seekg(blocks.at(block).offset);
+  uint32_t recordCount;
+  uint8_t compression;
+  uint64_t rawSize, storedSize;
+  readValue(file, recordCount);
+  readValue(file, compression);
+  readValue(file, rawSize);
+  readValue(file, storedSize);
+  std::string stored(storedSize, '\0');
+  if (!file.read(&stored[0], storedSize)) {
+    std::cout << "  In OrganismArchiveReader::readBlock :: block " << block
+              << " in " << fileName << " is truncated.\n  Exiting."
+              << std::endl;
+    exit(1);
+  }
+
+  std::string payload;
+  if (compression == noCompression) {
+    payload = std::move(stored);
+  } else {
+#ifdef MABE_ZLIB
+    payload.resize(rawSize);
+    uLongf payloadSize = rawSize;
+    if (uncompress(reinterpret_cast<Bytef *>(&payload[0]), &payloadSize,
+                   reinterpret_cast<const Bytef *>(stored.data()),
+                   stored.size()) != Z_OK ||
+        payloadSize != rawSize) {
+      std::cout << "  In OrganismArchiveReader::readBlock :: block " << block
+                << " in " << fileName << " can not be uncompressed.\n  Exiting."
+                << std::endl;
+      exit(1);
+    }
+#else
+    std::cout << "  In OrganismArchiveReader::readBlock :: " << fileName
+              << " is compressed, but MABE was built without zlib.\n  Exiting."
+              << std::endl;
+    exit(1);
+#endif
+  }
+
+  size_t pos = 0;
+  std::vector<std::pair<std::string, uint8_t>> columns(
+      extract<uint32_t>(payload, pos));
+  for (auto &column : columns) {
+    auto nameSize = extract<uint16_t>(payload, pos);
+    column.first = payload.substr(pos, nameSize);
+    pos += nameSize;
+    column.second = extract<uint8_t>(payload, pos);
+  }
+
+  std::vector<std::unordered_map<std::string, std::string>> records(
+      recordCount);
+  for (auto &record : records) {
+    auto entryCount = extract<uint32_t>(payload, pos);
+    for (uint32_t entry = 0; entry < entryCount; entry++) {
+      auto const &column = columns.at(extract<uint32_t>(payload, pos));
+      auto valueCount = extract<uint32_t>(payload, pos);
+      std::string text;
+      for (uint32_t i = 0; i < valueCount; i++) {
+        if (i > 0) {
+          text += FileManager::separator;
+        }
+        if (column.second == boolType) {
+          text += std::to_string(extract<uint8_t>(payload, pos));
+        } else if (column.second == doubleType) {
+          text += std::to_string(extract<double>(payload, pos));
+        } else if (column.second == intType) {
+          text += std::to_string(extract<int32_t>(payload, pos));
+        } else {
+          auto size = extract<uint32_t>(payload, pos);
+          if (pos + size > payload.size()) {
+            std::cout << "  In OrganismArchiveReader::readBlock :: block "
+                      << block << " in " << fileName
+                      << " is corrupt.\n  Exiting." << std::endl;
+            exit(1);
+          }
+          text.append(payload, pos, size);
+          pos += size;
+        }
+      }
+      record[column.first] = std::move(text);
+    }
+  }
+  return records;
+}
+
+std::vector<std::unordered_map<std::string, std::string>>
+OrganismArchiveReader::readAll() {
+  std::vector<std::unordered_map<std::string, std::string>> records;
+  for (size_t block = 0; block < blocks.size(); block++) {
+    auto blockRecords = readBlock(block);
+    std::move(blockRecords.begin(), blockRecords.end(),
+              std::back_inserter(records));
+  }
+  return records;
+}
@@ -0,0 +1,108 @@
+//  MABE is a product of The Hintze Lab @ MSU
+//     for general research information:
+//         hintzelab.msu.edu
+//     for MABE documentation:
+//         github.com/Hintzelab/MABE/wiki
+//
+//  Copyright (c) 2015 Michigan State University. All rights reserved.
+//     to view the full license, visit:
+//         github.com/Hintzelab/MABE/wiki/License
+
+#pragma once
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "Checkpoint.h"
+#include "Data.h"
+
+// Binary organism archives are a compact alternative to organisms csv files.
+// Each record is a DataMap (i.e. what would be one row in the csv file). Values
+// are stored in their DataMap type (bool, double, int, string) so nothing is
+// formatted on write, and genomes can store raw sites (see
+// AbstractGenome::serializeBinary).
+//
+// file layout (native byte order):
+//   "MABEORG1"
+//   blocks  : uint32 recordCount, uint8 compression, uint64 rawSize,
+//             uint64 storedSize, payload (storedSize bytes)
+//   index   : per block - uint64 offset, uint32 recordCount, int32 firstID,
+//             int32 lastID
+//   trailer : uint64 indexOffset, uint32 blockCount, "MABEIDX1"
+// a block payload is a column table (name, type) followed by the records. each
+// record is a list of entries (column index, value count, values).
+// If the trailer is missing (i.e. the run did not finish) readers walk the
+// blocks from the start of the file (firstID and lastID are then -1).
+
+class OrganismArchiveWriter {
+public:
+  // fileName is relative to FileManager::outputPrefix. if compress is true and
+  // MABE was built with zlib, blocks are compressed.
+  OrganismArchiveWriter(const std::string &fileName, bool compress,
+                        int recordsPerBlock);
+  ~OrganismArchiveWriter(); // calls close()
+
+  void write(DataMap &record); // buffer record, write a block if enough
+                               // records are buffered
+  void flush();                // write all buffered records as a block
+  void close();                // flush, then write the index and trailer
+
+  // save the buffered records and block index (and how much of the file has
+  // been written) in a checkpoint. loadCheckpoint cuts the file back to that
+  // size and continues from there
+  void saveCheckpoint(CheckpointWriter &checkpoint);
+  void loadCheckpoint(CheckpointReader &checkpoint);
+
+private:
+  struct Column {
+    std::string name;
+    uint8_t type;
+  };
+
+  std::string path; // outputPrefix + fileName
+  std::ofstream file;
+  bool compress;
+  int recordsPerBlock;
+  bool closed = false;
+
+  std::vector<Column> columns; // columns of the block being built
+  std::unordered_map<std::string, size_t> columnIndex; // name -> columns index
+  std::vector<std::string> records; // encoded records in this block
+  std::vector<int> recordIDs;
+
+  std::vector<uint64_t> blockOffsets;
+  std::vector<uint32_t> blockCounts;
+  std::vector<int32_t> blockFirstIDs, blockLastIDs;
+};
+
+class OrganismArchiveReader {
+public:
+  struct BlockInfo {
+    uint64_t offset;
+    uint32_t recordCount;
+    int32_t firstID, lastID;
+  };
+
+  static const std::string extension; // files with this extension are archives
+  static bool isArchive(const std::string &fileName);
+
+  explicit OrganismArchiveReader(const std::string &fileName);
+
+  const std::vector<BlockInfo> &getBlocks() const { return blocks; }
+
+  // records in block, values are converted to strings as they would be read
+  // from a csv file (lists are comma separated)
+  std::vector<std::unordered_map<std::string, std::string>>
+  readBlock(size_t block);
+  std::vector<std::unordered_map<std::string, std::string>> readAll();
+
+private:
+  std::string fileName;
+  std::ifstream file;
+  std::vector<BlockInfo> blocks;
+
+  void scanBlocks(); // build the block list when there is no index
+};
@@ -18,6 +18,7 @@ extern const char *gitversion; // from gitversion.h autogenerated by mbuild.py
 std::shared_ptr<ParametersTable> Parameters::root;
 bool Parameters::save_files;
 std::string Parameters::save_file_prefix = "./";
+std::string Parameters::resume_file;
 
 long long ParametersTable::nextTableID = 0;
 
@@ -96,7 +97,7 @@ void Parameters::readCommandLine(
     std::vector<std::string> &file_list) {
 
   const std::string usage_message =
-      R"( [-f <file1> <file2> ...] [-p <parameter name/value pairs>] [-s]
+      R"( [-f <file1> <file2> ...] [-p <parameter name/value pairs>] [-s] [-r <checkpoint file>]
                                     
   -f : "load files" - list of settings files to be loaded.
        Parameters in later files overwrite parameters in earlier files.
@@ -110,6 +111,11 @@ void Parameters::readCommandLine(
         specifying the path to save the settings files. The path can 
         contain a prefix to prepend to the settings files. 
 
+  -r : "resume" - continue a run from a checkpoint file (see 
+        GLOBAL-checkpointInterval). The run must be started with the same 
+        settings files and parameters as the run that saved the checkpoint 
+        (GLOBAL-updates may be changed).
+
   -l : "create population loading script"
         This creates a default file "population_loader.plf" that contains 
         the script for loading the initial population. See file or wiki
@@ -186,6 +192,15 @@ MASTER = default 100 # by default :)
         }
       }
       break;
+    case 'r':
+      if (i == argc - 1 || std::regex_match(std::string(argv[i + 1]),
+                                            command_line_argument_flag)) {
+        std::cout << "  ERROR :: -r must be followed by the name of a "
+                     "checkpoint file.\nExiting.\n";
+        exit(1);
+      }
+      resume_file = argv[++i];
+      break;
     case 'f':
       for (; i < argc - 1; i++) {
         std::string filename(argv[i+1]);
@@ -25,6 +25,8 @@
 #include <unordered_map>
 #include <set>
 #include <memory>
+#include <mutex>
+#include <shared_mutex>
 #include <vector>
 
 const std::string MABE_pretty_logo =
@@ -1270,6 +1272,14 @@ public:
   }
 };
 
+// get(lookupTable) may be called from many threads at once (i.e. when worlds
+// or optimizers use a ThreadPool). a cache miss adds entries to the
+// ParametersTables, this lock is held while doing so.
+inline std::mutex &parametersLookupMutex() {
+  static std::mutex lookupMutex;
+  return lookupMutex;
+}
+
 template <typename T> class ParameterLink {
 public:
   std::string name;
@@ -1277,6 +1287,7 @@ public:
   std::shared_ptr<ParametersTable> table;    // the table that owns this entry
   std::map<long long, std::shared_ptr<ParametersEntry<T>>>
       entriesCache; // used to track entries in other name spaces
+  std::shared_mutex cacheMutex; // guards entriesCache
 
   ParameterLink(std::string _name, std::shared_ptr<ParametersEntry<T>> _entry,
                 std::shared_ptr<ParametersTable> _table)
@@ -1296,17 +1307,22 @@ public:
                 << std::endl;
       exit(1);
     }
-    auto mapRecord = entriesCache.find(lookupTable->getID());
-    if (mapRecord ==
-        entriesCache.end()) { // if the cache does not contain this table
-      T lookupValue;
-      lookupTable->lookup(name, lookupValue);
-      entriesCache[lookupTable->getID()] =
-          std::dynamic_pointer_cast<ParametersEntry<T>>(
-              lookupTable->getEntry(name));
-      return lookupValue;
+    {
+      std::shared_lock<std::shared_mutex> lock(cacheMutex);
+      auto mapRecord = entriesCache.find(lookupTable->getID());
+      if (mapRecord != entriesCache.end()) {
+        return mapRecord->second->get();
+      }
     }
-    return entriesCache[lookupTable->getID()]->get();
+    // the cache does not contain this table
+    std::unique_lock<std::shared_mutex> lock(cacheMutex);
+    std::lock_guard<std::mutex> lookupLock(parametersLookupMutex());
+    T lookupValue;
+    lookupTable->lookup(name, lookupValue);
+    entriesCache[lookupTable->getID()] =
+        std::dynamic_pointer_cast<ParametersEntry<T>>(
+            lookupTable->getEntry(name));
+    return lookupValue;
   }
 
   // T lookup() {
@@ -1318,21 +1334,27 @@ public:
   //}
 
   void set(T value) {
+    std::unique_lock<std::shared_mutex> lock(cacheMutex);
     table->setParameter(name, value);
     entriesCache[table->getID()] =
         std::dynamic_pointer_cast<ParametersEntry<T>>(table->getEntry(name));
   }
 
   void set(T value, std::shared_ptr<ParametersTable> lookupTable) {
+    std::unique_lock<std::shared_mutex> lock(cacheMutex);
     lookupTable->setParameter(name, value);
     entriesCache[lookupTable->getID()] =
         std::dynamic_pointer_cast<ParametersEntry<T>>(
             lookupTable->getEntry(name));
   }
 
-  void clearCache() { entriesCache.clear(); }
+  void clearCache() {
+    std::unique_lock<std::shared_mutex> lock(cacheMutex);
+    entriesCache.clear();
+  }
 
   void clearCache(std::shared_ptr<ParametersTable> _table) {
+    std::unique_lock<std::shared_mutex> lock(cacheMutex);
     auto mapRecord = entriesCache.find(_table->getID());
     if (mapRecord !=
         entriesCache
@@ -1355,6 +1377,7 @@ public:
   static std::shared_ptr<ParametersTable> root;
   static bool save_files;
   static std::string save_file_prefix;
+  static std::string resume_file; // checkpoint file given with -r (or "")
 
   template <typename T>
   static std::shared_ptr<ParameterLink<T>>
@@ -26,6 +26,15 @@ using Generator = std::mt19937;
 static const int32_t _BINOMIAL_TO_NORMAL = 50;     // if < n*p*(1-p)
 static const int32_t _BINOMIAL_TO_POISSON = 1000;  // if < n && !Normal approx Engine
 
+// per-thread override for the common generator. When this is not nullptr,
+// getCommonGenerator() returns it instead of the process wide generator.
+// This lets code that draws from the default generator (brains, gates, worlds)
+// run on worker threads with its own deterministic stream (see ScopedGenerator)
+inline Generator *&getThreadGenerator() {
+  thread_local Generator *threadGenerator = nullptr;
+  return threadGenerator;
+}
+
 // Gives you access to the random number generator in general use
 inline Generator &getCommonGenerator() {
   // to seed, do get_common_generator().seed(value);
@@ -35,9 +44,28 @@ inline Generator &getCommonGenerator() {
   // called
   // after this, each time the function is called, a reference to the same
   // "common" is returned
-  return common;
+  // (unless this thread has installed it's own generator)
+  auto threadGenerator = getThreadGenerator();
+  return threadGenerator ? *threadGenerator : common;
 }
 
+// while a ScopedGenerator is alive, getCommonGenerator() on the current thread
+// returns gen. The previous generator is restored when the scope ends.
+// usage:
+//   Random::Generator gen(seed);
+//   { Random::ScopedGenerator scope(gen); ... }
+class ScopedGenerator {
+  Generator *previous;
+
+public:
+  explicit ScopedGenerator(Generator &gen) : previous(getThreadGenerator()) {
+    getThreadGenerator() = &gen;
+  }
+  ~ScopedGenerator() { getThreadGenerator() = previous; }
+  ScopedGenerator(const ScopedGenerator &) = delete;
+  ScopedGenerator &operator=(const ScopedGenerator &) = delete;
+};
+
 // result = Random::getDouble(7.2, 9.5);
 // result is in [7.2, 9.5)
 inline double getDouble(const double lower, const double upper,
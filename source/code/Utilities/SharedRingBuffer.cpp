@@ -0,0 +1,118 @@
+//  MABE is a product of The Hintze Lab @ MSU
+//     for general research information:
+//         hintzelab.msu.edu
+//     for MABE documentation:
+//         github.com/Hintzelab/MABE/wiki
+//
+//  Copyright (c) 2015 Michigan State University. All rights reserved.
+//     to view the full license, visit:
+//         github.com/Hintzelab/MABE/wiki/License
+
+#include "SharedRingBuffer.h"
+#include "Filesystem.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <iostream>
+#include <new>
+#include <thread>
+
+#if defined(OS_UNIX)
+#include <sys/mman.h>
+#endif
+
+// readPosition and writePosition only grow, (position % capacity) is the place
+// in the ring. each message is a uint32 size followed by the message.
+struct SharedRingBuffer::Header {
+  std::atomic<bool> locked;
+  uint64_t readPosition;
+  uint64_t writePosition;
+};
+
+SharedRingBuffer::SharedRingBuffer(size_t _capacity) : capacity(_capacity) {
+#if defined(OS_UNIX)
+  static_assert(std::atomic<bool>::is_always_lock_free,
+                "SharedRingBuffer needs a lock free atomic<bool>");
+  mappedSize = sizeof(Header) + capacity;
+  auto memory = mmap(nullptr, mappedSize, PROT_READ | PROT_WRITE,
+                     MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+  if (memory == MAP_FAILED) {
+    std::cout << "  In SharedRingBuffer :: unable to map " << mappedSize
+              << " bytes of shared memory.\n  Exiting." << std::endl;
+    exit(1);
+  }
+  header = new (memory) Header();
+  header->locked = false;
+  header->readPosition = 0;
+  header->writePosition = 0;
+  ring = static_cast<char *>(memory) + sizeof(Header);
+#else
+  std::cout << "  In SharedRingBuffer :: shared memory between processes is "
+               "not available on this system.\n  Exiting."
+            << std::endl;
+  exit(1);
+#endif
+}
+
+SharedRingBuffer::~SharedRingBuffer() {
+#if defined(OS_UNIX)
+  if (header != nullptr) {
+    munmap(header, mappedSize);
+  }
+#endif
+}
+
+void SharedRingBuffer::lock() {
+  while (header->locked.exchange(true, std::memory_order_acquire)) {
+    std::this_thread::yield();
+  }
+}
+
+void SharedRingBuffer::unlock() {
+  header->locked.store(false, std::memory_order_release);
+}
+
+void SharedRingBuffer::copyIn(uint64_t position, const char *data,
+                              size_t size) {
+  size_t start = position % capacity;
+  size_t first = std::min(size, capacity - start); // before wrapping around
+  std::memcpy(ring + start, data, first);
+  std::memcpy(ring, data + first, size - first);
+}
+
+void SharedRingBuffer::copyOut(uint64_t position, char *data, size_t size) {
+  size_t start = position % capacity;
+  size_t first = std::min(size, capacity - start);
+  std::memcpy(data, ring + start, first);
+  std::memcpy(data + first, ring, size - first);
+}
+
+bool SharedRingBuffer::push(const std::string &message) {
+  uint32_t size = static_cast<uint32_t>(message.size());
+  lock();
+  auto used = header->writePosition - header->readPosition;
+  if (used + sizeof(size) + size > capacity) {
+    unlock();
+    return false;
+  }
+  copyIn(header->writePosition, reinterpret_cast<const char *>(&size),
+         sizeof(size));
+  copyIn(header->writePosition + sizeof(size), message.data(), size);
+  header->writePosition += sizeof(size) + size;
+  unlock();
+  return true;
+}
+
+void SharedRingBuffer::popAll(std::vector<std::string> &messages) {
+  lock();
+  while (header->readPosition < header->writePosition) {
+    uint32_t size;
+    copyOut(header->readPosition, reinterpret_cast<char *>(&size),
+            sizeof(size));
+    messages.emplace_back(size, '\0');
+    copyOut(header->readPosition + sizeof(size), &messages.back()[0], size);
+    header->readPosition += sizeof(size) + size;
+  }
+  unlock();
+}
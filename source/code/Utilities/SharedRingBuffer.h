@@ -0,0 +1,52 @@
+//  MABE is a product of The Hintze Lab @ MSU
+//     for general research information:
+//         hintzelab.msu.edu
+//     for MABE documentation:
+//         github.com/Hintzelab/MABE/wiki
+//
+//  Copyright (c) 2015 Michigan State University. All rights reserved.
+//     to view the full license, visit:
+//         github.com/Hintzelab/MABE/wiki/License
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// A fixed size ring of messages in memory that is shared by processes made
+// with fork (i.e. the worker processes of IslandsOptimizer). The memory is
+// mapped when the ring is constructed, so the ring must be made before the
+// fork. Any process may push, the owner of the ring takes all waiting
+// messages with popAll. Pushing and popping are guarded by a spin lock in the
+// shared memory and are only meant for occasional use (i.e. migration).
+// Only available on unix like systems (see Filesystem.h), on other systems
+// the constructor exits with an error.
+class SharedRingBuffer {
+public:
+  explicit SharedRingBuffer(size_t capacity); // capacity in bytes
+  ~SharedRingBuffer();
+
+  SharedRingBuffer(const SharedRingBuffer &) = delete;
+  SharedRingBuffer &operator=(const SharedRingBuffer &) = delete;
+
+  // add message to the ring, return false (and drop message) if there is not
+  // enough free space
+  bool push(const std::string &message);
+  // move all waiting messages (oldest first) into messages
+  void popAll(std::vector<std::string> &messages);
+
+private:
+  struct Header; // lives at the start of the shared memory
+
+  Header *header = nullptr;
+  char *ring = nullptr; // capacity bytes after the header
+  size_t capacity;
+  size_t mappedSize = 0;
+
+  void lock();
+  void unlock();
+  void copyIn(uint64_t position, const char *data, size_t size);
+  void copyOut(uint64_t position, char *data, size_t size);
+};
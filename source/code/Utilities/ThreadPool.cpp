@@ -0,0 +1,80 @@
+//  MABE is a product of The Hintze Lab @ MSU
+//     for general research information:
+//         hintzelab.msu.edu
+//     for MABE documentation:
+//         github.com/Hintzelab/MABE/wiki
+//
+//  Copyright (c) 2015 Michigan State University. All rights reserved.
+//     to view the full license, visit:
+//         github.com/Hintzelab/MABE/wiki/License
+
+#include "ThreadPool.h"
+
+ThreadPool::ThreadPool(int threadCount) {
+  for (int i = 1; i < threadCount; i++) {
+    workers.emplace_back(&ThreadPool::workerLoop, this);
+  }
+}
+
+ThreadPool::~ThreadPool() {
+  {
+    std::lock_guard<std::mutex> lock(poolMutex);
+    shuttingDown = true;
+  }
+  startJob.notify_all();
+  for (auto &worker : workers) {
+    worker.join();
+  }
+}
+
+void ThreadPool::runIndices() {
+  int index;
+  while ((index = nextIndex.fetch_add(1)) < jobCount) {
+    (*job)(index);
+  }
+}
+
+void ThreadPool::workerLoop() {
+  int lastJobID = 0;
+  while (true) {
+    {
+      std::unique_lock<std::mutex> lock(poolMutex);
+      startJob.wait(lock, [&] { return shuttingDown || jobID != lastJobID; });
+      if (shuttingDown) {
+        return;
+      }
+      lastJobID = jobID;
+    }
+    runIndices();
+    {
+      std::lock_guard<std::mutex> lock(poolMutex);
+      if (--busyWorkers == 0) {
+        jobDone.notify_one();
+      }
+    }
+  }
+}
+
+void ThreadPool::parallelFor(int count,
+                             const std::function<void(int)> &jobFunction) {
+  if (workers.empty() || count <= 1) { // nothing to share, just run here
+    for (int i = 0; i < count; i++) {
+      jobFunction(i);
+    }
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock(poolMutex);
+    job = &jobFunction;
+    jobCount = count;
+    nextIndex = 0;
+    busyWorkers = static_cast<int>(workers.size());
+    jobID++;
+  }
+  startJob.notify_all();
+  runIndices(); // the calling thread works too
+
+  std::unique_lock<std::mutex> lock(poolMutex);
+  jobDone.wait(lock, [&] { return busyWorkers == 0; });
+  job = nullptr;
+}
@@ -0,0 +1,58 @@
+//  MABE is a product of The Hintze Lab @ MSU
+//     for general research information:
+//         hintzelab.msu.edu
+//     for MABE documentation:
+//         github.com/Hintzelab/MABE/wiki
+//
+//  Copyright (c) 2015 Michigan State University. All rights reserved.
+//     to view the full license, visit:
+//         github.com/Hintzelab/MABE/wiki/License
+
+// A small persistent pool of worker threads. Workers are created once and
+// then sleep between jobs. parallelFor hands out indices [0,count) to the
+// workers (and the calling thread) and blocks until all indices are done.
+// Which thread runs which index is not fixed, so jobs must not depend on it
+// (give each index it's own random generator, see Random::ScopedGenerator).
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class ThreadPool {
+  std::vector<std::thread> workers;
+
+  std::mutex poolMutex;
+  std::condition_variable startJob; // signaled when a new job is posted (or on shutdown)
+  std::condition_variable jobDone;  // signaled when the last worker leaves a job
+
+  const std::function<void(int)> *job = nullptr; // job currently being run
+  int jobCount = 0;                // number of indices in the current job
+  std::atomic<int> nextIndex{0};   // next index to be handed out
+  int jobID = 0;                   // increments for each job so workers can tell jobs apart
+  int busyWorkers = 0;             // workers still working on the current job
+  bool shuttingDown = false;
+
+  void workerLoop();
+  void runIndices(); // pull indices from nextIndex until the job is exhausted
+
+public:
+  // threadCount is the total number of threads that will work on a job,
+  // including the thread that calls parallelFor (so threadCount - 1 workers
+  // are created)
+  explicit ThreadPool(int threadCount);
+  ~ThreadPool();
+
+  ThreadPool(const ThreadPool &) = delete;
+  ThreadPool &operator=(const ThreadPool &) = delete;
+
+  int size() const { return static_cast<int>(workers.size()) + 1; }
+
+  // call jobFunction(i) for every i in [0,count). returns when all calls have
+  // finished.
+  void parallelFor(int count, const std::function<void(int)> &jobFunction);
+};
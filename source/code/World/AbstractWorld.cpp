@@ -10,6 +10,9 @@
 
 #include "AbstractWorld.h"
 
+#include <Global.h>
+#include <Utilities/Random.h>
+
 /*
 #include <math.h>
 
@@ -27,3 +30,83 @@ std::shared_ptr<ParameterLink<std::string>> AbstractWorld::worldTypePL =
         "WORLD-worldType", std::string("This_string_is_set_by_modules.h"),
         "This_string_is_set_by_modules.h");
 ////// WORLD-worldType is actually set by Modules.h //////
+
+std::shared_ptr<ParameterLink<int>> AbstractWorld::batchSizePL =
+    Parameters::register_parameter(
+        "WORLD-batchSize", 32,
+        "worlds which support it will update up to this many organisms together\n"
+        "if their brains can be batched (see AbstractBrain::makeBatch, currently\n"
+        "RNN brains). Results are the same as with no batching (1)");
+
+void AbstractWorld::evaluateOrganisms(
+    const std::vector<std::shared_ptr<Organism>> &population,
+    const std::function<void(std::shared_ptr<Organism>)> &evaluateOrg,
+    bool serial) {
+  // draw one seed per organism from the common generator. This is done
+  // serially and in population order so that the common generator advances
+  // the same amount no matter how many threads are used.
+  std::vector<Random::Generator::result_type> seeds(population.size());
+  for (auto &seed : seeds) {
+    seed = Random::getCommonGenerator()();
+  }
+
+  auto evaluateIndex = [&](int i) {
+    Random::Generator orgGenerator(seeds[i]);
+    Random::ScopedGenerator scope(orgGenerator);
+    evaluateOrg(population[i]);
+  };
+
+  if (serial) {
+    for (int i = 0; i < static_cast<int>(population.size()); i++) {
+      evaluateIndex(i);
+    }
+  } else {
+    getThreadPool().parallelFor(static_cast<int>(population.size()), evaluateIndex);
+  }
+}
+
+void AbstractWorld::evaluateOrganismBatches(
+    const std::vector<std::shared_ptr<Organism>> &population, int batchSize,
+    const std::function<void(const std::vector<std::shared_ptr<Organism>> &,
+                             std::vector<Random::Generator> &)> &evaluateBatch,
+    bool serial) {
+  // seeds are drawn just as in evaluateOrganisms
+  std::vector<Random::Generator::result_type> seeds(population.size());
+  for (auto &seed : seeds) {
+    seed = Random::getCommonGenerator()();
+  }
+
+  batchSize = std::max(1, batchSize);
+  int batchCount = (static_cast<int>(population.size()) + batchSize - 1) / batchSize;
+
+  auto evaluateBatchIndex = [&](int batchIndex) {
+    int first = batchIndex * batchSize;
+    int last = std::min(first + batchSize, static_cast<int>(population.size()));
+    std::vector<std::shared_ptr<Organism>> organisms(population.begin() + first,
+                                                     population.begin() + last);
+    std::vector<Random::Generator> generators;
+    for (int i = first; i < last; i++) {
+      generators.emplace_back(seeds[i]);
+    }
+    evaluateBatch(organisms, generators);
+  };
+
+  if (serial) {
+    for (int b = 0; b < batchCount; b++) {
+      evaluateBatchIndex(b);
+    }
+  } else {
+    getThreadPool().parallelFor(batchCount, evaluateBatchIndex);
+  }
+}
+
+ThreadPool &AbstractWorld::getThreadPool() {
+  if (!threadPool) {
+    int threads = Global::threadsPL->get(PT);
+    if (threads < 1) {
+      threads = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+    }
+    threadPool = std::make_shared<ThreadPool>(threads);
+  }
+  return *threadPool;
+}
@@ -11,18 +11,23 @@
 #pragma once
 
 #include <cstdlib>
+#include <functional>
 #include <thread>
 #include <vector>
 
 #include <Group/Group.h>
 #include <Utilities/Utilities.h>
+#include <Utilities/Checkpoint.h>
 #include <Utilities/Data.h>
 #include <Utilities/Parameters.h>
+#include <Utilities/Random.h>
+#include <Utilities/ThreadPool.h>
 
 class AbstractWorld {
 public:
   static std::shared_ptr<ParameterLink<bool>> debugPL;
   static std::shared_ptr<ParameterLink<std::string>> worldTypePL;
+  static std::shared_ptr<ParameterLink<int>> batchSizePL;
 
   const std::shared_ptr<ParametersTable> PT;
 
@@ -43,4 +48,40 @@ public:
 
   virtual void evaluate(std::map<std::string, std::shared_ptr<Group>> &groups,
 	  int analyze = 0, int visualize = 0, int debug = 0) = 0;
+
+  // checkpoints (see saveCheckpoint in main.cpp). worlds that keep state
+  // between updates (other then what is set from parameters when the world
+  // is made) save it here so that a resumed run continues the same way
+  virtual void saveCheckpoint(CheckpointWriter &checkpoint) {}
+  virtual void loadCheckpoint(CheckpointReader &checkpoint) {}
+
+  // call evaluateOrg for each organism in population, spreading the calls over
+  // GLOBAL-threads threads. Each organism is evaluated with it's own random
+  // generator (Random::getCommonGenerator() is redirected for the duration of
+  // the call) which is seeded, in population order, from the common generator.
+  // This makes results independent of the number of threads.
+  // evaluateOrg must only change the organism it is given (and it's brains and
+  // dataMap), anything shared must be read only or guarded.
+  // if serial is true, all organisms are evaluated on the calling thread (use
+  // this for analyze/visualize/debug where output order matters)
+  void evaluateOrganisms(
+      const std::vector<std::shared_ptr<Organism>> &population,
+      const std::function<void(std::shared_ptr<Organism>)> &evaluateOrg,
+      bool serial = false);
+
+  // like evaluateOrganisms, but the population is split into batches of up to
+  // batchSize organisms (in population order) and evaluateBatch is called once
+  // per batch. generators[i] is the generator organisms[i] would have been given
+  // by evaluateOrganisms, so a world which draws each organisms random numbers
+  // from it's own generator gets the same results as evaluateOrganisms.
+  // Use this with AbstractBrain::makeBatch to update many brains together.
+  void evaluateOrganismBatches(
+      const std::vector<std::shared_ptr<Organism>> &population, int batchSize,
+      const std::function<void(const std::vector<std::shared_ptr<Organism>> &,
+                               std::vector<Random::Generator> &)> &evaluateBatch,
+      bool serial = false);
+
+private:
+  std::shared_ptr<ThreadPool> threadPool; // created on first use
+  ThreadPool &getThreadPool();
 };
@@ -633,6 +633,13 @@ bool BerryWorld::WorldMap::loadMap(std::ifstream &FILE,
   std::vector<int> rawMap;
   std::vector<int> rawStartMap;
 
+  // files with windows line ends leave a '\r' at the end of each line, this is
+  // not part of the map (and would load as a column of -35s)
+  auto lineLength = [&rawLine]() {
+    return (!rawLine.empty() && rawLine.back() == '\r') ? rawLine.size() - 1
+                                                        : rawLine.size();
+  };
+
   if (FILE.is_open()) {
     atEOF = readFileLine(FILE, rawLine, ss);
     if (atEOF) { // if what's left in file is only whitespace...
@@ -646,9 +653,9 @@ bool BerryWorld::WorldMap::loadMap(std::ifstream &FILE,
     // make_shared<ParametersTable>(parentPT->getTableNameSpace()+"::"+fileName+"__"+name,Parameters::root);
     if (name != "") {
       atEOF = readFileLine(FILE, rawLine, ss); // read next line of file
-      worldX = rawLine.size(); // x size of map is length of this line
+      worldX = lineLength(); // x size of map is length of this line
       while (!atEOF && ss.peek() != '*' && ss.peek() != '+') {
-        if (rawLine.size() != worldX) {
+        if (lineLength() != worldX) {
           std::cout << "  While loading map " << name << " from file: " << file
                     << ", map has a line with the incorrect length\nexiting"
                     << std::endl;
@@ -683,7 +690,7 @@ bool BerryWorld::WorldMap::loadMap(std::ifstream &FILE,
                 << std::endl;
             exit(1);
           }
-          if (rawLine.size() != worldX) {
+          if (lineLength() != worldX) {
             std::cout << "  While loading map " << name
                       << " from file: " << file
                       << ", starting locations has a line with the incorrect "
@@ -1985,6 +1992,12 @@ void BerryWorld::runWorld(std::map<std::string, std::shared_ptr<Group>> &groups,
         generatorEvents[generators[i].nextEvent()].push_back(i);
       }
 
+      // sensor values (19 per sensor, one for each value a location can hold),
+      // made once here and reused every time a harvester senses
+      std::vector<int> visionValues(visionSensorCount * 19);
+      std::vector<int> smellValues(smellSensorCount * 19);
+      std::vector<int> sensorValues(19);
+
       // run evaluation
       for (int t = 0; t < evalTime; t++) {
         if (visualize) {
@@ -2052,74 +2065,59 @@ void BerryWorld::runWorld(std::map<std::string, std::shared_ptr<Group>> &groups,
             int inputCounter =
                 0; // This counter is used while setting brain inputs
 
-            std::vector<int> sensorValues(19);
-
             // for each sensor, collect data and set inputs
-            int sensorFacing;
-
             int locX = (int)harvester->loc.x;
             int locY = (int)harvester->loc.y;
 
+            if (visionSensorCount > 0) { // load what sensors see into visionValues
+              visionSensor.senseAll(foodMap, locX, locY, harvester->face,
+                                    visionSensorDirections, visionValues, 19,
+                                    wallsBlockVisonSensors ? WALL : -1, true);
+            }
             for (int i = 0; i < visionSensorCount;
                  i++) { // set inputs for vision sensors
-              sensorFacing =
-                  loopMod(harvester->face + visionSensorDirections[i],
-                          rotationResolution);
-              if (wallsBlockVisonSensors) {
-                visionSensor.senseTotals(
-                    foodMap, locX, locY, sensorFacing, sensorValues, WALL,
-                    true); // load what sensor sees into sensorValues
-              } else {
-                visionSensor.senseTotals(
-                    foodMap, locX, locY, sensorFacing, sensorValues, -1,
-                    true); // load what sensor sees into sensorValues
-              }
+              const int *values = &visionValues[i * 19];
               if (seeFood) {
                 for (int food = 1; food <= foodTypes; food++) {
                   brain->setInput(inputCounter++,
-                                  sensorValues[food] + sensorValues[food + 10]);
+                                  values[food] + values[food + 10]);
                 }
               }
               if (seeOther) {
                 int others = 0;
                 for (int val = 10; val < 19; val++) {
-                  others += sensorValues[val];
+                  others += values[val];
                 }
                 brain->setInput(inputCounter++, others); // set occupied
               }
               if (seeWalls) {
-                brain->setInput(inputCounter++, sensorValues[WALL]); // set wall
+                brain->setInput(inputCounter++, values[WALL]); // set wall
               }
             }
 
+            if (smellSensorCount > 0) { // load what sensors smell into smellValues
+              smellSensor.senseAll(foodMap, locX, locY, harvester->face,
+                                   smellSensorDirections, smellValues, 19,
+                                   wallsBlockSmellSensors ? WALL : -1, true);
+            }
             for (int i = 0; i < smellSensorCount;
                  i++) { // set inputs for smell sensors
-              sensorFacing = loopMod(harvester->face + smellSensorDirections[i],
-                                     rotationResolution);
-              if (wallsBlockSmellSensors) {
-                smellSensor.senseTotals(
-                    foodMap, locX, locY, sensorFacing, sensorValues, WALL,
-                    true); // load what sensor sees into sensorValues
-              } else {
-                smellSensor.senseTotals(
-                    foodMap, locX, locY, sensorFacing, sensorValues, -1,
-                    true); // load what sensor sees into sensorValues
-              }
+              const int *values = &smellValues[i * 19];
               if (smellFood) {
                 for (int food = 1; food <= foodTypes; food++) {
                   brain->setInput(inputCounter++,
-                                  sensorValues[food] + sensorValues[food + 10]);
+                                  values[food] + values[food + 10]);
                 }
               }
               if (smellOther) {
                 int others = 0;
                 for (int val = 10; val < 19; val++) {
-                  others += sensorValues[val];
+                  others += values[val];
                 }
                 brain->setInput(inputCounter++, others); // set occupied
               }
               if (smellWalls) {
-                brain->setInput(inputCounter++, sensorValues[WALL]); // set wall
+                brain->setInput(inputCounter++, values[WALL]); // set wall
               }
             }
 
@@ -855,6 +855,23 @@ public:
 
 	std::map<int, std::shared_ptr<SensorArc>> angles;
 
+	// the locations trees of angles copied into flat arrays (one per facing),
+	// so that sensing does not need to look up angles or walk SensorArc::Location
+	// for each cell
+	struct Cell {
+		int dx, dy; // offset from the sensing location
+		int clearIndex, blockedIndex; // next cell if this cell is clear/blocked (-1 = done)
+	};
+	std::vector<std::vector<Cell>> cells; // cells[facing]
+	// cells visited when nothing is blocked (cells[facing] from 0 following clearIndex)
+	std::vector<std::vector<std::pair<int, int>>> clearPaths;
+	// bounding box of the offsets for each facing, if the box (placed at the
+	// sensing location) is inside the grid, no wrapping is needed
+	struct Bounds {
+		int minX, maxX, minY, maxY;
+	};
+	std::vector<Bounds> bounds;
+
 	Sensor() {
 		resolution = 0;
 	}
@@ -867,53 +884,85 @@ public:
 			//std::cout << "   building arc # " << i << endl;
 			angles[i] = std::make_shared<SensorArc>((i * resolutionOffset) + angle1, (i * resolutionOffset) + angle2, distanceMax, distanceMin, calculateBlocking);
 		}
+		flatten();
 	}
 
-	void senseTotals(Vector2d<int>& worldgrid, int& orgx, int& orgy, int& orgf, std::vector<int>& values, int blocker = -1, bool wrap = false) {
+	void flatten() {
+		cells.assign(resolution, {});
+		clearPaths.assign(resolution, {});
+		bounds.assign(resolution, { 0, 0, 0, 0 });
+		for (int facing = 0; facing < resolution; facing++) {
+			auto &arc = angles[facing];
+			for (int i = 0; i < (int)arc->locationsTree.size(); i++) {
+				cells[facing].push_back({ arc->cX(i), arc->cY(i), arc->locationsTree[i].clearIndex, arc->locationsTree[i].blockedIndex });
+				bounds[facing].minX = std::min(bounds[facing].minX, arc->cX(i));
+				bounds[facing].maxX = std::max(bounds[facing].maxX, arc->cX(i));
+				bounds[facing].minY = std::min(bounds[facing].minY, arc->cY(i));
+				bounds[facing].maxY = std::max(bounds[facing].maxY, arc->cY(i));
+			}
+			for (int i = cells[facing].empty() ? -1 : 0; i != -1; i = cells[facing][i].clearIndex) {
+				clearPaths[facing].push_back({ cells[facing][i].dx, cells[facing][i].dy });
+			}
+		}
+	}
 
-		bool blocked = false;
-		int currentIndex = 0;
+	// values[v] is set to the number of cells with value v which the sensor at
+	// orgx,orgy facing orgf reaches (a cell that holds blocker is counted, but
+	// hides what is behind it). values must be large enough to hold every grid
+	// value. if wrap, the sensor wraps around the edges of the grid
+	void senseTotals(Vector2d<int>& worldgrid, int orgx, int orgy, int orgf, int *values, int valuesCount, int blocker = -1, bool wrap = false) {
+		std::fill(values, values + valuesCount, 0);
 
-		fill(values.begin(), values.end(), 0);
+		auto &box = bounds[orgf];
+		int width = worldgrid.x();
+		int height = worldgrid.y();
+		// when the whole sensor is inside the grid wrapping would not change anything
+		wrap = wrap && !(orgx + box.minX >= 0 && orgx + box.maxX < width && orgy + box.minY >= 0 && orgy + box.maxY < height);
+		const int *grid = worldgrid.rawData();
 
-		int currentX; // = loopMod(this->angles[orgf]->cX(currentIndex) + orgx,worldgrid.x());
-		int currentY; // = loopMod(this->angles[orgf]->cY(currentIndex) + orgy,worldgrid.y());
+		if (blocker < 0) { // the grid does not hold negative values, so nothing blocks
+			if (wrap) {
+				for (auto &offset : clearPaths[orgf]) {
+					values[grid[loopMod(orgy + offset.second, height) * width + loopMod(orgx + offset.first, width)]]++;
+				}
+			}
+			else {
+				int origin = orgy * width + orgx;
+				for (auto &offset : clearPaths[orgf]) {
+					values[grid[origin + offset.second * width + offset.first]]++;
+				}
+			}
+			return;
+		}
 
+		const Cell *tree = cells[orgf].data();
+		int currentIndex = cells[orgf].empty() ? -1 : 0;
 		if (wrap) {
-
 			while (currentIndex != -1) {
-				//std::cout << currentIndex << "  :  " << this->angles[orgf]->locationsTree[currentIndex].locationID << "  :  " << this->angles[orgf]->cX(currentIndex) << "," << this->angles[orgf]->cY(currentIndex) << "  "
-				//<< this->angles[orgf]->cX(currentIndex) + orgx << "," << this->angles[orgf]->cY(currentIndex) + orgy << "  <>  " << worldgrid(this->angles[orgf]->cX(currentIndex) + orgx, this->angles[orgf]->cY(currentIndex) + orgy) << endl;
-				currentX = loopMod(this->angles[orgf]->cX(currentIndex) + orgx, worldgrid.x());
-				currentY = loopMod(this->angles[orgf]->cY(currentIndex) + orgy, worldgrid.y());
-				blocked = worldgrid(currentX, currentY) == blocker;
-				//if (!this->angles[orgf]->isBlockingOnly(currentIndex)) {
-				values[worldgrid(currentX, currentY)]++;
-				//} //else {
-				//std::cout << " isBlockingOnly" << endl;
-				//}
-				//std::cout << blocker << "    " << ((blocked) ? "blocked" : "open") << endl;
-				currentIndex = this->angles[orgf]->advanceIndex(currentIndex, blocked);
-				//std::cout << " nextIndex: " << currentIndex << endl;
+				auto &cell = tree[currentIndex];
+				int value = grid[loopMod(orgy + cell.dy, height) * width + loopMod(orgx + cell.dx, width)];
+				values[value]++;
+				currentIndex = value == blocker ? cell.blockedIndex : cell.clearIndex;
 			}
 		}
 		else {
+			int origin = orgy * width + orgx;
 			while (currentIndex != -1) {
-				//std::cout << currentIndex << "  :  " << this->angles[orgf]->locationsTree[currentIndex].locationID << "  :  " << this->angles[orgf]->cX(currentIndex) << "," << this->angles[orgf]->cY(currentIndex) << "  "
-				//<< this->angles[orgf]->cX(currentIndex) + orgx << "," << this->angles[orgf]->cY(currentIndex) + orgy << "  <>  " << worldgrid(this->angles[orgf]->cX(currentIndex) + orgx, this->angles[orgf]->cY(currentIndex) + orgy) << endl;
-				currentX = this->angles[orgf]->cX(currentIndex) + orgx, worldgrid.x();
-				currentY = this->angles[orgf]->cY(currentIndex) + orgy, worldgrid.y();
-				blocked = worldgrid(currentX, currentY) == blocker;
-				//if (!this->angles[orgf]->isBlockingOnly(currentIndex)) {
-				values[worldgrid(currentX, currentY)]++;
-				//} //else {
-				//std::cout << " isBlockingOnly" << endl;
-				//}
-				//std::cout << blocker << "    " << ((blocked) ? "blocked" : "open") << endl;
-				currentIndex = this->angles[orgf]->advanceIndex(currentIndex, blocked);
-				//std::cout << " nextIndex: " << currentIndex << endl;
+				auto &cell = tree[currentIndex];
+				int value = grid[origin + cell.dy * width + cell.dx];
+				values[value]++;
+				currentIndex = value == blocker ? cell.blockedIndex : cell.clearIndex;
 			}
 		}
 	}
 
+	// sense in each of directions (relative to facing) at once, the totals for
+	// directions[i] are placed in values[i * valuesCount ... (i + 1) * valuesCount)
+	// (values must hold directions.size() * valuesCount values)
+	void senseAll(Vector2d<int>& worldgrid, int orgx, int orgy, int facing, const std::vector<int>& directions, std::vector<int>& values, int valuesCount, int blocker = -1, bool wrap = false) {
+		for (size_t i = 0; i < directions.size(); i++) {
+			senseTotals(worldgrid, orgx, orgy, loopMod(facing + directions[i], resolution), values.data() + i * valuesCount, valuesCount, blocker, wrap);
+		}
+	}
+
 };
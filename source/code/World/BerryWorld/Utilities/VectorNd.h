@@ -121,6 +121,9 @@ public:
   int x() { return C; }
 
   int y() { return R; }
+
+  // the values, row by row (x,y is at y * x() + x)
+  const T *rawData() { return data.data(); }
 };
 
 // Vector3d is wraps a vector<T> and provides x,y,z style access
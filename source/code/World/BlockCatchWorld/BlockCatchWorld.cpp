@@ -401,12 +401,254 @@ BlockCatchWorld::BlockCatchWorld(std::shared_ptr<ParametersTable> _PT) : Abstrac
 
 
 
+// allocate patternBuffer for a world of size worldX, load the pattern (at a position based on patternStartPositions)
+// and place the paddle (sensorArray and gapArray) at the left side of the world
+void BlockCatchWorld::setupTrial(int patternIndex, int repeat, int worldX, std::vector<std::vector<int>>& patternBuffer, std::vector<int>& sensorArray, std::vector<int>& gapArray) {
+	// allocate space for all frames in this pattern
+	patternBuffer.assign(allPatterns[patternIndex].size(), std::vector<int>(worldX, 0));
+
+	// get paddle offset based on patterStartPosition parameter 
+	int patternOffset;
+	if (patternStartPositions == 0) { // ALL
+		patternOffset = repeat;
+	}
+	else if (patternStartPositions == 1) { // ALL_CLEAR
+		patternOffset = paddleWidth + repeat;
+	}
+	else if (patternStartPositions == 2) { // RANDOM
+		patternOffset = Random::getIndex(worldX);
+	}
+	else if (patternStartPositions == 3) { // RANDOM_CLEAR
+		patternOffset = Random::getInt(paddleWidth, worldX - patternSizes[patternIndex]);
+	}
+	// load pattern into buffer
+	for (size_t frame = 0; frame < allPatterns[patternIndex].size(); frame++) { // for each frame in pattern
+		for (int loc = 0; loc < patternSizes[patternIndex]; loc++) { // for each location
+			patternBuffer[frame][loopMod(patternOffset + loc, worldX)] = allPatterns[patternIndex][frame][loc];
+		}
+	}
+
+	sensorArray.clear();
+	gapArray.clear();
+
+	// load the paddle buffer and gap buffer with paddle at left
+	for (size_t i = 0; i < paddleShape.size(); i++) {
+		if (paddleShape[i] == 1) {
+			sensorArray.push_back(loopMod(i, worldX));
+		}
+		else if (paddleShape[i] == 0) {
+			gapArray.push_back(loopMod(i, worldX));
+		}
+	}
+}
+
+// move the paddle based on action (1 = left, 2 = right, 0 or 3 = stay) and the pattern based on direction
+void BlockCatchWorld::moveWorld(int action, int direction, int worldX, std::vector<std::vector<int>>& patternBuffer, std::vector<int>& sensorArray, std::vector<int>& gapArray) {
+	switch (action) { // for cases 0 and 3 do nothing (i.e. 0,0 or 1,1)
+	case 1: // left
+		for (int i = 0; i < sensorArray.size(); i++) {
+			sensorArray[i] = loopMod(sensorArray[i] - 1, worldX);
+		}
+		for (int i = 0; i < gapArray.size(); i++) {
+			gapArray[i] = loopMod(gapArray[i] - 1, worldX);
+		}
+		break;
+	case 2: // right
+		for (int i = 0; i < sensorArray.size(); i++) {
+			sensorArray[i] = (sensorArray[i] + 1) % worldX;
+		}
+		for (int i = 0; i < gapArray.size(); i++) {
+			gapArray[i] = (gapArray[i] + 1) % worldX;
+		}
+	}
+
+	// move all frames in patternBuffer
+	if (direction < 0) { // if block is moving left
+		for (size_t i = 0; i < patternBuffer.size(); i++) {
+			std::rotate(patternBuffer[i].begin(), patternBuffer[i].begin() + loopMod(std::abs(direction), worldX), patternBuffer[i].end()); // shift block left. if anything gets cut off, shift it to the other side
+		}
+	}
+	else if (direction > 0) { // block is moving right
+		for (size_t i = 0; i < patternBuffer.size(); i++) {
+			std::rotate(patternBuffer[i].begin(), patternBuffer[i].begin() + (patternBuffer[i].size() - loopMod(direction, worldX)), patternBuffer[i].end()); // shift block left. if anything gets cut off, shift it to the other side
+		}
+	} // else no movement - do nothing
+}
+
+// how much did the paddle hit the falling frame (what counts as a hit depends on scoreMethod)
+int BlockCatchWorld::getHit(const std::vector<int>& frame, const std::vector<int>& sensorArray, const std::vector<int>& gapArray) {
+	int hit = 0;
+	if (scoreMethod <= 2) { // scoreing method is not summing
+		if (scoreMethod == 0) { // ANY_ANY - at least one element in the pattern (visible or invisible) contacts one sensor or non-sensor
+			for (int sensorIndex = 0; sensorIndex < sensorArray.size() && hit == 0; sensorIndex++) { // for locaiton in paddle and while no hit has been detected
+				if (frame[sensorArray[sensorIndex]] > 0) { // if location overlaps pattern
+					hit = 1; // set hit true
+				}
+			}
+			for (int gapIndex = 0; gapIndex < gapArray.size() && hit == 0; gapIndex++) { // for locaiton in paddle and while no hit has been detected
+				if (frame[gapArray[gapIndex]] > 0) { // if location overlaps pattern
+					hit = 1; // set hit true
+				}
+			}
+		}
+		else if (scoreMethod == 1) { // VISIBLE_ANY = at least one visible element in pattern contacts at least one sensor or non-sensor
+			for (int sensorIndex = 0; sensorIndex < sensorArray.size() && hit == 0; sensorIndex++) { // for locaiton in paddle and while no hit has been detected
+				if (frame[sensorArray[sensorIndex]] == 1) { // if location overlaps visible pattern
+					hit = 1; // set hit true
+				}
+			}
+			for (int gapIndex = 0; gapIndex < gapArray.size() && hit == 0; gapIndex++) { // for locaiton in paddle and while no hit has been detected
+				if (frame[gapArray[gapIndex]] == 1) { // if location overlaps visible pattern
+					hit = 1; // set hit true
+				}
+			}
+		}
+		else if (scoreMethod == 2) { // VISIBLE_SENSOR = at least one visible element of pattern contacts atlease one sensor
+			for (int sensorIndex = 0; sensorIndex < sensorArray.size() && hit == 0; sensorIndex++) { // for locaiton in paddle and while no hit has been detected
+				if (frame[sensorArray[sensorIndex]] == 1) { // if location overlaps pattern
+					hit = 1; // set hit true
+				}
+			}
+		}
+	}
+	else {
+		if (scoreMethod == 3) { // SUM_ALL_ALL = for each pattern location (visible or invisible) that overlaps a sensor or non-sensor record a hit
+			for (int sensorIndex = 0; sensorIndex < sensorArray.size(); sensorIndex++) { // for locaiton in paddle and while no hit has been detected
+				if (frame[sensorArray[sensorIndex]] > 0) { // if location overlaps pattern
+					hit++; // record a hit
+				}
+			}
+			for (int gapIndex = 0; gapIndex < gapArray.size(); gapIndex++) { // for locaiton in paddle and while no hit has been detected
+				if (frame[gapArray[gapIndex]] > 0) { // if location overlaps pattern
+					hit++; // record a hit
+				}
+			}
+		}
+		else if (scoreMethod == 4) { // SUM_VISIBLE_SENSOR = for each visible pattern location that overlaps a sensor record a hit
+			for (int sensorIndex = 0; sensorIndex < sensorArray.size(); sensorIndex++) { // for locaiton in paddle and while no hit has been detected
+				if (frame[sensorArray[sensorIndex]] == 1) { // if location overlaps pattern
+					hit++; // record a hit
+				}
+			}
+		}
+		else if (scoreMethod == 5) { // SUM_VISIBLE_NON_SENSOR = for each visible pattern location that overlaps a non-sensor record a hit
+			for (int gapIndex = 0; gapIndex < gapArray.size(); gapIndex++) { // for locaiton in paddle and while no hit has been detected
+				if (frame[gapArray[gapIndex]] == 1) { // if location overlaps pattern
+					hit++; // record a hit
+				}
+			}
+		}
+	}
+	return hit;
+}
+
+// update correct and incorrect counts given the hit value for one trial
+void BlockCatchWorld::scoreHit(int patternIndex, int hit, int& correct, int& incorrect, std::vector<int>& correctPer, std::vector<int>& incorrectPer) {
+	if (scoreMethod <= 2) { // scoreing method is not summing
+		// now set correct and/or incorrect (for non-sum scoring methods)
+		if (patternIndex < catchPatternsCount) { // if patternIndex is < catchPatternsCount we should be catching this
+			if (hit) {
+				correct++;
+				correctPer[patternIndex]++;
+			}
+			else {
+				incorrect++;
+				incorrectPer[patternIndex]++;
+			}
+		}
+		else { // this is in the set of patterns to miss
+			if (hit) {
+				incorrect++;
+				incorrectPer[patternIndex]++;
+			}
+			else {
+				correct++;
+				correctPer[patternIndex]++;
+			}
+		}
+	}
+	else {
+		// now set correct and/or incorrect (for sum scoring methods)
+		// in this mode, correct are accumulated for each hit on a to catch pattern
+		// and incorrect are accumulated for each hit on a to miss pattern 
+		if (patternIndex < catchPatternsCount) { // if patternIndex is < catchPatternsCount we should be catching this
+			correct += hit;
+			correctPer[patternIndex] += hit;
+		}
+		else { // this is in the set of patterns to miss
+			incorrect += hit;
+			incorrectPer[patternIndex] += hit;
+		}
+	}
+}
+
+// run all repeats of one pattern, up to 64 trials at a time (one per brain lane, see AbstractBrain::canUpdateLanes)
+// random values are drawn in the same order as when running one trial at a time, so the results are the same
+void BlockCatchWorld::evaluatePatternInLanes(std::shared_ptr<AbstractBrain> brain, int patternIndex, size_t repeats, int& directionCounter,
+	int& correct, int& incorrect, std::vector<int>& correctPer, std::vector<int>& incorrectPer) {
+	const int directionsCount = patternDirections[patternIndex].size();
+	for (size_t firstRepeat = 0; firstRepeat < repeats; firstRepeat += 64) {
+		int laneCount = (int)std::min<size_t>(64, repeats - firstRepeat);
+
+		std::vector<int> worldX(laneCount), endTime(laneCount), laneDirectionCounter(laneCount), frameIndex(laneCount, 0);
+		std::vector<std::vector<std::vector<int>>> patternBuffer(laneCount);
+		std::vector<std::vector<int>> sensorArray(laneCount), gapArray(laneCount);
+		int maxEndTime = -1;
+		for (int l = 0; l < laneCount; l++) {
+			worldX[l] = Random::getInt(worldXMin, worldXMax);
+			endTime[l] = Random::getInt(startYMin, startYMax);
+			setupTrial(patternIndex, firstRepeat + l, worldX[l], patternBuffer[l], sensorArray[l], gapArray[l]);
+			// each trial picks up the pattern directions where the last trial left off
+			laneDirectionCounter[l] = directionCounter;
+			directionCounter = (directionCounter + std::max(0, endTime[l] + 1)) % directionsCount;
+			maxEndTime = std::max(maxEndTime, endTime[l]);
+		}
+
+		brain->resetLanes(laneCount);
+		for (int step = 0; step <= maxEndTime; step++) {
+			// lanes which have finished keep running, but are given no input and are otherwise ignored
+			for (size_t sensor = 0; sensor < sensorArray[0].size(); sensor++) {
+				uint64_t sensorLanes = 0;
+				for (int l = 0; l < laneCount; l++) {
+					if (step <= endTime[l] && patternBuffer[l][frameIndex[l]][sensorArray[l][sensor]] == 1) {
+						sensorLanes |= uint64_t(1) << l;
+					}
+				}
+				brain->setInputLanes(sensor, sensorLanes);
+			}
+
+			brain->updateLanes();
+
+			uint64_t outputLanes0 = brain->readOutputLanes(0);
+			uint64_t outputLanes1 = brain->readOutputLanes(1);
+			for (int l = 0; l < laneCount; l++) {
+				if (step > endTime[l]) {
+					continue;
+				}
+				int action = (int)((outputLanes0 >> l) & 1) + ((int)((outputLanes1 >> l) & 1) << 1);
+				moveWorld(action, patternDirections[patternIndex][laneDirectionCounter[l]], worldX[l], patternBuffer[l], sensorArray[l], gapArray[l]);
+				laneDirectionCounter[l] = (laneDirectionCounter[l] + 1) % directionsCount;
+				frameIndex[l] = (frameIndex[l] + 1) % patternBuffer[l].size();
+			}
+		}
+		brain->finishLanes();
+
+		for (int l = 0; l < laneCount; l++) {
+			scoreHit(patternIndex, getHit(patternBuffer[l][frameIndex[l]], sensorArray[l], gapArray[l]), correct, incorrect, correctPer, incorrectPer);
+		}
+	}
+}
+
 void BlockCatchWorld::evaluateSolo(std::shared_ptr<Organism> org, int analyze, int visualize, int debug) {
 
 	if (analyze) {
 		visualize = 1;
 	}
 
+	// local copy of repeats, since ALL_CLEAR sets repeats per pattern and
+	// organisms may be evaluated on more then one thread
+	size_t repeats = this->repeats;
+
 	int correct = 0; // total number of correct catches/misses
 	int incorrect = 0; // total number of incorrect catches/misses
 	std::vector<int> correctPer(patternsCount, 0); // total number of correct catches/misses per pattern
@@ -426,7 +668,10 @@ void BlockCatchWorld::evaluateSolo(std::shared_ptr<Organism> org, int analyze, i
 	//std::vector<std::vector<int>> outputStateSet;
 
 	auto brain = org->brains[brainName];
-	brain->setRecordActivity(true);
+	// brains that support it run many trials at once. brain activity (and worldStateSet) are only
+	// needed for analyze, so they are not collected in that case
+	bool useLanes = !analyze && !visualize && !debug && brain->canUpdateLanes();
+	brain->setRecordActivity(!useLanes);
 	int action;
 	for (int patternIndex = 0; patternIndex < patternsCount; patternIndex++) { // for patternIndex in number of patterns
 		int directionCounter = 0;
@@ -443,48 +688,21 @@ void BlockCatchWorld::evaluateSolo(std::shared_ptr<Organism> org, int analyze, i
 		}
 
 
+		if (useLanes) {
+			evaluatePatternInLanes(brain, patternIndex, repeats, directionCounter, correct, incorrect, correctPer, incorrectPer);
+			continue;
+		}
+
 		for (int repeat = 0; repeat < repeats; repeat++) {
 
 			//get worldX and start height for pattern;
 			int worldX = Random::getInt(worldXMin, worldXMax);
 			int endTime = Random::getInt(startYMin, startYMax);
 
-			// allocate space for all frames in this pattern
-			std::vector<std::vector<int>> patternBuffer(allPatterns[patternIndex].size(), std::vector<int>(worldX, 0));
-
-			// get paddle offset based on patterStartPosition parameter 
-			int patternOffset;
-			if (patternStartPositions == 0) { // ALL
-				patternOffset = repeat;
-			}
-			else if (patternStartPositions == 1) { // ALL_CLEAR
-				patternOffset = paddleWidth + repeat;
-			}
-			else if (patternStartPositions == 2) { // RANDOM
-				patternOffset = Random::getIndex(worldX);
-			}
-			else if (patternStartPositions == 3) { // RANDOM_CLEAR
-				patternOffset = Random::getInt(paddleWidth, worldX - patternSizes[patternIndex]);
-			}
-			// load pattern into buffer
-			for (size_t frame = 0; frame < allPatterns[patternIndex].size(); frame++) { // for each frame in pattern
-				for (int loc = 0; loc < patternSizes[patternIndex]; loc++) { // for each location
-					patternBuffer[frame][loopMod(patternOffset + loc, worldX)] = allPatterns[patternIndex][frame][loc];
-				}
-			}
-
+			std::vector<std::vector<int>> patternBuffer;
 			std::vector<int> sensorArray; // locations for the paddle sensors relitive to paddleLoc
 			std::vector<int> gapArray; // locations for the paddle sensors relitive to paddleLoc
-
-			// load the paddle buffer and gap buffer with paddle at left
-			for (size_t i = 0; i < paddleShape.size(); i++) {
-				if (paddleShape[i] == 1) {
-					sensorArray.push_back(loopMod(i, worldX));
-				}
-				else if (paddleShape[i] == 0) {
-					gapArray.push_back(loopMod(i, worldX));
-				}
-			}
+			setupTrial(patternIndex, repeat, worldX, patternBuffer, sensorArray, gapArray);
 
 			int frameIndex = 0;
 
@@ -520,35 +738,7 @@ void BlockCatchWorld::evaluateSolo(std::shared_ptr<Organism> org, int analyze, i
 				// read action from brain
 				action = Bit(brain->readOutput(0)) + (Bit(brain->readOutput(1)) << 1); // convert 2 bits of brain output to a value in range[0,3]
 
-				switch (action) { // for cases 0 and 3 do nothing (i.e. 0,0 or 1,1)
-				case 1: // left
-					for (int i = 0; i < sensorArray.size(); i++) {
-						sensorArray[i] = loopMod(sensorArray[i] - 1, worldX);
-					}
-					for (int i = 0; i < gapArray.size(); i++) {
-						gapArray[i] = loopMod(gapArray[i] - 1, worldX);
-					}
-					break;
-				case 2: // right
-					for (int i = 0; i < sensorArray.size(); i++) {
-						sensorArray[i] = (sensorArray[i] + 1) % worldX;
-					}
-					for (int i = 0; i < gapArray.size(); i++) {
-						gapArray[i] = (gapArray[i] + 1) % worldX;
-					}
-				}
-
-				// move all frames in patternBuffer
-				if (patternDirections[patternIndex][directionCounter] < 0) { // if block is moving left
-					for (size_t i = 0; i < patternBuffer.size(); i++) {
-						std::rotate(patternBuffer[i].begin(), patternBuffer[i].begin() + loopMod(std::abs(patternDirections[patternIndex][directionCounter]), worldX), patternBuffer[i].end()); // shift block left. if anything gets cut off, shift it to the other side
-					}
-				}
-				else if (patternDirections[patternIndex][directionCounter] > 0) { // block is moving right
-					for (size_t i = 0; i < patternBuffer.size(); i++) {
-						std::rotate(patternBuffer[i].begin(), patternBuffer[i].begin() + (patternBuffer[i].size() - loopMod(patternDirections[patternIndex][directionCounter], worldX)), patternBuffer[i].end()); // shift block left. if anything gets cut off, shift it to the other side
-					}
-				} // else no movement - do nothing
+				moveWorld(action, patternDirections[patternIndex][directionCounter], worldX, patternBuffer, sensorArray, gapArray);
 
 				directionCounter = (directionCounter + 1) % patternDirections[patternIndex].size(); // move to next direction in patternDirections list
 				frameIndex = (frameIndex + 1) % patternBuffer.size(); // move to next frame in this pattern
@@ -562,100 +752,7 @@ void BlockCatchWorld::evaluateSolo(std::shared_ptr<Organism> org, int analyze, i
 			} // end single pattern evaluation
 
 			//if the block has fallen, collect score information
-			int hit = 0;
-			if (scoreMethod <= 2) { // scoreing method is not summing
-				if (scoreMethod == 0) { // ANY_ANY - at least one element in the pattern (visible or invisible) contacts one sensor or non-sensor
-					for (int sensorIndex = 0; sensorIndex < sensorArray.size() && hit == 0; sensorIndex++) { // for locaiton in paddle and while no hit has been detected
-						if (patternBuffer[frameIndex][sensorArray[sensorIndex]] > 0) { // if location overlaps pattern
-							hit = 1; // set hit true
-						}
-					}
-					for (int gapIndex = 0; gapIndex < gapArray.size() && hit == 0; gapIndex++) { // for locaiton in paddle and while no hit has been detected
-						if (patternBuffer[frameIndex][gapArray[gapIndex]] > 0) { // if location overlaps pattern
-							hit = 1; // set hit true
-						}
-					}
-				}
-				else if (scoreMethod == 1) { // VISIBLE_ANY = at least one visible element in pattern contacts at least one sensor or non-sensor
-					for (int sensorIndex = 0; sensorIndex < sensorArray.size() && hit == 0; sensorIndex++) { // for locaiton in paddle and while no hit has been detected
-						if (patternBuffer[frameIndex][sensorArray[sensorIndex]] == 1) { // if location overlaps visible pattern
-							hit = 1; // set hit true
-						}
-					}
-					for (int gapIndex = 0; gapIndex < gapArray.size() && hit == 0; gapIndex++) { // for locaiton in paddle and while no hit has been detected
-						if (patternBuffer[frameIndex][gapArray[gapIndex]] == 1) { // if location overlaps visible pattern
-							hit = 1; // set hit true
-						}
-					}
-				}
-				else if (scoreMethod == 2) { // VISIBLE_SENSOR = at least one visible element of pattern contacts atlease one sensor
-					for (int sensorIndex = 0; sensorIndex < sensorArray.size() && hit == 0; sensorIndex++) { // for locaiton in paddle and while no hit has been detected
-						if (patternBuffer[frameIndex][sensorArray[sensorIndex]] == 1) { // if location overlaps pattern
-							hit = 1; // set hit true
-						}
-					}
-				}
-				// now set correct and/or incorrect (for non-sum scoring methods)
-				if (patternIndex < catchPatternsCount) { // if patternIndex is < catchPatternsCount we should be catching this
-					if (hit) {
-						correct++;
-						correctPer[patternIndex]++;
-					}
-					else {
-						incorrect++;
-						incorrectPer[patternIndex]++;
-					}
-				}
-				else { // this is in the set of patterns to miss
-					if (hit) {
-						incorrect++;
-						incorrectPer[patternIndex]++;
-					}
-					else {
-						correct++;
-						correctPer[patternIndex]++;
-					}
-				}
-			}
-			else {
-				if (scoreMethod == 3) { // SUM_ALL_ALL = for each pattern location (visible or invisible) that overlaps a sensor or non-sensor record a hit
-					for (int sensorIndex = 0; sensorIndex < sensorArray.size(); sensorIndex++) { // for locaiton in paddle and while no hit has been detected
-						if (patternBuffer[frameIndex][sensorArray[sensorIndex]] > 0) { // if location overlaps pattern
-							hit++; // record a hit
-						}
-					}
-					for (int gapIndex = 0; gapIndex < gapArray.size(); gapIndex++) { // for locaiton in paddle and while no hit has been detected
-						if (patternBuffer[frameIndex][gapArray[gapIndex]] > 0) { // if location overlaps pattern
-							hit++; // record a hit
-						}
-					}
-				}
-				else if (scoreMethod == 4) { // SUM_VISIBLE_SENSOR = for each visible pattern location that overlaps a sensor record a hit
-					for (int sensorIndex = 0; sensorIndex < sensorArray.size(); sensorIndex++) { // for locaiton in paddle and while no hit has been detected
-						if (patternBuffer[frameIndex][sensorArray[sensorIndex]] == 1) { // if location overlaps pattern
-							hit++; // record a hit
-						}
-					}
-				}
-				else if (scoreMethod == 5) { // SUM_VISIBLE_NON_SENSOR = for each visible pattern location that overlaps a non-sensor record a hit
-					for (int gapIndex = 0; gapIndex < gapArray.size(); gapIndex++) { // for locaiton in paddle and while no hit has been detected
-						if (patternBuffer[frameIndex][gapArray[gapIndex]] == 1) { // if location overlaps pattern
-							hit++; // record a hit
-						}
-					}
-				}
-				// now set correct and/or incorrect (for sum scoring methods)
-				// in this mode, correct are accumulated for each hit on a to catch pattern
-				// and incorrect are accumulated for each hit on a to miss pattern 
-				if (patternIndex < catchPatternsCount) { // if patternIndex is < catchPatternsCount we should be catching this
-					correct += hit;
-					correctPer[patternIndex] += hit;
-				}
-				else { // this is in the set of patterns to miss
-					incorrect += hit;
-					incorrectPer[patternIndex] += hit;
-				}
-			} // end collect score information
+			scoreHit(patternIndex, getHit(patternBuffer[frameIndex], sensorArray, gapArray), correct, incorrect, correctPer, incorrectPer);
 		} // end repeats
 	} // end all patterns
 
@@ -730,11 +827,14 @@ void BlockCatchWorld::evaluateSolo(std::shared_ptr<Organism> org, int analyze, i
 
 		auto remapRule = TS::RemapRules::UNIQUE;
 		auto lifeTimes = brain->getLifeTimes();
-		auto inputStateSet = TS::remapToIntTimeSeries(brain->getInputStates(), remapRule);
-		auto brainAfterStateSet = TS::trimTimeSeries(TS::remapToIntTimeSeries(brain->getHiddenStates(), remapRule), TS::Position::FIRST, lifeTimes);
+		auto inputStateSet = TS::remapToIntSeries(brain->getInputStates(), remapRule);
+		auto outputStateSet = TS::remapToIntSeries(brain->getOutputStates(), remapRule);
+		auto brainStateSet = TS::remapToIntSeries(brain->getHiddenStates(), remapRule);
+		TS::intSeries worldStateSeries(worldStateSet);
 
-		auto outputStateSet = TS::remapToIntTimeSeries(brain->getOutputStates(), remapRule);
-		auto brainBeforeStateSet = TS::trimTimeSeries(TS::remapToIntTimeSeries(brain->getHiddenStates(), remapRule), TS::Position::LAST, lifeTimes);
+		// views of brainStateSet (nothing is copied)
+		auto brainAfterStateSet = TS::trimTimeSeries(brainStateSet, TS::Position::FIRST, lifeTimes);
+		auto brainBeforeStateSet = TS::trimTimeSeries(brainStateSet, TS::Position::LAST, lifeTimes);
 
 		brain->saveConnectome();
 		brain->saveStructure();
@@ -743,12 +843,12 @@ void BlockCatchWorld::evaluateSolo(std::shared_ptr<Organism> org, int analyze, i
 		for (double i = 0; i <= 1; i += .1) {
 			std::cout << i << " : ";
 			for (double j = i + .1; j <= 1; j += .1) {
-				std::cout << ENT::MutualEntropy(TS::trimTimeSeries(worldStateSet, { i,j }, patternsCount * repeats), TS::trimTimeSeries(brainAfterStateSet, { i,j }, patternsCount * repeats)) / ENT::Entropy(TS::trimTimeSeries(worldStateSet, { i,j }, patternsCount * repeats)) << " , ";
+				std::cout << ENT::MutualEntropy(TS::trimTimeSeries(worldStateSeries, { i,j }, patternsCount * repeats), TS::trimTimeSeries(brainAfterStateSet, { i,j }, patternsCount * repeats)) / ENT::Entropy(TS::trimTimeSeries(worldStateSeries, { i,j }, patternsCount * repeats)) << " , ";
 			}
 			std::cout << std::endl;
 		}
 
-		auto smearPair = SMR::getSmearednessConceptsNodesPair(inputStateSet, worldStateSet, brainAfterStateSet);
+		auto smearPair = SMR::getSmearednessConceptsNodesPair(inputStateSet, worldStateSeries, brainAfterStateSet);
 		std::cout << "smearedness of consepts: " << smearPair.first << "   smearedness of nodes: " << smearPair.second << std::endl;
 
 		BRAINTOOLS::saveStateToState(brain, "StateToState.txt", TS::RemapRules::UNIQUE);
@@ -761,7 +861,7 @@ void BlockCatchWorld::evaluateSolo(std::shared_ptr<Organism> org, int analyze, i
 		FileManager::writeToFile("score.txt", std::to_string(org->dataMap.getAverage("score")));
 
 		// save fragmentation matrix of brain(hidden) predictions of world features
-		FRAG::saveFragMatrix(worldStateSet, brainAfterStateSet, "feature");
+		FRAG::saveFragMatrix(worldStateSeries, brainAfterStateSet, "feature");
 
 
 		// save data flow information - 
@@ -772,11 +872,12 @@ void BlockCatchWorld::evaluateSolo(std::shared_ptr<Organism> org, int analyze, i
 }
 
 void BlockCatchWorld::evaluate(std::map<std::string, std::shared_ptr<Group>>& groups, int analyse, int visualize, int debug) {
-	int popSize = groups[groupName]->population.size();
+	int debugWorld = AbstractWorld::debugPL->get(PT);
 
-	for (int i = 0; i < popSize; i++) {
-		evaluateSolo(groups[groupName]->population[i], analyse, visualize, AbstractWorld::debugPL->get(PT));
-	}
+	// organisms do not interact, so they can be evaluated on multiple threads
+	evaluateOrganisms(groups[groupName]->population, [&](std::shared_ptr<Organism> org) {
+		evaluateSolo(org, analyse, visualize, debugWorld);
+		}, analyse || visualize || debugWorld);
 
 	if (visualizeBest > 0 && Global::update % visualizeBest == 0 && Global::update > 0) {
 		// get best org (org with best score)
@@ -82,6 +82,13 @@ public:
     BlockCatchWorld (std::shared_ptr<ParametersTable> _PT = nullptr);
     ~BlockCatchWorld () = default;
 	void evaluateSolo(std::shared_ptr<Organism> org, int analyse, int visualize, int debug);
+	void evaluatePatternInLanes(std::shared_ptr<AbstractBrain> brain, int patternIndex, size_t repeats, int& directionCounter,
+		int& correct, int& incorrect, std::vector<int>& correctPer, std::vector<int>& incorrectPer);
+
+	void setupTrial(int patternIndex, int repeat, int worldX, std::vector<std::vector<int>>& patternBuffer, std::vector<int>& sensorArray, std::vector<int>& gapArray);
+	void moveWorld(int action, int direction, int worldX, std::vector<std::vector<int>>& patternBuffer, std::vector<int>& sensorArray, std::vector<int>& gapArray);
+	int getHit(const std::vector<int>& frame, const std::vector<int>& sensorArray, const std::vector<int>& gapArray);
+	void scoreHit(int patternIndex, int hit, int& correct, int& incorrect, std::vector<int>& correctPer, std::vector<int>& incorrectPer);
 	void evaluate(std::map<std::string, std::shared_ptr<Group>>& groups, int analyse, int visualize, int debug);
 
 	void debugDisplay(int worldX, int time, std::vector<std::vector<int>> patternBuffer, int frameIndex, std::vector<int> sensorArray, std::vector<int> gapArray);
@@ -95,6 +95,9 @@ NBackWorld::NBackWorld(std::shared_ptr<ParametersTable> PT_) : AbstractWorld(PT_
 
 	evaluationsPerGeneration = evaluationsPerGenerationPL->get(PT); // each agent sees this number of inputs (+largest N) and is scored this number of times each evaluation
 	testsPerEvaluation = testsPerEvaluationPL->get(PT); // each agent is reset and evaluated this number of times
+	delayOutputEval = delayOutputEvalPL->get(PT);
+	scoreMult = scoreMultPL->get(PT);
+	RMult = RMultPL->get(PT);
 
 	std::cout << "output map:\n";
 	for (auto elem : N2OutMap) {
@@ -126,9 +129,23 @@ void NBackWorld::evaluate(std::map<std::string, std::shared_ptr<Group>> &groups,
 		}
 	}
 
-	int popSize = groups[groupNamePL->get(PT)]->population.size();
-	for (int i = 0; i < popSize; i++) {
-		evaluateSolo(groups[groupNamePL->get(PT)]->population[i], analyze, visualize, debug);
+	// organisms do not interact, so they can be evaluated on multiple threads.
+	// brains which can not be batched (makeBatch gives nullptr) are evaluated one
+	// organism at a time, so that each organism can be on it's own thread
+	auto& population = groups[groupNamePL->get(PT)]->population;
+	int batchSize = batchSizePL->get(PT);
+	bool batchable = batchSize > 1 && !analyze && !visualize && !debug && !population.empty() &&
+		population[0]->brains[brainName]->makeBatch({ population[0]->brains[brainName] }) != nullptr;
+	if (batchable) {
+		evaluateOrganismBatches(population, batchSize,
+			[&](const std::vector<std::shared_ptr<Organism>>& orgs, std::vector<Random::Generator>& generators) {
+			evaluateBatch(orgs, generators);
+		});
+	}
+	else {
+		evaluateOrganisms(population, [&](std::shared_ptr<Organism> org) {
+			evaluateSolo(org, analyze, visualize, debug);
+			}, analyze || visualize || debug);
 	}
 	if (analyze) {
 		groups[groupNamePL->get(PT)]->archive();
@@ -139,6 +156,7 @@ void NBackWorld::evaluateSolo(std::shared_ptr<Organism> org, int analyze, int vi
 		
 	auto brain = org->brains[brainName];
 	brain->setRecordActivity(true);
+	brain->reserveActivity(evaluationsPerGeneration * (testsPerEvaluation + currentLargestN), evaluationsPerGeneration);
 
 	double score = 0.0;
 	std::vector<int> tallies(N2OutMap.size(), 0); // how many times did brain get each N in current list correct?
@@ -146,36 +164,158 @@ void NBackWorld::evaluateSolo(std::shared_ptr<Organism> org, int analyze, int vi
 
 	std::vector<std::vector<int>> worldStates;
 
-	for (int r = 0; r < evaluationsPerGeneration; r++) {
-		brain->resetBrain();
+	if (brain->canUpdateLanes()) {
+		// run up to 64 evaluations at once (one per brain lane). inputs are drawn in the same
+		// order as below and brain activity is recorded per lane, so the results are the same
+		for (int firstEval = 0; firstEval < evaluationsPerGeneration; firstEval += 64) {
+			int laneCount = std::min(64, evaluationsPerGeneration - firstEval);
+			std::vector<std::vector<int>> laneInputLists(laneCount, std::vector<int>(inputList.size()));
+			for (auto& laneInputList : laneInputLists) {
+				for (auto& input : laneInputList) {
+					input = Random::getInt(1);
+				}
+			}
+
+			std::vector<std::vector<std::vector<int>>> laneWorldStates(laneCount);
+			brain->resetLanes(laneCount);
+			for (int t = 0; t < inputList.size(); t++) {
+				uint64_t inputLanes = 0;
+				for (int l = 0; l < laneCount; l++) {
+					inputLanes |= uint64_t(laneInputLists[l][t]) << l;
+				}
+				brain->setInputLanes(0, inputLanes);
+
+				brain->updateLanes();
+
+				// collect score and world data but only once we have reached currentLargestN
+				if (t >= currentLargestN) {
+					for (int l = 0; l < laneCount; l++) {
+						laneWorldStates[l].push_back({});
+					}
+					for (auto elem : NListLists[currentNList]) {
+						uint64_t outputLanes = brain->readOutputLanes(N2OutMap[elem]);
+						for (int l = 0; l < laneCount; l++) {
+							laneWorldStates[l].back().push_back(laneInputLists[l][t - elem + 1]);
+							if (Global::update >= delayOutputEval && // if update is greater than delay time
+								(int)((outputLanes >> l) & 1) == laneInputLists[l][t - elem]) { // if output is correct 
+								score += 1; // add 1 to score
+								tallies[N2OutMap[elem]] += 1; // add 1 to correct outputs for this N
+							}
+						}
+					}
+				}
+			}
+			brain->finishLanes();
+			for (auto& states : laneWorldStates) {
+				worldStates.insert(worldStates.end(), states.begin(), states.end());
+			}
+		}
+	}
+	else {
+		for (int r = 0; r < evaluationsPerGeneration; r++) {
+			brain->resetBrain();
+
+			int t = 0;
+
+
+			for (int t = 0; t < inputList.size(); t++) {
+
+				inputList[t] = Random::getInt(1);
+				brain->setInput(0, inputList[t]);
+
+				brain->update();
+
+				// collect score and world data but only once we have reached currentLargestN
+				if (t >= currentLargestN) {
+					// add space in world data vector
+					worldStates.push_back({});
+					for (auto elem : NListLists[currentNList]) {
+						worldStates.back().push_back(inputList[t - elem + 1]);
+						if (Global::update >= delayOutputEval && // if update is greater than delay time
+							Bit(brain->readOutput(N2OutMap[elem])) == inputList[t - elem]) { // if output is correct 
+							score += 1; // add 1 to score
+							tallies[N2OutMap[elem]] += 1; // add 1 to correct outputs for this N
+						}
+					}
+				}
+			}
+		}
+	}
+
+	recordResults(org, score, tallies, worldStates, analyze, visualize, debug);
+}
 
-		int t = 0;
+// update all brains in orgs together (if the brains can be batched, otherwise evaluateSolo is used)
+// each organisms inputs are drawn from it's own generator in the same order as evaluateSolo, so results are the same
+void NBackWorld::evaluateBatch(const std::vector<std::shared_ptr<Organism>>& orgs, std::vector<Random::Generator>& generators) {
+	std::vector<std::shared_ptr<AbstractBrain>> brains;
+	for (auto& org : orgs) {
+		brains.push_back(org->brains[brainName]);
+	}
+	auto batch = brains[0]->makeBatch(brains);
+	if (batch == nullptr) {
+		for (size_t b = 0; b < orgs.size(); b++) {
+			Random::ScopedGenerator scope(generators[b]);
+			evaluateSolo(orgs[b], 0, 0, 0);
+		}
+		return;
+	}
 
+	int batchSize = batch->size();
+	int inputListSize = testsPerEvaluation + currentLargestN;
+	std::vector<std::vector<int>> inputLists(batchSize, std::vector<int>(evaluationsPerGeneration * inputListSize));
+	for (int b = 0; b < batchSize; b++) {
+		brains[b]->setRecordActivity(true);
+		brains[b]->reserveActivity(evaluationsPerGeneration * inputListSize, evaluationsPerGeneration);
+		Random::ScopedGenerator scope(generators[b]);
+		for (auto& input : inputLists[b]) {
+			input = Random::getInt(1);
+		}
+	}
 
-		for (int t = 0; t < inputList.size(); t++) {
+	std::vector<double> scores(batchSize, 0.0);
+	std::vector<std::vector<int>> tallies(batchSize, std::vector<int>(N2OutMap.size(), 0));
+	std::vector<std::vector<std::vector<int>>> worldStates(batchSize);
 
-			inputList[t] = Random::getInt(1);
-			brain->setInput(0, inputList[t]);
+	for (int r = 0; r < evaluationsPerGeneration; r++) {
+		batch->resetBrains();
+		for (int t = 0; t < inputListSize; t++) {
+			for (int b = 0; b < batchSize; b++) {
+				batch->setInput(b, 0, inputLists[b][r * inputListSize + t]);
+			}
 
-			brain->update();
+			batch->update();
 
 			// collect score and world data but only once we have reached currentLargestN
 			if (t >= currentLargestN) {
-				// add space in world data vector
-				worldStates.push_back({});
-				for (auto elem : NListLists[currentNList]) {
-					worldStates.back().push_back(inputList[t - elem + 1]);
-					if (Global::update >= delayOutputEvalPL->get(PT) && // if update is greater than delay time
-						Bit(brain->readOutput(N2OutMap[elem])) == inputList[t - elem]) { // if output is correct 
-						score += 1; // add 1 to score
-						tallies[N2OutMap[elem]] += 1; // add 1 to correct outputs for this N
+				for (int b = 0; b < batchSize; b++) {
+					const int* inputList = inputLists[b].data() + r * inputListSize;
+					worldStates[b].push_back({});
+					for (auto elem : NListLists[currentNList]) {
+						worldStates[b].back().push_back(inputList[t - elem + 1]);
+						if (Global::update >= delayOutputEval && // if update is greater than delay time
+							Bit(batch->readOutput(b, N2OutMap[elem])) == inputList[t - elem]) { // if output is correct 
+							scores[b] += 1; // add 1 to score
+							tallies[b][N2OutMap[elem]] += 1; // add 1 to correct outputs for this N
+						}
 					}
 				}
 			}
 		}
 	}
-	
-	org->dataMap.append("score", (score*scoreMultPL->get(PT)) / (evaluationsPerGeneration*testsPerEvaluation*NListLists[currentNList].size()));
+	batch->finish();
+
+	for (int b = 0; b < batchSize; b++) {
+		Random::ScopedGenerator scope(generators[b]);
+		recordResults(orgs[b], scores[b], tallies[b], worldStates[b], 0, 0, 0);
+	}
+}
+
+void NBackWorld::recordResults(std::shared_ptr<Organism> org, double score, const std::vector<int>& tallies,
+	std::vector<std::vector<int>>& worldStates, int analyze, int visualize, int debug) {
+	auto brain = org->brains[brainName];
+
+	org->dataMap.append("score", (score*scoreMult) / (evaluationsPerGeneration*testsPerEvaluation*NListLists[currentNList].size()));
 	// score is divided by number of evals * number of tests * number of N's in current list
 
 	for (auto elem : N2OutMap) {
@@ -190,11 +330,12 @@ void NBackWorld::evaluateSolo(std::shared_ptr<Organism> org, int analyze, int vi
 	auto remapRule = TS::RemapRules::UNIQUE;
 	auto lifeTimes = brain->getLifeTimes();
 	//std::cout << "INPUT STATES" << std::endl;
-	auto inputStates = TS::remapToIntTimeSeries(brain->getInputStates(), TS::RemapRules::BIT);
+	auto inputStates = TS::remapToIntSeries(brain->getInputStates(), TS::RemapRules::BIT);
 	//std::cout << "OUTPUT STATES" << std::endl;
-	auto outputStates = TS::remapToIntTimeSeries(brain->getOutputStates(), TS::RemapRules::BIT);
+	auto outputStates = TS::remapToIntSeries(brain->getOutputStates(), TS::RemapRules::BIT);
 	//std::cout << "BRAIN STATES" << std::endl;
-	auto brainStates = TS::remapToIntTimeSeries(brain->getHiddenStates(), remapRule);
+	auto brainStates = TS::remapToIntSeries(brain->getHiddenStates(), remapRule);
+	TS::intSeries worldStateSeries(worldStates);
 
 	//std::cout << "inputStates" << std::endl;
 	//std::cout << TS::TimeSeriesToString(inputStates) << std::endl;
@@ -211,10 +352,11 @@ void NBackWorld::evaluateSolo(std::shared_ptr<Organism> org, int analyze, int vi
 	//}
 
 
-	TS::intTimeSeries shortInputStates = TS::trimTimeSeries(inputStates,TS::Position::FIRST,lifeTimes, currentLargestN);
+	// the short states are views of inputStates, outputStates and brainStates (nothing is copied)
+	TS::intSeriesView shortInputStates = TS::trimTimeSeries(inputStates,TS::Position::FIRST,lifeTimes, currentLargestN);
 
-	TS::intTimeSeries shortOutputStatesBefore;// only needed if recurrent
-	TS::intTimeSeries shortOutputStatesAfter; // always needed
+	TS::intSeriesView shortOutputStatesBefore;// only needed if recurrent
+	TS::intSeriesView shortOutputStatesAfter; // always needed
 	if (brain->recurrentOutput) {
 		shortOutputStatesAfter = TS::trimTimeSeries(outputStates, TS::Position::FIRST, lifeTimes, currentLargestN + 1);
 		shortOutputStatesBefore = TS::trimTimeSeries(outputStates, TS::Position::LAST, lifeTimes, currentLargestN + 1);
@@ -224,31 +366,31 @@ void NBackWorld::evaluateSolo(std::shared_ptr<Organism> org, int analyze, int vi
 	}
 
 	// always recurrent
-	TS::intTimeSeries shortBrainStatesBefore = TS::trimTimeSeries(brainStates, TS::Position::LAST, lifeTimes, currentLargestN+1);
-	TS::intTimeSeries shortBrainStatesAfter = TS::trimTimeSeries(brainStates, TS::Position::FIRST, lifeTimes, currentLargestN+1);
+	TS::intSeriesView shortBrainStatesBefore = TS::trimTimeSeries(brainStates, TS::Position::LAST, lifeTimes, currentLargestN+1);
+	TS::intSeriesView shortBrainStatesAfter = TS::trimTimeSeries(brainStates, TS::Position::FIRST, lifeTimes, currentLargestN+1);
 
 	std::vector<int> shortLifeTimes = TS::updateLifeTimes(lifeTimes, -1 * currentLargestN);
 
-	double R = ENT::ConditionalMutualEntropy(worldStates,shortBrainStatesAfter,shortInputStates);
-	org->dataMap.append("R", R * RMultPL->get(PT));
+	double R = ENT::ConditionalMutualEntropy(worldStateSeries,shortBrainStatesAfter,shortInputStates);
+	org->dataMap.append("R", R * RMult);
 
-	double rawR = ENT::MutualEntropy(worldStates, shortBrainStatesAfter);
+	double rawR = ENT::MutualEntropy(worldStateSeries, shortBrainStatesAfter);
 	org->dataMap.append("rawR", rawR);
 
 	
 
 
 
-	double earlyRawR50 = ENT::MutualEntropy(TS::trimTimeSeries(worldStates, { 0,.5 }, shortLifeTimes), TS::trimTimeSeries(shortBrainStatesAfter, { 0,.5 }, shortLifeTimes));
+	double earlyRawR50 = ENT::MutualEntropy(TS::trimTimeSeries(worldStateSeries, { 0,.5 }, shortLifeTimes), TS::trimTimeSeries(shortBrainStatesAfter, { 0,.5 }, shortLifeTimes));
 	org->dataMap.append("earlyRawR50", earlyRawR50);
 
-	double earlyRawR20 = ENT::MutualEntropy(TS::trimTimeSeries(worldStates, { 0,.2 }, shortLifeTimes), TS::trimTimeSeries(shortBrainStatesAfter, { 0,.2 }, shortLifeTimes));
+	double earlyRawR20 = ENT::MutualEntropy(TS::trimTimeSeries(worldStateSeries, { 0,.2 }, shortLifeTimes), TS::trimTimeSeries(shortBrainStatesAfter, { 0,.2 }, shortLifeTimes));
 	org->dataMap.append("earlyRawR20", earlyRawR20);
 
-	double lateRawR50 = ENT::MutualEntropy(TS::trimTimeSeries(worldStates, { .5,1 }, shortLifeTimes), TS::trimTimeSeries(shortBrainStatesAfter, { .5,1 }, shortLifeTimes));
+	double lateRawR50 = ENT::MutualEntropy(TS::trimTimeSeries(worldStateSeries, { .5,1 }, shortLifeTimes), TS::trimTimeSeries(shortBrainStatesAfter, { .5,1 }, shortLifeTimes));
 	org->dataMap.append("lateRawR50", lateRawR50);
 
-	double lateRawR20 = ENT::MutualEntropy(TS::trimTimeSeries(worldStates, { .8,1 }, shortLifeTimes), TS::trimTimeSeries(shortBrainStatesAfter, { .8,1 }, shortLifeTimes));
+	double lateRawR20 = ENT::MutualEntropy(TS::trimTimeSeries(worldStateSeries, { .8,1 }, shortLifeTimes), TS::trimTimeSeries(shortBrainStatesAfter, { .8,1 }, shortLifeTimes));
 	org->dataMap.append("lateRawR20", lateRawR20);
 
 
@@ -259,7 +401,7 @@ void NBackWorld::evaluateSolo(std::shared_ptr<Organism> org, int analyze, int vi
 
 		FileManager::writeToFile("score.txt", std::to_string(org->dataMap.getAverage("score")));
 
-		auto smearPair = SMR::getSmearednessConceptsNodesPair(shortInputStates, worldStates, shortBrainStatesAfter);
+		auto smearPair = SMR::getSmearednessConceptsNodesPair(shortInputStates, worldStateSeries, shortBrainStatesAfter);
 		FileManager::writeToFile("score.txt", std::to_string(smearPair.second));
 		FileManager::writeToFile("score.txt", std::to_string(smearPair.first));
 
@@ -268,27 +410,28 @@ void NBackWorld::evaluateSolo(std::shared_ptr<Organism> org, int analyze, int vi
 		for (double i = 0; i <= 1; i += .1) {
 			std::cout << i << " : ";
 			for (double j = i + .1; j <= 1; j += .1) {
-				std::cout << ENT::MutualEntropy(TS::trimTimeSeries(worldStates, { i,j }, shortLifeTimes), TS::trimTimeSeries(shortBrainStatesAfter, { i,j }, shortLifeTimes)) / ENT::Entropy(TS::trimTimeSeries(shortBrainStatesAfter, { i,j }, shortLifeTimes)) << " , ";
+				std::cout << ENT::MutualEntropy(TS::trimTimeSeries(worldStateSeries, { i,j }, shortLifeTimes), TS::trimTimeSeries(shortBrainStatesAfter, { i,j }, shortLifeTimes)) / ENT::Entropy(TS::trimTimeSeries(shortBrainStatesAfter, { i,j }, shortLifeTimes)) << " , ";
 			}
 			std::cout << std::endl;
 		}
 
 		//BRAINTOOLS::saveStateToState(brain, "StateToState.txt", TS::RemapRules::UNIQUE);
 		std::string fileName = "StateToState.txt";
-		S2S::saveStateToState({ brainStates, TS::extendTimeSeries(outputStates, lifeTimes, {0}, TS::Position::FIRST) }, { inputStates }, lifeTimes, "H_O__I_" + fileName);
+		auto extendedOutputStates = TS::extendTimeSeries(outputStates, lifeTimes, std::vector<int>(outputStates.getWidth(), 0), TS::Position::FIRST);
+		S2S::saveStateToState({ brainStates, extendedOutputStates }, { inputStates }, lifeTimes, "H_O__I_" + fileName);
 		S2S::saveStateToState({ brainStates }, { outputStates, inputStates }, lifeTimes, "H__O_I_" + fileName);
 		S2S::saveStateToState({ brainStates }, { inputStates }, lifeTimes, "H_I_" + fileName);
 
 
 
 
-		std::cout << "worldEnt: " << ENT::Entropy(worldStates) << "  brainEnt: " << ENT::Entropy(shortBrainStatesAfter) << "  worldBrainEnt: " << ENT::Entropy(TS::Join(worldStates, shortBrainStatesAfter)) << "  rawR: " << rawR << std::endl;
+		std::cout << "worldEnt: " << ENT::Entropy(worldStateSeries) << "  brainEnt: " << ENT::Entropy(shortBrainStatesAfter) << "  worldBrainEnt: " << ENT::Entropy(TS::Join(worldStateSeries, shortBrainStatesAfter)) << "  rawR: " << rawR << std::endl;
 		std::cout << "earlyRawR20: " << earlyRawR20 << "  earlyRawR50: " << earlyRawR50 << "  lateRawR50: " << lateRawR50 << "  lateRawR20: " << lateRawR20 << std::endl;
 
 		std::cout << "organism with ID " << org->ID << " scored " << org->dataMap.getAverage("score") << std::endl;
 
 		// save fragmentation matrix of brain(hidden) predictions of world features
-		FRAG::saveFragMatrix(worldStates, shortBrainStatesAfter, "feature.py");
+		FRAG::saveFragMatrix(worldStateSeries, shortBrainStatesAfter, "feature.py");
 
 		// save data flow information - 
 		std::vector<std::pair<double, double>> flowRanges = { {0,1},{0,.333},{.333,.666},{.666,1},{0,.5},{.5,1} };
@@ -302,5 +445,17 @@ std::unordered_map<std::string, std::unordered_set<std::string>> NBackWorld::req
 	return { {groupName, {"B:" + brainName + ",1," + std::to_string(N2OutMap.size())}} };
 }
 
+void NBackWorld::saveCheckpoint(CheckpointWriter &checkpoint) {
+	checkpoint.section("WORLD_NBACK");
+	checkpoint.write(currentNList);
+	checkpoint.write(currentLargestN);
+}
+
+void NBackWorld::loadCheckpoint(CheckpointReader &checkpoint) {
+	checkpoint.section("WORLD_NBACK");
+	checkpoint.read(currentNList);
+	checkpoint.read(currentLargestN);
+}
+
 
 
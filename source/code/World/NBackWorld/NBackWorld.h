@@ -40,6 +40,9 @@ public:
 
   int testsPerEvaluation; // each agent is reset and evaluated this number of times
   int evaluationsPerGeneration; // each agent sees this number of inputs (+largest N) and is scored this number of times each evaluation
+  int delayOutputEval;
+  int scoreMult;
+  int RMult;
 
   static std::shared_ptr<ParameterLink<std::string>> groupNamePL;
   static std::shared_ptr<ParameterLink<std::string>> brainNamePL;
@@ -56,12 +59,20 @@ public:
 
   void evaluateSolo(std::shared_ptr<Organism> org, int analyze,
                             int visualize, int debug);
+  void evaluateBatch(const std::vector<std::shared_ptr<Organism>> &orgs,
+                            std::vector<Random::Generator> &generators);
+  void recordResults(std::shared_ptr<Organism> org, double score, const std::vector<int> &tallies,
+                            std::vector<std::vector<int>> &worldStates, int analyze, int visualize, int debug);
   void evaluate(std::map<std::string, std::shared_ptr<Group>> &groups,
                 int analyze, int visualize, int debug);
 
   virtual std::unordered_map<std::string, std::unordered_set<std::string>>
     requiredGroups() override;
 
+  // the current N list changes with Global::update, so it is saved with checkpoints
+  virtual void saveCheckpoint(CheckpointWriter &checkpoint) override;
+  virtual void loadCheckpoint(CheckpointReader &checkpoint) override;
+
 
 
   std::vector<int> getHiddenBrainStates(std::shared_ptr<AbstractBrain> brain) {
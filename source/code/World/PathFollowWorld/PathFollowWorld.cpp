@@ -278,9 +278,6 @@ PathFollowWorld::PathFollowWorld(shared_ptr<ParametersTable> PT_) : AbstractWorl
 // that will be used by other parts of MABE for things like reproduction and archiving
 auto PathFollowWorld::evaluate(map<string, shared_ptr<Group>>& groups, int analyze, int visualize, int debug) -> void {
 
-    int sign2; // remapping for 2s in the map
-    int sign3; // remapping for 3s in the map
-
     // if randomizeTurnSigns, create a pair of random signals for each map
     if (useRandomTurnSymbols && currentUpdate < Global::update) {
         for (int t = 0; t < evaluationsPerGeneration * maps.size(); t++) {
@@ -296,291 +293,296 @@ auto PathFollowWorld::evaluate(map<string, shared_ptr<Group>>& groups, int analy
         currentUpdate = Global::update;
     }
 
-    int popSize = groups[groupName]->population.size();
-    
-    // in this world, organisms do not interact, so we can just iterate over the population
+    // in this world, organisms do not interact, so they can be evaluated on multiple threads
     // on each iteration, each agent will visit every world evaluationsPerGeneration times
-    for (int orgID = 0; orgID < popSize; orgID++) {
-
-        // create a shortcut to access the organism and organisms brain
-        auto org = groups[groupName]->population[orgID];
-        auto brain = org->brains[brainName];
-        
-        int xPos, yPos, direction, out0, out1, out2;
-        double score, reachGoal;
-        int thisForwardCount;
-
-        // evaluate this organism some number of times based on evaluationsPerGeneration
-        for (int trial = 0; trial < evaluationsPerGeneration; trial++) {
-            for (size_t mapID = 0; mapID < maps.size(); mapID++) {
-                // new map! reset score and reachGoal
-                score = 0;
-                reachGoal = 0;
-
-                // set starting location using value from file for this map
-                xPos = startLocations[mapID].first;
-                yPos = startLocations[mapID].second;
-                direction = initalDirections[mapID];
-                thisForwardCount = 0;
-
-                // make a copy of the map so we can change it
-                auto mapCopy = maps[mapID];
-                
-                // if useRandomTurnSymbols, pull values for turn symbol values from randomValues
-                if (useRandomTurnSymbols) {
-                    sign2 = randomValues[(trial * maps.size()) + mapID].first;
-                    sign3 = randomValues[(trial * maps.size()) + mapID].second;
-                }
-                else { // use fixed values
-                    sign2 = 1;
-                    sign3 = 2;
-                }
+    evaluateOrganisms(groups[groupName]->population, [&](shared_ptr<Organism> org) {
+        evaluateSolo(org, analyze, visualize, debug);
+        }, analyze || visualize || debug);
+}
 
-                if (debug) {
-                    // show current map
-                    mapCopy.showGrid();
-                    std::cout << "at location: " << xPos << "," << yPos << "  direction: " << direction << std::endl;
-                }
-                if (visualize) {
-                    std::string os = "new";
-                    FileManager::writeToFile("pathVisualization.txt", os);
-                }
+// evaluate a single organism on every map evaluationsPerGeneration times
+auto PathFollowWorld::evaluateSolo(shared_ptr<Organism> org, int analyze, int visualize, int debug) -> void {
 
-                // clear the brain - resets brain state including memory
-                brain->resetBrain();
+    int sign2; // remapping for 2s in the map
+    int sign3; // remapping for 3s in the map
 
+    // create a shortcut to access the organisms brain
+    auto brain = org->brains[brainName];
+    
+    int xPos, yPos, direction, out0, out1, out2;
+    double score, reachGoal;
+    int thisForwardCount;
+
+    // evaluate this organism some number of times based on evaluationsPerGeneration
+    for (int trial = 0; trial < evaluationsPerGeneration; trial++) {
+        for (size_t mapID = 0; mapID < maps.size(); mapID++) {
+            // new map! reset score and reachGoal
+            score = 0;
+            reachGoal = 0;
+
+            // set starting location using value from file for this map
+            xPos = startLocations[mapID].first;
+            yPos = startLocations[mapID].second;
+            direction = initalDirections[mapID];
+            thisForwardCount = 0;
+
+            // make a copy of the map so we can change it
+            auto mapCopy = maps[mapID];
+            
+            // if useRandomTurnSymbols, pull values for turn symbol values from randomValues
+            if (useRandomTurnSymbols) {
+                sign2 = randomValues[(trial * maps.size()) + mapID].first;
+                sign3 = randomValues[(trial * maps.size()) + mapID].second;
+            }
+            else { // use fixed values
+                sign2 = 1;
+                sign3 = 2;
+            }
+
+            if (debug) {
+                // show current map
+                mapCopy.showGrid();
+                std::cout << "at location: " << xPos << "," << yPos << "  direction: " << direction << std::endl;
+            }
+            if (visualize) {
+                std::string os = "new";
+                FileManager::writeToFile("pathVisualization.txt", os);
+            }
 
-                int firstTurn = -1;
-                bool swapped = false;
+            // clear the brain - resets brain state including memory
+            brain->resetBrain();
 
-                for (int step = 0; step < (minSteps[mapID] + extraSteps); step++) {
 
-                    if ((swapSymbolsAfter < 1.0) && (swapped == false) && (step > ((double)minSteps[mapID] * swapSymbolsAfter)) ) {
-                        swapped = true;
-                        auto temp = sign3;
-                        sign3 = sign2;
-                        sign2 = temp;
-                    }
+            int firstTurn = -1;
+            bool swapped = false;
 
-                    if (visualize) {
-                        std::string os = "start\n";
-                        os += std::to_string(direction) + "\n";
-                        os += std::to_string(score) + "\n";
-                        os += std::to_string(mapSizes[mapID].first) + "\n";
-                        os += std::to_string(mapSizes[mapID].second) + "\n";
+            for (int step = 0; step < (minSteps[mapID] + extraSteps); step++) {
 
-                        os += std::to_string(sign2) + "\n";
-                        os += std::to_string(sign3) + "\n";
+                if ((swapSymbolsAfter < 1.0) && (swapped == false) && (step > ((double)minSteps[mapID] * swapSymbolsAfter)) ) {
+                    swapped = true;
+                    auto temp = sign3;
+                    sign3 = sign2;
+                    sign2 = temp;
+                }
 
-                        auto mapSource = mapCopy;
-                        if (!clearVisted) {
-                            mapSource = maps[mapID];;
-                        }
-                        // show grid, and other stats
-                        for (int y = 0; y < mapSizes[mapID].second; y++) {
-                            for (int x = 0; x < mapSizes[mapID].first; x++) {
-                                auto hereValue = mapSource(x, y);
-                                if (x == xPos && y == yPos) {
-                                    if (debug) { std::cout << "* "; }
-                                    os += "*";
-                                }
-                                else if (mapSource(x, y) == 0) {
-                                    if (debug) { std::cout << "  "; }
-                                    os += "0";
-                                }
-                                else if (mapSource(x, y) == 2) {
-                                    if (debug) { std::cout << "R "; }
-                                    os += "2";
-                                }
-                                else if (mapSource(x, y) == 3) {
-                                    if (debug) { std::cout << "L ";; }
-                                    os += "3";
-                                }
-                                else {
-                                    if (debug) { std::cout << mapSource(x, y) << " "; }
-                                    os += std::to_string(mapSource(x, y));
-                                }
+                if (visualize) {
+                    std::string os = "start\n";
+                    os += std::to_string(direction) + "\n";
+                    os += std::to_string(score) + "\n";
+                    os += std::to_string(mapSizes[mapID].first) + "\n";
+                    os += std::to_string(mapSizes[mapID].second) + "\n";
+
+                    os += std::to_string(sign2) + "\n";
+                    os += std::to_string(sign3) + "\n";
+
+                    auto mapSource = mapCopy;
+                    if (!clearVisted) {
+                        mapSource = maps[mapID];;
+                    }
+                    // show grid, and other stats
+                    for (int y = 0; y < mapSizes[mapID].second; y++) {
+                        for (int x = 0; x < mapSizes[mapID].first; x++) {
+                            auto hereValue = mapSource(x, y);
+                            if (x == xPos && y == yPos) {
+                                if (debug) { std::cout << "* "; }
+                                os += "*";
+                            }
+                            else if (mapSource(x, y) == 0) {
+                                if (debug) { std::cout << "  "; }
+                                os += "0";
+                            }
+                            else if (mapSource(x, y) == 2) {
+                                if (debug) { std::cout << "R "; }
+                                os += "2";
+                            }
+                            else if (mapSource(x, y) == 3) {
+                                if (debug) { std::cout << "L ";; }
+                                os += "3";
+                            }
+                            else {
+                                if (debug) { std::cout << mapSource(x, y) << " "; }
+                                os += std::to_string(mapSource(x, y));
                             }
-                            if (debug) { std::cout << std::endl; }
-                            os += "\n";
                         }
+                        if (debug) { std::cout << std::endl; }
+                        os += "\n";
+                    }
 
-                        FileManager::writeToFile("pathVisualization.txt", os);
+                    FileManager::writeToFile("pathVisualization.txt", os);
 
-                        if (debug) {
-                            std::cout << "at location: " << xPos << "," << yPos << "  direction: " << direction << std::endl;
-                            std::cout << "forward steps taken: " << thisForwardCount << "  current score: " << score << std::endl;
-                            std::cout << "value @ this location: " << mapCopy(xPos, yPos) << std::endl;
-                        }
+                    if (debug) {
+                        std::cout << "at location: " << xPos << "," << yPos << "  direction: " << direction << std::endl;
+                        std::cout << "forward steps taken: " << thisForwardCount << "  current score: " << score << std::endl;
+                        std::cout << "value @ this location: " << mapCopy(xPos, yPos) << std::endl;
                     }
+                }
 
 
-                    int inputValue; // value at agents current location
-                    if (clearVisted) {
-                        inputValue = mapCopy(xPos, yPos);
+                int inputValue; // value at agents current location
+                if (clearVisted) {
+                    inputValue = mapCopy(xPos, yPos);
+                }
+                else {
+                    inputValue = maps[mapID](xPos, yPos);
+                }
+
+                if (inputMode == "single") {
+                    // map values are 0 = empty, 1 = forward, 2 = left, 3 = right,
+                    // but output is -1 = empty, 0 = forward, 1+ = turn, so we need to do some conversion...
+                    inputValue--;
+                    if (inputValue == 1) { // value in map was 2
+                        inputValue = sign2;
                     }
-                    else {
-                        inputValue = maps[mapID](xPos, yPos);
+                    else if (inputValue == 2) { // value in map was 3
+                        inputValue = sign3;
                     }
-
-                    if (inputMode == "single") {
-                        // map values are 0 = empty, 1 = forward, 2 = left, 3 = right,
-                        // but output is -1 = empty, 0 = forward, 1+ = turn, so we need to do some conversion...
-                        inputValue--;
-                        if (inputValue == 1) { // value in map was 2
-                            inputValue = sign2;
+                    else if (inputValue == 3) { // value in map was 4
+                        inputValue = 0; // end marker now looks like any other forward location so it does not appear as a turn
+                    }
+                    brain->setInput(0, inputValue);
+                }
+                else { // (inputMode == "mixed" || "binary") {
+                    
+                    brain->setInput(0, inputValue == 0); // is location empty?
+                    brain->setInput(1, inputValue == 1 || inputValue == 4); // is location path or goal?
+                    
+                    if (inputMode == "mixed") {
+                        if (inputValue == 2) {
+                            brain->setInput(2, 1); // is location a turn?
+                            brain->setInput(3, sign2);
                         }
-                        else if (inputValue == 2) { // value in map was 3
-                            inputValue = sign3;
+                        else if (inputValue == 3) {
+                            brain->setInput(2, 1); // is location a turn?
+                            brain->setInput(3, sign3);
                         }
-                        else if (inputValue == 3) { // value in map was 4
-                            inputValue = 0; // end marker now looks like any other forward location so it does not appear as a turn
+                        else { // if not a turn
+                            brain->setInput(2, 0); // is location a turn?
+                            brain->setInput(3, 0);
                         }
-                        brain->setInput(0, inputValue);
-                    }
-                    else { // (inputMode == "mixed" || "binary") {
-                        
-                        brain->setInput(0, inputValue == 0); // is location empty?
-                        brain->setInput(1, inputValue == 1 || inputValue == 4); // is location path or goal?
-                        
-                        if (inputMode == "mixed") {
-                            if (inputValue == 2) {
-                                brain->setInput(2, 1); // is location a turn?
-                                brain->setInput(3, sign2);
-                            }
-                            else if (inputValue == 3) {
-                                brain->setInput(2, 1); // is location a turn?
-                                brain->setInput(3, sign3);
-                            }
-                            else { // if not a turn
-                                brain->setInput(2, 0); // is location a turn?
-                                brain->setInput(3, 0);
-                            }
-                        } // end inputMode = "mixed"
-                        else { // inputMode == "binary"
+                    } // end inputMode = "mixed"
+                    else { // inputMode == "binary"
 
-                            int val;
-                            bool isTurn;
+                        int val;
+                        bool isTurn;
 
-                            if (inputValue == 2) { // is turn
-                                val = sign2-1;
-                                isTurn = true;
-                            }
-                            else if (inputValue == 3) { // is turn
-                                val = sign3-1;
-                                isTurn = true;
-                            }
-                            else { // is not a turn
-                                val = 0;
-                                isTurn = false;
-                            }
+                        if (inputValue == 2) { // is turn
+                            val = sign2-1;
+                            isTurn = true;
+                        }
+                        else if (inputValue == 3) { // is turn
+                            val = sign3-1;
+                            isTurn = true;
+                        }
+                        else { // is not a turn
+                            val = 0;
+                            isTurn = false;
+                        }
 
-                            if (isTurn == false) {
-                                brain->setInput(2, 0); // set input turn
-                                for (int xx = 0; xx < outputsNeededForTurnSign; xx++) {
-                                    brain->setInput(3 + xx, 0); // set turn symbol inputs to 0
-                                }
+                        if (isTurn == false) {
+                            brain->setInput(2, 0); // set input turn
+                            for (int xx = 0; xx < outputsNeededForTurnSign; xx++) {
+                                brain->setInput(3 + xx, 0); // set turn symbol inputs to 0
                             }
-                            if (isTurn == true) {
-                                brain->setInput(2, 1); // set input turn
-                                int c = 0;
-                                for (int xx = 0; xx < outputsNeededForTurnSign; xx++) {
-                                    brain->setInput(3 + xx, val & 1); // set turn symbol inputs
-                                    val = val >> 1;
-                                    ++c;
-                                }
-                            }
-                        } // end else inputMode == "binary"
-                    } // end else (inputMode == "mixed" || "binary")
-
-                    // now that agent has inputs, update score based on map value at this location,
-                    // and update map
-                    // if map location = 1, +1 score, and change map location value to 0
-                    // if map location = 4, goal, set step = steps (so while loop will end)
-                    //    also add any remaning steps to score, if all path locations were visited
-                    // if map location > 1, set location value to 1 (i.e. turn markers become 1s),
-                    //    the value will be 1 next update if this agent turns, which will provide +1 score
-                    if (mapCopy(xPos, yPos) > 1) {
-                        if (firstTurn == -1) { // if this is the first turn the agent has seen in this map, recored map value
-                            firstTurn = mapCopy(xPos, yPos);
                         }
-                        if (mapCopy(xPos, yPos) == 4) { // if we get to the goal, and visted all locations get extra points for time left
-                            if (thisForwardCount >= forwardCounts[mapID]) { // if all forward locations have been visited...
-                                reachGoal = 1;
-                                score += (minSteps[mapID] + extraSteps) - step; // add points for time left
+                        if (isTurn == true) {
+                            brain->setInput(2, 1); // set input turn
+                            int c = 0;
+                            for (int xx = 0; xx < outputsNeededForTurnSign; xx++) {
+                                brain->setInput(3 + xx, val & 1); // set turn symbol inputs
+                                val = val >> 1;
+                                ++c;
                             }
-                            step = minSteps[mapID] + extraSteps; // if agent steps on 4, end now
                         }
-                        mapCopy(xPos, yPos) = 1; // set this location value to 1 so that on the next update agents do not pay emptySpaceCost
+                    } // end else inputMode == "binary"
+                } // end else (inputMode == "mixed" || "binary")
+
+                // now that agent has inputs, update score based on map value at this location,
+                // and update map
+                // if map location = 1, +1 score, and change map location value to 0
+                // if map location = 4, goal, set step = steps (so while loop will end)
+                //    also add any remaning steps to score, if all path locations were visited
+                // if map location > 1, set location value to 1 (i.e. turn markers become 1s),
+                //    the value will be 1 next update if this agent turns, which will provide +1 score
+                if (mapCopy(xPos, yPos) > 1) {
+                    if (firstTurn == -1) { // if this is the first turn the agent has seen in this map, recored map value
+                        firstTurn = mapCopy(xPos, yPos);
                     }
-                    else if (mapCopy(xPos, yPos) == 1) {
-                        score += 1;
-                        thisForwardCount += 1;
-                        if (clearVisted) {
-                            mapCopy(xPos, yPos) = 0; // revisting will cost agent emptySpaceCost
-                        }
-                        else { // clear visted is off, 1s on map (move forward) will be changed to -2, agents will still see marker on original map
-                            // agents will not get extra points or lose points for revisting this location
-                            mapCopy(xPos, yPos) = -2; // -2 value will remain unchanged so that this location will not score (positive or negitive) in the future
+                    if (mapCopy(xPos, yPos) == 4) { // if we get to the goal, and visted all locations get extra points for time left
+                        if (thisForwardCount >= forwardCounts[mapID]) { // if all forward locations have been visited...
+                            reachGoal = 1;
+                            score += (minSteps[mapID] + extraSteps) - step; // add points for time left
                         }
+                        step = minSteps[mapID] + extraSteps; // if agent steps on 4, end now
+                    }
+                    mapCopy(xPos, yPos) = 1; // set this location value to 1 so that on the next update agents do not pay emptySpaceCost
+                }
+                else if (mapCopy(xPos, yPos) == 1) {
+                    score += 1;
+                    thisForwardCount += 1;
+                    if (clearVisted) {
+                        mapCopy(xPos, yPos) = 0; // revisting will cost agent emptySpaceCost
                     }
-                    else if (mapCopy(xPos, yPos) == 0){
-                        // if current location is empty, pay emptySpaceCost
-                        score -= emptySpaceCost;
+                    else { // clear visted is off, 1s on map (move forward) will be changed to -2, agents will still see marker on original map
+                        // agents will not get extra points or lose points for revisting this location
+                        mapCopy(xPos, yPos) = -2; // -2 value will remain unchanged so that this location will not score (positive or negitive) in the future
                     }
+                }
+                else if (mapCopy(xPos, yPos) == 0){
+                    // if current location is empty, pay emptySpaceCost
+                    score -= emptySpaceCost;
+                }
 
-                    brain->update();
+                brain->update();
 
-                    out0 = Bit(brain->readOutput(0));
-                    out1 = Bit(brain->readOutput(1));
-                    out2 = Bit(brain->readOutput(2));
-                    if (debug) {
-                        std::cout << "outputs: " << out0 << "," << out1 << "," << out2 << std::endl;
-                    }
+                out0 = Bit(brain->readOutput(0));
+                out1 = Bit(brain->readOutput(1));
+                out2 = Bit(brain->readOutput(2));
+                if (debug) {
+                    std::cout << "outputs: " << out0 << "," << out1 << "," << out2 << std::endl;
+                }
 
-                    if (out2 == 1) { // reverse
-                        xPos = std::max(0, std::min(xPos - dx[direction], mapSizes[mapID].first-1));
-                        yPos = std::max(0, std::min(yPos - dy[direction], mapSizes[mapID].second-1));
-                    }
-                    else if (out0 == 1 && out1 == 1) { // forward
-                        xPos = std::max(0, std::min(xPos + dx[direction], mapSizes[mapID].first-1));
-                        yPos = std::max(0, std::min(yPos + dy[direction], mapSizes[mapID].second-1));
-                    }
-                    else if (out0 == 1 && out1 == 0) { // left
-                        direction = loopMod(direction - 1, 8);
-                    }
-                    else if (out0 == 0 && out1 == 1) { // right
-                        direction = loopMod(direction + 1, 8);
-                    }
+                if (out2 == 1) { // reverse
+                    xPos = std::max(0, std::min(xPos - dx[direction], mapSizes[mapID].first-1));
+                    yPos = std::max(0, std::min(yPos - dy[direction], mapSizes[mapID].second-1));
                 }
-                org->dataMap.append("completion", (double)thisForwardCount / (double)forwardCounts[mapID]);
-                if (reachGoal) {
-                    org->dataMap.append("score", score / maxScores[mapID]);
+                else if (out0 == 1 && out1 == 1) { // forward
+                    xPos = std::max(0, std::min(xPos + dx[direction], mapSizes[mapID].first-1));
+                    yPos = std::max(0, std::min(yPos + dy[direction], mapSizes[mapID].second-1));
                 }
-                else {
-                    org->dataMap.append("score", (.5 * score) / maxScores[mapID]);
+                else if (out0 == 1 && out1 == 0) { // left
+                    direction = loopMod(direction - 1, 8);
+                }
+                else if (out0 == 0 && out1 == 1) { // right
+                    direction = loopMod(direction + 1, 8);
                 }
-                org->dataMap.append("reachGoal", reachGoal);
-                if (debug || visualize) {
-                    std::cout << "completion: " << (double)thisForwardCount / (double)forwardCounts[mapID] << std::endl;
-                    std::cout << "score: " << score / maxScores[mapID] << std::endl;
-                    std::cout << "reachGoal: " << reachGoal << std::endl;
-                    std::cout << "sign2: " << sign2 << "   sign3: " << sign3 << std::endl;
-                    if (visualize) {
-                        std::string os = std::to_string(score / maxScores[mapID]) + ",";
-                        os += std::to_string(reachGoal) + ",";
-                        os += std::to_string((double)thisForwardCount / (double)forwardCounts[mapID]) + ",";
-                        os += std::to_string(firstTurn) + ",";
-                        os += std::to_string(sign2) + ",";
-                        os += std::to_string(sign3);
-                        FileManager::writeToFile("visualizationData_" + std::to_string(Global::randomSeedPL->get(PT)) + ".txt", os,
-                            "score,completion,reachGoal,firstTurn,sign2,sign3");
+            }
+            org->dataMap.append("completion", (double)thisForwardCount / (double)forwardCounts[mapID]);
+            if (reachGoal) {
+                org->dataMap.append("score", score / maxScores[mapID]);
+            }
+            else {
+                org->dataMap.append("score", (.5 * score) / maxScores[mapID]);
+            }
+            org->dataMap.append("reachGoal", reachGoal);
+            if (debug || visualize) {
+                std::cout << "completion: " << (double)thisForwardCount / (double)forwardCounts[mapID] << std::endl;
+                std::cout << "score: " << score / maxScores[mapID] << std::endl;
+                std::cout << "reachGoal: " << reachGoal << std::endl;
+                std::cout << "sign2: " << sign2 << "   sign3: " << sign3 << std::endl;
+                if (visualize) {
+                    std::string os = std::to_string(score / maxScores[mapID]) + ",";
+                    os += std::to_string(reachGoal) + ",";
+                    os += std::to_string((double)thisForwardCount / (double)forwardCounts[mapID]) + ",";
+                    os += std::to_string(firstTurn) + ",";
+                    os += std::to_string(sign2) + ",";
+                    os += std::to_string(sign3);
+                    FileManager::writeToFile("visualizationData_" + std::to_string(Global::randomSeedPL->get(PT)) + ".txt", os,
+                        "score,completion,reachGoal,firstTurn,sign2,sign3");
 
-                    }
                 }
             }
         }
-    } // end of population loop
+    }
 }
 
 // the requiredGroups function lets MABE know how to set up populations of organisms that this world needs
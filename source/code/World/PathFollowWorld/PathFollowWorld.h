@@ -296,6 +296,7 @@ public:
 	virtual ~PathFollowWorld() = default;
 
 	virtual auto evaluate(map<string, shared_ptr<Group>>& /*groups*/, int /*analyze*/, int /*visualize*/, int /*debug*/) -> void override;
+	auto evaluateSolo(shared_ptr<Organism> org, int analyze, int visualize, int debug) -> void;
 
 	virtual auto requiredGroups() -> unordered_map<string,unordered_set<string>> override;
 };
@@ -14,6 +14,7 @@
 #include <Group/Group.h>
 #include <Organism/Organism.h>
 #include <Utilities/Utilities.h>
+#include <Utilities/Checkpoint.h>
 #include <Utilities/Data.h>
 #include <Utilities/Loader.h>
 #include <Utilities/MTree.h>
@@ -24,11 +25,13 @@
 #include <Utilities/Filesystem.h>
 
 #include <algorithm>
+#include <chrono>
 #include <csignal> // sigint
 #include <cstdio>
 #include <cstdlib>
 #include <memory>
 #include <regex>
+#include <sstream>
 #include <vector>
 
 
@@ -50,6 +53,12 @@ std::map<std::string, std::shared_ptr<Group>>
 constructAllGroupsFrom(const std::shared_ptr<AbstractWorld> &world,
                        std::shared_ptr<ParametersTable> PT);
 
+void saveCheckpoint(const std::shared_ptr<AbstractWorld> &world,
+                    std::map<std::string, std::shared_ptr<Group>> &groups);
+void loadCheckpoint(const std::shared_ptr<AbstractWorld> &world,
+                    std::map<std::string, std::shared_ptr<Group>> &groups,
+                    const std::string &fileName);
+
 int main(int argc, const char *argv[]) {
   signal(SIGINT, catchCtrlC);
 
@@ -120,6 +129,7 @@ int main(int argc, const char *argv[]) {
     exit(1);
   }
   FileManager::outputPrefix = output_prefix;
+  FileManager::setAsync(Global::asyncFileWritingPL->get());
 
   // set up random number generator
   if (Global::randomSeedPL->get() == -1) {
@@ -158,6 +168,13 @@ int main(int argc, const char *argv[]) {
               << "\n"
               << "\n";
 
+    auto checkpointInterval = Global::checkpointIntervalPL->get();
+    auto checkpointTimeLimit = Global::checkpointTimeLimitPL->get();
+    auto startTime = std::chrono::steady_clock::now();
+    if (!Parameters::resume_file.empty()) {
+      loadCheckpoint(world, groups, Parameters::resume_file);
+    }
+
     // in run mode we evolve organsims
     auto done = false;
     while ((!done) && (!userExitFlag)) { //! groups[defaultGroup]->archivist->finished) {
@@ -180,12 +197,38 @@ int main(int argc, const char *argv[]) {
       }
 	  std::cout << std::endl;
       Global::update++; // advance time to create new population(s)
+
+      if (!done && !userExitFlag) {
+        auto timeUp =
+            checkpointTimeLimit > 0 &&
+            std::chrono::steady_clock::now() - startTime >=
+                std::chrono::minutes(checkpointTimeLimit);
+        if (timeUp || (checkpointInterval > 0 &&
+                       Global::update % checkpointInterval == 0)) {
+          saveCheckpoint(world, groups);
+        }
+        if (timeUp) { // stop now, the run is continued with -r
+          std::cout << "GLOBAL-checkpointTimeLimit reached. Run can be resumed "
+                       "from update "
+                    << Global::update << " with: -r "
+                    << FileManager::outputPrefix +
+                           Global::checkpointFilePL->get()
+                    << std::endl;
+          FileManager::flush();
+          return 0;
+        }
+      }
     }
 
     // the run is finished... flush any data that has not been output yet
     for (auto const &group : groups) {
       group.second->archive(1);
     }
+  } else if (!Parameters::resume_file.empty()) {
+    std::cout << "error: -r (resume from checkpoint) can only be used in run "
+                 "mode"
+              << std::endl;
+    exit(1);
   } else if (Global::modePL->get() == "visualize") {
     ////////////////////////////////////////////////////////////////////////////////////
     // visualize mode
@@ -209,6 +252,7 @@ int main(int argc, const char *argv[]) {
               << std::endl;
     exit(1);
   }
+  FileManager::flush(); // make sure all output is on disk
   return 0;
 }
 
@@ -492,3 +536,60 @@ constructAllGroupsFrom(const std::shared_ptr<AbstractWorld> &world,
   }
   return groups;
 }
+
+// a checkpoint is everything needed to continue the run: update, the next
+// organism ID and the random number generator, then each group (see
+// Group::saveCheckpoint), the world (see AbstractWorld::saveCheckpoint) and
+// the output files (so that a resumed run continues writing where this run
+// was when the checkpoint was saved)
+void saveCheckpoint(const std::shared_ptr<AbstractWorld> &world,
+                    std::map<std::string, std::shared_ptr<Group>> &groups) {
+  CheckpointWriter checkpoint(FileManager::outputPrefix +
+                              Global::checkpointFilePL->get());
+  checkpoint.section("MABE");
+  checkpoint.write(Global::update);
+  checkpoint.write(Organism::getOrganismIDCounter());
+  std::stringstream generatorState;
+  generatorState << Random::getCommonGenerator();
+  checkpoint.write(generatorState.str());
+  checkpoint.write(static_cast<uint64_t>(groups.size()));
+  for (auto const &group : groups) {
+    checkpoint.write(group.first);
+    group.second->saveCheckpoint(checkpoint);
+  }
+  checkpoint.section("WORLD");
+  world->saveCheckpoint(checkpoint);
+  FileManager::saveCheckpoint(checkpoint);
+  checkpoint.close();
+}
+
+void loadCheckpoint(const std::shared_ptr<AbstractWorld> &world,
+                    std::map<std::string, std::shared_ptr<Group>> &groups,
+                    const std::string &fileName) {
+  CheckpointReader checkpoint(fileName);
+  checkpoint.section("MABE");
+  auto update = checkpoint.read<int>();
+  auto organismIDCounter = checkpoint.read<int>();
+  auto generatorState = checkpoint.read<std::string>();
+  if (checkpoint.read<uint64_t>() != groups.size()) {
+    std::cout << "  In loadCheckpoint :: checkpoint \"" << fileName
+              << "\" was saved with different groups.\n  Exiting."
+              << std::endl;
+    exit(1);
+  }
+  for (auto const &group : groups) {
+    checkpoint.section(group.first);
+    group.second->loadCheckpoint(checkpoint);
+  }
+  checkpoint.section("WORLD");
+  world->loadCheckpoint(checkpoint);
+  FileManager::loadCheckpoint(checkpoint);
+
+  // loading organisms may issue IDs and use random numbers (i.e. when brains
+  // are built) so these are set last
+  Global::update = update;
+  Organism::setOrganismIDCounter(organismIDCounter);
+  std::stringstream(generatorState) >> Random::getCommonGenerator();
+  std::cout << "Resumed from checkpoint \"" << fileName << "\" at update "
+            << Global::update << std::endl;
+}